@@ -79,6 +79,11 @@ static void mailbox_destroy(Mailbox* mb);
  * Instead, we wrap the behavior call in a lambda body
  * that the fiber will evaluate. */
 Actor* actor_create(EvalContext* ctx, Cell* behavior, Cell* env) {
+    return actor_create_sized(ctx, behavior, env, FIBER_DEFAULT_STACK_SIZE);
+}
+
+/* As actor_create, with an explicit fiber stack reservation in bytes */
+Actor* actor_create_sized(EvalContext* ctx, Cell* behavior, Cell* env, size_t stack_size) {
     if (g_actor_count >= MAX_ACTORS) {
         return NULL;
     }
@@ -91,6 +96,7 @@ Actor* actor_create(EvalContext* ctx, Cell* behavior, Cell* env) {
     actor->home_scheduler = (int)tls_scheduler_id;
     atomic_init(&actor->wait_flag, 0);
     atomic_init(&actor->trace_seq, 0);
+    atomic_init(&actor->cold, NULL);
     actor->trace_origin = 0;
     actor->trace_causal = false;
 
@@ -102,7 +108,7 @@ Actor* actor_create(EvalContext* ctx, Cell* behavior, Cell* env) {
     /* We'll create the CELL_ACTOR externally and pass the call body.
      * For now, create fiber with the behavior body.
      * The caller (prim_spawn) builds the application expression. */
-    actor->fiber = fiber_create(ctx, behavior, env, FIBER_DEFAULT_STACK_SIZE);
+    actor->fiber = fiber_create(ctx, behavior, env, stack_size);
 
     /* Register in global registry (rwlock for thread safety) */
     pthread_rwlock_wrlock(&g_registry_lock);
@@ -129,44 +135,61 @@ static void mailbox_init(Mailbox* mb, uint32_t capacity) {
     atomic_init(&mb->enqueue_pos, 0);
     atomic_init(&mb->dequeue_pos, 0);
     atomic_init(&mb->count, 0);
-    mb->slots = (MailboxSlot*)calloc(capacity, sizeof(MailboxSlot));
-    for (uint32_t i = 0; i < capacity; i++) {
-        atomic_init(&mb->slots[i].sequence, (uint64_t)i);
-        mb->slots[i].value = NULL;
+    atomic_init(&mb->slots, NULL);
+}
+
+/* Slot array, allocated by the first sender. Concurrent first senders
+ * race to install theirs; losers free their copy and use the winner's. */
+static MailboxSlot* mailbox_slots(Mailbox* mb) {
+    MailboxSlot* slots = atomic_load_explicit(&mb->slots, memory_order_acquire);
+    if (slots) return slots;
+
+    MailboxSlot* fresh = (MailboxSlot*)malloc(mb->capacity * sizeof(MailboxSlot));
+    for (uint32_t i = 0; i < mb->capacity; i++) {
+        atomic_init(&fresh[i].sequence, (uint64_t)i);
+        fresh[i].value = NULL;
+    }
+    if (atomic_compare_exchange_strong_explicit(&mb->slots, &slots, fresh,
+            memory_order_acq_rel, memory_order_acquire)) {
+        return fresh;
     }
+    free(fresh);
+    return slots;
 }
 
 static void mailbox_destroy(Mailbox* mb) {
-    if (!mb->slots) return;
+    MailboxSlot* slots = atomic_load_explicit(&mb->slots, memory_order_acquire);
+    if (!slots) return;
     /* Drain remaining messages */
     uint64_t dq = atomic_load_explicit(&mb->dequeue_pos, memory_order_relaxed);
     uint64_t eq = atomic_load_explicit(&mb->enqueue_pos, memory_order_relaxed);
     for (uint64_t i = dq; i < eq; i++) {
-        MailboxSlot* slot = &mb->slots[i & mb->mask];
+        MailboxSlot* slot = &slots[i & mb->mask];
         if (slot->value) {
             cell_release(slot->value);
             slot->value = NULL;
         }
     }
-    free(mb->slots);
-    mb->slots = NULL;
+    free(slots);
+    atomic_store_explicit(&mb->slots, NULL, memory_order_relaxed);
 }
 
 void actor_send(Actor* actor, Cell* message) {
     if (!actor || !actor->alive) return;
     Mailbox* mb = &actor->mailbox;
+    MailboxSlot* slots = mailbox_slots(mb);
 
     uint64_t pos = atomic_load_explicit(&mb->enqueue_pos, memory_order_relaxed);
     for (;;) {
-        MailboxSlot* slot = &mb->slots[pos & mb->mask];
+        MailboxSlot* slot = &slots[pos & mb->mask];
         uint64_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
         int64_t diff = (int64_t)seq - (int64_t)pos;
 
         if (diff == 0) {
             if (atomic_compare_exchange_weak_explicit(&mb->enqueue_pos, &pos, pos + 1,
                     memory_order_relaxed, memory_order_relaxed)) {
-                cell_retain(message);
-                slot->value = message;
+                /* Copy-on-send: never leave another actor holding arena cells */
+                slot->value = cell_arena_promote(message);
                 atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
                 atomic_fetch_add_explicit(&mb->count, 1, memory_order_relaxed);
 
@@ -199,12 +222,19 @@ void actor_send(Actor* actor, Cell* message) {
 }
 
 Cell* actor_receive(Actor* actor) {
+    if (actor->save_len > 0) return actor_save_remove(actor, 0);
+    return actor_mailbox_take(actor);
+}
+
+Cell* actor_mailbox_take(Actor* actor) {
     Mailbox* mb = &actor->mailbox;
     if (atomic_load_explicit(&mb->count, memory_order_relaxed) <= 0) return NULL;
+    MailboxSlot* slots = atomic_load_explicit(&mb->slots, memory_order_acquire);
+    if (!slots) return NULL;
 
     uint64_t pos = atomic_load_explicit(&mb->dequeue_pos, memory_order_relaxed);
     for (;;) {
-        MailboxSlot* slot = &mb->slots[pos & mb->mask];
+        MailboxSlot* slot = &slots[pos & mb->mask];
         uint64_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
         int64_t diff = (int64_t)seq - (int64_t)(pos + 1);
 
@@ -226,6 +256,92 @@ Cell* actor_receive(Actor* actor) {
     }
 }
 
+/* Save queue: a ring of skipped messages, grown by doubling */
+void actor_save(Actor* actor, Cell* message) {
+    if (actor->save_len == actor->save_cap) {
+        uint32_t cap = actor->save_cap ? actor->save_cap * 2 : 16;
+        Cell** q = (Cell**)malloc(cap * sizeof(Cell*));
+        for (uint32_t i = 0; i < actor->save_len; i++)
+            q[i] = actor->save_queue[(actor->save_head + i) & (actor->save_cap - 1)];
+        free(actor->save_queue);
+        actor->save_queue = q;
+        actor->save_cap = cap;
+        actor->save_head = 0;
+    }
+    actor->save_queue[(actor->save_head + actor->save_len) & (actor->save_cap - 1)] = message;
+    actor->save_len++;
+}
+
+/* Remove the index-th oldest saved message; caller owns the ref.
+ * Closes the gap from whichever end is nearer. */
+Cell* actor_save_remove(Actor* actor, uint32_t index) {
+    uint32_t mask = actor->save_cap - 1;
+    Cell* msg = actor->save_queue[(actor->save_head + index) & mask];
+    if (index < actor->save_len / 2) {
+        for (uint32_t i = index; i > 0; i--)
+            actor->save_queue[(actor->save_head + i) & mask] =
+                actor->save_queue[(actor->save_head + i - 1) & mask];
+        actor->save_head = (actor->save_head + 1) & mask;
+    } else {
+        for (uint32_t i = index; i + 1 < actor->save_len; i++)
+            actor->save_queue[(actor->save_head + i) & mask] =
+                actor->save_queue[(actor->save_head + i + 1) & mask];
+    }
+    actor->save_len--;
+    return msg;
+}
+
+/* Deliver a reply for call `ref` straight into the caller's reply slot.
+ * Returns false if the caller is no longer waiting on that ref. */
+bool actor_deliver_reply(Actor* caller, uint32_t ref, Cell* reply) {
+    if (!caller || !caller->alive || ref == 0) return false;
+    uint32_t expected = ref;
+    if (!atomic_compare_exchange_strong_explicit(&caller->call_ref, &expected, 0,
+            memory_order_acq_rel, memory_order_relaxed)) {
+        return false;
+    }
+    atomic_store_explicit(&caller->call_reply, cell_arena_promote(reply), memory_order_release);
+
+    if (atomic_exchange_explicit(&caller->wait_flag, 0, memory_order_acq_rel) == 1) {
+        Scheduler* home = sched_get(caller->home_scheduler);
+        if (home) {
+            sched_enqueue(home, caller);
+        }
+    }
+    return true;
+}
+
+/* Bulk-free a finished actor's private heap. Cells that escaped it (the
+ * result, messages held elsewhere) are tenured in place. The caller
+ * guarantees no scheduler can still run the actor. */
+void actor_release_arena(Actor* actor) {
+    if (!actor || !actor->arena) return;
+    pthread_mutex_lock(ACTOR_STRIPE(actor->id));
+    CellArena* arena = actor->arena;
+    actor->arena_final_slabs = cell_arena_slab_count(arena);
+    actor->arena_final_allocs = cell_arena_alloc_count(arena);
+    actor->arena_released = true;
+    actor->arena = NULL;
+    pthread_mutex_unlock(ACTOR_STRIPE(actor->id));
+    cell_arena_destroy(arena);
+}
+
+/* Arena statistics, live or as they were when the arena was released.
+ * False if the actor never had an arena. */
+bool actor_arena_stats(Actor* actor, uint32_t* slabs, uint64_t* allocs) {
+    pthread_mutex_lock(ACTOR_STRIPE(actor->id));
+    bool has = actor->arena || actor->arena_released;
+    if (actor->arena) {
+        *slabs = cell_arena_slab_count(actor->arena);
+        *allocs = cell_arena_alloc_count(actor->arena);
+    } else {
+        *slabs = actor->arena_final_slabs;
+        *allocs = actor->arena_final_allocs;
+    }
+    pthread_mutex_unlock(ACTOR_STRIPE(actor->id));
+    return has;
+}
+
 /* Destroy actor and free resources */
 void actor_destroy(Actor* actor) {
     if (!actor) return;
@@ -233,12 +349,22 @@ void actor_destroy(Actor* actor) {
     /* Release remaining mailbox messages */
     mailbox_destroy(&actor->mailbox);
 
-    /* Release process dictionary entries */
-    for (int i = 0; i < actor->dict_count; i++) {
-        if (actor->dict_keys[i]) cell_release(actor->dict_keys[i]);
-        if (actor->dict_values[i]) cell_release(actor->dict_values[i]);
+    /* Release skipped and undelivered messages */
+    while (actor->save_len > 0) cell_release(actor_save_remove(actor, 0));
+    free(actor->save_queue);
+    Cell* reply = atomic_load_explicit(&actor->call_reply, memory_order_acquire);
+    if (reply) cell_release(reply);
+
+    /* Release links/monitors and process dictionary entries */
+    ActorCold* cold = atomic_load_explicit(&actor->cold, memory_order_acquire);
+    if (cold) {
+        free(cold->links.ids);
+        free(cold->links.index);
+        free(cold->monitors.ids);
+        free(cold->monitors.index);
+        if (cold->dict) cell_release(cold->dict);
+        free(cold);
     }
-    actor->dict_count = 0;
 
     if (actor->result) {
         cell_release_shared(actor->result);
@@ -248,12 +374,165 @@ void actor_destroy(Actor* actor) {
         fiber_destroy(actor->fiber);
     }
 
+    /* Bulk-free the private heap; escaped cells are tenured, not freed */
+    cell_arena_destroy(actor->arena);
+
     free(actor);
 }
 
-/* Supervision: bidirectional link */
-void actor_link(Actor* a, Actor* b) {
-    if (!a || !b) return;
+/* Cold state, installed by CAS: links/monitors are added by other actors
+ * under the stripe lock while the owner may be creating its dictionary. */
+ActorCold* actor_cold(Actor* actor) {
+    ActorCold* cold = atomic_load_explicit(&actor->cold, memory_order_acquire);
+    if (cold) return cold;
+    ActorCold* fresh = (ActorCold*)calloc(1, sizeof(ActorCold));
+    if (!fresh) return NULL;
+    if (atomic_compare_exchange_strong_explicit(&actor->cold, &cold, fresh,
+            memory_order_acq_rel, memory_order_acquire)) {
+        return fresh;
+    }
+    free(fresh);
+    return cold;
+}
+
+/* Resident bytes owned by the actor, excluding its (lazily committed) stack */
+size_t actor_memory(Actor* actor) {
+    size_t bytes = sizeof(Actor);
+    if (actor->fiber) bytes += sizeof(Fiber);
+    if (atomic_load_explicit(&actor->mailbox.slots, memory_order_acquire))
+        bytes += actor->mailbox.capacity * sizeof(MailboxSlot);
+    bytes += actor->save_cap * sizeof(Cell*);
+    ActorCold* cold = atomic_load_explicit(&actor->cold, memory_order_acquire);
+    if (cold) {
+        bytes += sizeof(ActorCold);
+        bytes += (cold->links.cap + cold->monitors.cap) * sizeof(int);
+        bytes += (cold->links.index_cap + cold->monitors.index_cap) * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+/* ── Actor ID lists (links/monitors) ── */
+
+#define IDLIST_INDEX_MIN 16
+
+static inline uint32_t idlist_home(const ActorIdList* list, int id) {
+    return ((uint32_t)id * 2654435761u) & (list->index_cap - 1);
+}
+
+static void idlist_index_put(ActorIdList* list, uint32_t pos) {
+    uint32_t mask = list->index_cap - 1;
+    uint32_t s = idlist_home(list, list->ids[pos]);
+    while (list->index[s]) s = (s + 1) & mask;
+    list->index[s] = pos + 1;
+}
+
+/* Backward-shift deletion keeps every probe run free of gaps */
+static void idlist_index_del(ActorIdList* list, uint32_t pos) {
+    uint32_t mask = list->index_cap - 1;
+    uint32_t s = idlist_home(list, list->ids[pos]);
+    while (list->index[s] != pos + 1) s = (s + 1) & mask;
+    for (uint32_t n = (s + 1) & mask; list->index[n]; n = (n + 1) & mask) {
+        uint32_t home = idlist_home(list, list->ids[list->index[n] - 1]);
+        if (((n - home) & mask) >= ((n - s) & mask)) {
+            list->index[s] = list->index[n];
+            s = n;
+        }
+    }
+    list->index[s] = 0;
+}
+
+/* Position + 1 of the oldest entry for id, or 0 */
+static uint32_t idlist_find(const ActorIdList* list, int id) {
+    if (!list->index) {
+        for (uint32_t i = 0; i < list->count; i++) {
+            if (list->ids[i] == id) return i + 1;
+        }
+        return 0;
+    }
+    /* Repeats (monitors) share one probe run; keep the earliest */
+    uint32_t mask = list->index_cap - 1, best = 0;
+    for (uint32_t s = idlist_home(list, id); list->index[s]; s = (s + 1) & mask) {
+        uint32_t p = list->index[s];
+        if (list->ids[p - 1] == id && (!best || p < best)) best = p;
+    }
+    return best;
+}
+
+static bool idlist_contains(const ActorIdList* list, int id) {
+    return idlist_find(list, id) != 0;
+}
+
+static void idlist_squeeze(ActorIdList* list) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < list->count; i++) {
+        if (list->ids[i] >= 0) list->ids[n++] = list->ids[i];
+    }
+    list->count = n;
+}
+
+/* Squeeze out holes and rebuild the index for the current capacity. A
+ * failed index allocation only drops the list back to scanning. */
+static void idlist_compact(ActorIdList* list) {
+    idlist_squeeze(list);
+    uint32_t n = list->count;
+    free(list->index);
+    list->index = NULL;
+    list->index_cap = 0;
+    if (list->cap < IDLIST_INDEX_MIN) return;
+    uint32_t icap = IDLIST_INDEX_MIN * 2;
+    while (icap < list->cap * 2) icap *= 2;
+    list->index = (uint32_t*)calloc(icap, sizeof(uint32_t));
+    if (!list->index) return;
+    list->index_cap = icap;
+    for (uint32_t i = 0; i < n; i++) idlist_index_put(list, i);
+}
+
+/* Append id; false (list unchanged) if it could not grow */
+static bool idlist_push(ActorIdList* list, int id) {
+    if (list->count == list->cap) {
+        if (list->live <= list->cap / 2 && list->cap) {
+            /* Half holes: reclaim them instead of growing */
+            idlist_compact(list);
+        } else {
+            uint32_t cap = list->cap ? list->cap * 2 : 4;
+            int* grown = (int*)realloc(list->ids, cap * sizeof(int));
+            if (!grown) return false;
+            list->ids = grown;
+            list->cap = cap;
+            idlist_compact(list);
+        }
+    }
+    list->ids[list->count] = id;
+    if (list->index) idlist_index_put(list, list->count);
+    list->count++;
+    list->live++;
+    return true;
+}
+
+/* Remove the oldest occurrence of id; the rest keep their order */
+static void idlist_remove(ActorIdList* list, int id) {
+    uint32_t p = idlist_find(list, id);
+    if (!p) return;
+    if (list->index) idlist_index_del(list, p - 1);
+    list->ids[p - 1] = -1;
+    list->live--;
+}
+
+/* Detach the list's entries in order; caller frees the array. Leaves the
+ * list empty. */
+static int* idlist_take(ActorIdList* list, uint32_t* count_out) {
+    idlist_squeeze(list);
+    free(list->index);
+    int* ids = list->ids;
+    *count_out = list->count;
+    *list = (ActorIdList){0};
+    return ids;
+}
+
+/* Supervision: bidirectional link. False if either side could not record
+ * it, in which case neither does. */
+bool actor_link(Actor* a, Actor* b) {
+    if (!a || !b) return true;
     /* Lock both stripes (ordered by ID to prevent deadlock) */
     int lo = a->id < b->id ? a->id : b->id;
     int hi = a->id < b->id ? b->id : a->id;
@@ -261,28 +540,27 @@ void actor_link(Actor* a, Actor* b) {
     if ((lo & (ACTOR_LOCK_STRIPES - 1)) != (hi & (ACTOR_LOCK_STRIPES - 1)))
         pthread_mutex_lock(ACTOR_STRIPE(hi));
 
-    /* Add b to a's links (if not already there) */
-    bool found_a = false;
-    for (int i = 0; i < a->link_count; i++) {
-        if (a->links[i] == b->id) { found_a = true; break; }
-    }
-    if (!found_a && a->link_count < MAX_LINKS) {
-        a->links[a->link_count++] = b->id;
-    }
-    /* Add a to b's links */
-    bool found_b = false;
-    for (int i = 0; i < b->link_count; i++) {
-        if (b->links[i] == a->id) { found_b = true; break; }
-    }
-    if (!found_b && b->link_count < MAX_LINKS) {
-        b->links[b->link_count++] = a->id;
+    /* Add each to the other's link set (no-op if already linked) */
+    ActorCold* ca = actor_cold(a);
+    ActorCold* cb = actor_cold(b);
+    bool ok = ca && cb;
+    if (ok) {
+        bool added_a = false;
+        if (!idlist_contains(&ca->links, b->id)) {
+            ok = idlist_push(&ca->links, b->id);
+            added_a = ok;
+        }
+        if (ok && !idlist_contains(&cb->links, a->id)) {
+            ok = idlist_push(&cb->links, a->id);
+            if (!ok && added_a) idlist_remove(&ca->links, b->id);
+        }
     }
-
-    trace_record(TRACE_LINK, (uint16_t)a->id, (uint16_t)b->id);
+    if (ok) trace_record(TRACE_LINK, (uint16_t)a->id, (uint16_t)b->id);
 
     if ((lo & (ACTOR_LOCK_STRIPES - 1)) != (hi & (ACTOR_LOCK_STRIPES - 1)))
         pthread_mutex_unlock(ACTOR_STRIPE(hi));
     pthread_mutex_unlock(ACTOR_STRIPE(lo));
+    return ok;
 }
 
 void actor_unlink(Actor* a, Actor* b) {
@@ -293,18 +571,10 @@ void actor_unlink(Actor* a, Actor* b) {
     if ((lo & (ACTOR_LOCK_STRIPES - 1)) != (hi & (ACTOR_LOCK_STRIPES - 1)))
         pthread_mutex_lock(ACTOR_STRIPE(hi));
 
-    for (int i = 0; i < a->link_count; i++) {
-        if (a->links[i] == b->id) {
-            a->links[i] = a->links[--a->link_count];
-            break;
-        }
-    }
-    for (int i = 0; i < b->link_count; i++) {
-        if (b->links[i] == a->id) {
-            b->links[i] = b->links[--b->link_count];
-            break;
-        }
-    }
+    ActorCold* ca = atomic_load_explicit(&a->cold, memory_order_acquire);
+    ActorCold* cb = atomic_load_explicit(&b->cold, memory_order_acquire);
+    if (ca) idlist_remove(&ca->links, b->id);
+    if (cb) idlist_remove(&cb->links, a->id);
 
     if ((lo & (ACTOR_LOCK_STRIPES - 1)) != (hi & (ACTOR_LOCK_STRIPES - 1)))
         pthread_mutex_unlock(ACTOR_STRIPE(hi));
@@ -312,27 +582,29 @@ void actor_unlink(Actor* a, Actor* b) {
 }
 
 /* Add watcher as a monitor of target */
-/* Returns true if monitor was added (target alive), false if target already dead.
- * Caller must send :DOWN immediately when false is returned — this closes the
- * TOCTOU race between alive-check and monitor registration that caused deadlocks
- * in multi-scheduler mode. */
-bool actor_add_monitor(Actor* target, Actor* watcher) {
-    if (!target || !watcher) return false;
+/* Returns MONITOR_TARGET_DEAD if target is already dead. Caller must send
+ * :DOWN immediately then — this closes the TOCTOU race between alive-check
+ * and monitor registration that caused deadlocks in multi-scheduler mode. */
+MonitorResult actor_add_monitor(Actor* target, Actor* watcher) {
+    if (!target || !watcher) return MONITOR_TARGET_DEAD;
     pthread_mutex_lock(ACTOR_STRIPE(target->id));
     if (!target->alive) {
         pthread_mutex_unlock(ACTOR_STRIPE(target->id));
         LOG_DEBUG("add_monitor: target %d already dead, watcher %d gets immediate :DOWN",
             target->id, watcher->id);
-        return false;  /* Target died between caller's check and our lock */
+        return MONITOR_TARGET_DEAD;  /* Target died between caller's check and our lock */
     }
-    if (target->monitor_count < MAX_MONITORS) {
-        target->monitors[target->monitor_count++] = watcher->id;
-        LOG_DEBUG("add_monitor: target %d watcher %d (count=%d)",
-            target->id, watcher->id, target->monitor_count);
-        trace_record(TRACE_MONITOR, (uint16_t)target->id, (uint16_t)watcher->id);
+    /* Each call is its own monitor: watching twice means two :DOWNs */
+    ActorCold* cold = actor_cold(target);
+    if (!cold || !idlist_push(&cold->monitors, watcher->id)) {
+        pthread_mutex_unlock(ACTOR_STRIPE(target->id));
+        return MONITOR_NO_MEMORY;
     }
+    LOG_DEBUG("add_monitor: target %d watcher %d (count=%u)",
+        target->id, watcher->id, cold->monitors.live);
+    trace_record(TRACE_MONITOR, (uint16_t)target->id, (uint16_t)watcher->id);
     pthread_mutex_unlock(ACTOR_STRIPE(target->id));
-    return true;
+    return MONITOR_ADDED;
 }
 
 /* Decrement g_alive_actors and wake all schedulers if it hits 0.
@@ -468,23 +740,22 @@ void actor_notify_exit(Actor* exiting, Cell* reason) {
         }
     }
 
-    /* Copy link/monitor arrays under stripe lock to avoid races */
-    int monitor_ids[MAX_MONITORS];
-    int monitor_count;
-    int link_ids[MAX_LINKS];
-    int link_count;
+    /* Detach link/monitor sets under stripe lock to avoid races */
+    int* monitor_ids = NULL;
+    uint32_t monitor_count = 0;
+    int* link_ids = NULL;
+    uint32_t link_count = 0;
 
     pthread_mutex_lock(ACTOR_STRIPE(exiting->id));
-    monitor_count = exiting->monitor_count;
-    memcpy(monitor_ids, exiting->monitors, monitor_count * sizeof(int));
-    link_count = exiting->link_count;
-    memcpy(link_ids, exiting->links, link_count * sizeof(int));
-    exiting->monitor_count = 0;
-    exiting->link_count = 0;
+    ActorCold* cold = atomic_load_explicit(&exiting->cold, memory_order_acquire);
+    if (cold) {
+        monitor_ids = idlist_take(&cold->monitors, &monitor_count);
+        link_ids = idlist_take(&cold->links, &link_count);
+    }
     pthread_mutex_unlock(ACTOR_STRIPE(exiting->id));
 
     /* Notify monitors: send ⟨:DOWN id reason⟩ message (outside lock) */
-    for (int i = 0; i < monitor_count; i++) {
+    for (uint32_t i = 0; i < monitor_count; i++) {
         Actor* watcher = actor_lookup(monitor_ids[i]);
         LOG_DEBUG("notify_exit: actor %d -> monitor watcher %d (found=%d alive=%d)",
             exiting->id, monitor_ids[i], watcher != NULL, watcher ? watcher->alive : 0);
@@ -501,7 +772,7 @@ void actor_notify_exit(Actor* exiting, Cell* reason) {
     }
 
     /* Notify linked actors (outside lock) */
-    for (int i = 0; i < link_count; i++) {
+    for (uint32_t i = 0; i < link_count; i++) {
         Actor* linked = actor_lookup(link_ids[i]);
         if (linked && linked->alive) {
             if (is_error) {
@@ -519,6 +790,9 @@ void actor_notify_exit(Actor* exiting, Cell* reason) {
             }
         }
     }
+
+    free(monitor_ids);
+    free(link_ids);
 }
 
 /* ─── Supervisor ─── */
@@ -787,6 +1061,9 @@ int actor_run_all(int max_ticks) {
                         if (awaited && awaited->alive) continue;
                         break;
                     }
+                    case SUSPEND_CALL:
+                        if (atomic_load_explicit(&actor->call_reply, memory_order_acquire) == NULL) continue;
+                        break;
                     case SUSPEND_GENERAL:
                         continue; /* Wait for explicit resume */
                     case SUSPEND_REDUCTION:
@@ -797,8 +1074,20 @@ int actor_run_all(int max_ticks) {
             /* Set current actor so ←? can find it */
             Actor* prev_actor = g_current_actor;
             Fiber* prev_fiber = fiber_current();
+            /* The fiber shares the caller's context: its budget must not
+             * outlive the quantum, and its reduction continuation is parked
+             * on the fiber in between (as sched_run_one_quantum does) */
+            EvalContext* fctx = fiber->eval_ctx;
+            int32_t prev_reds = fctx->reductions_left;
+            if (fiber->saved_continuation) {
+                fctx->continuation = fiber->saved_continuation;
+                fctx->continuation_env = fiber->saved_continuation_env;
+                fiber->saved_continuation = NULL;
+                fiber->saved_continuation_env = NULL;
+            }
             g_current_actor = actor;
             fiber_set_current(fiber);
+            CellArena* prev_arena = cell_arena_enter(actor->arena);
 
             if (fiber->state == FIBER_READY) {
                 /* First run — set reduction budget */
@@ -826,7 +1115,8 @@ int actor_run_all(int max_ticks) {
 
                 switch (fiber->suspend_reason) {
                     case SUSPEND_MAILBOX: {
-                        Cell* msg = actor_receive(actor);
+                        /* The save queue was already scanned before suspending */
+                        Cell* msg = actor_mailbox_take(actor);
                         resume_val = msg ? msg : cell_nil();
                         break;
                     }
@@ -893,6 +1183,12 @@ int actor_run_all(int max_ticks) {
                         }
                         break;
                     }
+                    case SUSPEND_CALL: {
+                        Cell* reply = atomic_exchange_explicit(&actor->call_reply, NULL,
+                                                               memory_order_acq_rel);
+                        resume_val = reply ? reply : cell_nil();
+                        break;
+                    }
                     case SUSPEND_GENERAL:
                         resume_val = cell_nil();
                         break;
@@ -914,15 +1210,26 @@ int actor_run_all(int max_ticks) {
                 if (resume_val) cell_release(resume_val);
                 any_ran = true;
             }
+            cell_arena_enter(prev_arena);
+
+            if (fctx->continuation) {
+                fiber->saved_continuation = fctx->continuation;
+                fiber->saved_continuation_env = fctx->continuation_env;
+                fctx->continuation = NULL;
+                fctx->continuation_env = NULL;
+            }
 
             /* Check if actor finished */
             if (fiber->state == FIBER_FINISHED) {
                 actor_finish(actor, fiber->result);
+                /* Single-threaded run loop: nothing else can hold the actor */
+                actor_release_arena(actor);
             }
 
             /* Restore */
             g_current_actor = prev_actor;
             fiber_set_current(prev_fiber);
+            fctx->reductions_left = prev_reds;
         }
 
         /* Tick timers each scheduler round */
@@ -17,65 +17,112 @@ typedef struct {
     Cell* value;
 } MailboxSlot;
 
-/* Per-actor Vyukov MPMC mailbox */
+/* Per-actor Vyukov MPMC mailbox. Slots are allocated by the first send,
+ * so an actor that is never messaged carries no slot array. */
 typedef struct {
     uint32_t capacity;
     uint32_t mask;
     _Atomic uint64_t enqueue_pos;
     _Atomic uint64_t dequeue_pos;
     _Atomic int32_t count;       /* Approximate count for scheduling heuristic */
-    MailboxSlot* slots;
+    _Atomic(MailboxSlot*) slots;
 } Mailbox;
-#define MAX_LINKS 32
-#define MAX_MONITORS 32
+
+/* Insertion-ordered set of actor IDs, so exit notifications go out in the
+ * order links/monitors were made. Removal leaves a hole (-1) in ids that
+ * the next growth compacts away. Lists of IDLIST_INDEX_MIN slots or more
+ * also keep an open-addressed index from id to position, making lookup
+ * and removal O(1); without one (short list, or the index could not be
+ * allocated) they are scanned. */
+typedef struct {
+    int* ids;            /* Insertion order; -1 marks a removed entry */
+    uint32_t* index;     /* Probe slot -> position + 1, 0 = empty; or NULL */
+    uint32_t count;      /* Used slots of ids, holes included */
+    uint32_t live;       /* Entries that are not holes */
+    uint32_t cap;
+    uint32_t index_cap;  /* Power of two, at least 2 * cap */
+} ActorIdList;
+
+/* Outcome of actor_add_monitor */
+typedef enum {
+    MONITOR_ADDED,
+    MONITOR_TARGET_DEAD,   /* Caller sends :DOWN itself */
+    MONITOR_NO_MEMORY,
+} MonitorResult;
+
+/* Cold actor state: supervision sets and the process dictionary.
+ * Allocated on first link/monitor/proc-dict-put; most actors never need it. */
+typedef struct ActorCold {
+    ActorIdList links;     /* Bidirectional linked actor IDs, no repeats (stripe lock) */
+    ActorIdList monitors;  /* Watchers, one entry per monitor call (stripe lock) */
+    Cell* dict;            /* Process dictionary (CELL_HASHMAP), owner only */
+} ActorCold;
+
 #define MAX_SUPERVISORS 64
 #define MAX_SUP_CHILDREN 32
 #define SUP_MAX_RESTARTS 5
 #define MAX_REGISTRY 256
 #define MAX_TIMERS 256
-#define MAX_DICT_ENTRIES 256
 #define MAX_ETS_TABLES 64
 #define MAX_ETS_ENTRIES 1024
 #define MAX_APPLICATIONS 16
 #define MAX_APP_ENV 64
 
-/* Actor - a fiber with a mailbox */
+/* Actor - a fiber with a mailbox.
+ * Hot fields (mailbox, run state, scheduling) come first; rarely used
+ * state lives behind `cold`. An idle actor is this struct, its Fiber and
+ * a lazily committed stack. */
 typedef struct Actor {
-    int id;                /* Unique actor ID */
-    Fiber* fiber;          /* Underlying fiber */
+    /* Hot: touched on every send / receive / scheduling decision */
     Mailbox mailbox;       /* Per-actor Vyukov MPMC mailbox */
+    _Atomic int wait_flag; /* 0=runnable, 1=blocked on mailbox/channel/etc (Day 134) */
+    int id;                /* Unique actor ID */
+    int home_scheduler;    /* Scheduler ID that owns this actor (Day 133) */
     bool alive;            /* false after actor finishes */
+    bool trap_exit;        /* Convert exit signals to messages */
+    bool trace_causal;     /* Causal tracing active for this actor (Day 136) */
+    bool arena_released;   /* Arena destroyed after finish; stats below are final */
+    uint16_t trace_origin; /* Origin actor of causal chain (0=none) */
+    Fiber* fiber;          /* Underlying fiber */
     Cell* result;          /* Final result when finished */
 
-    /* Supervision */
-    int links[MAX_LINKS];      /* Bidirectional linked actor IDs */
-    int link_count;
-    int monitors[MAX_MONITORS]; /* Actor IDs monitoring this actor */
-    int monitor_count;
-    bool trap_exit;             /* Convert exit signals to messages */
-
-    /* Process dictionary (per-actor key-value store) */
-    Cell* dict_keys[MAX_DICT_ENTRIES];
-    Cell* dict_values[MAX_DICT_ENTRIES];
-    int dict_count;
-
-    /* Scheduler affinity (Day 133) */
-    int home_scheduler;     /* Scheduler ID that owns this actor */
-
-    /* Blocking/wake protocol (Day 134) */
-    _Atomic int wait_flag;  /* 0=runnable, 1=blocked on mailbox/channel/etc */
-
-    /* Causal trace token (Day 136) */
-    _Atomic uint32_t trace_seq;    /* Monotonic per-actor sequence counter */
-    uint16_t trace_origin;         /* Origin actor of causal chain (0=none) */
-    bool trace_causal;             /* Causal tracing active for this actor */
+    /* actor-call ref tag: the reply goes to call_reply, not the mailbox */
+    uint32_t call_seq;
+    _Atomic uint32_t call_ref;     /* Outstanding call ref (0 = none) */
+    _Atomic(Cell*) call_reply;
+    _Atomic uint32_t trace_seq;    /* Monotonic per-actor causal sequence counter */
+
+    /* Selective receive: messages skipped by actor-receive-match, oldest
+     * first. Only the owning actor touches the save queue. */
+    uint32_t save_head;
+    uint32_t save_len;
+    uint32_t save_cap;
+    Cell** save_queue;
+
+    /* Private cell heap — NULL uses the shared per-thread slab allocator.
+     * Released once the finished actor is past its QSBR grace period. */
+    CellArena* arena;
+    uint32_t arena_final_slabs;
+    uint64_t arena_final_allocs;
+
+    /* Links, monitors, process dictionary — NULL until first used */
+    _Atomic(ActorCold*) cold;
 } Actor;
 
 /* Lifecycle */
 Actor* actor_create(EvalContext* ctx, Cell* behavior, Cell* env);
+Actor* actor_create_sized(EvalContext* ctx, Cell* behavior, Cell* env, size_t stack_size);
+ActorCold* actor_cold(Actor* actor);      /* Allocate cold state on first use; NULL if out of memory */
+size_t actor_memory(Actor* actor);        /* Resident bytes, excluding the stack */
 void   actor_send(Actor* actor, Cell* message);
-Cell*  actor_receive(Actor* actor);
+Cell*  actor_receive(Actor* actor);       /* Save queue first, then mailbox */
+Cell*  actor_mailbox_take(Actor* actor);  /* Mailbox only, bypasses save queue */
+void   actor_save(Actor* actor, Cell* message);
+Cell*  actor_save_remove(Actor* actor, uint32_t index);
+bool   actor_deliver_reply(Actor* caller, uint32_t ref, Cell* reply);
 void   actor_destroy(Actor* actor);
+void   actor_release_arena(Actor* actor);  /* Finished actors only */
+bool   actor_arena_stats(Actor* actor, uint32_t* slabs, uint64_t* allocs);
 
 /* Striped lock initialization/cleanup */
 void actor_locks_init(void);
@@ -92,9 +139,9 @@ Actor* actor_current(void);
 void   actor_set_current(Actor* actor);
 
 /* Supervision */
-void   actor_link(Actor* a, Actor* b);
+bool   actor_link(Actor* a, Actor* b);   /* false: out of memory, nothing linked */
 void   actor_unlink(Actor* a, Actor* b);
-bool   actor_add_monitor(Actor* target, Actor* watcher);
+MonitorResult actor_add_monitor(Actor* target, Actor* watcher);
 void   actor_exit_signal(Actor* target, Actor* sender, Cell* reason);
 void   actor_notify_exit(Actor* exiting, Cell* reason);
 bool   actor_finish(Actor* actor, Cell* result);  /* Thread-safe finish: returns false if already dead */
@@ -3,14 +3,126 @@
 #include "intern.h"
 #include <dirent.h>
 #include "siphash.h"
+#include "fasthash.h"
 #include "swisstable.h"
 #include "btree_simd.h"
 #include "art_simd.h"
 #include "eval.h"
+#include "scheduler.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include <assert.h>
+#include <sched.h>
+
+/* === Shared containers: optimistic reads, deferred reclamation ===
+ * Sorted maps and tries may be read from several schedulers at once. Each
+ * carries a sequence word that is even when quiet and odd while a writer
+ * (or a walk that needs a stable view) holds it. Point lookups take no
+ * lock: they read, then re-check the word and retry if it moved. Writers
+ * never free what such a reader may still be looking at — replaced nodes,
+ * deleted leaves and dropped references wait in a retire list until every
+ * scheduler has passed a QSBR quiescent state. */
+
+#define OLC_RETRIES 64  /* Optimistic attempts before a reader takes the lock */
+
+static inline void olc_pause(unsigned spins) {
+    if (spins % 256 == 255) {
+        sched_yield();
+        return;
+    }
+#if defined(__aarch64__)
+    __builtin_arm_yield();
+#elif defined(__x86_64__)
+    __asm__ volatile("pause");
+#endif
+}
+
+/* Snapshot for an optimistic read: waits out a writer, returns the word */
+static inline uint32_t olc_read_begin(uint32_t* seq) {
+    for (unsigned spins = 0;; spins++) {
+        uint32_t v = __atomic_load_n(seq, __ATOMIC_ACQUIRE);
+        if (!(v & 1)) return v;
+        olc_pause(spins);
+    }
+}
+
+/* True if nothing was written since olc_read_begin returned v */
+static inline bool olc_read_valid(uint32_t* seq, uint32_t v) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(seq, __ATOMIC_RELAXED) == v;
+}
+
+/* Exclusive hold; returns the even word it replaced */
+static inline uint32_t olc_lock(uint32_t* seq) {
+    for (unsigned spins = 0;; spins++) {
+        uint32_t v = __atomic_load_n(seq, __ATOMIC_RELAXED);
+        if (!(v & 1) && __atomic_compare_exchange_n(seq, &v, v + 1, false,
+                                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            /* The odd word, and anything built before the lock (new key and
+             * value cells), is visible before the writes made under it */
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            return v;
+        }
+        olc_pause(spins);
+    }
+}
+
+/* Release; a hold that changed nothing restores the old word so optimistic
+ * readers that overlapped it still validate */
+static inline void olc_unlock(uint32_t* seq, uint32_t v, bool wrote) {
+    __atomic_store_n(seq, wrote ? v + 2 : v, __ATOMIC_RELEASE);
+}
+
+typedef enum { RETIRE_MEM, RETIRE_CELL, RETIRE_ART_LEAF } RetireKind;
+
+typedef struct {
+    void*    ptr;
+    uint64_t epoch;   /* QSBR epoch when it was unlinked */
+    uint8_t  kind;
+} RetireEntry;
+
+typedef struct {
+    RetireEntry* items;
+    uint32_t     count;
+    uint32_t     cap;
+} RetireList;
+
+static void retire_push(RetireList* r, RetireKind kind, void* ptr) {
+    if (r->count == r->cap) {
+        r->cap = r->cap ? r->cap * 2 : 16;
+        r->items = (RetireEntry*)realloc(r->items, r->cap * sizeof(RetireEntry));
+    }
+    r->items[r->count].ptr = ptr;
+    r->items[r->count].epoch = atomic_load_explicit(&g_qsbr.global_epoch, memory_order_acquire);
+    r->items[r->count].kind = (uint8_t)kind;
+    r->count++;
+}
+
+static void retire_free_entry(RetireEntry* e);
+
+/* Free entries every scheduler has moved past (all: container is dying).
+ * Epochs are pushed in order, so the safe ones form a prefix. */
+static void retire_reclaim(RetireList* r, bool all) {
+    uint32_t n = 0;
+    while (n < r->count && (all || qsbr_safe(r->items[n].epoch))) n++;
+    if (n > 0) {
+        /* Freeing may drop the last reference to another shared container,
+         * whose own reclaim must not see this list half-compacted: detach */
+        RetireEntry* done = (RetireEntry*)malloc(n * sizeof(RetireEntry));
+        memcpy(done, r->items, n * sizeof(RetireEntry));
+        memmove(r->items, r->items + n, (r->count - n) * sizeof(RetireEntry));
+        r->count -= n;
+        for (uint32_t i = 0; i < n; i++) retire_free_entry(&done[i]);
+        free(done);
+    }
+    if (all) {
+        free(r->items);
+        r->items = NULL;
+        r->cap = 0;
+    }
+}
 
 /* === Sorted Map B-tree types (forward declarations for release/print/hash) === */
 
@@ -20,7 +132,10 @@
 typedef struct {
     uint64_t sort_keys[BTREE_B];
     Cell*    keys[BTREE_B];
-    Cell*    values[BTREE_B];
+    union {
+        Cell*    values[BTREE_B];       /* Leaf: entry values */
+        uint32_t counts[BTREE_B + 1];   /* Internal: entries under each child */
+    };
     uint32_t children[BTREE_B + 1];
     uint32_t next_leaf;
     uint32_t prev_leaf;
@@ -35,11 +150,35 @@ typedef struct {
     uint32_t* free_list;
     uint32_t free_count;
     uint32_t free_cap;
+    RetireList retired;   /* Old node arrays and dropped refs (shared reads) */
 } SMPool;
 
+/* Internal nodes hold their own reference to each separator key (a copy of
+ * the greatest key in the left subtree); walk them for release/visit. */
+static void sm_each_separator(SMPool* pool, uint32_t idx, uint8_t height,
+                              void (*fn)(Cell*, void*), void* ctx) {
+    if (height == 0) return;
+    SMNode* node = &pool->nodes[idx];
+    for (uint8_t i = 0; i < node->n_keys; i++) fn(node->keys[i], ctx);
+    for (uint8_t i = 0; i <= node->n_keys; i++)
+        sm_each_separator(pool, node->children[i], height - 1, fn, ctx);
+}
+
+static void sm_release_separator(Cell* key, void* ctx) {
+    (void)ctx;
+    cell_release(key);
+}
+
 /* Forward declarations */
 static void sm_pool_destroy_impl(SMPool* p);
 void art_destroy_node(void* node);
+static void champ_free(Cell* c);
+static bool champ_equal(Cell* a, Cell* b);
+static uint64_t champ_hash(Cell* c);
+static void table_free(Cell* c);
+static void table_visit_children(Cell* c, void (*fn)(Cell*, void*), void* ctx);
+static inline Cell** vec_buf(Cell* v);
+static void graph_index_release(void* index);
 
 /* Thread-local scheduler ID (defined here, declared extern in cell.h) */
 _Thread_local uint16_t tls_scheduler_id = 0;
@@ -102,15 +241,129 @@ static inline Cell* cell_pool_alloc(void) {
     return &slab->cells[0];
 }
 
+/* ── Per-Actor Cell Arenas ──
+ * Opt-in private heap for one actor (BEAM per-process heap model).
+ * While the actor runs, tls_cell_arena routes every cell_alloc into the
+ * arena's own 64 KiB slabs, so its garbage is never interleaved with
+ * other actors' cells on the same scheduler.
+ *
+ * Slabs are aligned to their size, so a cell finds its arena by masking
+ * its address. Frees from the running actor's thread push onto the local
+ * free list; frees from any other thread (a message released by its
+ * receiver) push onto an atomic remote-free stack, mimalloc-style, which
+ * the owner adopts when the local list runs dry. */
+
+#define ARENA_SLAB_BYTES (64u * 1024u)
+
+typedef struct ArenaSlab {
+    struct ArenaSlab* next;
+    CellArena* arena;
+    uint32_t used;
+    uint32_t index;        /* Position in arena (for sweep side tables) */
+    bool     pinned;       /* Holds tenured cells — never returned to malloc */
+    Cell     cells[];
+} ArenaSlab;
+
+#define ARENA_SLAB_CELLS \
+    ((uint32_t)((ARENA_SLAB_BYTES - sizeof(ArenaSlab)) / sizeof(Cell)))
+
+struct CellArena {
+    ArenaSlab* slabs;              /* Newest first; head is the bump slab */
+    uint32_t   n_slabs;
+    Cell*      free_list;          /* Owner-thread frees */
+    _Atomic(Cell*) remote_free;    /* Frees from other threads (Treiber push) */
+    uint64_t   allocs;
+};
+
+static _Thread_local CellArena* tls_cell_arena = NULL;
+
+/* Arena frees in flight, one row per scheduler thread (rows shared by
+ * scheduler id 0 and by wrapped ids). A free is counted before it reads
+ * its slab; cell_arena_destroy waits for every row to drain after its
+ * sweep, so no free can still be pushing onto an arena it is freeing. */
+#define ARENA_FREE_ROWS 16
+static struct {
+    _Atomic uint32_t n;
+    char pad[60];
+} g_arena_frees_inflight[ARENA_FREE_ROWS];
+
+static inline ArenaSlab* arena_slab_of(Cell* c) {
+    return (ArenaSlab*)((uintptr_t)c & ~(uintptr_t)(ARENA_SLAB_BYTES - 1));
+}
+
+static Cell* arena_alloc(CellArena* a) {
+    a->allocs++;
+    if (a->free_list) {
+        Cell* c = a->free_list;
+        a->free_list = *(Cell**)c;
+        return c;
+    }
+    ArenaSlab* slab = a->slabs;
+    if (slab && slab->used < ARENA_SLAB_CELLS) {
+        return &slab->cells[slab->used++];
+    }
+    /* Adopt cells freed by other threads before growing */
+    if (atomic_load_explicit(&a->remote_free, memory_order_relaxed)) {
+        Cell* c = atomic_exchange_explicit(&a->remote_free, NULL, memory_order_acquire);
+        if (c) {
+            a->free_list = *(Cell**)c;
+            return c;
+        }
+    }
+    slab = (ArenaSlab*)aligned_alloc(ARENA_SLAB_BYTES, ARENA_SLAB_BYTES);
+    assert(slab != NULL);
+    slab->next = a->slabs;
+    slab->arena = a;
+    slab->used = 1;
+    slab->index = a->n_slabs++;
+    slab->pinned = false;
+    a->slabs = slab;
+    return &slab->cells[0];
+}
+
+static inline void cell_pool_free(Cell* c);
+
+static void arena_free(Cell* c) {
+    _Atomic uint32_t* inflight = &g_arena_frees_inflight[tls_scheduler_id & (ARENA_FREE_ROWS - 1)].n;
+    atomic_fetch_add_explicit(inflight, 1, memory_order_seq_cst);
+    /* A destroy that finished its sweep before we were counted has already
+     * tenured (ARENA_NONE) or reclaimed (ARENA_FREE) this cell. */
+    uint8_t state = c->arena_state;
+    if (state != ARENA_LIVE) {
+        atomic_fetch_sub_explicit(inflight, 1, memory_order_release);
+        if (state == ARENA_NONE) cell_pool_free(c);
+        return;
+    }
+    CellArena* a = arena_slab_of(c)->arena;
+    c->arena_state = ARENA_FREE;
+    if (a == tls_cell_arena) {
+        *(Cell**)c = a->free_list;
+        a->free_list = c;
+    } else {
+        Cell* head = atomic_load_explicit(&a->remote_free, memory_order_relaxed);
+        do {
+            *(Cell**)c = head;
+        } while (!atomic_compare_exchange_weak_explicit(&a->remote_free, &head, c,
+                     memory_order_release, memory_order_relaxed));
+    }
+    atomic_fetch_sub_explicit(inflight, 1, memory_order_release);
+}
+
 static inline void cell_pool_free(Cell* c) {
+    if (UNLIKELY(c->arena_state == ARENA_LIVE)) {
+        arena_free(c);
+        return;
+    }
     *(Cell**)c = tls_cell_free;
     tls_cell_free = c;
 }
 
 /* Cell allocation */
 static Cell* cell_alloc(CellType type) {
-    Cell* c = cell_pool_alloc();
+    CellArena* arena = tls_cell_arena;
+    Cell* c = UNLIKELY(arena != NULL) ? arena_alloc(arena) : cell_pool_alloc();
     memset(c, 0, sizeof(Cell));
+    if (UNLIKELY(arena != NULL)) c->arena_state = ARENA_LIVE;
     atomic_fetch_add_explicit(&g_cell_alloc_count, 1, memory_order_relaxed);
     if (UNLIKELY(g_profile_enabled)) g_prof_cell_allocs++;
 
@@ -188,6 +441,8 @@ Cell* cell_lambda(Cell* env, Cell* body, int arity, const char* source_module, i
     c->data.lambda.arity = arity;
     c->data.lambda.source_module = source_module ? strdup(source_module) : NULL;  /* Day 27 */
     c->data.lambda.source_line = source_line;  /* Day 27 */
+    c->data.lambda.jit_calls = 0;
+    c->data.lambda.jit_slot = 0;
     c->data.lambda.constraints = NULL;
     c->data.lambda.param_names = NULL;
 
@@ -245,6 +500,8 @@ Cell* cell_struct(StructKind kind, Cell* type_tag, Cell* variant, Cell* fields)
     c->data.structure.type_tag = type_tag;
     c->data.structure.variant = variant;
     c->data.structure.fields = fields;
+    c->data.structure.layout = NULL;
+    c->data.structure.slots = NULL;
 
     if (type_tag) cell_retain(type_tag);
     if (variant) cell_retain(variant);
@@ -261,6 +518,8 @@ Cell* cell_graph(GraphType graph_type, Cell* nodes, Cell* edges, Cell* metadata)
     c->data.graph.metadata = metadata ? metadata : cell_nil();
     c->data.graph.entry = NULL;
     c->data.graph.exit = NULL;
+    c->data.graph.index = NULL;
+    c->data.graph.index_ops = 0;
 
     cell_retain(c->data.graph.nodes);
     cell_retain(c->data.graph.edges);
@@ -363,6 +622,32 @@ Cell* cell_cdr(Cell* c) {
  * Slow path (non-owner): atomic CAS on shared counter.
  * Merge: when biased hits 0, owner merges into shared; last release frees. */
 
+typedef struct {
+    Cell**   cells;
+    uint32_t n_cells;
+    bool     live;
+} FrozenRegion;
+
+/* References from outside the region, one cache line per region so
+ * unrelated regions never contend */
+typedef struct {
+    _Atomic int32_t n;
+    char pad[64 - sizeof(int32_t)];
+} FrozenRefs;
+
+static FrozenRegion g_frozen_regions[FROZEN_MAX_REGIONS];
+static FrozenRefs g_frozen_refs[FROZEN_MAX_REGIONS];
+static atomic_flag g_frozen_lock = ATOMIC_FLAG_INIT;
+static _Atomic uint32_t g_frozen_live = 0;
+
+static void frozen_free_region(uint32_t id);
+
+static inline void frozen_ref(Cell* c, int32_t delta) {
+    uint32_t id = c->rc.owner_tid - FROZEN_TID_BASE;
+    int32_t prev = atomic_fetch_add_explicit(&g_frozen_refs[id].n, delta, memory_order_acq_rel);
+    if (delta < 0 && prev + delta == 0) frozen_free_region(id);
+}
+
 /* Slow path: non-owner thread retain — fetch_add (2x faster than CAS on M-series) */
 __attribute__((noinline))
 static void cell_retain_slow(Cell* c) {
@@ -386,7 +671,10 @@ static bool cell_release_slow(Cell* c) {
 void cell_retain(Cell* c) {
     if (c == NULL) return;
     if (UNLIKELY(g_profile_enabled)) g_prof_retain_calls++;
-    if (UNLIKELY(c->rc.biased == BRC_IMMORTAL)) return;  /* Immortal sentinel */
+    if (UNLIKELY(c->rc.biased == BRC_IMMORTAL)) {  /* Immortal sentinel or frozen */
+        if (cell_is_frozen(c)) frozen_ref(c, 1);
+        return;
+    }
 
     /* Fast path: owner thread, non-atomic */
     if (LIKELY(c->rc.owner_tid == tls_scheduler_id)) {
@@ -402,7 +690,10 @@ void cell_retain(Cell* c) {
  * (e.g., actor->result set on worker, released on main during cleanup). */
 void cell_retain_shared(Cell* c) {
     if (c == NULL) return;
-    if (UNLIKELY(c->rc.biased == BRC_IMMORTAL)) return;
+    if (UNLIKELY(c->rc.biased == BRC_IMMORTAL)) {
+        if (cell_is_frozen(c)) frozen_ref(c, 1);
+        return;
+    }
     cell_retain_slow(c);
 }
 
@@ -443,7 +734,10 @@ static void cell_free_children(Cell* c);
 void cell_release(Cell* c) {
     if (c == NULL) return;
     if (UNLIKELY(g_profile_enabled)) g_prof_release_calls++;
-    if (UNLIKELY(c->rc.biased == BRC_IMMORTAL)) return;  /* Immortal sentinel */
+    if (UNLIKELY(c->rc.biased == BRC_IMMORTAL)) {  /* Immortal sentinel or frozen */
+        if (cell_is_frozen(c)) frozen_ref(c, -1);
+        return;
+    }
 
     /* Fast path: owner thread */
     if (LIKELY(c->rc.owner_tid == tls_scheduler_id)) {
@@ -494,7 +788,10 @@ do_free:
  * Pairs with cell_retain_shared — ensures retain/release use the same domain. */
 void cell_release_shared(Cell* c) {
     if (c == NULL) return;
-    if (UNLIKELY(c->rc.biased == BRC_IMMORTAL)) return;
+    if (UNLIKELY(c->rc.biased == BRC_IMMORTAL)) {
+        if (cell_is_frozen(c)) frozen_ref(c, -1);
+        return;
+    }
     if (cell_release_slow(c)) {
         /* Check weak refs before freeing */
         uint16_t weak = atomic_load_explicit(&c->weak_refcount, memory_order_acquire);
@@ -546,6 +843,12 @@ static void cell_free_children(Cell* c) {
                 cell_release(c->data.structure.type_tag);
                 cell_release(c->data.structure.variant);
                 cell_release(c->data.structure.fields);
+                if (c->data.structure.layout) {
+                    uint16_t n = cell_struct_layout_size(c->data.structure.layout);
+                    for (uint16_t i = 0; i < n; i++) cell_release(c->data.structure.slots[i]);
+                    free(c->data.structure.slots);
+                    cell_release(c->data.structure.layout);
+                }
                 break;
             case CELL_GRAPH:
                 cell_release(c->data.graph.nodes);
@@ -553,6 +856,7 @@ static void cell_free_children(Cell* c) {
                 cell_release(c->data.graph.metadata);
                 cell_release(c->data.graph.entry);
                 cell_release(c->data.graph.exit);
+                graph_index_release(c->data.graph.index);
                 break;
             case CELL_ACTOR:
                 /* Actor ID is just an int, no children to release */
@@ -578,6 +882,17 @@ static void cell_free_children(Cell* c) {
                 }
                 free(ctrl);
                 free(slots);
+                /* Entries not yet moved out of an incremental resize */
+                uint8_t* octrl = c->data.hashmap.old_ctrl;
+                HashSlot* oslots = c->data.hashmap.old_slots;
+                for (uint32_t i = 0; octrl && i < c->data.hashmap.old_capacity; i++) {
+                    if ((octrl[i] & 0x80) == 0) {
+                        cell_release(oslots[i].key);
+                        cell_release(oslots[i].value);
+                    }
+                }
+                free(octrl);
+                free(oslots);
                 break;
             }
             case CELL_SET: {
@@ -592,6 +907,16 @@ static void cell_free_children(Cell* c) {
                 }
                 free(c->data.hashset.metadata);
                 free(c->data.hashset.elements);
+                uint8_t* ometa = c->data.hashset.old_metadata;
+                for (uint32_t sg = 0; ometa && sg < c->data.hashset.old_n_groups; sg++) {
+                    for (int ss = 0; ss < 15; ss++) {
+                        if (ometa[sg * 16 + ss] >= 2) {
+                            cell_release(c->data.hashset.old_elements[sg * 15 + ss]);
+                        }
+                    }
+                }
+                free(ometa);
+                free(c->data.hashset.old_elements);
                 break;
             }
             case CELL_DEQUE: {
@@ -640,6 +965,8 @@ static void cell_free_children(Cell* c) {
                         }
                         leaf = node->next_leaf;
                     }
+                    sm_each_separator(pool, c->data.sorted_map.root_idx,
+                                      c->data.sorted_map.height, sm_release_separator, NULL);
                     sm_pool_destroy_impl(pool);
                 }
                 break;
@@ -647,8 +974,19 @@ static void cell_free_children(Cell* c) {
             case CELL_TRIE: {
                 if (c->data.trie.root)
                     art_destroy_node(c->data.trie.root);
+                if (c->data.trie.retired) {
+                    retire_reclaim((RetireList*)c->data.trie.retired, true);
+                    free(c->data.trie.retired);
+                }
                 break;
             }
+            case CELL_PMAP:
+            case CELL_PSET:
+                champ_free(c);
+                break;
+            case CELL_TABLE:
+                table_free(c);
+                break;
             case CELL_ITERATOR: {
                 IteratorData* id = (IteratorData*)c->data.iterator.iter_data;
                 if (id) {
@@ -693,6 +1031,20 @@ static void cell_free_children(Cell* c) {
                         case ITER_GRAPH:
                             if (id->state.graph.remaining) cell_release(id->state.graph.remaining);
                             break;
+                        case ITER_TABLE:
+                            if (id->state.table.bound) cell_release(id->state.table.bound);
+                            break;
+                        case ITER_SORTED_MAP:
+                            if (id->state.sorted_map.lo) cell_release(id->state.sorted_map.lo);
+                            if (id->state.sorted_map.hi) cell_release(id->state.sorted_map.hi);
+                            if (id->state.sorted_map.last) cell_release(id->state.sorted_map.last);
+                            break;
+                        case ITER_TRIE:
+                            free(id->state.trie.nodes);
+                            free(id->state.trie.slots);
+                            free(id->state.trie.prefix);
+                            free(id->state.trie.last);
+                            break;
                         default: break;
                     }
                     free(id);
@@ -727,6 +1079,548 @@ static void cell_free_children(Cell* c) {
     }
 }
 
+/* ── Arena bulk free + copy-on-send ──
+ * cell_arena_destroy replaces a cell_release graph walk with one linear
+ * sweep over the arena's slabs. Trial deletion (Bacon–Rajan) finds the
+ * escapees: a live cell whose refcount exceeds the references held by
+ * other arena cells is reachable from outside, so it and everything it
+ * reaches is tenured in place (arena_state = ARENA_NONE, slab pinned).
+ * The rest — including cycles plain RC would leak — is garbage: edges
+ * leaving the arena are released, then whole slabs go back to malloc. */
+
+typedef void (*CellVisitFn)(Cell* child, void* ctx);
+
+/* Visit strong child references. Types not listed (trie, iterator) are
+ * skipped; that is conservative — an unseen edge makes its target look
+ * externally referenced, so it is tenured rather than freed. */
+static void cell_visit_children(Cell* c, CellVisitFn fn, void* ctx) {
+    switch (c->type) {
+        case CELL_PAIR:
+            fn(c->data.pair.car, ctx);
+            fn(c->data.pair.cdr, ctx);
+            break;
+        case CELL_LAMBDA:
+            fn(c->data.lambda.env, ctx);
+            fn(c->data.lambda.body, ctx);
+            fn(c->data.lambda.constraints, ctx);
+            break;
+        case CELL_ERROR:
+            fn(c->data.error.data, ctx);
+            fn(c->data.error.cause, ctx);
+            break;
+        case CELL_STRUCT:
+            fn(c->data.structure.type_tag, ctx);
+            fn(c->data.structure.variant, ctx);
+            fn(c->data.structure.fields, ctx);
+            /* The layout is an immutable per-type descriptor shared by every
+             * instance; it is not visited so freezing a struct stays legal */
+            if (c->data.structure.layout) {
+                uint16_t n = cell_struct_layout_size(c->data.structure.layout);
+                for (uint16_t i = 0; i < n; i++) fn(c->data.structure.slots[i], ctx);
+            }
+            break;
+        case CELL_GRAPH:
+            fn(c->data.graph.nodes, ctx);
+            fn(c->data.graph.edges, ctx);
+            fn(c->data.graph.metadata, ctx);
+            fn(c->data.graph.entry, ctx);
+            fn(c->data.graph.exit, ctx);
+            break;
+        case CELL_BOX:
+            fn(c->data.box.value, ctx);
+            break;
+        case CELL_HASHMAP:
+            for (uint32_t i = 0; i < c->data.hashmap.capacity; i++) {
+                if ((c->data.hashmap.ctrl[i] & 0x80) == 0) {
+                    fn(c->data.hashmap.slots[i].key, ctx);
+                    fn(c->data.hashmap.slots[i].value, ctx);
+                }
+            }
+            for (uint32_t i = 0; c->data.hashmap.old_ctrl && i < c->data.hashmap.old_capacity; i++) {
+                if ((c->data.hashmap.old_ctrl[i] & 0x80) == 0) {
+                    fn(c->data.hashmap.old_slots[i].key, ctx);
+                    fn(c->data.hashmap.old_slots[i].value, ctx);
+                }
+            }
+            break;
+        case CELL_SET:
+            for (uint32_t g = 0; g < c->data.hashset.n_groups; g++) {
+                uint8_t* meta = c->data.hashset.metadata + g * 16;
+                for (int i = 0; i < 15; i++) {
+                    if (meta[i] >= 2) fn(c->data.hashset.elements[g * 15 + i], ctx);
+                }
+            }
+            for (uint32_t g = 0; c->data.hashset.old_metadata && g < c->data.hashset.old_n_groups; g++) {
+                uint8_t* meta = c->data.hashset.old_metadata + g * 16;
+                for (int i = 0; i < 15; i++) {
+                    if (meta[i] >= 2) fn(c->data.hashset.old_elements[g * 15 + i], ctx);
+                }
+            }
+            break;
+        case CELL_DEQUE: {
+            uint32_t n = c->data.deque.tail - c->data.deque.head;
+            uint32_t mask = c->data.deque.capacity - 1;
+            for (uint32_t i = 0; i < n; i++)
+                fn(c->data.deque.buffer[(c->data.deque.head + i) & mask], ctx);
+            break;
+        }
+        case CELL_VECTOR: {
+            Cell** buf = (c->data.vector.capacity <= 4)
+                ? c->data.vector.sbo : c->data.vector.heap;
+            for (uint32_t i = 0; i < c->data.vector.size; i++) fn(buf[i], ctx);
+            break;
+        }
+        case CELL_HEAP:
+            for (uint32_t i = 0; i < c->data.pq.size; i++) fn(c->data.pq.vals[i], ctx);
+            break;
+        case CELL_TABLE:
+            table_visit_children(c, fn, ctx);
+            break;
+        case CELL_SORTED_MAP: {
+            SMPool* pool = (SMPool*)c->data.sorted_map.node_pool;
+            if (!pool) break;
+            for (uint32_t leaf = c->data.sorted_map.first_leaf; leaf != SM_NIL;
+                 leaf = pool->nodes[leaf].next_leaf) {
+                SMNode* node = &pool->nodes[leaf];
+                for (uint8_t i = 0; i < node->n_keys; i++) {
+                    fn(node->keys[i], ctx);
+                    fn(node->values[i], ctx);
+                }
+            }
+            sm_each_separator(pool, c->data.sorted_map.root_idx,
+                              c->data.sorted_map.height, fn, ctx);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/* Total strong references across both BRC domains */
+static inline uint32_t cell_rc_total(Cell* c) {
+    return (uint32_t)c->rc.biased +
+           (atomic_load_explicit(&c->rc.shared, memory_order_acquire) & BRC_COUNT_MASK);
+}
+
+typedef struct {
+    CellArena* arena;
+    uint32_t*  internal;   /* Per-slot count of references from arena cells */
+    Cell**     stack;      /* Tenure DFS work stack */
+    uint32_t   sp;
+    uint32_t   cap;
+} ArenaSweep;
+
+static inline bool arena_owns(ArenaSweep* sw, Cell* c) {
+    return c && c->arena_state == ARENA_LIVE && arena_slab_of(c)->arena == sw->arena;
+}
+
+static inline uint32_t arena_slot(Cell* c) {
+    ArenaSlab* slab = arena_slab_of(c);
+    return slab->index * ARENA_SLAB_CELLS + (uint32_t)(c - slab->cells);
+}
+
+static void arena_count_internal(Cell* child, void* ctx) {
+    ArenaSweep* sw = (ArenaSweep*)ctx;
+    if (arena_owns(sw, child)) sw->internal[arena_slot(child)]++;
+}
+
+static void arena_push_tenure(Cell* child, void* ctx) {
+    ArenaSweep* sw = (ArenaSweep*)ctx;
+    if (!arena_owns(sw, child)) return;
+    child->arena_state = ARENA_NONE;
+    arena_slab_of(child)->pinned = true;
+    if (sw->sp == sw->cap) {
+        sw->cap = sw->cap ? sw->cap * 2 : 256;
+        sw->stack = (Cell**)realloc(sw->stack, sw->cap * sizeof(Cell*));
+    }
+    sw->stack[sw->sp++] = child;
+}
+
+static void arena_tenure(ArenaSweep* sw, Cell* root) {
+    arena_push_tenure(root, sw);
+    while (sw->sp > 0) {
+        Cell* c = sw->stack[--sw->sp];
+        /* Zombies (rc 0, held by weak refs) already released their children */
+        if (cell_rc_total(c) > 0) cell_visit_children(c, arena_push_tenure, sw);
+    }
+}
+
+CellArena* cell_arena_new(void) {
+    CellArena* a = (CellArena*)calloc(1, sizeof(CellArena));
+    atomic_init(&a->remote_free, NULL);
+    return a;
+}
+
+CellArena* cell_arena_enter(CellArena* arena) {
+    CellArena* prev = tls_cell_arena;
+    tls_cell_arena = arena;
+    return prev;
+}
+
+CellArena* cell_arena_current(void) {
+    return tls_cell_arena;
+}
+
+uint32_t cell_arena_slab_count(CellArena* arena) {
+    return arena ? arena->n_slabs : 0;
+}
+
+uint64_t cell_arena_alloc_count(CellArena* arena) {
+    return arena ? arena->allocs : 0;
+}
+
+void cell_arena_destroy(CellArena* a) {
+    if (!a) return;
+    if (tls_cell_arena == a) tls_cell_arena = NULL;
+
+    ArenaSweep sw = { .arena = a };
+    sw.internal = (uint32_t*)calloc((size_t)a->n_slabs * ARENA_SLAB_CELLS + 1, sizeof(uint32_t));
+
+    /* Pass 1: count references held by live arena cells */
+    for (ArenaSlab* slab = a->slabs; slab; slab = slab->next) {
+        for (uint32_t i = 0; i < slab->used; i++) {
+            Cell* c = &slab->cells[i];
+            if (c->arena_state == ARENA_LIVE && cell_rc_total(c) > 0)
+                cell_visit_children(c, arena_count_internal, &sw);
+        }
+    }
+
+    /* Pass 2: tenure everything reachable from outside the arena */
+    for (ArenaSlab* slab = a->slabs; slab; slab = slab->next) {
+        for (uint32_t i = 0; i < slab->used; i++) {
+            Cell* c = &slab->cells[i];
+            if (c->arena_state != ARENA_LIVE) continue;
+            if (c->rc.biased == BRC_IMMORTAL ||
+                atomic_load_explicit(&c->weak_refcount, memory_order_acquire) > 0 ||
+                cell_rc_total(c) > sw.internal[arena_slot(c)]) {
+                arena_tenure(&sw, c);
+            }
+        }
+    }
+    free(sw.internal);
+    free(sw.stack);
+
+    /* Pass 3: what is left is garbage. Make it immortal so releases between
+     * garbage cells are no-ops, then drop only the edges leaving the arena. */
+    for (ArenaSlab* slab = a->slabs; slab; slab = slab->next) {
+        for (uint32_t i = 0; i < slab->used; i++) {
+            Cell* c = &slab->cells[i];
+            if (c->arena_state == ARENA_LIVE) c->rc.biased = BRC_IMMORTAL;
+        }
+    }
+    for (ArenaSlab* slab = a->slabs; slab; slab = slab->next) {
+        for (uint32_t i = 0; i < slab->used; i++) {
+            Cell* c = &slab->cells[i];
+            if (c->arena_state != ARENA_LIVE) continue;
+            cell_free_children(c);
+            c->arena_state = ARENA_FREE;
+        }
+    }
+
+    /* Nothing in the arena is live now; wait out frees that saw a live cell
+     * before the sweep and may still be pushing onto remote_free. */
+    atomic_thread_fence(memory_order_seq_cst);
+    for (uint32_t r = 0; r < ARENA_FREE_ROWS; r++) {
+        while (atomic_load_explicit(&g_arena_frees_inflight[r].n, memory_order_acquire))
+            sched_yield();
+    }
+
+    /* Pass 4: unpinned slabs go back to malloc wholesale; pinned slabs donate
+     * their dead cells to this thread's shared free list and live on. */
+    ArenaSlab* slab = a->slabs;
+    while (slab) {
+        ArenaSlab* next = slab->next;
+        if (slab->pinned) {
+            for (uint32_t i = 0; i < slab->used; i++) {
+                Cell* c = &slab->cells[i];
+                if (c->arena_state == ARENA_FREE) {
+                    c->arena_state = ARENA_NONE;
+                    cell_pool_free(c);
+                }
+            }
+        } else {
+            free(slab);
+        }
+        slab = next;
+    }
+    free(a);
+}
+
+/* Deep-copy arena-resident immutable data into the shared heap.
+ * List spines are copied iteratively (actor fibers have small stacks). */
+static Cell* arena_copy_out(Cell* c) {
+    if (!c || c->arena_state != ARENA_LIVE || cell_is_frozen(c)) {
+        cell_retain(c);
+        return c;
+    }
+    switch (c->type) {
+        case CELL_ATOM_NUMBER:
+        case CELL_ATOM_INTEGER:
+        case CELL_ATOM_BOOL:
+        case CELL_ATOM_SYMBOL:
+        case CELL_ATOM_NIL:
+        case CELL_ATOM_STRING: {
+            Cell* n = cell_alloc(c->type);
+            n->data.atom = c->data.atom;
+            n->sym_id = c->sym_id;
+            n->span = c->span;
+            if (c->type == CELL_ATOM_STRING) n->data.atom.string = strdup(c->data.atom.string);
+            return n;
+        }
+        case CELL_PAIR: {
+            Cell* head = NULL;
+            Cell* tail = NULL;
+            Cell* cur = c;
+            while (cur && cur->type == CELL_PAIR && cur->arena_state == ARENA_LIVE &&
+                   !cell_is_frozen(cur)) {
+                Cell* p = cell_alloc(CELL_PAIR);
+                p->span = cur->span;
+                p->data.pair.car = arena_copy_out(cur->data.pair.car);
+                p->data.pair.cdr = NULL;
+                if (tail) tail->data.pair.cdr = p; else head = p;
+                tail = p;
+                cur = cur->data.pair.cdr;
+            }
+            tail->data.pair.cdr = arena_copy_out(cur);
+            return head;
+        }
+        case CELL_STRUCT: {
+            Cell* n = cell_alloc(CELL_STRUCT);
+            n->span = c->span;
+            n->data.structure.kind = c->data.structure.kind;
+            n->data.structure.type_tag = arena_copy_out(c->data.structure.type_tag);
+            n->data.structure.variant = arena_copy_out(c->data.structure.variant);
+            n->data.structure.fields = arena_copy_out(c->data.structure.fields);
+            n->data.structure.layout = c->data.structure.layout;
+            n->data.structure.slots = NULL;
+            if (n->data.structure.layout) {
+                uint16_t sn = cell_struct_layout_size(n->data.structure.layout);
+                n->data.structure.slots = (Cell**)malloc((sn ? sn : 1) * sizeof(Cell*));
+                assert(n->data.structure.slots != NULL);
+                for (uint16_t i = 0; i < sn; i++)
+                    n->data.structure.slots[i] = arena_copy_out(c->data.structure.slots[i]);
+                cell_retain(n->data.structure.layout);
+            }
+            return n;
+        }
+        case CELL_ERROR: {
+            Cell* n = cell_alloc(CELL_ERROR);
+            n->span = c->span;
+            n->data.error = c->data.error;
+            n->data.error.data = arena_copy_out(c->data.error.data);
+            n->data.error.cause = arena_copy_out(c->data.error.cause);
+            if (c->data.error.return_trace) {
+                n->data.error.return_trace = (uint32_t*)malloc(ERROR_TRACE_CAP * sizeof(uint32_t));
+                memcpy(n->data.error.return_trace, c->data.error.return_trace,
+                       ERROR_TRACE_CAP * sizeof(uint32_t));
+            }
+            return n;
+        }
+        default:
+            /* Mutable or opaque: share; tenured at arena destroy if still held */
+            cell_retain(c);
+            return c;
+    }
+}
+
+Cell* cell_arena_promote(Cell* c) {
+    if (LIKELY(!c || c->arena_state != ARENA_LIVE || cell_is_frozen(c))) {
+        cell_retain(c);
+        return c;
+    }
+    CellArena* saved = tls_cell_arena;
+    tls_cell_arena = NULL;
+    Cell* out = arena_copy_out(c);
+    tls_cell_arena = saved;
+    return out;
+}
+
+/* ============ Frozen subgraphs ============ */
+
+typedef struct {
+    Cell**   cells;
+    uint32_t n;
+    uint32_t cap;
+    Cell**   shared;      /* Sorted: interior cells left in ordinary BRC */
+    uint32_t n_shared;
+    Cell*    offender;    /* First mutable cell found, if any */
+} FreezeWalk;
+
+static bool freezable_type(CellType t) {
+    switch (t) {
+        case CELL_ATOM_NUMBER:
+        case CELL_ATOM_INTEGER:
+        case CELL_ATOM_BOOL:
+        case CELL_ATOM_SYMBOL:
+        case CELL_ATOM_NIL:
+        case CELL_ATOM_STRING:
+        case CELL_PAIR:
+        case CELL_LAMBDA:
+        case CELL_BUILTIN:
+        case CELL_ERROR:
+        case CELL_STRUCT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static int freeze_ptr_cmp(const void* a, const void* b) {
+    uintptr_t x = (uintptr_t)*(Cell* const*)a, y = (uintptr_t)*(Cell* const*)b;
+    return (x > y) - (x < y);
+}
+
+static void freeze_push(Cell* c, void* ctx) {
+    FreezeWalk* w = (FreezeWalk*)ctx;
+    /* Sentinels and members of other frozen regions stay where they are */
+    if (!c || c->marked || c->rc.biased == BRC_IMMORTAL) return;
+    if (!freezable_type(c->type)) {
+        if (!w->offender) w->offender = c;
+        return;
+    }
+    if (w->n_shared && bsearch(&c, w->shared, w->n_shared, sizeof(Cell*), freeze_ptr_cmp))
+        return;
+    c->marked = true;
+    if (w->n == w->cap) {
+        w->cap = w->cap ? w->cap * 2 : 64;
+        w->cells = (Cell**)realloc(w->cells, w->cap * sizeof(Cell*));
+    }
+    w->cells[w->n++] = c;
+}
+
+static void freeze_walk(FreezeWalk* w, Cell* root) {
+    w->n = 0;
+    freeze_push(root, w);
+    for (uint32_t i = 0; i < w->n && !w->offender; i++)
+        cell_visit_children(w->cells[i], freeze_push, w);
+}
+
+typedef struct {
+    Cell**    sorted;
+    uint32_t  n;
+    uint32_t* internal;
+} FreezeCount;
+
+static void freeze_count_internal(Cell* child, void* ctx) {
+    FreezeCount* fc = (FreezeCount*)ctx;
+    if (!child || !child->marked) return;
+    Cell** hit = (Cell**)bsearch(&child, fc->sorted, fc->n, sizeof(Cell*), freeze_ptr_cmp);
+    if (hit) fc->internal[hit - fc->sorted]++;
+}
+
+static Cell* freeze_abort(FreezeWalk* w, uint32_t* internal) {
+    for (uint32_t i = 0; i < w->n; i++) w->cells[i]->marked = false;
+    free(w->cells);
+    free(w->shared);
+    free(internal);
+    return w->offender;
+}
+
+/* Freeze reads each member's biased counter, so the root must be owned by
+ * the calling thread; a root owned by another thread is returned as the
+ * offender. Interior cells owned by another thread, and cells also
+ * referenced from outside the value (literals in code, sublists held
+ * elsewhere), keep ordinary refcounts, so a region's lifetime is exactly
+ * that of the value it was frozen from. */
+Cell* cell_freeze(Cell* root) {
+    FreezeWalk w = {0};
+    uint32_t* internal = NULL;
+    int64_t external = 0;
+
+    if (root && !cell_owned_here(root) && root->rc.biased != BRC_IMMORTAL) return root;
+
+    /* Deep immutability is checked against the whole reachable graph */
+    freeze_walk(&w, root);
+    if (w.offender || w.n == 0) return freeze_abort(&w, internal);
+
+    for (;;) {
+        /* External references = total RC minus edges between members */
+        qsort(w.cells, w.n, sizeof(Cell*), freeze_ptr_cmp);
+        internal = (uint32_t*)realloc(internal, w.n * sizeof(uint32_t));
+        memset(internal, 0, w.n * sizeof(uint32_t));
+        FreezeCount fc = { w.cells, w.n, internal };
+        for (uint32_t i = 0; i < w.n; i++)
+            cell_visit_children(w.cells[i], freeze_count_internal, &fc);
+
+        uint32_t before = w.n_shared;
+        external = 0;
+        for (uint32_t i = 0; i < w.n; i++) {
+            Cell* c = w.cells[i];
+            if (!cell_owned_here(c)) {
+                /* Never a member here; dropped by the re-walk below */
+                w.shared = (Cell**)realloc(w.shared, (w.n_shared + 1) * sizeof(Cell*));
+                w.shared[w.n_shared++] = c;
+                continue;
+            }
+            uint32_t rc = cell_rc_total(c);
+            if (c != root && rc > internal[i]) {
+                w.shared = (Cell**)realloc(w.shared, (w.n_shared + 1) * sizeof(Cell*));
+                w.shared[w.n_shared++] = c;
+            }
+            external += (int64_t)rc - internal[i];
+        }
+        if (w.n_shared == before) break;
+
+        /* Excluding a shared cell can expose new outside edges; re-walk */
+        qsort(w.shared, w.n_shared, sizeof(Cell*), freeze_ptr_cmp);
+        for (uint32_t i = 0; i < w.n; i++) w.cells[i]->marked = false;
+        freeze_walk(&w, root);
+    }
+
+    while (atomic_flag_test_and_set_explicit(&g_frozen_lock, memory_order_acquire)) {}
+    uint32_t id = 0;
+    while (id < FROZEN_MAX_REGIONS && g_frozen_regions[id].live) id++;
+    if (id == FROZEN_MAX_REGIONS) {
+        atomic_flag_clear_explicit(&g_frozen_lock, memory_order_release);
+        /* Region table full: the value stays ordinarily refcounted */
+        w.offender = NULL;
+        return freeze_abort(&w, internal);
+    }
+    g_frozen_regions[id] = (FrozenRegion){ w.cells, w.n, true };
+    g_frozen_live++;
+    atomic_store_explicit(&g_frozen_refs[id].n, (int32_t)external, memory_order_release);
+    atomic_flag_clear_explicit(&g_frozen_lock, memory_order_release);
+
+    for (uint32_t i = 0; i < w.n; i++) {
+        Cell* c = w.cells[i];
+        c->marked = false;
+        atomic_store_explicit(&c->rc.shared, 0, memory_order_relaxed);
+        c->rc.owner_tid = (uint16_t)(FROZEN_TID_BASE + id);
+        c->rc.biased = BRC_IMMORTAL;
+    }
+    free(w.shared);
+    free(internal);
+    return NULL;
+}
+
+/* Runs on whichever thread dropped the last outside reference. Nothing
+ * can reach the members any more, so the slot is only handed back once
+ * they are gone; releases into other regions may free those in turn. */
+static void frozen_free_region(uint32_t id) {
+    FrozenRegion r = g_frozen_regions[id];
+    /* Edges between members only drive this region's counter below zero,
+     * so members can be torn down in any order. */
+    for (uint32_t i = 0; i < r.n_cells; i++) cell_free_children(r.cells[i]);
+    for (uint32_t i = 0; i < r.n_cells; i++) {
+        Cell* c = r.cells[i];
+        c->rc.owner_tid = tls_scheduler_id;
+        c->rc.biased = 0;
+        if (atomic_load_explicit(&c->weak_refcount, memory_order_acquire) == 0)
+            cell_pool_free(c);
+        /* else: zombie, freed by the last weak_release */
+    }
+    free(r.cells);
+    while (atomic_flag_test_and_set_explicit(&g_frozen_lock, memory_order_acquire)) {}
+    atomic_store_explicit(&g_frozen_refs[id].n, 0, memory_order_relaxed);
+    g_frozen_regions[id] = (FrozenRegion){0};
+    g_frozen_live--;
+    atomic_flag_clear_explicit(&g_frozen_lock, memory_order_release);
+}
+
+uint32_t cell_frozen_region_count(void) {
+    return g_frozen_live;
+}
+
 /* Linear type operations */
 bool cell_is_linear(Cell* c) {
     return (c->linear_flags & LINEAR_UNIQUE) != 0;
@@ -1002,17 +1896,116 @@ Cell* cell_struct_variant(Cell* c) {
     return c->data.structure.variant;
 }
 
+/* Alist view of a slotted struct, in layout order */
+static Cell* struct_slots_alist(Cell* c) {
+    Cell** names = vec_buf(c->data.structure.layout);
+    Cell* alist = cell_nil();
+    for (int i = (int)cell_struct_layout_size(c->data.structure.layout) - 1; i >= 0; i--) {
+        Cell* entry = cell_cons(names[i], c->data.structure.slots[i]);
+        Cell* next = cell_cons(entry, alist);
+        cell_release(entry);
+        cell_release(alist);
+        alist = next;
+    }
+    return alist;
+}
+
 Cell* cell_struct_fields(Cell* c) {
     assert(c->type == CELL_STRUCT);
-    return c->data.structure.fields;
+    Cell* fields = __atomic_load_n(&c->data.structure.fields, __ATOMIC_ACQUIRE);
+    if (fields || !c->data.structure.layout) return fields;
+    /* Built once; a thread that loses the race drops its copy */
+    Cell* built = struct_slots_alist(c);
+    if (__atomic_compare_exchange_n(&c->data.structure.fields, &fields, built, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        return built;
+    cell_release(built);
+    return fields;
+}
+
+Cell* cell_struct_layout_new(Cell* field_names) {
+    uint32_t n = 0;
+    for (Cell* f = field_names; cell_is_pair(f); f = cell_cdr(f)) n++;
+    Cell* layout = cell_vector_new(n);
+    for (Cell* f = field_names; cell_is_pair(f); f = cell_cdr(f))
+        cell_vector_push(layout, cell_car(f));
+    return layout;
+}
+
+uint16_t cell_struct_layout_size(Cell* layout) {
+    assert(layout->type == CELL_VECTOR);
+    return (uint16_t)layout->data.vector.size;
+}
+
+Cell* cell_struct_slotted(StructKind kind, Cell* type_tag, Cell* variant,
+                          Cell* layout, Cell** values) {
+    uint16_t n = cell_struct_layout_size(layout);
+    Cell** slots = (Cell**)malloc((n ? n : 1) * sizeof(Cell*));
+    assert(slots != NULL);
+    for (uint16_t i = 0; i < n; i++) {
+        cell_retain(values[i]);
+        slots[i] = values[i];
+    }
+    Cell* c = cell_alloc(CELL_STRUCT);
+    c->data.structure.kind = kind;
+    c->data.structure.type_tag = type_tag;
+    c->data.structure.variant = variant;
+    c->data.structure.fields = NULL;
+    c->data.structure.layout = layout;
+    c->data.structure.slots = slots;
+    cell_retain(type_tag);
+    if (variant) cell_retain(variant);
+    cell_retain(layout);
+    return c;
 }
 
-Cell* cell_struct_get_field(Cell* c, Cell* field_name) {
+Cell* cell_struct_layout(Cell* c) {
     assert(c->type == CELL_STRUCT);
-    assert(cell_is_symbol(field_name));
+    return c->data.structure.layout;
+}
 
-    /* Search in alist of fields */
-    Cell* fields = c->data.structure.fields;
+/* Symbols are interned, so a field name compares by its string pointer */
+int cell_struct_slot_of(Cell* c, Cell* field_name, int hint) {
+    assert(c->type == CELL_STRUCT && c->data.structure.layout);
+    if (!cell_is_symbol(field_name)) return -1;
+    Cell** names = vec_buf(c->data.structure.layout);
+    int n = cell_struct_layout_size(c->data.structure.layout);
+    const char* sym = field_name->data.atom.symbol;
+    if (hint >= 0 && hint < n && names[hint]->data.atom.symbol == sym) return hint;
+    for (int i = 0; i < n; i++)
+        if (names[i]->data.atom.symbol == sym) return i;
+    return -1;
+}
+
+Cell* cell_struct_slot(Cell* c, int slot) {
+    assert(c->type == CELL_STRUCT && c->data.structure.layout);
+    assert(slot >= 0 && slot < cell_struct_layout_size(c->data.structure.layout));
+    return c->data.structure.slots[slot];
+}
+
+/* Copy of a slotted struct with one slot replaced: one cell, one array */
+Cell* cell_struct_with_slot(Cell* c, int slot, Cell* value) {
+    assert(c->type == CELL_STRUCT && c->data.structure.layout);
+    Cell** old = c->data.structure.slots;
+    Cell* saved = old[slot];
+    old[slot] = value;
+    Cell* r = cell_struct_slotted(c->data.structure.kind, c->data.structure.type_tag,
+                                  c->data.structure.variant, c->data.structure.layout, old);
+    old[slot] = saved;
+    return r;
+}
+
+Cell* cell_struct_get_field(Cell* c, Cell* field_name) {
+    assert(c->type == CELL_STRUCT);
+    assert(cell_is_symbol(field_name));
+
+    if (c->data.structure.layout) {
+        int slot = cell_struct_slot_of(c, field_name, -1);
+        return slot < 0 ? NULL : c->data.structure.slots[slot];
+    }
+
+    /* Search in alist of fields */
+    Cell* fields = c->data.structure.fields;
     while (fields && !cell_is_nil(fields)) {
         Cell* pair = cell_car(fields);  /* (field . value) */
         Cell* fname = cell_car(pair);
@@ -1062,6 +2055,570 @@ Cell* cell_graph_exit(Cell* c) {
     return c->data.graph.exit;
 }
 
+/* ── Graph adjacency index ──
+ * Node values are interned to dense ids through an open-addressed table;
+ * edges live in parallel arrays threaded into per-node out/in lists
+ * (newest edge first). Additions are numbered: a graph version sees the
+ * first index_ops of them, so every version built by appending shares one
+ * index, and an edge or node added later is skipped by older versions.
+ * All access holds the index lock; visitors run after it is dropped. */
+
+#define GRAPH_NONE UINT32_MAX
+
+typedef struct GraphIndex {
+    _Atomic uint32_t refs;
+    atomic_flag lock;
+    uint32_t ops;              /* Additions applied (the tip version) */
+    uint32_t n_ids, cap_ids;
+    Cell**    id_node;         /* id -> node value (retained) */
+    uint64_t* id_hash;
+    uint32_t* id_decl;         /* Addition that declared the node, GRAPH_NONE if edge-only */
+    uint32_t* id_seen;         /* First addition that mentioned the node */
+    uint32_t* out_head;        /* Newest outgoing edge */
+    uint32_t* in_head;         /* Newest incoming edge */
+    uint32_t* table;           /* id + 1, 0 = empty */
+    uint32_t  table_cap;
+    uint32_t n_edges, cap_edges;
+    uint32_t* e_from;
+    uint32_t* e_to;
+    uint32_t* e_op;
+    uint32_t* e_next_out;
+    uint32_t* e_next_in;
+    double*   e_weight;        /* Numeric label, else 1 */
+} GraphIndex;
+
+static inline void graph_index_lock(GraphIndex* ix) {
+    while (atomic_flag_test_and_set_explicit(&ix->lock, memory_order_acquire)) sched_yield();
+}
+
+static inline void graph_index_unlock(GraphIndex* ix) {
+    atomic_flag_clear_explicit(&ix->lock, memory_order_release);
+}
+
+static void graph_index_release(void* index) {
+    GraphIndex* ix = (GraphIndex*)index;
+    if (!ix || atomic_fetch_sub_explicit(&ix->refs, 1, memory_order_acq_rel) != 1) return;
+    for (uint32_t i = 0; i < ix->n_ids; i++) cell_release(ix->id_node[i]);
+    free(ix->id_node); free(ix->id_hash); free(ix->id_decl); free(ix->id_seen);
+    free(ix->out_head); free(ix->in_head); free(ix->table);
+    free(ix->e_from); free(ix->e_to); free(ix->e_op);
+    free(ix->e_next_out); free(ix->e_next_in); free(ix->e_weight);
+    free(ix);
+}
+
+#define GRAPH_GROW(ptr, cap) do { \
+        (ptr) = realloc((ptr), (size_t)(cap) * sizeof(*(ptr))); \
+        assert((ptr) != NULL); \
+    } while (0)
+
+static void graph_table_insert(GraphIndex* ix, uint32_t id) {
+    uint32_t mask = ix->table_cap - 1;
+    uint32_t i = (uint32_t)ix->id_hash[id] & mask;
+    while (ix->table[i]) i = (i + 1) & mask;
+    ix->table[i] = id + 1;
+}
+
+static uint32_t graph_find_id(GraphIndex* ix, Cell* node, uint64_t hash) {
+    if (!ix->table_cap) return GRAPH_NONE;
+    uint32_t mask = ix->table_cap - 1;
+    for (uint32_t i = (uint32_t)hash & mask; ix->table[i]; i = (i + 1) & mask) {
+        uint32_t id = ix->table[i] - 1;
+        if (ix->id_hash[id] == hash && cell_equal(ix->id_node[id], node)) return id;
+    }
+    return GRAPH_NONE;
+}
+
+/* Id of node, interning it at addition op if it is new */
+static uint32_t graph_intern(GraphIndex* ix, Cell* node, uint32_t op) {
+    uint64_t hash = cell_hash(node);
+    uint32_t id = graph_find_id(ix, node, hash);
+    if (id != GRAPH_NONE) return id;
+    if (ix->n_ids == ix->cap_ids) {
+        ix->cap_ids = ix->cap_ids ? ix->cap_ids * 2 : 16;
+        GRAPH_GROW(ix->id_node, ix->cap_ids);
+        GRAPH_GROW(ix->id_hash, ix->cap_ids);
+        GRAPH_GROW(ix->id_decl, ix->cap_ids);
+        GRAPH_GROW(ix->id_seen, ix->cap_ids);
+        GRAPH_GROW(ix->out_head, ix->cap_ids);
+        GRAPH_GROW(ix->in_head, ix->cap_ids);
+    }
+    id = ix->n_ids++;
+    cell_retain(node);
+    ix->id_node[id] = node;
+    ix->id_hash[id] = hash;
+    ix->id_decl[id] = GRAPH_NONE;
+    ix->id_seen[id] = op;
+    ix->out_head[id] = GRAPH_NONE;
+    ix->in_head[id] = GRAPH_NONE;
+    if (ix->n_ids * 2 > ix->table_cap) {
+        free(ix->table);
+        ix->table_cap = ix->table_cap ? ix->table_cap * 2 : 32;
+        ix->table = (uint32_t*)calloc(ix->table_cap, sizeof(uint32_t));
+        assert(ix->table != NULL);
+        for (uint32_t i = 0; i < ix->n_ids; i++) graph_table_insert(ix, i);
+    } else {
+        graph_table_insert(ix, id);
+    }
+    return id;
+}
+
+static void graph_index_add_node(GraphIndex* ix, Cell* node) {
+    uint32_t op = ix->ops++;
+    uint32_t id = graph_intern(ix, node, op);
+    if (ix->id_decl[id] == GRAPH_NONE) ix->id_decl[id] = op;
+}
+
+static void graph_index_add_edge(GraphIndex* ix, Cell* from, Cell* to, Cell* label) {
+    uint32_t op = ix->ops++;
+    uint32_t u = graph_intern(ix, from, op);
+    uint32_t v = graph_intern(ix, to, op);
+    if (ix->n_edges == ix->cap_edges) {
+        ix->cap_edges = ix->cap_edges ? ix->cap_edges * 2 : 16;
+        GRAPH_GROW(ix->e_from, ix->cap_edges);
+        GRAPH_GROW(ix->e_to, ix->cap_edges);
+        GRAPH_GROW(ix->e_op, ix->cap_edges);
+        GRAPH_GROW(ix->e_next_out, ix->cap_edges);
+        GRAPH_GROW(ix->e_next_in, ix->cap_edges);
+        GRAPH_GROW(ix->e_weight, ix->cap_edges);
+    }
+    uint32_t e = ix->n_edges++;
+    ix->e_from[e] = u;
+    ix->e_to[e] = v;
+    ix->e_op[e] = op;
+    ix->e_weight[e] = cell_is_number(label) ? cell_get_number(label)
+                    : cell_is_integer(label) ? (double)cell_get_integer(label) : 1.0;
+    ix->e_next_out[e] = ix->out_head[u];
+    ix->out_head[u] = e;
+    ix->e_next_in[e] = ix->in_head[v];
+    ix->in_head[v] = e;
+}
+
+/* Index for graph, built from its lists on first use. The lists hold the
+ * newest entry first; nodes are replayed before edges, oldest first. */
+static GraphIndex* graph_index(Cell* graph) {
+    GraphIndex* ix = __atomic_load_n((GraphIndex**)&graph->data.graph.index, __ATOMIC_ACQUIRE);
+    if (ix) return ix;
+    ix = (GraphIndex*)calloc(1, sizeof(GraphIndex));
+    assert(ix != NULL);
+    atomic_init(&ix->refs, 1);
+    atomic_flag_clear(&ix->lock);
+    uint32_t n = 0, m = 0;
+    for (Cell* p = graph->data.graph.nodes; cell_is_pair(p); p = cell_cdr(p)) n++;
+    for (Cell* p = graph->data.graph.edges; cell_is_pair(p); p = cell_cdr(p)) m++;
+    Cell** items = (Cell**)malloc(((n > m ? n : m) + 1) * sizeof(Cell*));
+    assert(items != NULL);
+    uint32_t k = n;
+    for (Cell* p = graph->data.graph.nodes; cell_is_pair(p); p = cell_cdr(p)) items[--k] = cell_car(p);
+    for (uint32_t i = 0; i < n; i++) graph_index_add_node(ix, items[i]);
+    k = m;
+    for (Cell* p = graph->data.graph.edges; cell_is_pair(p); p = cell_cdr(p)) items[--k] = cell_car(p);
+    for (uint32_t i = 0; i < m; i++) {
+        Cell* e = items[i];
+        if (!cell_is_pair(e) || !cell_is_pair(cell_cdr(e))) { ix->ops++; continue; }
+        Cell* rest = cell_cdr(cell_cdr(e));
+        graph_index_add_edge(ix, cell_car(e), cell_car(cell_cdr(e)),
+                             cell_is_pair(rest) ? cell_car(rest) : NULL);
+    }
+    free(items);
+    /* Racing builders compute the same view */
+    graph->data.graph.index_ops = ix->ops;
+    GraphIndex* expected = NULL;
+    if (__atomic_compare_exchange_n((GraphIndex**)&graph->data.graph.index, &expected, ix, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        return ix;
+    graph_index_release(ix);
+    return expected;
+}
+
+/* next was built from graph by one addition: extend graph's index in place
+ * when graph is its newest version, else leave next to build its own.
+ * to == NULL adds node `from`; otherwise the edge from -> to. */
+static void graph_index_extend(Cell* graph, Cell* next, Cell* from, Cell* to, Cell* label) {
+    GraphIndex* ix = graph_index(graph);
+    graph_index_lock(ix);
+    if (ix->ops != graph->data.graph.index_ops) {
+        graph_index_unlock(ix);
+        return;
+    }
+    if (to) graph_index_add_edge(ix, from, to, label);
+    else graph_index_add_node(ix, from);
+    next->data.graph.index_ops = ix->ops;
+    atomic_fetch_add_explicit(&ix->refs, 1, memory_order_relaxed);
+    next->data.graph.index = ix;
+    graph_index_unlock(ix);
+}
+
+/* next has graph's nodes and edges: same view of the same index */
+static void graph_index_share(Cell* graph, Cell* next) {
+    GraphIndex* ix = __atomic_load_n((GraphIndex**)&graph->data.graph.index, __ATOMIC_ACQUIRE);
+    if (!ix) return;
+    atomic_fetch_add_explicit(&ix->refs, 1, memory_order_relaxed);
+    next->data.graph.index_ops = graph->data.graph.index_ops;
+    next->data.graph.index = ix;
+}
+
+/* Node id as seen by a version with `ops` additions, or GRAPH_NONE */
+static uint32_t graph_view_id(GraphIndex* ix, uint32_t ops, Cell* node) {
+    uint32_t id = graph_find_id(ix, node, cell_hash(node));
+    return id != GRAPH_NONE && ix->id_seen[id] < ops ? id : GRAPH_NONE;
+}
+
+/* Visible edges of a node, oldest first, into buf (at least n_edges long) */
+static uint32_t graph_view_out(GraphIndex* ix, uint32_t ops, uint32_t id, uint32_t* buf) {
+    uint32_t n = 0;
+    for (uint32_t e = ix->out_head[id]; e != GRAPH_NONE; e = ix->e_next_out[e])
+        if (ix->e_op[e] < ops) buf[n++] = e;
+    for (uint32_t i = 0, j = n; i + 1 < j; i++, j--) {
+        uint32_t t = buf[i]; buf[i] = buf[j - 1]; buf[j - 1] = t;
+    }
+    return n;
+}
+
+/* List of ids' node values, ids[0] first */
+static Cell* graph_id_list(GraphIndex* ix, const uint32_t* ids, uint32_t n) {
+    Cell* result = cell_nil();
+    for (uint32_t i = n; i-- > 0;) {
+        Cell* next = cell_cons(ix->id_node[ids[i]], result);
+        cell_release(result);
+        result = next;
+    }
+    return result;
+}
+
+/* Direct neighbours along out (or in) edges, oldest edge first */
+static Cell* graph_neighbours(Cell* graph, Cell* node, bool out) {
+    GraphIndex* ix = graph_index(graph);
+    uint32_t ops = graph->data.graph.index_ops;
+    graph_index_lock(ix);
+    Cell* result = cell_nil();
+    uint32_t id = graph_view_id(ix, ops, node);
+    if (id != GRAPH_NONE) {
+        uint32_t e = out ? ix->out_head[id] : ix->in_head[id];
+        for (; e != GRAPH_NONE; e = out ? ix->e_next_out[e] : ix->e_next_in[e]) {
+            if (ix->e_op[e] >= ops) continue;
+            Cell* next = cell_cons(ix->id_node[out ? ix->e_to[e] : ix->e_from[e]], result);
+            cell_release(result);
+            result = next;
+        }
+    }
+    graph_index_unlock(ix);
+    return result;
+}
+
+Cell* cell_graph_successors(Cell* graph, Cell* node) {
+    assert(graph->type == CELL_GRAPH);
+    return graph_neighbours(graph, node, true);
+}
+
+Cell* cell_graph_predecessors(Cell* graph, Cell* node) {
+    assert(graph->type == CELL_GRAPH);
+    return graph_neighbours(graph, node, false);
+}
+
+/* BFS (or DFS preorder) from src over the visible edges. Fills order with
+ * the ids reached and, when parent is non-NULL, each one's BFS parent.
+ * Stops early once stop_at is reached. Returns the number reached. */
+static uint32_t graph_search(GraphIndex* ix, uint32_t ops, uint32_t src, bool depth_first,
+                             uint32_t stop_at, uint32_t* order, uint32_t* parent) {
+    uint8_t* seen = (uint8_t*)calloc(ix->n_ids, 1);
+    uint32_t* edges = (uint32_t*)malloc((ix->n_edges + 1) * sizeof(uint32_t));
+    uint32_t* work = (uint32_t*)malloc((ix->n_edges + 1) * sizeof(uint32_t));
+    assert(seen && edges && work);
+    uint32_t n = 0;
+    if (depth_first) {
+        /* Stack of pending ids; oldest edge ends on top, as recursion would */
+        uint32_t top = 0;
+        work[top++] = src;
+        while (top) {
+            uint32_t u = work[--top];
+            if (seen[u]) continue;
+            seen[u] = 1;
+            order[n++] = u;
+            if (u == stop_at) break;
+            uint32_t k = graph_view_out(ix, ops, u, edges);
+            while (k) work[top++] = ix->e_to[edges[--k]];
+        }
+    } else {
+        /* order doubles as the FIFO queue */
+        seen[src] = 1;
+        order[n++] = src;
+        if (parent) parent[src] = GRAPH_NONE;
+        for (uint32_t head = 0; head < n && order[n - 1] != stop_at; head++) {
+            uint32_t u = order[head];
+            uint32_t k = graph_view_out(ix, ops, u, edges);
+            for (uint32_t i = 0; i < k; i++) {
+                uint32_t v = ix->e_to[edges[i]];
+                if (seen[v]) continue;
+                seen[v] = 1;
+                if (parent) parent[v] = u;
+                order[n++] = v;
+                if (v == stop_at) break;
+            }
+        }
+    }
+    free(seen);
+    free(edges);
+    free(work);
+    return n;
+}
+
+Cell* cell_graph_walk(Cell* graph, Cell* start, bool depth_first) {
+    assert(graph->type == CELL_GRAPH);
+    GraphIndex* ix = graph_index(graph);
+    uint32_t ops = graph->data.graph.index_ops;
+    graph_index_lock(ix);
+    Cell* result = cell_nil();
+    uint32_t id = graph_view_id(ix, ops, start);
+    /* Traversals start only from declared nodes */
+    if (id != GRAPH_NONE && ix->id_decl[id] < ops) {
+        uint32_t* order = (uint32_t*)malloc(ix->n_ids * sizeof(uint32_t));
+        assert(order != NULL);
+        uint32_t n = graph_search(ix, ops, id, depth_first, GRAPH_NONE, order, NULL);
+        cell_release(result);
+        result = graph_id_list(ix, order, n);
+        free(order);
+    }
+    graph_index_unlock(ix);
+    return result;
+}
+
+bool cell_graph_reachable(Cell* graph, Cell* from, Cell* to) {
+    assert(graph->type == CELL_GRAPH);
+    if (cell_equal(from, to)) return true;
+    GraphIndex* ix = graph_index(graph);
+    uint32_t ops = graph->data.graph.index_ops;
+    graph_index_lock(ix);
+    bool found = false;
+    uint32_t u = graph_view_id(ix, ops, from);
+    uint32_t v = graph_view_id(ix, ops, to);
+    if (u != GRAPH_NONE && v != GRAPH_NONE) {
+        uint32_t* order = (uint32_t*)malloc(ix->n_ids * sizeof(uint32_t));
+        assert(order != NULL);
+        uint32_t n = graph_search(ix, ops, u, false, v, order, NULL);
+        found = order[n - 1] == v;
+        free(order);
+    }
+    graph_index_unlock(ix);
+    return found;
+}
+
+/* Fewest-edge path from -> to as a node list, nil if there is none */
+Cell* cell_graph_path(Cell* graph, Cell* from, Cell* to) {
+    assert(graph->type == CELL_GRAPH);
+    if (cell_equal(from, to)) return cell_cons(from, cell_nil());
+    GraphIndex* ix = graph_index(graph);
+    uint32_t ops = graph->data.graph.index_ops;
+    graph_index_lock(ix);
+    Cell* result = cell_nil();
+    uint32_t u = graph_view_id(ix, ops, from);
+    uint32_t v = graph_view_id(ix, ops, to);
+    if (u != GRAPH_NONE && v != GRAPH_NONE) {
+        uint32_t* order = (uint32_t*)malloc(ix->n_ids * sizeof(uint32_t));
+        uint32_t* parent = (uint32_t*)malloc(ix->n_ids * sizeof(uint32_t));
+        assert(order && parent);
+        uint32_t n = graph_search(ix, ops, u, false, v, order, parent);
+        if (order[n - 1] == v) {
+            /* Walk parents back into order, then emit reversed */
+            uint32_t len = 0;
+            for (uint32_t x = v; x != GRAPH_NONE; x = parent[x]) order[len++] = x;
+            for (uint32_t i = 0; i < len / 2; i++) {
+                uint32_t t = order[i]; order[i] = order[len - 1 - i]; order[len - 1 - i] = t;
+            }
+            cell_release(result);
+            result = graph_id_list(ix, order, len);
+        }
+        free(order);
+        free(parent);
+    }
+    graph_index_unlock(ix);
+    return result;
+}
+
+/* Back edges found by a colouring DFS from every declared node, each as
+ * the list (from to); nil for an acyclic graph */
+Cell* cell_graph_cycles(Cell* graph) {
+    assert(graph->type == CELL_GRAPH);
+    GraphIndex* ix = graph_index(graph);
+    uint32_t ops = graph->data.graph.index_ops;
+    graph_index_lock(ix);
+    uint32_t nid = ix->n_ids;
+    uint8_t* colour = (uint8_t*)calloc(nid ? nid : 1, 1);   /* 0 white, 1 grey, 2 black */
+    uint32_t* stack = (uint32_t*)malloc((nid ? nid : 1) * sizeof(uint32_t));
+    uint32_t* cursor = (uint32_t*)malloc((nid ? nid : 1) * sizeof(uint32_t));
+    assert(colour && stack && cursor);
+    Cell* cycles = cell_nil();
+    for (uint32_t root = 0; root < nid; root++) {
+        if (ix->id_decl[root] >= ops || colour[root]) continue;
+        uint32_t top = 0;
+        stack[top++] = root;
+        colour[root] = 1;
+        cursor[root] = ix->out_head[root];
+        while (top) {
+            uint32_t u = stack[top - 1];
+            uint32_t e = cursor[u];
+            while (e != GRAPH_NONE && ix->e_op[e] >= ops) e = ix->e_next_out[e];
+            if (e == GRAPH_NONE) {
+                colour[u] = 2;
+                top--;
+                continue;
+            }
+            cursor[u] = ix->e_next_out[e];
+            uint32_t v = ix->e_to[e];
+            if (colour[v] == 1) {
+                uint32_t pair[2] = { u, v };
+                Cell* cycle = graph_id_list(ix, pair, 2);
+                Cell* next = cell_cons(cycle, cycles);
+                cell_release(cycle);
+                cell_release(cycles);
+                cycles = next;
+            } else if (colour[v] == 0) {
+                colour[v] = 1;
+                cursor[v] = ix->out_head[v];
+                stack[top++] = v;
+            }
+        }
+    }
+    free(colour);
+    free(stack);
+    free(cursor);
+    graph_index_unlock(ix);
+    return cycles;
+}
+
+/* Kahn's algorithm over every node the graph mentions, ties broken by
+ * first appearance. NULL when the graph has a cycle. */
+Cell* cell_graph_topo_sort(Cell* graph) {
+    assert(graph->type == CELL_GRAPH);
+    GraphIndex* ix = graph_index(graph);
+    uint32_t ops = graph->data.graph.index_ops;
+    graph_index_lock(ix);
+    uint32_t nid = ix->n_ids;
+    uint32_t* indeg = (uint32_t*)calloc(nid ? nid : 1, sizeof(uint32_t));
+    uint32_t* order = (uint32_t*)malloc((nid ? nid : 1) * sizeof(uint32_t));
+    uint32_t* edges = (uint32_t*)malloc((ix->n_edges + 1) * sizeof(uint32_t));
+    assert(indeg && order && edges);
+    uint32_t visible = 0, n = 0;
+    for (uint32_t e = 0; e < ix->n_edges; e++)
+        if (ix->e_op[e] < ops) indeg[ix->e_to[e]]++;
+    for (uint32_t i = 0; i < nid; i++) {
+        if (ix->id_seen[i] >= ops) continue;
+        visible++;
+        if (indeg[i] == 0) order[n++] = i;
+    }
+    for (uint32_t head = 0; head < n; head++) {
+        uint32_t k = graph_view_out(ix, ops, order[head], edges);
+        for (uint32_t i = 0; i < k; i++)
+            if (--indeg[ix->e_to[edges[i]]] == 0) order[n++] = ix->e_to[edges[i]];
+    }
+    Cell* result = n == visible ? graph_id_list(ix, order, n) : NULL;
+    free(indeg);
+    free(order);
+    free(edges);
+    graph_index_unlock(ix);
+    return result;
+}
+
+typedef struct { double dist; uint32_t id; } GraphHeapEntry;
+
+static void graph_heap_push(GraphHeapEntry* h, uint32_t* n, double dist, uint32_t id) {
+    uint32_t i = (*n)++;
+    while (i && h[(i - 1) / 2].dist > dist) {
+        h[i] = h[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    h[i] = (GraphHeapEntry){ dist, id };
+}
+
+static GraphHeapEntry graph_heap_pop(GraphHeapEntry* h, uint32_t* n) {
+    GraphHeapEntry top = h[0], last = h[--(*n)];
+    uint32_t i = 0;
+    for (;;) {
+        uint32_t c = 2 * i + 1;
+        if (c >= *n) break;
+        if (c + 1 < *n && h[c + 1].dist < h[c].dist) c++;
+        if (h[c].dist >= last.dist) break;
+        h[i] = h[c];
+        i = c;
+    }
+    if (*n) h[i] = last;
+    return top;
+}
+
+/* Dijkstra over numeric edge labels (other labels weigh 1). Returns
+ * (cost . path), nil when to is unreachable, or an error for a negative
+ * weight on a visible edge. */
+Cell* cell_graph_shortest(Cell* graph, Cell* from, Cell* to) {
+    assert(graph->type == CELL_GRAPH);
+    GraphIndex* ix = graph_index(graph);
+    uint32_t ops = graph->data.graph.index_ops;
+    graph_index_lock(ix);
+    for (uint32_t e = 0; e < ix->n_edges; e++) {
+        if (ix->e_op[e] < ops && ix->e_weight[e] < 0) {
+            graph_index_unlock(ix);
+            return cell_error("graph-shortest-path negative edge weight", cell_number(ix->e_weight[e]));
+        }
+    }
+    Cell* result = cell_nil();
+    uint32_t src = graph_view_id(ix, ops, from);
+    uint32_t dst = graph_view_id(ix, ops, to);
+    if (cell_equal(from, to)) {
+        Cell* path = cell_cons(from, cell_nil());
+        Cell* zero = cell_number(0);
+        result = cell_cons(zero, path);
+        cell_release(zero);
+        cell_release(path);
+    } else if (src != GRAPH_NONE && dst != GRAPH_NONE) {
+        uint32_t nid = ix->n_ids;
+        double* dist = (double*)malloc(nid * sizeof(double));
+        uint32_t* parent = (uint32_t*)malloc(nid * sizeof(uint32_t));
+        uint8_t* done = (uint8_t*)calloc(nid, 1);
+        GraphHeapEntry* heap = (GraphHeapEntry*)malloc((ix->n_edges + 1) * sizeof(GraphHeapEntry));
+        assert(dist && parent && done && heap);
+        for (uint32_t i = 0; i < nid; i++) { dist[i] = INFINITY; parent[i] = GRAPH_NONE; }
+        uint32_t hn = 0;
+        dist[src] = 0;
+        graph_heap_push(heap, &hn, 0, src);
+        while (hn) {
+            GraphHeapEntry top = graph_heap_pop(heap, &hn);
+            uint32_t u = top.id;
+            if (done[u]) continue;
+            done[u] = 1;
+            if (u == dst) break;
+            for (uint32_t e = ix->out_head[u]; e != GRAPH_NONE; e = ix->e_next_out[e]) {
+                if (ix->e_op[e] >= ops) continue;
+                uint32_t v = ix->e_to[e];
+                double d = dist[u] + ix->e_weight[e];
+                if (!done[v] && d < dist[v]) {
+                    dist[v] = d;
+                    parent[v] = u;
+                    graph_heap_push(heap, &hn, d, v);
+                }
+            }
+        }
+        if (done[dst]) {
+            uint32_t len = 0;
+            for (uint32_t x = dst; x != GRAPH_NONE; x = parent[x]) heap[len++].id = x;
+            Cell* path = cell_nil();
+            for (uint32_t i = 0; i < len; i++) {
+                Cell* next = cell_cons(ix->id_node[heap[i].id], path);
+                cell_release(path);
+                path = next;
+            }
+            Cell* cost = cell_number(dist[dst]);
+            cell_release(result);
+            result = cell_cons(cost, path);
+            cell_release(cost);
+            cell_release(path);
+        }
+        free(dist);
+        free(parent);
+        free(done);
+        free(heap);
+    }
+    graph_index_unlock(ix);
+    return result;
+}
+
 /* Graph mutators (return modified graph - immutable style) */
 Cell* cell_graph_add_node(Cell* graph, Cell* node) {
     assert(graph->type == CELL_GRAPH);
@@ -1088,6 +2645,7 @@ Cell* cell_graph_add_node(Cell* graph, Cell* node) {
     }
 
     cell_release(new_nodes);  /* cell_graph retained it */
+    graph_index_extend(graph, new_graph, node, NULL, NULL);
     return new_graph;
 }
 
@@ -1095,7 +2653,11 @@ Cell* cell_graph_add_edge(Cell* graph, Cell* from, Cell* to, Cell* label) {
     assert(graph->type == CELL_GRAPH);
 
     /* Create edge as ⟨from ⟨to ⟨label ∅⟩⟩⟩ (proper list) */
-    Cell* edge = cell_cons(from, cell_cons(to, cell_cons(label, cell_nil())));
+    Cell* tail = cell_cons(label, cell_nil());
+    Cell* rest = cell_cons(to, tail);
+    Cell* edge = cell_cons(from, rest);
+    cell_release(tail);
+    cell_release(rest);
 
     /* Create new edge list with edge prepended */
     Cell* new_edges = cell_cons(edge, graph->data.graph.edges);
@@ -1120,6 +2682,7 @@ Cell* cell_graph_add_edge(Cell* graph, Cell* from, Cell* to, Cell* label) {
 
     cell_release(edge);
     cell_release(new_edges);
+    graph_index_extend(graph, new_graph, from, to, label);
     return new_graph;
 }
 
@@ -1144,6 +2707,7 @@ Cell* cell_graph_set_entry(Cell* graph, Cell* entry) {
         new_graph->data.graph.exit = graph->data.graph.exit;
         cell_retain(new_graph->data.graph.exit);
     }
+    graph_index_share(graph, new_graph);
 
     return new_graph;
 }
@@ -1169,6 +2733,7 @@ Cell* cell_graph_set_exit(Cell* graph, Cell* exit) {
         new_graph->data.graph.entry = graph->data.graph.entry;
         cell_retain(new_graph->data.graph.entry);
     }
+    graph_index_share(graph, new_graph);
 
     return new_graph;
 }
@@ -1207,9 +2772,18 @@ bool cell_equal(Cell* a, Cell* b) {
                    cell_equal(a->data.pair.cdr, b->data.pair.cdr);
         case CELL_STRUCT:
             /* Structures equal if same type, variant, and fields */
-            return cell_equal(a->data.structure.type_tag, b->data.structure.type_tag) &&
-                   cell_equal(a->data.structure.variant, b->data.structure.variant) &&
-                   cell_equal(a->data.structure.fields, b->data.structure.fields);
+            if (!cell_equal(a->data.structure.type_tag, b->data.structure.type_tag) ||
+                !cell_equal(a->data.structure.variant, b->data.structure.variant))
+                return false;
+            if (a->data.structure.layout && b->data.structure.layout &&
+                cell_equal(a->data.structure.layout, b->data.structure.layout)) {
+                uint16_t n = cell_struct_layout_size(a->data.structure.layout);
+                for (uint16_t i = 0; i < n; i++)
+                    if (!cell_equal(a->data.structure.slots[i], b->data.structure.slots[i]))
+                        return false;
+                return true;
+            }
+            return cell_equal(cell_struct_fields(a), cell_struct_fields(b));
         case CELL_GRAPH:
             /* Graphs equal if same type and structure (deep comparison) */
             return a->data.graph.graph_type == b->data.graph.graph_type &&
@@ -1258,8 +2832,13 @@ bool cell_equal(Cell* a, Cell* b) {
         case CELL_SORTED_MAP:
         case CELL_TRIE:
         case CELL_ITERATOR:
+        case CELL_TABLE:
             /* Identity only — structural comparison too expensive */
             return false;
+        case CELL_PMAP:
+        case CELL_PSET:
+            /* Immutable values: equal contents are equal */
+            return champ_equal(a, b);
         case CELL_LAMBDA:
         case CELL_BUILTIN:
         case CELL_ERROR:
@@ -1333,9 +2912,9 @@ void cell_print(Cell* c) {
                 printf(" ");
                 cell_print(c->data.structure.variant);
             }
-            if (c->data.structure.fields && !cell_is_nil(c->data.structure.fields)) {
+            if (cell_struct_fields(c) && !cell_is_nil(cell_struct_fields(c))) {
                 printf(" ");
-                cell_print(c->data.structure.fields);
+                cell_print(cell_struct_fields(c));
             }
             printf("]");
             break;
@@ -1408,11 +2987,19 @@ void cell_print(Cell* c) {
         case CELL_TRIE:
             printf("trie[%u]", c->data.trie.size);
             break;
+        case CELL_PMAP:
+        case CELL_PSET:
+            printf("%s%s[%u]", c->type == CELL_PMAP ? "pmap" : "pset",
+                   cell_champ_is_transient(c) ? "!" : "", c->data.champ.size);
+            break;
+        case CELL_TABLE:
+            printf("table[%u]", c->data.table.size);
+            break;
         case CELL_ITERATOR: {
             IteratorData* id = (IteratorData*)c->data.iterator.iter_data;
             static const char* kind_names[] = {
                 "list","hmap","hset","deque","vec","heap",
-                "smap","trie","buf","graph",
+                "smap","trie","buf","graph","table",
                 "map","filter","take","drop","chain","zip"
             };
             const char* kn = (id && id->kind <= ITER_ZIP) ? kind_names[id->kind] : "if";
@@ -1442,8 +3029,41 @@ void cell_println(Cell* c) {
 
 /* ===== HashMap (Swiss Table) Implementation ===== */
 
-/* Hash a cell value using SipHash-2-4 */
-uint64_t cell_hash(Cell* c) {
+/* Hash a word / byte string with the selected family */
+static inline uint64_t hash_word(CellHashFamily fam, uint64_t w) {
+    return fam == CELL_HASH_FAST ? guage_fasthash64(w) : guage_siphash(&w, sizeof(w));
+}
+
+static inline uint64_t hash_bytes(CellHashFamily fam, const void* p, size_t n) {
+    return fam == CELL_HASH_FAST ? guage_fasthash(p, n) : guage_siphash(p, n);
+}
+
+/* Memoized structural hashes. A cell caches the hash of one family: the
+ * first writer claims the slot (0 → 0xFF) with a CAS, stores the hash,
+ * then publishes the family with release order. Frozen cells are hashed by
+ * several schedulers at once; readers that see another family, or a claim
+ * in progress, just recompute. */
+#define HASH_MEMO_BUSY 0xFF
+
+static inline bool hash_memo_get(uint8_t* fam_slot, uint64_t* memo, CellHashFamily fam, uint64_t* out) {
+    if (__atomic_load_n(fam_slot, __ATOMIC_ACQUIRE) != (uint8_t)(fam + 1)) return false;
+    *out = *memo;
+    return true;
+}
+
+static inline void hash_memo_put(uint8_t* fam_slot, uint64_t* memo, CellHashFamily fam, uint64_t h) {
+    uint8_t expected = 0;
+    if (!__atomic_compare_exchange_n(fam_slot, &expected, HASH_MEMO_BUSY, false,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        return;
+    *memo = h;
+    __atomic_store_n(fam_slot, (uint8_t)(fam + 1), __ATOMIC_RELEASE);
+}
+
+/* Structural hash; *stable is cleared when the result depends on something
+ * that can still change (unfrozen vectors/buffers, heaps, transients), so
+ * enclosing pairs know whether their hash may be memoized. */
+static uint64_t cell_hash_impl(Cell* c, CellHashFamily fam, bool* stable) {
     if (!c) return 0;
     switch (c->type) {
         case CELL_ATOM_NUMBER: {
@@ -1451,75 +3071,118 @@ uint64_t cell_hash(Cell* c) {
             /* If integer-valued double, hash as int64 for cross-type consistency */
             if (n == (double)(int64_t)n && n >= (double)INT64_MIN && n <= (double)INT64_MAX) {
                 int64_t iv = (int64_t)n;
-                return guage_siphash(&iv, sizeof(iv));
+                return hash_word(fam, (uint64_t)iv);
             }
-            return guage_siphash(&n, sizeof(n));
+            return hash_bytes(fam, &n, sizeof(n));
         }
         case CELL_ATOM_INTEGER: {
             int64_t iv = c->data.atom.integer;
-            return guage_siphash(&iv, sizeof(iv));
+            return hash_word(fam, (uint64_t)iv);
         }
         case CELL_ATOM_SYMBOL:
             return intern_hash_by_id(c->sym_id);
         case CELL_ATOM_STRING:
-            return guage_siphash(c->data.atom.string, strlen(c->data.atom.string));
+            return hash_bytes(fam, c->data.atom.string, strlen(c->data.atom.string));
         case CELL_ATOM_BOOL:
             return c->data.atom.boolean ? 0x0001ULL : 0x0002ULL;
         case CELL_ATOM_NIL:
             return 0x0003ULL;
         case CELL_PAIR: {
-            uint64_t h = cell_hash(c->data.pair.car);
-            h ^= cell_hash(c->data.pair.cdr) * 0x9E3779B97F4A7C15ULL + (h << 12) + (h >> 4);
+            /* Pairs are immutable once built: memoize when the subtree is */
+            uint64_t h;
+            if (hash_memo_get(&c->data.pair.hash_memo_family, &c->data.pair.hash_memo, fam, &h))
+                return h;
+            bool sub_stable = true;
+            h = cell_hash_impl(c->data.pair.car, fam, &sub_stable);
+            h ^= cell_hash_impl(c->data.pair.cdr, fam, &sub_stable) * 0x9E3779B97F4A7C15ULL + (h << 12) + (h >> 4);
+            if (sub_stable) {
+                hash_memo_put(&c->data.pair.hash_memo_family, &c->data.pair.hash_memo, fam, h);
+            } else {
+                *stable = false;
+            }
             return h;
         }
         case CELL_BUFFER:
-            return guage_siphash(c->data.buffer.bytes, c->data.buffer.size);
+            if (!cell_is_frozen(c)) *stable = false;
+            return hash_bytes(fam, c->data.buffer.bytes, c->data.buffer.size);
         case CELL_VECTOR: {
+            /* Memo is cleared by cell_vector_set/push/pop; a vector can still
+             * change, so enclosing pairs never memoize over one. */
+            *stable = false;
+            uint64_t vh;
+            if (hash_memo_get(&c->data.vector.hash_memo_family, &c->data.vector.hash_memo, fam, &vh))
+                return vh;
             /* Hash all elements */
-            uint64_t vh = 0x5678ULL;
+            vh = 0x5678ULL;
+            bool sub_stable = true;
             Cell** vbuf = (c->data.vector.capacity <= 4) ? c->data.vector.sbo : c->data.vector.heap;
             for (uint32_t vi = 0; vi < c->data.vector.size; vi++) {
-                vh ^= cell_hash(vbuf[vi]) * 0x9E3779B97F4A7C15ULL + (vh << 12) + (vh >> 4);
+                vh ^= cell_hash_impl(vbuf[vi], fam, &sub_stable) * 0x9E3779B97F4A7C15ULL + (vh << 12) + (vh >> 4);
             }
+            if (sub_stable)
+                hash_memo_put(&c->data.vector.hash_memo_family, &c->data.vector.hash_memo, fam, vh);
             return vh;
         }
         case CELL_HEAP: {
+            *stable = false;
             uint64_t hh = 0x9ABCull;
             for (uint32_t hi = 0; hi < c->data.pq.size; hi++) {
-                hh ^= guage_siphash(&c->data.pq.keys[hi], sizeof(double));
-                hh ^= cell_hash(c->data.pq.vals[hi]) * 0x9E3779B97F4A7C15ULL + (hh << 12) + (hh >> 4);
+                hh ^= hash_bytes(fam, &c->data.pq.keys[hi], sizeof(double));
+                hh ^= cell_hash_impl(c->data.pq.vals[hi], fam, stable) * 0x9E3779B97F4A7C15ULL + (hh << 12) + (hh >> 4);
             }
             return hh;
         }
         case CELL_SORTED_MAP: {
+            *stable = false;
             uint64_t smh = 0xDEF0ull;
             uint32_t sz = c->data.sorted_map.size;
             smh ^= guage_siphash(&sz, sizeof(sz));
             return smh;
         }
         case CELL_TRIE: {
+            *stable = false;
             uint64_t th = 0xAE70ull;
             uint32_t tsz = c->data.trie.size;
             th ^= guage_siphash(&tsz, sizeof(tsz));
             return th;
         }
+        case CELL_PMAP:
+        case CELL_PSET:
+            if (cell_champ_is_transient(c)) *stable = false;
+            return champ_hash(c);
         case CELL_ITERATOR: {
             uintptr_t ptr = (uintptr_t)c;
-            return guage_siphash(&ptr, sizeof(ptr));
+            return hash_word(fam, (uint64_t)ptr);
         }
         default: {
             /* Lambda, error, actor, box, etc. — hash pointer */
             uintptr_t ptr = (uintptr_t)c;
-            return guage_siphash(&ptr, sizeof(ptr));
+            return hash_word(fam, (uint64_t)ptr);
         }
     }
 }
 
+/* Hash a cell value using SipHash-2-4 */
+uint64_t cell_hash(Cell* c) {
+    bool stable = true;
+    return cell_hash_impl(c, CELL_HASH_SIP, &stable);
+}
+
+/* Hash a cell value with an explicit family (see CellHashFamily) */
+uint64_t cell_hash_with(Cell* c, CellHashFamily family) {
+    bool stable = true;
+    return cell_hash_impl(c, family, &stable);
+}
+
 bool cell_is_hashmap(Cell* c) {
     return c && c->type == CELL_HASHMAP;
 }
 
 Cell* cell_hashmap_new(uint32_t initial_capacity) {
+    return cell_hashmap_new_with(initial_capacity, CELL_HASH_SIP);
+}
+
+Cell* cell_hashmap_new_with(uint32_t initial_capacity, CellHashFamily family) {
     /* Ensure minimum capacity and power of 2 */
     if (initial_capacity < (uint32_t)GROUP_WIDTH)
         initial_capacity = GROUP_WIDTH;
@@ -1531,6 +3194,11 @@ Cell* cell_hashmap_new(uint32_t initial_capacity) {
     c->data.hashmap.capacity = cap;
     c->data.hashmap.size = 0;
     c->data.hashmap.growth_left = cap * 7 / 8;
+    c->data.hashmap.old_ctrl = NULL;
+    c->data.hashmap.old_slots = NULL;
+    c->data.hashmap.old_capacity = 0;
+    c->data.hashmap.migrate_pos = 0;
+    c->data.hashmap.hash_family = (uint8_t)family;
 
     /* Allocate control bytes: capacity + GROUP_WIDTH for mirroring */
     c->data.hashmap.ctrl = (uint8_t*)malloc(cap + GROUP_WIDTH);
@@ -1542,11 +3210,16 @@ Cell* cell_hashmap_new(uint32_t initial_capacity) {
     return c;
 }
 
-/* Internal: find slot for key. Returns slot index or -1. */
-static int hashmap_find(Cell* map, Cell* key, uint64_t hash) {
-    uint32_t cap = map->data.hashmap.capacity;
-    uint8_t* ctrl = map->data.hashmap.ctrl;
-    HashSlot* slots = map->data.hashmap.slots;
+/* Tables below this capacity still resize in one step (the copy is cheap);
+ * larger ones keep the old table and drain HASHMAP_MIGRATE_GROUPS groups of
+ * it into the new one on every put/delete, so no single operation pays for
+ * rehashing the whole map. */
+#define HASHMAP_INCREMENTAL_MIN 1024
+#define HASHMAP_MIGRATE_GROUPS  2
+
+/* Internal: find key in one table. Returns slot index or -1. */
+static int hashmap_probe(uint8_t* ctrl, HashSlot* slots, uint32_t cap,
+                         Cell* key, uint64_t hash) {
     uint8_t h2 = H2(hash);
     uint32_t group_mask = (cap / GROUP_WIDTH) - 1;
     uint32_t group_idx = (uint32_t)(H1(hash) / GROUP_WIDTH) & group_mask;
@@ -1574,6 +3247,25 @@ static int hashmap_find(Cell* map, Cell* key, uint64_t hash) {
     }
 }
 
+/* Internal: find slot for key in the live table. Returns slot index or -1. */
+static int hashmap_find(Cell* map, Cell* key, uint64_t hash) {
+    return hashmap_probe(map->data.hashmap.ctrl, map->data.hashmap.slots,
+                         map->data.hashmap.capacity, key, hash);
+}
+
+/* Internal: find key in the table still being drained, or -1 */
+static int hashmap_find_old(Cell* map, Cell* key, uint64_t hash) {
+    if (!map->data.hashmap.old_ctrl) return -1;
+    return hashmap_probe(map->data.hashmap.old_ctrl, map->data.hashmap.old_slots,
+                         map->data.hashmap.old_capacity, key, hash);
+}
+
+/* Internal: write a control byte, keeping the first group's mirror in sync */
+static inline void hashmap_set_ctrl(uint8_t* ctrl, uint32_t cap, uint32_t idx, uint8_t b) {
+    ctrl[idx] = b;
+    if (idx < (uint32_t)GROUP_WIDTH) ctrl[cap + idx] = b;
+}
+
 /* Internal: find an empty or deleted slot for insertion */
 static uint32_t hashmap_find_insert_slot(Cell* map, uint64_t hash) {
     uint32_t cap = map->data.hashmap.capacity;
@@ -1598,7 +3290,48 @@ static uint32_t hashmap_find_insert_slot(Cell* map, uint64_t hash) {
     }
 }
 
-/* Internal: resize the hashmap */
+/* Internal: move up to n_slots slots of the old table into the live one.
+ * Moved slots become tombstones so old-table lookups skip them; the old
+ * arrays are freed once the last slot has moved. growth_left was charged
+ * for every entry when the resize began, so moving does not touch it. */
+static void hashmap_migrate(Cell* map, uint32_t n_slots) {
+    uint8_t* octrl = map->data.hashmap.old_ctrl;
+    if (!octrl) return;
+    HashSlot* oslots = map->data.hashmap.old_slots;
+    uint32_t ocap = map->data.hashmap.old_capacity;
+    uint32_t pos = map->data.hashmap.migrate_pos;
+    uint32_t end = (n_slots >= ocap - pos) ? ocap : pos + n_slots;
+
+    for (; pos < end; pos++) {
+        if ((octrl[pos] & 0x80) == 0) {  /* FULL slot */
+            uint64_t hash = cell_hash_with(oslots[pos].key, map->data.hashmap.hash_family);
+            uint32_t slot = hashmap_find_insert_slot(map, hash);
+            hashmap_set_ctrl(map->data.hashmap.ctrl, map->data.hashmap.capacity, slot, H2(hash));
+            map->data.hashmap.slots[slot] = oslots[pos];  /* Move pointer, no retain/release */
+            hashmap_set_ctrl(octrl, ocap, pos, CTRL_DELETED);
+        }
+    }
+
+    if (pos >= ocap) {
+        free(octrl);
+        free(oslots);
+        map->data.hashmap.old_ctrl = NULL;
+        map->data.hashmap.old_slots = NULL;
+        map->data.hashmap.old_capacity = 0;
+        map->data.hashmap.migrate_pos = 0;
+    } else {
+        map->data.hashmap.migrate_pos = pos;
+    }
+}
+
+/* Finish any incremental resize, leaving every entry in ctrl/slots.
+ * Whole-table walks (keys, iteration, images) call this first. */
+void cell_hashmap_settle(Cell* map) {
+    assert(map->type == CELL_HASHMAP);
+    hashmap_migrate(map, UINT32_MAX);
+}
+
+/* Internal: resize the hashmap in one step */
 static void hashmap_resize(Cell* map, uint32_t new_cap) {
     uint32_t old_cap = map->data.hashmap.capacity;
     uint8_t* old_ctrl = map->data.hashmap.ctrl;
@@ -1618,13 +3351,9 @@ static void hashmap_resize(Cell* map, uint32_t new_cap) {
     /* Reinsert all entries */
     for (uint32_t i = 0; i < old_cap; i++) {
         if ((old_ctrl[i] & 0x80) == 0) {  /* FULL slot */
-            uint64_t hash = cell_hash(old_slots[i].key);
+            uint64_t hash = cell_hash_with(old_slots[i].key, map->data.hashmap.hash_family);
             uint32_t slot = hashmap_find_insert_slot(map, hash);
-            uint8_t h2 = H2(hash);
-            new_ctrl[slot] = h2;
-            if (slot < (uint32_t)GROUP_WIDTH) {
-                new_ctrl[new_cap + slot] = h2;  /* Mirror */
-            }
+            hashmap_set_ctrl(new_ctrl, new_cap, slot, H2(hash));
             new_slots[slot] = old_slots[i];  /* Move pointer, no retain/release */
         }
     }
@@ -1633,47 +3362,89 @@ static void hashmap_resize(Cell* map, uint32_t new_cap) {
     free(old_slots);
 }
 
+/* Internal: double the table once growth_left is exhausted. Large tables
+ * swap in empty arrays and keep the old ones to drain incrementally. */
+static void hashmap_grow(Cell* map) {
+    /* A drain still in progress must finish before the next one starts */
+    cell_hashmap_settle(map);
+
+    uint32_t old_cap = map->data.hashmap.capacity;
+    uint32_t new_cap = old_cap * 2;
+    if (old_cap < HASHMAP_INCREMENTAL_MIN) {
+        hashmap_resize(map, new_cap);
+        return;
+    }
+
+    map->data.hashmap.old_ctrl = map->data.hashmap.ctrl;
+    map->data.hashmap.old_slots = map->data.hashmap.slots;
+    map->data.hashmap.old_capacity = old_cap;
+    map->data.hashmap.migrate_pos = 0;
+
+    map->data.hashmap.ctrl = (uint8_t*)malloc(new_cap + GROUP_WIDTH);
+    memset(map->data.hashmap.ctrl, CTRL_EMPTY, new_cap + GROUP_WIDTH);
+    map->data.hashmap.slots = (HashSlot*)calloc(new_cap, sizeof(HashSlot));
+    map->data.hashmap.capacity = new_cap;
+    map->data.hashmap.growth_left = new_cap * 7 / 8 - map->data.hashmap.size;
+}
+
+/* Make room for n entries up front: one synchronous resize to the smallest
+ * capacity whose load limit covers n, so later puts never have to grow. */
+void cell_hashmap_reserve(Cell* map, uint32_t n) {
+    assert(map->type == CELL_HASHMAP);
+    cell_hashmap_settle(map);
+    uint32_t cap = map->data.hashmap.capacity;
+    while ((uint64_t)cap * 7 / 8 < n && cap < (1u << 31)) cap <<= 1;
+    if (cap > map->data.hashmap.capacity) hashmap_resize(map, cap);
+}
+
 Cell* cell_hashmap_get(Cell* map, Cell* key) {
     assert(map->type == CELL_HASHMAP);
     if (map->data.hashmap.size == 0) return cell_nil();
 
-    uint64_t hash = cell_hash(key);
+    uint64_t hash = cell_hash_with(key, map->data.hashmap.hash_family);
     int idx = hashmap_find(map, key, hash);
-    if (idx < 0) return cell_nil();
-
-    Cell* val = map->data.hashmap.slots[idx].value;
+    Cell* val;
+    if (idx >= 0) {
+        val = map->data.hashmap.slots[idx].value;
+    } else {
+        idx = hashmap_find_old(map, key, hash);
+        if (idx < 0) return cell_nil();
+        val = map->data.hashmap.old_slots[idx].value;
+    }
     cell_retain(val);
     return val;
 }
 
 Cell* cell_hashmap_put(Cell* map, Cell* key, Cell* value) {
     assert(map->type == CELL_HASHMAP);
-    uint64_t hash = cell_hash(key);
+    uint64_t hash = cell_hash_with(key, map->data.hashmap.hash_family);
+    hashmap_migrate(map, HASHMAP_MIGRATE_GROUPS * GROUP_WIDTH);
 
-    /* Check for existing key */
+    /* Check for existing key — live table first, then the one draining */
+    HashSlot* hit = NULL;
     int idx = hashmap_find(map, key, hash);
     if (idx >= 0) {
+        hit = &map->data.hashmap.slots[idx];
+    } else if ((idx = hashmap_find_old(map, key, hash)) >= 0) {
+        hit = &map->data.hashmap.old_slots[idx];
+    }
+    if (hit) {
         /* Overwrite — return old value (caller owns ref) */
-        Cell* old = map->data.hashmap.slots[idx].value;
-        map->data.hashmap.slots[idx].value = value;
+        Cell* old = hit->value;
+        hit->value = value;
         cell_retain(value);
         return old;  /* Old value returned without release */
     }
 
     /* Need to insert — check if resize needed first */
     if (map->data.hashmap.growth_left == 0) {
-        hashmap_resize(map, map->data.hashmap.capacity * 2);
+        hashmap_grow(map);
     }
 
-    /* Find insertion slot */
+    /* Find insertion slot (new keys always go to the live table) */
     uint32_t slot = hashmap_find_insert_slot(map, hash);
-    uint8_t h2 = H2(hash);
     bool was_empty = (map->data.hashmap.ctrl[slot] == CTRL_EMPTY);
-
-    map->data.hashmap.ctrl[slot] = h2;
-    if (slot < (uint32_t)GROUP_WIDTH) {
-        map->data.hashmap.ctrl[map->data.hashmap.capacity + slot] = h2;
-    }
+    hashmap_set_ctrl(map->data.hashmap.ctrl, map->data.hashmap.capacity, slot, H2(hash));
 
     map->data.hashmap.slots[slot].key = key;
     map->data.hashmap.slots[slot].value = value;
@@ -1688,29 +3459,42 @@ Cell* cell_hashmap_put(Cell* map, Cell* key, Cell* value) {
 
 Cell* cell_hashmap_delete(Cell* map, Cell* key) {
     assert(map->type == CELL_HASHMAP);
-    uint64_t hash = cell_hash(key);
+    uint64_t hash = cell_hash_with(key, map->data.hashmap.hash_family);
+    hashmap_migrate(map, HASHMAP_MIGRATE_GROUPS * GROUP_WIDTH);
     int idx = hashmap_find(map, key, hash);
-    if (idx < 0) return cell_nil();
+    if (idx < 0) {
+        /* Entry not moved yet: tombstone it in the old table */
+        idx = hashmap_find_old(map, key, hash);
+        if (idx < 0) return cell_nil();
+        HashSlot* os = &map->data.hashmap.old_slots[idx];
+        Cell* old_value = os->value;
+        cell_release(os->key);
+        os->key = NULL;
+        os->value = NULL;
+        hashmap_set_ctrl(map->data.hashmap.old_ctrl, map->data.hashmap.old_capacity,
+                         (uint32_t)idx, CTRL_DELETED);
+        map->data.hashmap.size--;
+        return old_value;  /* Caller owns ref */
+    }
 
     Cell* old_value = map->data.hashmap.slots[idx].value;
     cell_release(map->data.hashmap.slots[idx].key);
     map->data.hashmap.slots[idx].key = NULL;
     map->data.hashmap.slots[idx].value = NULL;
 
-    /* Determine tombstone strategy */
+    /* Determine tombstone strategy: probes walk aligned groups and stop at
+     * the first one holding an EMPTY byte. If this slot's group already has
+     * one, no probe ever passed through it and the slot can go back to
+     * EMPTY; otherwise some key may live further along, so leave a tombstone. */
     uint32_t cap = map->data.hashmap.capacity;
-    uint32_t group_mask = (cap / GROUP_WIDTH) - 1;
-    uint32_t next_group = (((uint32_t)idx / GROUP_WIDTH + 1) & group_mask) * GROUP_WIDTH;
-    GroupMask next_empty = guage_group_match_empty(map->data.hashmap.ctrl + next_group);
+    uint32_t own_group = ((uint32_t)idx / GROUP_WIDTH) * GROUP_WIDTH;
+    GroupMask group_empty = guage_group_match_empty(map->data.hashmap.ctrl + own_group);
 
-    if (next_empty) {
-        map->data.hashmap.ctrl[idx] = CTRL_EMPTY;
+    if (group_empty) {
+        hashmap_set_ctrl(map->data.hashmap.ctrl, cap, (uint32_t)idx, CTRL_EMPTY);
         map->data.hashmap.growth_left++;
     } else {
-        map->data.hashmap.ctrl[idx] = CTRL_DELETED;
-    }
-    if ((uint32_t)idx < (uint32_t)GROUP_WIDTH) {
-        map->data.hashmap.ctrl[cap + (uint32_t)idx] = map->data.hashmap.ctrl[idx];
+        hashmap_set_ctrl(map->data.hashmap.ctrl, cap, (uint32_t)idx, CTRL_DELETED);
     }
 
     map->data.hashmap.size--;
@@ -1720,8 +3504,8 @@ Cell* cell_hashmap_delete(Cell* map, Cell* key) {
 bool cell_hashmap_has(Cell* map, Cell* key) {
     assert(map->type == CELL_HASHMAP);
     if (map->data.hashmap.size == 0) return false;
-    uint64_t hash = cell_hash(key);
-    return hashmap_find(map, key, hash) >= 0;
+    uint64_t hash = cell_hash_with(key, map->data.hashmap.hash_family);
+    return hashmap_find(map, key, hash) >= 0 || hashmap_find_old(map, key, hash) >= 0;
 }
 
 uint32_t cell_hashmap_size(Cell* map) {
@@ -1731,6 +3515,7 @@ uint32_t cell_hashmap_size(Cell* map) {
 
 Cell* cell_hashmap_keys(Cell* map) {
     assert(map->type == CELL_HASHMAP);
+    cell_hashmap_settle(map);
     Cell* result = cell_nil();
     uint32_t cap = map->data.hashmap.capacity;
     uint8_t* ctrl = map->data.hashmap.ctrl;
@@ -1748,6 +3533,7 @@ Cell* cell_hashmap_keys(Cell* map) {
 
 Cell* cell_hashmap_values(Cell* map) {
     assert(map->type == CELL_HASHMAP);
+    cell_hashmap_settle(map);
     Cell* result = cell_nil();
     uint32_t cap = map->data.hashmap.capacity;
     uint8_t* ctrl = map->data.hashmap.ctrl;
@@ -1765,6 +3551,7 @@ Cell* cell_hashmap_values(Cell* map) {
 
 Cell* cell_hashmap_entries(Cell* map) {
     assert(map->type == CELL_HASHMAP);
+    cell_hashmap_settle(map);
     Cell* result = cell_nil();
     uint32_t cap = map->data.hashmap.capacity;
     uint8_t* ctrl = map->data.hashmap.ctrl;
@@ -1785,10 +3572,13 @@ Cell* cell_hashmap_entries(Cell* map) {
 Cell* cell_hashmap_merge(Cell* m1, Cell* m2) {
     assert(m1->type == CELL_HASHMAP);
     assert(m2->type == CELL_HASHMAP);
+    cell_hashmap_settle(m1);
+    cell_hashmap_settle(m2);
 
     /* Estimate capacity */
     uint32_t est = m1->data.hashmap.size + m2->data.hashmap.size;
-    Cell* result = cell_hashmap_new(est < (uint32_t)GROUP_WIDTH ? GROUP_WIDTH : est * 2);
+    Cell* result = cell_hashmap_new_with(est < (uint32_t)GROUP_WIDTH ? GROUP_WIDTH : est * 2,
+                                         (CellHashFamily)m1->data.hashmap.hash_family);
 
     /* Insert all from m1 */
     for (uint32_t i = 0; i < m1->data.hashmap.capacity; i++) {
@@ -1859,6 +3649,10 @@ bool cell_is_hashset(Cell* c) {
 }
 
 Cell* cell_hashset_new(uint32_t initial_n_groups) {
+    return cell_hashset_new_with(initial_n_groups, CELL_HASH_SIP);
+}
+
+Cell* cell_hashset_new_with(uint32_t initial_n_groups, CellHashFamily family) {
     if (initial_n_groups < 1) initial_n_groups = 1;
     /* Round up to power of 2 */
     uint32_t ng = 1;
@@ -1880,13 +3674,19 @@ Cell* cell_hashset_new(uint32_t initial_n_groups) {
     c->data.hashset.size = 0;
     c->data.hashset.n_groups = ng;
     c->data.hashset.ml_left = ng * 13;  /* 86.7% load factor (13/15) */
+    c->data.hashset.hash_family = (uint8_t)family;
 
     return c;
 }
 
-/* Internal: find element in set. Returns group*15+slot if found, -1 otherwise. */
-static int hashset_find(Cell* set, Cell* val, uint64_t hash) {
-    uint32_t ng = set->data.hashset.n_groups;
+/* Sets of at least this many groups drain into the doubled table a few
+ * groups per add/remove instead of rehashing everything in one step. */
+#define HASHSET_INCREMENTAL_MIN 64
+#define HASHSET_MIGRATE_GROUPS  2
+
+/* Internal: find element in one table. Returns group*15+slot if found, -1 otherwise. */
+static int hashset_probe(uint8_t* metadata, Cell** elements, uint32_t ng,
+                         Cell* val, uint64_t hash) {
     uint32_t group_mask = ng - 1;
     uint8_t tag = hs_tag(hash);
     uint32_t g = hs_group_index(hash, group_mask);
@@ -1897,13 +3697,13 @@ static int hashset_find(Cell* set, Cell* val, uint64_t hash) {
 
     while (1) {
         uint32_t gi = (g + probe_offset) & group_mask;
-        uint8_t* meta = hs_meta(set, gi);
+        uint8_t* meta = metadata + gi * HS_META_SIZE;
 
         /* SIMD match: find all slots with matching tag (mask out overflow byte) */
         GroupMask match = guage_group_match(meta, tag) & HS_MATCH_MASK;
         while (match) {
             int bit = guage_bitmask_next(&match);
-            if (bit < HS_GROUP_SLOTS && cell_equal(*hs_elem(set, gi, bit), val)) {
+            if (bit < HS_GROUP_SLOTS && cell_equal(elements[gi * HS_GROUP_SLOTS + bit], val)) {
                 return (int)(gi * HS_GROUP_SLOTS + bit);
             }
         }
@@ -1918,6 +3718,19 @@ static int hashset_find(Cell* set, Cell* val, uint64_t hash) {
     }
 }
 
+/* Internal: find element in the live table. Returns group*15+slot if found, -1 otherwise. */
+static int hashset_find(Cell* set, Cell* val, uint64_t hash) {
+    return hashset_probe(set->data.hashset.metadata, set->data.hashset.elements,
+                         set->data.hashset.n_groups, val, hash);
+}
+
+/* Internal: find element in the table still being drained, or -1 */
+static int hashset_find_old(Cell* set, Cell* val, uint64_t hash) {
+    if (!set->data.hashset.old_metadata) return -1;
+    return hashset_probe(set->data.hashset.old_metadata, set->data.hashset.old_elements,
+                         set->data.hashset.old_n_groups, val, hash);
+}
+
 /* Internal: find empty slot for insertion. Also sets overflow bits on bypassed groups. */
 static int hashset_find_insert_slot(Cell* set, uint64_t hash) {
     uint32_t ng = set->data.hashset.n_groups;
@@ -1947,6 +3760,53 @@ static int hashset_find_insert_slot(Cell* set, uint64_t hash) {
     }
 }
 
+/* Internal: move up to n_groups groups of the old table into the live one.
+ * Moved slots are emptied (the table is tombstone-free); the old arrays
+ * are freed after the last group. ml_left was charged for every element
+ * when the resize began. */
+static void hashset_migrate(Cell* set, uint32_t n_groups) {
+    uint8_t* ometa = set->data.hashset.old_metadata;
+    if (!ometa) return;
+    Cell** oelems = set->data.hashset.old_elements;
+    uint32_t ong = set->data.hashset.old_n_groups;
+    uint32_t g = set->data.hashset.migrate_group;
+    uint32_t end = (n_groups >= ong - g) ? ong : g + n_groups;
+
+    for (; g < end; g++) {
+        uint8_t* meta = ometa + g * HS_META_SIZE;
+        for (int s = 0; s < HS_GROUP_SLOTS; s++) {
+            if (meta[s] >= 2) {  /* Occupied slot */
+                Cell* elem = oelems[g * HS_GROUP_SLOTS + s];
+                uint64_t hash = cell_hash_with(elem, set->data.hashset.hash_family);
+                int slot = hashset_find_insert_slot(set, hash);
+                uint32_t tg = (uint32_t)slot / HS_GROUP_SLOTS;
+                int ts = slot % HS_GROUP_SLOTS;
+                hs_meta(set, tg)[ts] = hs_tag(hash);
+                *hs_elem(set, tg, ts) = elem;  /* Move pointer, no retain/release */
+                meta[s] = HS_TAG_EMPTY;
+                oelems[g * HS_GROUP_SLOTS + s] = NULL;
+            }
+        }
+    }
+
+    if (g >= ong) {
+        free(ometa);
+        free(oelems);
+        set->data.hashset.old_metadata = NULL;
+        set->data.hashset.old_elements = NULL;
+        set->data.hashset.old_n_groups = 0;
+        set->data.hashset.migrate_group = 0;
+    } else {
+        set->data.hashset.migrate_group = g;
+    }
+}
+
+/* Finish any incremental resize; whole-set walks call this first */
+void cell_hashset_settle(Cell* set) {
+    assert(set->type == CELL_SET);
+    hashset_migrate(set, UINT32_MAX);
+}
+
 /* Internal: resize (double n_groups) */
 static void hashset_resize(Cell* set, uint32_t new_ng) {
     uint32_t old_ng = set->data.hashset.n_groups;
@@ -1970,7 +3830,7 @@ static void hashset_resize(Cell* set, uint32_t new_ng) {
         for (int s = 0; s < HS_GROUP_SLOTS; s++) {
             if (meta[s] >= 2) {  /* Occupied slot */
                 Cell* elem = old_elems[g * HS_GROUP_SLOTS + s];
-                uint64_t hash = cell_hash(elem);
+                uint64_t hash = cell_hash_with(elem, set->data.hashset.hash_family);
                 int slot = hashset_find_insert_slot(set, hash);
                 uint32_t tg = (uint32_t)slot / HS_GROUP_SLOTS;
                 int ts = slot % HS_GROUP_SLOTS;
@@ -1984,18 +3844,45 @@ static void hashset_resize(Cell* set, uint32_t new_ng) {
     free(old_elems);
 }
 
+/* Internal: double the table once ml_left is exhausted. Large sets keep
+ * the old arrays and drain them incrementally. */
+static void hashset_grow(Cell* set) {
+    /* A drain still in progress must finish before the next one starts */
+    cell_hashset_settle(set);
+
+    uint32_t old_ng = set->data.hashset.n_groups;
+    uint32_t new_ng = old_ng * 2;
+    if (old_ng < HASHSET_INCREMENTAL_MIN) {
+        hashset_resize(set, new_ng);
+        return;
+    }
+
+    set->data.hashset.old_metadata = set->data.hashset.metadata;
+    set->data.hashset.old_elements = set->data.hashset.elements;
+    set->data.hashset.old_n_groups = old_ng;
+    set->data.hashset.migrate_group = 0;
+
+    set->data.hashset.metadata = (uint8_t*)aligned_alloc(16, new_ng * HS_META_SIZE);
+    memset(set->data.hashset.metadata, HS_TAG_EMPTY, new_ng * HS_META_SIZE);
+    set->data.hashset.elements = (Cell**)calloc(new_ng * HS_GROUP_SLOTS, sizeof(Cell*));
+    set->data.hashset.n_groups = new_ng;
+    set->data.hashset.ml_left = new_ng * 13 - set->data.hashset.size;
+}
+
 bool cell_hashset_add(Cell* set, Cell* val) {
     assert(set->type == CELL_SET);
-    uint64_t hash = cell_hash(val);
+    uint64_t hash = cell_hash_with(val, set->data.hashset.hash_family);
+
+    hashset_migrate(set, HASHSET_MIGRATE_GROUPS);
 
     /* Check if already present */
-    if (hashset_find(set, val, hash) >= 0) {
+    if (hashset_find(set, val, hash) >= 0 || hashset_find_old(set, val, hash) >= 0) {
         return false;  /* Already exists */
     }
 
     /* Resize if needed */
     if (set->data.hashset.ml_left == 0) {
-        hashset_resize(set, set->data.hashset.n_groups * 2);
+        hashset_grow(set);
     }
 
     /* Insert */
@@ -2013,9 +3900,20 @@ bool cell_hashset_add(Cell* set, Cell* val) {
 
 bool cell_hashset_remove(Cell* set, Cell* val) {
     assert(set->type == CELL_SET);
-    uint64_t hash = cell_hash(val);
+    uint64_t hash = cell_hash_with(val, set->data.hashset.hash_family);
+    hashset_migrate(set, HASHSET_MIGRATE_GROUPS);
     int idx = hashset_find(set, val, hash);
-    if (idx < 0) return false;  /* Not present */
+    if (idx < 0) {
+        /* Element not moved yet: clear it in the old table */
+        idx = hashset_find_old(set, val, hash);
+        if (idx < 0) return false;  /* Not present */
+        set->data.hashset.old_metadata[(uint32_t)idx / HS_GROUP_SLOTS * HS_META_SIZE
+                                       + idx % HS_GROUP_SLOTS] = HS_TAG_EMPTY;
+        cell_release(set->data.hashset.old_elements[idx]);
+        set->data.hashset.old_elements[idx] = NULL;
+        set->data.hashset.size--;
+        return true;
+    }
 
     uint32_t g = (uint32_t)idx / HS_GROUP_SLOTS;
     int s = idx % HS_GROUP_SLOTS;
@@ -2033,7 +3931,8 @@ bool cell_hashset_remove(Cell* set, Cell* val) {
 bool cell_hashset_has(Cell* set, Cell* val) {
     assert(set->type == CELL_SET);
     if (set->data.hashset.size == 0) return false;
-    return hashset_find(set, val, cell_hash(val)) >= 0;
+    uint64_t hash = cell_hash_with(val, set->data.hashset.hash_family);
+    return hashset_find(set, val, hash) >= 0 || hashset_find_old(set, val, hash) >= 0;
 }
 
 uint32_t cell_hashset_size(Cell* set) {
@@ -2043,6 +3942,7 @@ uint32_t cell_hashset_size(Cell* set) {
 
 Cell* cell_hashset_elements(Cell* set) {
     assert(set->type == CELL_SET);
+    cell_hashset_settle(set);
     Cell* result = cell_nil();
     uint32_t ng = set->data.hashset.n_groups;
     for (uint32_t g = 0; g < ng; g++) {
@@ -2062,10 +3962,12 @@ Cell* cell_hashset_elements(Cell* set) {
 
 Cell* cell_hashset_union(Cell* s1, Cell* s2) {
     assert(s1->type == CELL_SET && s2->type == CELL_SET);
+    cell_hashset_settle(s1);
+    cell_hashset_settle(s2);
     uint32_t est = s1->data.hashset.size + s2->data.hashset.size;
     uint32_t ng = 1;
     while (ng * 13 < est) ng <<= 1;
-    Cell* result = cell_hashset_new(ng);
+    Cell* result = cell_hashset_new_with(ng, (CellHashFamily)s1->data.hashset.hash_family);
 
     /* Add all from s1 */
     for (uint32_t g = 0; g < s1->data.hashset.n_groups; g++) {
@@ -2090,7 +3992,8 @@ Cell* cell_hashset_union(Cell* s1, Cell* s2) {
 
 Cell* cell_hashset_intersection(Cell* s1, Cell* s2) {
     assert(s1->type == CELL_SET && s2->type == CELL_SET);
-    Cell* result = cell_hashset_new(1);
+    cell_hashset_settle(s1);
+    Cell* result = cell_hashset_new_with(1, (CellHashFamily)s1->data.hashset.hash_family);
 
     /* Add elements from s1 that also exist in s2 */
     for (uint32_t g = 0; g < s1->data.hashset.n_groups; g++) {
@@ -2109,7 +4012,8 @@ Cell* cell_hashset_intersection(Cell* s1, Cell* s2) {
 
 Cell* cell_hashset_difference(Cell* s1, Cell* s2) {
     assert(s1->type == CELL_SET && s2->type == CELL_SET);
-    Cell* result = cell_hashset_new(1);
+    cell_hashset_settle(s1);
+    Cell* result = cell_hashset_new_with(1, (CellHashFamily)s1->data.hashset.hash_family);
 
     /* Add elements from s1 that do NOT exist in s2 */
     for (uint32_t g = 0; g < s1->data.hashset.n_groups; g++) {
@@ -2129,6 +4033,7 @@ Cell* cell_hashset_difference(Cell* s1, Cell* s2) {
 bool cell_hashset_subset(Cell* s1, Cell* s2) {
     assert(s1->type == CELL_SET && s2->type == CELL_SET);
     if (s1->data.hashset.size > s2->data.hashset.size) return false;
+    cell_hashset_settle(s1);
 
     for (uint32_t g = 0; g < s1->data.hashset.n_groups; g++) {
         uint8_t* meta = hs_meta(s1, g);
@@ -2507,6 +4412,7 @@ Cell* cell_vector_set(Cell* v, uint32_t idx, Cell* val) {
     Cell* old = buf[idx];
     buf[idx] = val;
     cell_retain(val);
+    v->data.vector.hash_memo_family = 0;
     /* Return old value — caller inherits the vector's reference */
     return old;
 }
@@ -2522,6 +4428,7 @@ void cell_vector_push(Cell* v, Cell* val) {
     buf[idx] = val;
     cell_retain(val);
     v->data.vector.size++;
+    v->data.vector.hash_memo_family = 0;
 }
 
 Cell* cell_vector_pop(Cell* v) {
@@ -2531,6 +4438,7 @@ Cell* cell_vector_pop(Cell* v) {
     Cell** buf = vec_buf(v);
     Cell* val = buf[v->data.vector.size];
     buf[v->data.vector.size] = NULL;
+    v->data.vector.hash_memo_family = 0;
     /* Caller inherits the vector's reference — no release here */
     return val;
 }
@@ -2787,21 +4695,25 @@ static SMPool* sm_pool_new(void) {
     p->free_list = (uint32_t*)malloc(SM_POOL_INIT * sizeof(uint32_t));
     p->free_count = 0;
     p->free_cap = SM_POOL_INIT;
+    memset(&p->retired, 0, sizeof(p->retired));
     return p;
 }
 
+/* Optimistic readers may still be walking the old array: it is retired, not
+ * freed. The new array is published before the larger capacity, so a reader
+ * that loads capacity first never indexes past the array it then loads. */
 static void sm_pool_grow(SMPool* p) {
     uint32_t new_cap = p->capacity * 2;
     SMNode* new_nodes = (SMNode*)aligned_alloc(64, new_cap * sizeof(SMNode));
     memcpy(new_nodes, p->nodes, p->capacity * sizeof(SMNode));
     memset(new_nodes + p->capacity, 0, (new_cap - p->capacity) * sizeof(SMNode));
-    free(p->nodes);
-    p->nodes = new_nodes;
+    retire_push(&p->retired, RETIRE_MEM, p->nodes);
+    __atomic_store_n(&p->nodes, new_nodes, __ATOMIC_RELEASE);
     /* Grow free list too */
     uint32_t* new_fl = (uint32_t*)realloc(p->free_list, new_cap * sizeof(uint32_t));
     p->free_list = new_fl;
     p->free_cap = new_cap;
-    p->capacity = new_cap;
+    __atomic_store_n(&p->capacity, new_cap, __ATOMIC_RELEASE);
 }
 
 static uint32_t sm_pool_alloc(SMPool* p) {
@@ -2823,16 +4735,8 @@ static uint32_t sm_pool_alloc(SMPool* p) {
     return idx;
 }
 
-static void sm_pool_free(SMPool* p, uint32_t idx) {
-    if (p->free_count >= p->free_cap) {
-        uint32_t new_cap = p->free_cap * 2;
-        p->free_list = (uint32_t*)realloc(p->free_list, new_cap * sizeof(uint32_t));
-        p->free_cap = new_cap;
-    }
-    p->free_list[p->free_count++] = idx;
-}
-
 static void sm_pool_destroy_impl(SMPool* p) {
+    retire_reclaim(&p->retired, true);
     free(p->nodes);
     free(p->free_list);
     free(p);
@@ -2888,6 +4792,9 @@ int cell_compare(Cell* a, Cell* b) {
         [CELL_PORT] = 24,
         [CELL_DIR] = 25,
         [CELL_FFI_PTR] = 26,
+        [CELL_PMAP] = 27,
+        [CELL_PSET] = 28,
+        [CELL_TABLE] = 29,
     };
 
     int ta = type_order[a->type];
@@ -2961,42 +4868,49 @@ static uint64_t cell_sort_key(Cell* c) {
 
 /* === B-tree search === */
 
-/* Find position of key in node (returns index where key should be).
- * If exact match found, *found is set to 1 and index points to the match. */
-static unsigned sm_node_find(SMPool* pool, uint32_t node_idx,
-                              uint64_t sk, Cell* key, int* found) {
-    SMNode* node = &pool->nodes[node_idx];
-    *found = 0;
+/* Tree order: sort key first, cell_compare breaks sort-key ties (the key is
+ * only a 7-byte prefix for strings/symbols, so ties are common). */
+static inline int sm_order(uint64_t ska, Cell* a, uint64_t skb, Cell* b) {
+    if (ska != skb) return (ska < skb) ? -1 : 1;
+    return cell_compare(a, b);
+}
+
+/* Lower bound: index of the first key >= (sk, key) in tree order.
+ * sm_rank16 skips every strictly smaller sort key; only the run of equal
+ * sort keys needs a full compare. *found is set on an exact match. */
+static unsigned sm_lower_bound(SMNode* node, uint64_t sk, Cell* key, int* found) {
     unsigned pos = sm_rank16(sk, node->sort_keys);
-    /* Check for exact match at pos-1 (rank gives count of keys < query) */
-    /* We need to check pos-1 and pos for sort_key ties */
-    for (unsigned i = (pos > 0 ? pos - 1 : 0); i < node->n_keys; i++) {
-        if (node->sort_keys[i] > sk) break;
-        if (node->sort_keys[i] == sk && cell_compare(node->keys[i], key) == 0) {
-            *found = 1;
-            return i;
+    *found = 0;
+    while (pos < node->n_keys && node->sort_keys[pos] == sk) {
+        int c = cell_compare(node->keys[pos], key);
+        if (c >= 0) {
+            *found = (c == 0);
+            break;
         }
+        pos++;
     }
     return pos;
 }
 
+/* Find position of key in node (returns index where key should be).
+ * If exact match found, *found is set to 1 and index points to the match. */
+static unsigned sm_node_find(SMPool* pool, uint32_t node_idx,
+                              uint64_t sk, Cell* key, int* found) {
+    return sm_lower_bound(&pool->nodes[node_idx], sk, key, found);
+}
+
 /* Search for key in B-tree, returns leaf node index and position.
- * If found, *found=1 and returned position is the key's index in the leaf. */
+ * If found, *found=1 and returned position is the key's index in the leaf.
+ * Separators are the greatest key of their left subtree, so a key equal to
+ * a separator descends left. */
 static uint32_t sm_search(SMPool* pool, uint32_t root, uint8_t height,
                            uint64_t sk, Cell* key, unsigned* pos, int* found) {
     uint32_t cur = root;
     *found = 0;
     for (uint8_t h = 0; h < height; h++) {
         SMNode* node = &pool->nodes[cur];
-        unsigned rank = sm_rank16(sk, node->sort_keys);
-        /* Check exact match in sort keys for early exit on internal nodes */
-        for (unsigned i = (rank > 0 ? rank - 1 : 0); i < node->n_keys; i++) {
-            if (node->sort_keys[i] > sk) break;
-            if (node->sort_keys[i] == sk && cell_compare(node->keys[i], key) == 0) {
-                rank = i;
-                break;
-            }
-        }
+        int hit;
+        unsigned rank = sm_lower_bound(node, sk, key, &hit);
         /* Prefetch next child */
         uint32_t child = node->children[rank];
         if (child != SM_NIL) {
@@ -3009,11 +4923,29 @@ static uint32_t sm_search(SMPool* pool, uint32_t root, uint8_t height,
     return cur;
 }
 
+/* Walk from the root to the leaf holding key, adding delta to the entry
+ * count of each child slot passed on the way */
+static void sm_adjust_counts(SMPool* pool, uint32_t root, uint8_t height,
+                             uint64_t sk, Cell* key, int32_t delta) {
+    uint32_t cur = root;
+    for (uint8_t h = 0; h < height; h++) {
+        SMNode* node = &pool->nodes[cur];
+        int hit;
+        unsigned rank = sm_lower_bound(node, sk, key, &hit);
+        node->counts[rank] += (uint32_t)delta;
+        cur = node->children[rank];
+    }
+}
+
 /* === B-tree split === */
 
-/* Split a full node into two, returning the median key/value and new node index */
+/* Split a full node into two, returning the separator and new node index.
+ * Leaves (B+ copy-up): the left leaf keeps [0..mid], the right gets the
+ * rest, and the left's last key is copied up as the separator — retained,
+ * since the parent now holds a reference of its own. Internal nodes move
+ * their median up. */
 static void sm_split(SMPool* pool, uint32_t node_idx, uint32_t* new_idx,
-                      Cell** median_key, Cell** median_val, uint64_t* median_sk) {
+                      Cell** median_key, uint64_t* median_sk) {
     SMNode* node = &pool->nodes[node_idx];
     uint8_t mid = BTREE_B / 2;  /* 8 */
 
@@ -3025,11 +4957,7 @@ static void sm_split(SMPool* pool, uint32_t node_idx, uint32_t* new_idx,
 
     *median_key = node->keys[mid];
     *median_sk = node->sort_keys[mid];
-    if (node->is_leaf) {
-        *median_val = node->values[mid];
-    } else {
-        *median_val = NULL;
-    }
+    if (node->is_leaf) cell_retain(*median_key);
 
     /* Copy upper half to new node */
     uint8_t right_start = mid + 1;
@@ -3044,10 +4972,18 @@ static void sm_split(SMPool* pool, uint32_t node_idx, uint32_t* new_idx,
     if (!node->is_leaf) {
         for (uint8_t i = 0; i <= right_count; i++) {
             new_node->children[i] = node->children[right_start + i];
+            new_node->counts[i] = node->counts[right_start + i];
+            node->children[right_start + i] = SM_NIL;
+            node->counts[right_start + i] = 0;
         }
     }
     new_node->n_keys = right_count;
-    node->n_keys = mid;
+    node->n_keys = node->is_leaf ? mid + 1 : mid;
+    for (uint8_t i = node->n_keys; i < BTREE_B; i++) {
+        node->sort_keys[i] = UINT64_MAX;
+        node->keys[i] = NULL;
+        if (node->is_leaf) node->values[i] = NULL;
+    }
 
     /* Maintain leaf chain */
     if (node->is_leaf) {
@@ -3060,10 +4996,19 @@ static void sm_split(SMPool* pool, uint32_t node_idx, uint32_t* new_idx,
     }
 }
 
-/* Insert into a non-full node (recursive) */
-static void sm_insert_nonfull(SMPool* pool, uint32_t node_idx,
-                               Cell* key, Cell* value, uint64_t sk,
-                               uint32_t* first_leaf, uint32_t* last_leaf);
+/* Entries under a node: its own keys for a leaf, the child counts summed
+ * for an internal node */
+static uint32_t sm_node_count(SMNode* node) {
+    if (node->is_leaf) return node->n_keys;
+    uint32_t total = 0;
+    for (uint8_t i = 0; i <= node->n_keys; i++) total += node->counts[i];
+    return total;
+}
+
+/* Insert into a non-full node (recursive); returns 1 if the key was new */
+static int sm_insert_nonfull(SMPool* pool, uint32_t node_idx,
+                              Cell* key, Cell* value, uint64_t sk,
+                              uint32_t* first_leaf, uint32_t* last_leaf);
 
 /* Insert key-value into leaf node at position pos, shifting right */
 static void sm_leaf_insert_at(SMNode* node, unsigned pos,
@@ -3082,24 +5027,30 @@ static void sm_leaf_insert_at(SMNode* node, unsigned pos,
     node->n_keys++;
 }
 
-/* Insert into internal node at position pos, with child split */
+/* Insert into internal node at position pos, with child split: children
+ * [pos] and [pos + 1] are the two halves, holding `left` and `right`
+ * entries */
 static void sm_internal_insert_at(SMNode* node, unsigned pos,
-                                    Cell* key, uint64_t sk, uint32_t right_child) {
+                                    Cell* key, uint64_t sk, uint32_t right_child,
+                                    uint32_t left, uint32_t right) {
     /* Shift right */
     for (int i = (int)node->n_keys - 1; i >= (int)pos; i--) {
         node->sort_keys[i + 1] = node->sort_keys[i];
         node->keys[i + 1] = node->keys[i];
         node->children[i + 2] = node->children[i + 1];
+        node->counts[i + 2] = node->counts[i + 1];
     }
     node->sort_keys[pos] = sk;
     node->keys[pos] = key;
     node->children[pos + 1] = right_child;
+    node->counts[pos] = left;
+    node->counts[pos + 1] = right;
     node->n_keys++;
 }
 
-static void sm_insert_nonfull(SMPool* pool, uint32_t node_idx,
-                               Cell* key, Cell* value, uint64_t sk,
-                               uint32_t* first_leaf, uint32_t* last_leaf) {
+static int sm_insert_nonfull(SMPool* pool, uint32_t node_idx,
+                              Cell* key, Cell* value, uint64_t sk,
+                              uint32_t* first_leaf, uint32_t* last_leaf) {
     SMNode* node = &pool->nodes[node_idx];
 
     if (node->is_leaf) {
@@ -3107,51 +5058,215 @@ static void sm_insert_nonfull(SMPool* pool, uint32_t node_idx,
         int found = 0;
         unsigned pos = sm_node_find(pool, node_idx, sk, key, &found);
         if (found) {
-            /* Overwrite value — release old, retain new */
+            /* Overwrite value — retire old (a reader may hold it), retain new */
             node = &pool->nodes[node_idx]; /* re-fetch */
             Cell* old_val = node->values[pos];
-            node->values[pos] = value;
             cell_retain(value);
-            cell_release(old_val);
-            return;
+            node->values[pos] = value;
+            retire_push(&pool->retired, RETIRE_CELL, old_val);
+            return 0;
         }
         sm_leaf_insert_at(node, pos, key, value, sk);
+        return 1;
     } else {
-        /* Internal node — find child */
-        unsigned pos = sm_rank16(sk, node->sort_keys);
-        /* Check for existing key in internal node (sort key ties) */
-        for (unsigned i = (pos > 0 ? pos - 1 : 0); i < node->n_keys; i++) {
-            if (node->sort_keys[i] > sk) break;
-            if (node->sort_keys[i] == sk && cell_compare(node->keys[i], key) == 0) {
-                /* Key exists — for B-tree we only store keys in leaves for simplicity */
-                /* Since our B-tree puts all data in leaves, go to child anyway */
-                break;
-            }
-        }
+        /* Internal node — find child (all data lives in the leaves) */
+        int hit;
+        unsigned pos = sm_lower_bound(node, sk, key, &hit);
         uint32_t child_idx = node->children[pos];
         SMNode* child = &pool->nodes[child_idx];
         if (child->n_keys == BTREE_B) {
             /* Child is full — split it */
             uint32_t new_idx;
             Cell* med_key;
-            Cell* med_val;
             uint64_t med_sk;
-            sm_split(pool, child_idx, &new_idx, &med_key, &med_val, &med_sk);
+            sm_split(pool, child_idx, &new_idx, &med_key, &med_sk);
             /* Re-fetch after potential realloc */
             node = &pool->nodes[node_idx];
-            /* Insert median into this node */
-            sm_internal_insert_at(node, pos, med_key, med_sk, new_idx);
+            /* Insert separator into this node */
+            uint32_t right = sm_node_count(&pool->nodes[new_idx]);
+            sm_internal_insert_at(node, pos, med_key, med_sk, new_idx,
+                                  node->counts[pos] - right, right);
             /* Update leaf chain boundaries */
             if (pool->nodes[new_idx].is_leaf && pool->nodes[new_idx].next_leaf == SM_NIL) {
                 *last_leaf = new_idx;
             }
             /* Decide which child to recurse into */
-            if (sk > med_sk || (sk == med_sk && cell_compare(key, med_key) > 0)) {
+            if (sm_order(sk, key, med_sk, med_key) > 0) {
                 child_idx = new_idx;
+                pos++;
             }
         }
-        sm_insert_nonfull(pool, child_idx, key, value, sk, first_leaf, last_leaf);
+        int added = sm_insert_nonfull(pool, child_idx, key, value, sk, first_leaf, last_leaf);
+        pool->nodes[node_idx].counts[pos] += added;
+        return added;
+    }
+}
+
+/* === Optimistic reads ===
+ * Point queries run without the lock against a snapshot of the node array.
+ * Any index or count they read may come from a half-finished write, so each
+ * step is bounds-checked and a bad one reports the view as torn; a result
+ * only counts if the sequence word did not move meanwhile. The cells found
+ * are retained after validation — writers retire, never free, what they
+ * unlink, so they are still alive. */
+
+typedef struct {
+    SMNode*  nodes;
+    uint32_t cap;
+} SMView;
+
+typedef struct {
+    Cell*    key;     /* Query key (lo for count-range) */
+    uint64_t sk;
+    Cell*    hi;      /* count-range upper bound */
+    uint64_t hi_sk;
+    uint32_t n;       /* nth index */
+} SMQuery;
+
+typedef struct {
+    Cell*    key;     /* Entry found (NULL: none) */
+    Cell*    value;
+    uint32_t count;   /* rank / count-range answer */
+} SMRead;
+
+/* Reader body over one view; false if the view was torn */
+typedef bool (*SMReadFn)(Cell* m, SMView* v, SMQuery* q, SMRead* out);
+
+static inline SMNode* sm_view_node(SMView* v, uint32_t idx) {
+    if (idx >= v->cap) return NULL;
+    SMNode* n = &v->nodes[idx];
+    return n->n_keys <= BTREE_B ? n : NULL;
+}
+
+/* Leaf for (sk, key) and the position in it; *below (optional) gets the
+ * entries in subtrees left of the path. NULL if the view is torn. */
+static SMNode* sm_view_descend(Cell* m, SMView* v, uint64_t sk, Cell* key,
+                               unsigned* pos, int* found, uint32_t* below) {
+    uint8_t height = m->data.sorted_map.height;
+    SMNode* node = sm_view_node(v, m->data.sorted_map.root_idx);
+    uint32_t n_below = 0;
+    for (uint8_t h = 0; node && h < height; h++) {
+        if (node->is_leaf) return NULL;
+        int hit;
+        unsigned p = sm_lower_bound(node, sk, key, &hit);
+        if (below)
+            for (unsigned i = 0; i < p; i++) n_below += node->counts[i];
+        node = sm_view_node(v, node->children[p]);
+    }
+    if (!node || !node->is_leaf) return NULL;
+    *pos = sm_lower_bound(node, sk, key, found);
+    if (below) *below = n_below;
+    return node;
+}
+
+static inline bool sm_view_entry(SMNode* node, unsigned i, SMRead* out) {
+    if (i >= BTREE_B) return false;
+    out->key = node->keys[i];
+    out->value = node->values[i];
+    return out->key && out->value;
+}
+
+/* First non-empty leaf from idx along the chain (prev or next); sets *leaf
+ * to NULL at the end of the chain. False if the view is torn. */
+static bool sm_view_chain(SMView* v, uint32_t idx, bool backward, SMNode** leaf) {
+    for (uint32_t steps = 0; steps <= v->cap; steps++) {
+        if (idx == SM_NIL) {
+            *leaf = NULL;
+            return true;
+        }
+        SMNode* n = sm_view_node(v, idx);
+        if (!n || !n->is_leaf) return false;
+        if (n->n_keys > 0) {
+            *leaf = n;
+            return true;
+        }
+        idx = backward ? n->prev_leaf : n->next_leaf;
     }
+    return false;
+}
+
+static SMRead sm_read(Cell* m, SMReadFn fn, SMQuery* q) {
+    SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
+    uint32_t* seq = &m->data.sorted_map.seq;
+    SMRead out;
+    bool done = false;
+    for (unsigned tries = 0; tries < OLC_RETRIES && !done; tries++) {
+        uint32_t ver = olc_read_begin(seq);
+        SMView v;
+        v.cap = __atomic_load_n(&pool->capacity, __ATOMIC_ACQUIRE);
+        v.nodes = __atomic_load_n(&pool->nodes, __ATOMIC_ACQUIRE);
+        memset(&out, 0, sizeof(out));
+        bool ok = fn(m, &v, q, &out);
+        done = olc_read_valid(seq, ver) && ok;
+    }
+    if (!done) {
+        /* Writers keep winning: read under the lock */
+        uint32_t ver = olc_lock(seq);
+        SMView v = { pool->nodes, pool->capacity };
+        memset(&out, 0, sizeof(out));
+        fn(m, &v, q, &out);
+        olc_unlock(seq, ver, false);
+    }
+    if (out.key) cell_retain(out.key);
+    if (out.value) cell_retain(out.value);
+    return out;
+}
+
+/* ⟨k v⟩ from a read (consumes its references), or NULL */
+static Cell* sm_read_pair(SMRead* r) {
+    if (!r->key) return NULL;
+    Cell* pair = cell_cons(r->key, r->value);
+    cell_release(r->key);
+    cell_release(r->value);
+    return pair;
+}
+
+static bool sm_rd_get(Cell* m, SMView* v, SMQuery* q, SMRead* out) {
+    unsigned pos;
+    int found;
+    SMNode* leaf = sm_view_descend(m, v, q->sk, q->key, &pos, &found, NULL);
+    if (!leaf) return false;
+    return !found || sm_view_entry(leaf, pos, out);
+}
+
+static bool sm_rd_floor(Cell* m, SMView* v, SMQuery* q, SMRead* out) {
+    unsigned pos;
+    int found;
+    SMNode* leaf = sm_view_descend(m, v, q->sk, q->key, &pos, &found, NULL);
+    if (!leaf) return false;
+    if (found) return sm_view_entry(leaf, pos, out);
+    /* pos is where key would be inserted — floor is at pos-1 */
+    if (pos > 0) return sm_view_entry(leaf, pos - 1, out);
+    /* Otherwise the last entry of the previous non-empty leaf */
+    SMNode* prev;
+    if (!sm_view_chain(v, leaf->prev_leaf, true, &prev)) return false;
+    return !prev || sm_view_entry(prev, prev->n_keys - 1u, out);
+}
+
+static bool sm_rd_ceiling(Cell* m, SMView* v, SMQuery* q, SMRead* out) {
+    unsigned pos;
+    int found;
+    SMNode* leaf = sm_view_descend(m, v, q->sk, q->key, &pos, &found, NULL);
+    if (!leaf) return false;
+    /* pos is the insertion point — ceiling is at pos */
+    if (pos < leaf->n_keys) return sm_view_entry(leaf, pos, out);
+    SMNode* next;
+    if (!sm_view_chain(v, leaf->next_leaf, false, &next)) return false;
+    return !next || sm_view_entry(next, 0, out);
+}
+
+static bool sm_rd_min(Cell* m, SMView* v, SMQuery* q, SMRead* out) {
+    (void)q;
+    SMNode* leaf;
+    if (!sm_view_chain(v, m->data.sorted_map.first_leaf, false, &leaf)) return false;
+    return !leaf || sm_view_entry(leaf, 0, out);
+}
+
+static bool sm_rd_max(Cell* m, SMView* v, SMQuery* q, SMRead* out) {
+    (void)q;
+    SMNode* leaf;
+    if (!sm_view_chain(v, m->data.sorted_map.last_leaf, true, &leaf)) return false;
+    return !leaf || sm_view_entry(leaf, leaf->n_keys - 1u, out);
 }
 
 /* === Public API === */
@@ -3172,6 +5287,8 @@ Cell* cell_sorted_map_new(void) {
     c->data.sorted_map.first_leaf = root;
     c->data.sorted_map.last_leaf = root;
     c->data.sorted_map.size = 0;
+    c->data.sorted_map.version = 0;
+    c->data.sorted_map.seq = 0;
     c->data.sorted_map.height = 0;
     return c;
 }
@@ -3180,6 +5297,7 @@ Cell* cell_sorted_map_put(Cell* m, Cell* key, Cell* value) {
     assert(m->type == CELL_SORTED_MAP);
     SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
     uint64_t sk = cell_sort_key(key);
+    uint32_t seq = olc_lock(&m->data.sorted_map.seq);
     uint32_t root = m->data.sorted_map.root_idx;
 
     /* Check if root is full */
@@ -3189,9 +5307,8 @@ Cell* cell_sorted_map_put(Cell* m, Cell* key, Cell* value) {
         uint32_t new_root = sm_pool_alloc(pool);
         uint32_t new_child;
         Cell* med_key;
-        Cell* med_val;
         uint64_t med_sk;
-        sm_split(pool, old_root, &new_child, &med_key, &med_val, &med_sk);
+        sm_split(pool, old_root, &new_child, &med_key, &med_sk);
         /* Re-fetch after potential realloc */
         SMNode* nr = &pool->nodes[new_root];
         nr->is_leaf = 0;
@@ -3200,6 +5317,8 @@ Cell* cell_sorted_map_put(Cell* m, Cell* key, Cell* value) {
         nr->keys[0] = med_key;
         nr->children[0] = old_root;
         nr->children[1] = new_child;
+        nr->counts[1] = sm_node_count(&pool->nodes[new_child]);
+        nr->counts[0] = m->data.sorted_map.size - nr->counts[1];
         for (int i = 2; i <= BTREE_B; i++) nr->children[i] = SM_NIL;
         nr->next_leaf = SM_NIL;
         nr->prev_leaf = SM_NIL;
@@ -3212,19 +5331,14 @@ Cell* cell_sorted_map_put(Cell* m, Cell* key, Cell* value) {
         root = new_root;
     }
 
-    /* Search BEFORE insert to determine if this is new or overwrite */
-    unsigned pos;
-    int found;
-    sm_search(pool, root, m->data.sorted_map.height, sk, key, &pos, &found);
-    int is_new = !found;
-
-    sm_insert_nonfull(pool, root, key, value, sk,
-                      &m->data.sorted_map.first_leaf,
-                      &m->data.sorted_map.last_leaf);
+    int is_new = sm_insert_nonfull(pool, root, key, value, sk,
+                                   &m->data.sorted_map.first_leaf,
+                                   &m->data.sorted_map.last_leaf);
 
     Cell* old_val = NULL;
     if (is_new) {
         m->data.sorted_map.size++;
+        m->data.sorted_map.version++;
         old_val = NULL;  /* New key inserted */
     } else {
         old_val = cell_nil();  /* Marker: key existed (overwrite) */
@@ -3244,34 +5358,24 @@ Cell* cell_sorted_map_put(Cell* m, Cell* key, Cell* value) {
     }
     m->data.sorted_map.last_leaf = leaf;
 
+    retire_reclaim(&pool->retired, false);
+    olc_unlock(&m->data.sorted_map.seq, seq, true);
     return old_val ? old_val : cell_nil();
 }
 
 Cell* cell_sorted_map_get(Cell* m, Cell* key) {
     assert(m->type == CELL_SORTED_MAP);
-    SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
-    uint64_t sk = cell_sort_key(key);
-    unsigned pos;
-    int found;
-    uint32_t leaf = sm_search(pool, m->data.sorted_map.root_idx,
-                               m->data.sorted_map.height, sk, key, &pos, &found);
-    if (found) {
-        Cell* val = pool->nodes[leaf].values[pos];
-        cell_retain(val);
-        return val;
-    }
-    return NULL; /* Not found */
+    SMQuery q = { .key = key, .sk = cell_sort_key(key) };
+    SMRead r = sm_read(m, sm_rd_get, &q);
+    if (r.key) cell_release(r.key);
+    return r.value; /* NULL: not found */
 }
 
 bool cell_sorted_map_has(Cell* m, Cell* key) {
-    assert(m->type == CELL_SORTED_MAP);
-    SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
-    uint64_t sk = cell_sort_key(key);
-    unsigned pos;
-    int found;
-    sm_search(pool, m->data.sorted_map.root_idx,
-              m->data.sorted_map.height, sk, key, &pos, &found);
-    return found != 0;
+    Cell* v = cell_sorted_map_get(m, key);
+    if (!v) return false;
+    cell_release(v);
+    return true;
 }
 
 uint32_t cell_sorted_map_size(Cell* m) {
@@ -3286,9 +5390,14 @@ Cell* cell_sorted_map_del(Cell* m, Cell* key) {
     uint64_t sk = cell_sort_key(key);
     unsigned pos;
     int found;
+    uint32_t seq = olc_lock(&m->data.sorted_map.seq);
     uint32_t leaf = sm_search(pool, m->data.sorted_map.root_idx,
                                m->data.sorted_map.height, sk, key, &pos, &found);
-    if (!found) return NULL;
+    if (!found) {
+        olc_unlock(&m->data.sorted_map.seq, seq, false);
+        return NULL;
+    }
+    sm_adjust_counts(pool, m->data.sorted_map.root_idx, m->data.sorted_map.height, sk, key, -1);
 
     SMNode* node = &pool->nodes[leaf];
     Cell* old_val = node->values[pos];
@@ -3305,24 +5414,18 @@ Cell* cell_sorted_map_del(Cell* m, Cell* key) {
     node->keys[node->n_keys] = NULL;
     node->values[node->n_keys] = NULL;
     m->data.sorted_map.size--;
-    cell_release(old_key);
-    /* old_val returned to caller — caller gets the reference */
-
-    /* If leaf is empty and it's not the root, we should remove it from the chain.
-     * For simplicity (and since rebalancing is complex), we leave empty leaves
-     * in place — they'll be garbage when the tree is freed. */
-    if (node->n_keys == 0 && m->data.sorted_map.size > 0) {
-        /* Unlink from leaf chain */
-        if (node->prev_leaf != SM_NIL)
-            pool->nodes[node->prev_leaf].next_leaf = node->next_leaf;
-        if (node->next_leaf != SM_NIL)
-            pool->nodes[node->next_leaf].prev_leaf = node->prev_leaf;
-        if (m->data.sorted_map.first_leaf == leaf)
-            m->data.sorted_map.first_leaf = node->next_leaf;
-        if (m->data.sorted_map.last_leaf == leaf)
-            m->data.sorted_map.last_leaf = node->prev_leaf;
-        sm_pool_free(pool, leaf);
-    }
+    m->data.sorted_map.version++;
+    /* The map's references wait out concurrent readers; the caller gets a
+     * fresh one to old_val */
+    cell_retain(old_val);
+    retire_push(&pool->retired, RETIRE_CELL, old_key);
+    retire_push(&pool->retired, RETIRE_CELL, old_val);
+    retire_reclaim(&pool->retired, false);
+    olc_unlock(&m->data.sorted_map.seq, seq, true);
+
+    /* No rebalancing: a leaf emptied here stays in the tree and on the leaf
+     * chain (its parent still routes to it, so it must not be freed or
+     * reused), and walks simply skip it. */
 
     return old_val;
 }
@@ -3333,6 +5436,7 @@ Cell* cell_sorted_map_keys(Cell* m) {
     SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
     /* Build list in reverse, then reverse */
     Cell* result = cell_nil();
+    uint32_t seq = olc_lock(&m->data.sorted_map.seq);
     uint32_t leaf = m->data.sorted_map.last_leaf;
     while (leaf != SM_NIL) {
         SMNode* node = &pool->nodes[leaf];
@@ -3346,6 +5450,7 @@ Cell* cell_sorted_map_keys(Cell* m) {
         }
         leaf = node->prev_leaf;
     }
+    olc_unlock(&m->data.sorted_map.seq, seq, false);
     return result;
 }
 
@@ -3354,6 +5459,7 @@ Cell* cell_sorted_map_values(Cell* m) {
     assert(m->type == CELL_SORTED_MAP);
     SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
     Cell* result = cell_nil();
+    uint32_t seq = olc_lock(&m->data.sorted_map.seq);
     uint32_t leaf = m->data.sorted_map.last_leaf;
     while (leaf != SM_NIL) {
         SMNode* node = &pool->nodes[leaf];
@@ -3367,6 +5473,7 @@ Cell* cell_sorted_map_values(Cell* m) {
         }
         leaf = node->prev_leaf;
     }
+    olc_unlock(&m->data.sorted_map.seq, seq, false);
     return result;
 }
 
@@ -3375,6 +5482,7 @@ Cell* cell_sorted_map_entries(Cell* m) {
     assert(m->type == CELL_SORTED_MAP);
     SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
     Cell* result = cell_nil();
+    uint32_t seq = olc_lock(&m->data.sorted_map.seq);
     uint32_t leaf = m->data.sorted_map.last_leaf;
     while (leaf != SM_NIL) {
         SMNode* node = &pool->nodes[leaf];
@@ -3393,35 +5501,194 @@ Cell* cell_sorted_map_entries(Cell* m) {
         }
         leaf = node->prev_leaf;
     }
+    olc_unlock(&m->data.sorted_map.seq, seq, false);
     return result;
 }
 
-/* Merge: build new sorted map from both m1 and m2 (m2 wins on conflict) */
+/* === Bulk load (bottom-up) === */
+
+/* Streams entries in ascending tree order into full leaves, then builds the
+ * internal levels over them: O(n) with no per-key descent or split, and
+ * every leaf but the last packed to BTREE_B. */
+typedef struct {
+    SMPool*   pool;
+    uint32_t  leaf;       /* Leaf being filled */
+    uint32_t* level;      /* Finished nodes of the level being built */
+    uint32_t  n_level;
+    uint32_t  cap_level;
+    uint32_t  size;
+} SMLoader;
+
+/* Make room for at least n nodes up front so loading never re-copies */
+static void sm_pool_reserve(SMPool* p, uint32_t n) {
+    while (p->capacity < n) sm_pool_grow(p);
+}
+
+static void sm_load_begin(SMLoader* ld, Cell* m, uint32_t expected) {
+    ld->pool = (SMPool*)m->data.sorted_map.node_pool;
+    sm_pool_reserve(ld->pool, expected / BTREE_B + expected / (BTREE_B * BTREE_B) + 2);
+    ld->leaf = m->data.sorted_map.root_idx;  /* The fresh map's empty leaf */
+    ld->cap_level = 16;
+    ld->level = (uint32_t*)malloc(ld->cap_level * sizeof(uint32_t));
+    ld->n_level = 0;
+    ld->size = 0;
+}
+
+static void sm_load_emit(SMLoader* ld, uint32_t idx) {
+    if (ld->n_level >= ld->cap_level) {
+        ld->cap_level *= 2;
+        ld->level = (uint32_t*)realloc(ld->level, ld->cap_level * sizeof(uint32_t));
+    }
+    ld->level[ld->n_level++] = idx;
+}
+
+/* Order of (sk, key) against the last loaded entry: <0, 0 (same key) or >0 */
+static int sm_load_order(SMLoader* ld, uint64_t sk, Cell* key) {
+    SMNode* leaf = &ld->pool->nodes[ld->leaf];
+    if (leaf->n_keys == 0) return 1;
+    return sm_order(sk, key, leaf->sort_keys[leaf->n_keys - 1], leaf->keys[leaf->n_keys - 1]);
+}
+
+/* Append an entry greater than every entry loaded so far (retains both) */
+static void sm_load_push(SMLoader* ld, uint64_t sk, Cell* key, Cell* value) {
+    SMNode* leaf = &ld->pool->nodes[ld->leaf];
+    if (leaf->n_keys == BTREE_B) {
+        uint32_t next = sm_pool_alloc(ld->pool);
+        leaf = &ld->pool->nodes[ld->leaf];  /* Re-fetch after possible realloc */
+        ld->pool->nodes[next].is_leaf = 1;
+        ld->pool->nodes[next].prev_leaf = ld->leaf;
+        leaf->next_leaf = next;
+        sm_load_emit(ld, ld->leaf);
+        ld->leaf = next;
+        leaf = &ld->pool->nodes[next];
+    }
+    sm_leaf_insert_at(leaf, leaf->n_keys, key, value, sk);
+    ld->size++;
+}
+
+/* Replace the value of the last loaded entry (duplicate key: later wins) */
+static void sm_load_overwrite(SMLoader* ld, Cell* value) {
+    SMNode* leaf = &ld->pool->nodes[ld->leaf];
+    Cell* old = leaf->values[leaf->n_keys - 1];
+    cell_retain(value);
+    leaf->values[leaf->n_keys - 1] = value;
+    cell_release(old);
+}
+
+/* Greatest key of a subtree: its rightmost leaf's last entry */
+static uint32_t sm_subtree_max(SMPool* pool, uint32_t idx) {
+    while (!pool->nodes[idx].is_leaf) {
+        SMNode* node = &pool->nodes[idx];
+        idx = node->children[node->n_keys];
+    }
+    return idx;
+}
+
+/* Build internal levels over the loaded leaves and install the tree in m */
+static void sm_load_finish(SMLoader* ld, Cell* m) {
+    SMPool* pool = ld->pool;
+    m->data.sorted_map.first_leaf = ld->n_level > 0 ? ld->level[0] : ld->leaf;
+    m->data.sorted_map.last_leaf = ld->leaf;
+    sm_load_emit(ld, ld->leaf);
+
+    uint8_t height = 0;
+    uint32_t* next_level = (uint32_t*)malloc(ld->n_level * sizeof(uint32_t));
+    while (ld->n_level > 1) {
+        /* Spread children evenly so no node ends up with a lone child */
+        uint32_t n = ld->n_level;
+        uint32_t n_nodes = (n + BTREE_B) / (BTREE_B + 1);
+        uint32_t base = n / n_nodes, extra = n % n_nodes, c = 0;
+        for (uint32_t g = 0; g < n_nodes; g++) {
+            uint32_t count = base + (g < extra ? 1 : 0);
+            uint32_t idx = sm_pool_alloc(pool);
+            SMNode* node = &pool->nodes[idx];
+            for (uint32_t j = 0; j < count; j++) {
+                uint32_t child = ld->level[c++];
+                node->children[j] = child;
+                node->counts[j] = sm_node_count(&pool->nodes[child]);
+                if (j + 1 < count) {
+                    SMNode* leaf = &pool->nodes[sm_subtree_max(pool, child)];
+                    node->keys[j] = leaf->keys[leaf->n_keys - 1];
+                    node->sort_keys[j] = leaf->sort_keys[leaf->n_keys - 1];
+                    cell_retain(node->keys[j]);
+                }
+            }
+            node->n_keys = (uint8_t)(count - 1);
+            next_level[g] = idx;
+        }
+        memcpy(ld->level, next_level, n_nodes * sizeof(uint32_t));
+        ld->n_level = n_nodes;
+        height++;
+    }
+    free(next_level);
+
+    m->data.sorted_map.root_idx = ld->level[0];
+    m->data.sorted_map.height = height;
+    m->data.sorted_map.size = ld->size;
+    free(ld->level);
+}
+
+/* Build a sorted map from entries already in ascending key order.
+ * Equal adjacent keys keep the later value. Returns NULL (nothing leaked)
+ * if the input is out of order. */
+Cell* cell_sorted_map_from_sorted(Cell** keys, Cell** values, uint32_t n) {
+    Cell* m = cell_sorted_map_new();
+    SMLoader ld;
+    sm_load_begin(&ld, m, n);
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t sk = cell_sort_key(keys[i]);
+        int ord = sm_load_order(&ld, sk, keys[i]);
+        if (ord < 0) {
+            sm_load_finish(&ld, m);
+            cell_release(m);
+            return NULL;
+        }
+        if (ord == 0) sm_load_overwrite(&ld, values[i]);
+        else sm_load_push(&ld, sk, keys[i], values[i]);
+    }
+    sm_load_finish(&ld, m);
+    return m;
+}
+
+/* Merge: build new sorted map from both m1 and m2 (m2 wins on conflict).
+ * Linear: walk both leaf chains in step and bulk-load the union. */
 Cell* cell_sorted_map_merge(Cell* m1, Cell* m2) {
     assert(m1->type == CELL_SORTED_MAP);
     assert(m2->type == CELL_SORTED_MAP);
     Cell* result = cell_sorted_map_new();
     SMPool* p1 = (SMPool*)m1->data.sorted_map.node_pool;
     SMPool* p2 = (SMPool*)m2->data.sorted_map.node_pool;
-
-    /* Insert all from m1 */
-    uint32_t leaf = m1->data.sorted_map.first_leaf;
-    while (leaf != SM_NIL) {
-        SMNode* node = &p1->nodes[leaf];
-        for (uint8_t i = 0; i < node->n_keys; i++) {
-            cell_sorted_map_put(result, node->keys[i], node->values[i]);
-        }
-        leaf = node->next_leaf;
-    }
-    /* Insert all from m2 (overwrites m1 on conflict) */
-    leaf = m2->data.sorted_map.first_leaf;
-    while (leaf != SM_NIL) {
-        SMNode* node = &p2->nodes[leaf];
-        for (uint8_t i = 0; i < node->n_keys; i++) {
-            cell_sorted_map_put(result, node->keys[i], node->values[i]);
+    SMLoader ld;
+    /* Both sources stay still for the walk; locked in address order */
+    Cell* first = m1 < m2 ? m1 : m2;
+    Cell* second = m1 < m2 ? m2 : m1;
+    uint32_t seq1 = olc_lock(&first->data.sorted_map.seq);
+    uint32_t seq2 = first != second ? olc_lock(&second->data.sorted_map.seq) : 0;
+    sm_load_begin(&ld, result, m1->data.sorted_map.size + m2->data.sorted_map.size);
+
+    uint32_t l1 = m1->data.sorted_map.first_leaf, l2 = m2->data.sorted_map.first_leaf;
+    unsigned i1 = 0, i2 = 0;
+    for (;;) {
+        /* Step over exhausted (or emptied) leaves */
+        while (l1 != SM_NIL && i1 >= p1->nodes[l1].n_keys) { l1 = p1->nodes[l1].next_leaf; i1 = 0; }
+        while (l2 != SM_NIL && i2 >= p2->nodes[l2].n_keys) { l2 = p2->nodes[l2].next_leaf; i2 = 0; }
+        if (l1 == SM_NIL && l2 == SM_NIL) break;
+        SMNode* a = l1 != SM_NIL ? &p1->nodes[l1] : NULL;
+        SMNode* b = l2 != SM_NIL ? &p2->nodes[l2] : NULL;
+        int c = !a ? 1 : !b ? -1
+              : sm_order(a->sort_keys[i1], a->keys[i1], b->sort_keys[i2], b->keys[i2]);
+        if (c < 0) {
+            sm_load_push(&ld, a->sort_keys[i1], a->keys[i1], a->values[i1]);
+            i1++;
+        } else {
+            sm_load_push(&ld, b->sort_keys[i2], b->keys[i2], b->values[i2]);
+            i2++;
+            if (c == 0) i1++;
         }
-        leaf = node->next_leaf;
     }
+    if (first != second) olc_unlock(&second->data.sorted_map.seq, seq2, false);
+    olc_unlock(&first->data.sorted_map.seq, seq1, false);
+    sm_load_finish(&ld, result);
     return result;
 }
 
@@ -3429,35 +5696,16 @@ Cell* cell_sorted_map_merge(Cell* m1, Cell* m2) {
 Cell* cell_sorted_map_min(Cell* m) {
     assert(m->type == CELL_SORTED_MAP);
     if (m->data.sorted_map.size == 0) return NULL;
-    SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
-    SMNode* node = &pool->nodes[m->data.sorted_map.first_leaf];
-    if (node->n_keys == 0) return NULL;
-    Cell* k = node->keys[0];
-    Cell* v = node->values[0];
-    cell_retain(k);
-    cell_retain(v);
-    Cell* pair = cell_cons(k, v);
-    cell_release(k);
-    cell_release(v);
-    return pair;
+    SMRead r = sm_read(m, sm_rd_min, NULL);
+    return sm_read_pair(&r);
 }
 
 /* Max: O(1) via last_leaf cache */
 Cell* cell_sorted_map_max(Cell* m) {
     assert(m->type == CELL_SORTED_MAP);
     if (m->data.sorted_map.size == 0) return NULL;
-    SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
-    SMNode* node = &pool->nodes[m->data.sorted_map.last_leaf];
-    if (node->n_keys == 0) return NULL;
-    uint8_t last = node->n_keys - 1;
-    Cell* k = node->keys[last];
-    Cell* v = node->values[last];
-    cell_retain(k);
-    cell_retain(v);
-    Cell* pair = cell_cons(k, v);
-    cell_release(k);
-    cell_release(v);
-    return pair;
+    SMRead r = sm_read(m, sm_rd_max, NULL);
+    return sm_read_pair(&r);
 }
 
 /* Range: return entries where lo <= key <= hi */
@@ -3470,6 +5718,7 @@ Cell* cell_sorted_map_range(Cell* m, Cell* lo, Cell* hi) {
     uint64_t lo_sk = cell_sort_key(lo);
     unsigned start_pos;
     int found;
+    uint32_t seq = olc_lock(&m->data.sorted_map.seq);
     uint32_t start_leaf = sm_search(pool, m->data.sorted_map.root_idx,
                                      m->data.sorted_map.height, lo_sk, lo, &start_pos, &found);
 
@@ -3503,7 +5752,8 @@ Cell* cell_sorted_map_range(Cell* m, Cell* lo, Cell* hi) {
         }
         leaf = nd->next_leaf;
     }
-range_done:;
+range_done:
+    olc_unlock(&m->data.sorted_map.seq, seq, false);
     /* Build list from items array (reverse to get sorted order) */
     Cell* result = cell_nil();
     for (int i = (int)item_count - 1; i >= 0; i--) {
@@ -3519,109 +5769,83 @@ range_done:;
 /* Floor: greatest key <= query */
 Cell* cell_sorted_map_floor(Cell* m, Cell* key) {
     assert(m->type == CELL_SORTED_MAP);
-    SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
     if (m->data.sorted_map.size == 0) return NULL;
-
-    uint64_t sk = cell_sort_key(key);
-    unsigned pos;
-    int found;
-    uint32_t leaf = sm_search(pool, m->data.sorted_map.root_idx,
-                               m->data.sorted_map.height, sk, key, &pos, &found);
-    SMNode* node = &pool->nodes[leaf];
-
-    if (found) {
-        /* Exact match */
-        Cell* k = node->keys[pos];
-        Cell* v = node->values[pos];
-        cell_retain(k);
-        cell_retain(v);
-        Cell* pair = cell_cons(k, v);
-        cell_release(k);
-        cell_release(v);
-        return pair;
-    }
-
-    /* pos is where key would be inserted — floor is at pos-1 */
-    if (pos > 0) {
-        Cell* k = node->keys[pos - 1];
-        Cell* v = node->values[pos - 1];
-        cell_retain(k);
-        cell_retain(v);
-        Cell* pair = cell_cons(k, v);
-        cell_release(k);
-        cell_release(v);
-        return pair;
-    }
-
-    /* Need to go to previous leaf */
-    if (node->prev_leaf != SM_NIL) {
-        SMNode* prev = &pool->nodes[node->prev_leaf];
-        if (prev->n_keys > 0) {
-            uint8_t last = prev->n_keys - 1;
-            Cell* k = prev->keys[last];
-            Cell* v = prev->values[last];
-            cell_retain(k);
-            cell_retain(v);
-            Cell* pair = cell_cons(k, v);
-            cell_release(k);
-            cell_release(v);
-            return pair;
-        }
-    }
-    return NULL; /* No floor exists */
+    SMQuery q = { .key = key, .sk = cell_sort_key(key) };
+    SMRead r = sm_read(m, sm_rd_floor, &q);
+    return sm_read_pair(&r);
 }
 
 /* Ceiling: least key >= query */
 Cell* cell_sorted_map_ceiling(Cell* m, Cell* key) {
     assert(m->type == CELL_SORTED_MAP);
-    SMPool* pool = (SMPool*)m->data.sorted_map.node_pool;
     if (m->data.sorted_map.size == 0) return NULL;
+    SMQuery q = { .key = key, .sk = cell_sort_key(key) };
+    SMRead r = sm_read(m, sm_rd_ceiling, &q);
+    return sm_read_pair(&r);
+}
 
-    uint64_t sk = cell_sort_key(key);
+/* === Order statistics (subtree counts) === */
+
+/* Entries ordered before key; with `inclusive`, key itself counts too.
+ * Each internal level adds the counts of the children left of the path. */
+static bool sm_view_rank(Cell* m, SMView* v, uint64_t sk, Cell* key,
+                         bool inclusive, uint32_t* rank) {
     unsigned pos;
     int found;
-    uint32_t leaf = sm_search(pool, m->data.sorted_map.root_idx,
-                               m->data.sorted_map.height, sk, key, &pos, &found);
-    SMNode* node = &pool->nodes[leaf];
+    uint32_t below;
+    if (!sm_view_descend(m, v, sk, key, &pos, &found, &below)) return false;
+    *rank = below + pos + (inclusive && found ? 1 : 0);
+    return true;
+}
 
-    if (found) {
-        Cell* k = node->keys[pos];
-        Cell* v = node->values[pos];
-        cell_retain(k);
-        cell_retain(v);
-        Cell* pair = cell_cons(k, v);
-        cell_release(k);
-        cell_release(v);
-        return pair;
-    }
+static bool sm_rd_rank(Cell* m, SMView* v, SMQuery* q, SMRead* out) {
+    return sm_view_rank(m, v, q->sk, q->key, false, &out->count);
+}
 
-    /* pos is insertion point — ceiling is at pos */
-    if (pos < node->n_keys) {
-        Cell* k = node->keys[pos];
-        Cell* v = node->values[pos];
-        cell_retain(k);
-        cell_retain(v);
-        Cell* pair = cell_cons(k, v);
-        cell_release(k);
-        cell_release(v);
-        return pair;
-    }
+static bool sm_rd_count_range(Cell* m, SMView* v, SMQuery* q, SMRead* out) {
+    uint32_t below, upto;
+    if (!sm_view_rank(m, v, q->sk, q->key, false, &below) ||
+        !sm_view_rank(m, v, q->hi_sk, q->hi, true, &upto))
+        return false;
+    out->count = upto > below ? upto - below : 0;
+    return true;
+}
 
-    /* Need to go to next leaf */
-    if (node->next_leaf != SM_NIL) {
-        SMNode* next = &pool->nodes[node->next_leaf];
-        if (next->n_keys > 0) {
-            Cell* k = next->keys[0];
-            Cell* v = next->values[0];
-            cell_retain(k);
-            cell_retain(v);
-            Cell* pair = cell_cons(k, v);
-            cell_release(k);
-            cell_release(v);
-            return pair;
-        }
+static bool sm_rd_nth(Cell* m, SMView* v, SMQuery* q, SMRead* out) {
+    uint32_t n = q->n;
+    if (n >= m->data.sorted_map.size) return true;
+    uint8_t height = m->data.sorted_map.height;
+    SMNode* node = sm_view_node(v, m->data.sorted_map.root_idx);
+    for (uint8_t h = 0; node && h < height; h++) {
+        if (node->is_leaf) return false;
+        unsigned i = 0;
+        while (i < node->n_keys && n >= node->counts[i]) n -= node->counts[i++];
+        node = sm_view_node(v, node->children[i]);
     }
-    return NULL;
+    if (!node || !node->is_leaf || n >= node->n_keys) return false;
+    return sm_view_entry(node, n, out);
+}
+
+/* Number of keys strictly less than key */
+uint32_t cell_sorted_map_rank(Cell* m, Cell* key) {
+    assert(m->type == CELL_SORTED_MAP);
+    SMQuery q = { .key = key, .sk = cell_sort_key(key) };
+    return sm_read(m, sm_rd_rank, &q).count;
+}
+
+/* Number of keys in [lo, hi] */
+uint32_t cell_sorted_map_count_range(Cell* m, Cell* lo, Cell* hi) {
+    assert(m->type == CELL_SORTED_MAP);
+    SMQuery q = { .key = lo, .sk = cell_sort_key(lo), .hi = hi, .hi_sk = cell_sort_key(hi) };
+    return sm_read(m, sm_rd_count_range, &q).count;
+}
+
+/* Entry ⟨k v⟩ at zero-based position n in key order, or NULL */
+Cell* cell_sorted_map_nth(Cell* m, uint32_t n) {
+    assert(m->type == CELL_SORTED_MAP);
+    SMQuery q = { .n = n };
+    SMRead r = sm_read(m, sm_rd_nth, &q);
+    return sm_read_pair(&r);
 }
 
 /* ===== ART (Adaptive Radix Tree) Trie Implementation ===== */
@@ -3702,7 +5926,7 @@ static void art_key_from_cell(Cell* c, uint8_t** out, uint32_t* len) {
             break;
         }
         case CELL_ATOM_NUMBER: {
-            static uint8_t nbuf[8];
+            static _Thread_local uint8_t nbuf[8];
             uint64_t sk = double_to_sortkey(c->data.atom.number);
             for (int i = 7; i >= 0; i--) { nbuf[7 - i] = (sk >> (i * 8)) & 0xFF; }
             *out = nbuf;
@@ -3711,7 +5935,7 @@ static void art_key_from_cell(Cell* c, uint8_t** out, uint32_t* len) {
         }
         default: {
             /* Generic: type tag byte + pointer bytes */
-            static uint8_t gbuf[9];
+            static _Thread_local uint8_t gbuf[9];
             gbuf[0] = (uint8_t)c->type;
             uintptr_t ptr = (uintptr_t)c;
             for (int i = 7; i >= 0; i--) { gbuf[8 - i] = (ptr >> (i * 8)) & 0xFF; }
@@ -3741,6 +5965,40 @@ static void art_free_leaf(ARTLeaf* leaf) {
     free(leaf);
 }
 
+/* Retire list of the trie being written (set by put/del for the call):
+ * nodes and leaves it unlinks wait for readers instead of being freed.
+ * Unset (building a private trie), they go at once. */
+static _Thread_local RetireList* tls_art_retire = NULL;
+
+static void art_retire_node(void* node) {
+    if (tls_art_retire) retire_push(tls_art_retire, RETIRE_MEM, node);
+    else free(node);
+}
+
+static void art_retire_leaf(ARTLeaf* leaf) {
+    if (tls_art_retire) retire_push(tls_art_retire, RETIRE_ART_LEAF, leaf);
+    else art_free_leaf(leaf);
+}
+
+static void art_retire_cell(Cell* c) {
+    if (tls_art_retire) retire_push(tls_art_retire, RETIRE_CELL, c);
+    else cell_release(c);
+}
+
+static void retire_free_entry(RetireEntry* e) {
+    switch ((RetireKind)e->kind) {
+        case RETIRE_MEM:      free(e->ptr); break;
+        case RETIRE_CELL:     cell_release((Cell*)e->ptr); break;
+        case RETIRE_ART_LEAF: art_free_leaf((ARTLeaf*)e->ptr); break;
+    }
+}
+
+/* Link a node or leaf where optimistic readers can reach it: its contents
+ * are visible before the pointer is */
+static inline void art_publish(void** slot, void* p) {
+    __atomic_store_n(slot, p, __ATOMIC_RELEASE);
+}
+
 static ARTNode4* art_new_node4(void) {
     ARTNode4* n = (ARTNode4*)calloc(1, sizeof(ARTNode4));
     n->hdr.type = ART_NODE4;
@@ -3772,12 +6030,16 @@ static ARTHeader* art_node_header(void* node) {
     return (ARTHeader*)node;
 }
 
+/* Also used by optimistic readers, which may see a node mid-update: counts
+ * and slots are clamped to the node's capacity so a torn read stays inside
+ * it (the caller's validation then rejects the result) */
 static void** art_find_child(void* node, uint8_t byte) {
     ARTHeader* hdr = art_node_header(node);
     switch (hdr->type) {
         case ART_NODE4: {
             ARTNode4* n = (ARTNode4*)node;
-            for (uint8_t i = 0; i < n->hdr.num_children; i++) {
+            uint8_t count = n->hdr.num_children < 4 ? n->hdr.num_children : 4;
+            for (uint8_t i = 0; i < count; i++) {
                 if (n->keys[i] == byte)
                     return &n->children[i];
             }
@@ -3785,14 +6047,15 @@ static void** art_find_child(void* node, uint8_t byte) {
         }
         case ART_NODE16: {
             ARTNode16* n = (ARTNode16*)node;
-            int idx = art_node16_find(n->keys, n->hdr.num_children, byte);
+            uint8_t count = n->hdr.num_children < 16 ? n->hdr.num_children : 16;
+            int idx = art_node16_find(n->keys, count, byte);
             if (idx >= 0) return &n->children[idx];
             return NULL;
         }
         case ART_NODE48: {
             ARTNode48* n = (ARTNode48*)node;
             uint8_t slot = n->child_index[byte];
-            if (slot != 0xFF) return &n->children[slot];
+            if (slot < 48) return &n->children[slot];
             return NULL;
         }
         case ART_NODE256: {
@@ -3808,6 +6071,8 @@ static void** art_find_child(void* node, uint8_t byte) {
 static uint32_t art_check_prefix(void* node, const uint8_t* key, uint32_t key_len, uint32_t depth) {
     ARTHeader* hdr = art_node_header(node);
     uint32_t max_cmp = hdr->prefix_len;
+    if (depth >= key_len)
+        return 0;
     if (key_len - depth < max_cmp)
         max_cmp = key_len - depth;
     uint32_t idx = 0;
@@ -3818,6 +6083,26 @@ static uint32_t art_check_prefix(void* node, const uint8_t* key, uint32_t key_le
     return idx;
 }
 
+static ARTLeaf* art_any_leaf(void* node);
+
+/* Match against the full logical prefix: bytes past the ART_MAX_PREFIX kept
+ * in the header are read back from any leaf below the node */
+static uint32_t art_prefix_mismatch(void* node, const uint8_t* key, uint32_t key_len, uint32_t depth) {
+    ARTHeader* hdr = art_node_header(node);
+    uint32_t idx = art_check_prefix(node, key, key_len, depth);
+    if (idx < hdr->prefix_len || hdr->full_prefix_len <= ART_MAX_PREFIX)
+        return idx;
+    ARTLeaf* leaf = art_any_leaf(node);
+    uint32_t max_cmp = hdr->full_prefix_len;
+    if (key_len - depth < max_cmp)
+        max_cmp = key_len - depth;
+    for (; idx < max_cmp; idx++) {
+        if (leaf->key[depth + idx] != key[depth + idx])
+            return idx;
+    }
+    return idx;
+}
+
 /* Leaf key matches? */
 static bool art_leaf_matches(ARTLeaf* leaf, const uint8_t* key, uint32_t key_len) {
     if (leaf->key_len != key_len) return false;
@@ -3840,7 +6125,7 @@ static void art_add_child4(ARTNode4* n, void** ref, uint8_t byte, void* child) {
         memmove(n->children + idx + 1, n->children + idx,
                 (n->hdr.num_children - idx) * sizeof(void*));
         n->keys[idx] = byte;
-        n->children[idx] = child;
+        art_publish(&n->children[idx], child);
         n->hdr.num_children++;
     } else {
         /* Grow to Node16 */
@@ -3856,8 +6141,8 @@ static void art_add_child4(ARTNode4* n, void** ref, uint8_t byte, void* child) {
         new_node->keys[idx] = byte;
         new_node->children[idx] = child;
         new_node->hdr.num_children = 5;
-        *ref = new_node;
-        free(n);
+        art_publish(ref, new_node);
+        art_retire_node(n);
     }
 }
 
@@ -3868,7 +6153,7 @@ static void art_add_child16(ARTNode16* n, void** ref, uint8_t byte, void* child)
         memmove(n->children + idx + 1, n->children + idx,
                 (n->hdr.num_children - idx) * sizeof(void*));
         n->keys[idx] = byte;
-        n->children[idx] = child;
+        art_publish(&n->children[idx], child);
         n->hdr.num_children++;
     } else {
         /* Grow to Node48 */
@@ -3882,16 +6167,18 @@ static void art_add_child16(ARTNode16* n, void** ref, uint8_t byte, void* child)
         new_node->child_index[byte] = 16;
         new_node->children[16] = child;
         new_node->hdr.num_children = 17;
-        *ref = new_node;
-        free(n);
+        art_publish(ref, new_node);
+        art_retire_node(n);
     }
 }
 
 static void art_add_child48(ARTNode48* n, void** ref, uint8_t byte, void* child) {
     if (n->hdr.num_children < 48) {
-        uint8_t pos = n->hdr.num_children;
+        /* Removals leave holes: take the first free slot */
+        uint8_t pos = 0;
+        while (n->children[pos]) pos++;
         n->child_index[byte] = pos;
-        n->children[pos] = child;
+        art_publish(&n->children[pos], child);
         n->hdr.num_children++;
     } else {
         /* Grow to Node256 */
@@ -3904,13 +6191,13 @@ static void art_add_child48(ARTNode48* n, void** ref, uint8_t byte, void* child)
         }
         new_node->children[byte] = child;
         new_node->hdr.num_children = 49;
-        *ref = new_node;
-        free(n);
+        art_publish(ref, new_node);
+        art_retire_node(n);
     }
 }
 
 static void art_add_child256(ARTNode256* n, uint8_t byte, void* child) {
-    n->children[byte] = child;
+    art_publish(&n->children[byte], child);
     n->hdr.num_children++;
 }
 
@@ -3956,11 +6243,15 @@ static void art_remove_child4(ARTNode4* n, void** ref, int idx) {
         child_hdr->prefix_len = (total <= ART_MAX_PREFIX) ? (uint8_t)total : ART_MAX_PREFIX;
         memcpy(child_hdr->prefix, new_prefix, child_hdr->prefix_len);
 
-        *ref = child;
-        free(n);
+        art_publish(ref, child);
+        art_retire_node(n);
         return;
     }
-    (void)ref;
+    /* A lone leaf needs no inner node: leaves carry their full key */
+    if (n->hdr.num_children == 1) {
+        art_publish(ref, n->children[0]);
+        art_retire_node(n);
+    }
 }
 
 static void art_remove_child16(ARTNode16* n, void** ref, int idx) {
@@ -3975,8 +6266,8 @@ static void art_remove_child16(ARTNode16* n, void** ref, int idx) {
         new_node->hdr.type = ART_NODE4;
         memcpy(new_node->keys, n->keys, n->hdr.num_children);
         memcpy(new_node->children, n->children, n->hdr.num_children * sizeof(void*));
-        *ref = new_node;
-        free(n);
+        art_publish(ref, new_node);
+        art_retire_node(n);
     }
 }
 
@@ -3998,8 +6289,8 @@ static void art_remove_child48(ARTNode48* n, void** ref, uint8_t byte) {
                 j++;
             }
         }
-        *ref = new_node;
-        free(n);
+        art_publish(ref, new_node);
+        art_retire_node(n);
     }
 }
 
@@ -4019,8 +6310,8 @@ static void art_remove_child256(ARTNode256* n, void** ref, uint8_t byte) {
                 slot++;
             }
         }
-        *ref = new_node;
-        free(n);
+        art_publish(ref, new_node);
+        art_retire_node(n);
     }
 }
 
@@ -4092,7 +6383,7 @@ static ARTLeaf* art_search(void* root, const uint8_t* key, uint32_t key_len) {
         uint8_t byte = (depth < key_len) ? key[depth] : 0;
         void** child = art_find_child(node, byte);
         if (!child) return NULL;
-        node = *child;
+        node = __atomic_load_n(child, __ATOMIC_ACQUIRE);
         depth++;
     }
     return NULL;
@@ -4106,7 +6397,7 @@ static int art_insert_recursive(void* node, void** ref,
     /* Empty tree → create leaf */
     if (!node) {
         ARTLeaf* leaf = art_make_leaf(key, key_len, value);
-        *ref = ART_SET_LEAF(leaf);
+        art_publish(ref, ART_SET_LEAF(leaf));
         return 1;
     }
 
@@ -4117,9 +6408,9 @@ static int art_insert_recursive(void* node, void** ref,
         /* Same key → update value */
         if (art_leaf_matches(existing, key, key_len)) {
             Cell* old_val = existing->value;
-            existing->value = value;
             cell_retain(value);
-            cell_release(old_val);
+            existing->value = value;
+            art_retire_cell(old_val);
             return 0;
         }
 
@@ -4150,7 +6441,7 @@ static int art_insert_recursive(void* node, void** ref,
         ARTLeaf* new_leaf = art_make_leaf(key, key_len, value);
         void* nref = new_node;
         art_add_child(new_node, &nref, new_byte, ART_SET_LEAF(new_leaf));
-        *ref = nref;
+        art_publish(ref, nref);
         return 1;
     }
 
@@ -4159,22 +6450,30 @@ static int art_insert_recursive(void* node, void** ref,
 
     /* Check prefix match */
     if (hdr->prefix_len > 0) {
-        uint32_t prefix_match = art_check_prefix(node, key, key_len, depth);
-        if (prefix_match != hdr->prefix_len) {
+        uint32_t prefix_match = art_prefix_mismatch(node, key, key_len, depth);
+        if (prefix_match != hdr->full_prefix_len) {
             /* Prefix mismatch → split node */
             ARTNode4* new_node = art_new_node4();
             new_node->hdr.prefix_len = (prefix_match <= ART_MAX_PREFIX) ? (uint8_t)prefix_match : ART_MAX_PREFIX;
             new_node->hdr.full_prefix_len = prefix_match;
-            memcpy(new_node->hdr.prefix, hdr->prefix,
+            memcpy(new_node->hdr.prefix, key + depth,
                    (prefix_match <= ART_MAX_PREFIX) ? prefix_match : ART_MAX_PREFIX);
 
             /* Old node as child at its divergent byte */
-            uint8_t old_byte = hdr->prefix[prefix_match];
-            uint32_t remaining = hdr->prefix_len - prefix_match - 1;
-            memmove(hdr->prefix, hdr->prefix + prefix_match + 1,
-                    (remaining <= ART_MAX_PREFIX) ? remaining : ART_MAX_PREFIX);
-            hdr->prefix_len = (remaining <= ART_MAX_PREFIX) ? (uint8_t)remaining : ART_MAX_PREFIX;
-            hdr->full_prefix_len -= (prefix_match + 1);
+            uint8_t old_byte;
+            uint32_t remaining = hdr->full_prefix_len - prefix_match - 1;
+            uint32_t keep = (remaining <= ART_MAX_PREFIX) ? remaining : ART_MAX_PREFIX;
+            if (hdr->full_prefix_len <= ART_MAX_PREFIX) {
+                old_byte = hdr->prefix[prefix_match];
+                memmove(hdr->prefix, hdr->prefix + prefix_match + 1, keep);
+            } else {
+                /* Header holds a truncated prefix: rebuild it from a leaf */
+                ARTLeaf* leaf = art_any_leaf(node);
+                old_byte = leaf->key[depth + prefix_match];
+                memcpy(hdr->prefix, leaf->key + depth + prefix_match + 1, keep);
+            }
+            hdr->prefix_len = (uint8_t)keep;
+            hdr->full_prefix_len = remaining;
 
             new_node->keys[0] = old_byte;
             new_node->children[0] = node;
@@ -4186,7 +6485,7 @@ static int art_insert_recursive(void* node, void** ref,
             ARTLeaf* new_leaf = art_make_leaf(key, key_len, value);
             void* nref = new_node;
             art_add_child(new_node, &nref, new_byte, ART_SET_LEAF(new_leaf));
-            *ref = nref;
+            art_publish(ref, nref);
             return 1;
         }
         depth += hdr->full_prefix_len;
@@ -4218,8 +6517,8 @@ static Cell* art_delete_recursive(void* node, void** ref,
         if (art_leaf_matches(leaf, key, key_len)) {
             Cell* val = leaf->value;
             cell_retain(val);
-            *ref = NULL;
-            art_free_leaf(leaf);
+            art_publish(ref, NULL);
+            art_retire_leaf(leaf);
             return val;
         }
         return NULL;
@@ -4247,7 +6546,7 @@ static Cell* art_delete_recursive(void* node, void** ref,
 
         Cell* val = leaf->value;
         cell_retain(val);
-        art_free_leaf(leaf);
+        art_retire_leaf(leaf);
 
         /* Remove child from this node */
         switch (hdr->type) {
@@ -4335,13 +6634,11 @@ static void* art_find_prefix_node(void* root, const uint8_t* prefix, uint32_t pr
 
         ARTHeader* hdr = art_node_header(node);
         if (hdr->prefix_len > 0) {
-            uint32_t max_cmp = hdr->prefix_len;
+            uint32_t max_cmp = hdr->full_prefix_len;
             if (prefix_len - depth < max_cmp)
                 max_cmp = prefix_len - depth;
-            for (uint32_t i = 0; i < max_cmp; i++) {
-                if (hdr->prefix[i] != prefix[depth + i])
-                    return NULL;
-            }
+            if (art_prefix_mismatch(node, prefix, prefix_len, depth) < max_cmp)
+                return NULL;
             depth += hdr->full_prefix_len;
             if (depth >= prefix_len) return node;
         }
@@ -4391,7 +6688,7 @@ static ARTLeaf* art_longest_prefix_match(void* root, const uint8_t* key, uint32_
 
         void** child = art_find_child(node, key[depth]);
         if (!child) break;
-        node = *child;
+        node = __atomic_load_n(child, __ATOMIC_ACQUIRE);
         depth++;
 
         /* If we landed on a leaf, check if it's a prefix match */
@@ -4474,9 +6771,44 @@ Cell* cell_trie_new(void) {
     Cell* c = cell_alloc(CELL_TRIE);
     c->data.trie.root = NULL;
     c->data.trie.size = 0;
+    c->data.trie.version = 0;
+    c->data.trie.seq = 0;
+    c->data.trie.retired = NULL;
     return c;
 }
 
+typedef ARTLeaf* (*art_lookup_fn)(void* root, const uint8_t* key, uint32_t key_len);
+
+/* Optimistic lookup (see the sorted map's sm_read): the leaf found is only
+ * trusted if no write overlapped. It stays allocated until this thread's
+ * next quiescent state even if deleted right after. */
+static ARTLeaf* art_read(Cell* t, art_lookup_fn fn, const uint8_t* key, uint32_t key_len) {
+    uint32_t* seq = &t->data.trie.seq;
+    for (unsigned tries = 0; tries < OLC_RETRIES; tries++) {
+        uint32_t v = olc_read_begin(seq);
+        ARTLeaf* leaf = fn(__atomic_load_n(&t->data.trie.root, __ATOMIC_ACQUIRE), key, key_len);
+        if (olc_read_valid(seq, v)) return leaf;
+    }
+    uint32_t v = olc_lock(seq);
+    ARTLeaf* leaf = fn(t->data.trie.root, key, key_len);
+    olc_unlock(seq, v, false);
+    return leaf;
+}
+
+/* Writer hold: ART helpers retire into the trie's list for the duration */
+static uint32_t art_write_begin(Cell* t) {
+    uint32_t v = olc_lock(&t->data.trie.seq);
+    if (!t->data.trie.retired) t->data.trie.retired = calloc(1, sizeof(RetireList));
+    tls_art_retire = (RetireList*)t->data.trie.retired;
+    return v;
+}
+
+static void art_write_end(Cell* t, uint32_t v, bool wrote) {
+    tls_art_retire = NULL;
+    retire_reclaim((RetireList*)t->data.trie.retired, false);
+    olc_unlock(&t->data.trie.seq, v, wrote);
+}
+
 bool cell_is_trie(Cell* c) {
     return c && c->type == CELL_TRIE;
 }
@@ -4486,7 +6818,7 @@ Cell* cell_trie_get(Cell* t, Cell* key) {
     uint8_t* kbytes;
     uint32_t klen;
     art_key_from_cell(key, &kbytes, &klen);
-    ARTLeaf* leaf = art_search(t->data.trie.root, kbytes, klen);
+    ARTLeaf* leaf = art_read(t, art_search, kbytes, klen);
     return leaf ? leaf->value : NULL;
 }
 
@@ -4495,9 +6827,14 @@ bool cell_trie_put(Cell* t, Cell* key, Cell* value) {
     uint8_t* kbytes;
     uint32_t klen;
     art_key_from_cell(key, &kbytes, &klen);
+    uint32_t seq = art_write_begin(t);
     int is_new = art_insert_recursive(t->data.trie.root, &t->data.trie.root,
                                        kbytes, klen, value, 0);
-    if (is_new) t->data.trie.size++;
+    if (is_new) {
+        t->data.trie.size++;
+        t->data.trie.version++;
+    }
+    art_write_end(t, seq, true);
     return (bool)is_new;
 }
 
@@ -4506,9 +6843,14 @@ Cell* cell_trie_del(Cell* t, Cell* key) {
     uint8_t* kbytes;
     uint32_t klen;
     art_key_from_cell(key, &kbytes, &klen);
+    uint32_t seq = art_write_begin(t);
     Cell* old = art_delete_recursive(t->data.trie.root, &t->data.trie.root,
                                       kbytes, klen, 0);
-    if (old) t->data.trie.size--;
+    if (old) {
+        t->data.trie.size--;
+        t->data.trie.version++;
+    }
+    art_write_end(t, seq, old != NULL);
     return old;
 }
 
@@ -4521,34 +6863,28 @@ uint32_t cell_trie_size(Cell* t) {
     return t->data.trie.size;
 }
 
+/* Whole-trie walk with writers held off */
+static void art_walk(Cell* t, art_iter_cb cb, void* ctx) {
+    uint32_t seq = olc_lock(&t->data.trie.seq);
+    art_iter_node(t->data.trie.root, cb, ctx);
+    olc_unlock(&t->data.trie.seq, seq, false);
+}
+
+/* Copy each leaf straight into the destination trie (no entry list) */
+static void art_copy_cb(ARTLeaf* leaf, void* ctx) {
+    Cell* dst = (Cell*)ctx;
+    if (art_insert_recursive(dst->data.trie.root, &dst->data.trie.root,
+                             leaf->key, leaf->key_len, leaf->value, 0))
+        dst->data.trie.size++;
+}
+
 Cell* cell_trie_merge(Cell* t1, Cell* t2) {
     Cell* result = cell_trie_new();
-    /* Copy all from t1 */
-    if (t1 && cell_is_trie(t1) && t1->data.trie.root) {
-        ARTIterCtx ctx = { .list = cell_nil(), .mode = 0 };
-        art_iter_node(t1->data.trie.root, art_collect_cb, &ctx);
-        Cell* entries = art_reverse_list(ctx.list);
-        Cell* cur = entries;
-        while (cur && cell_is_pair(cur)) {
-            Cell* pair = cell_car(cur);
-            cell_trie_put(result, cell_car(pair), cell_cdr(pair));
-            cur = cell_cdr(cur);
-        }
-        cell_release(entries);
-    }
-    /* Copy all from t2 (overwrites on conflict) */
-    if (t2 && cell_is_trie(t2) && t2->data.trie.root) {
-        ARTIterCtx ctx = { .list = cell_nil(), .mode = 0 };
-        art_iter_node(t2->data.trie.root, art_collect_cb, &ctx);
-        Cell* entries = art_reverse_list(ctx.list);
-        Cell* cur = entries;
-        while (cur && cell_is_pair(cur)) {
-            Cell* pair = cell_car(cur);
-            cell_trie_put(result, cell_car(pair), cell_cdr(pair));
-            cur = cell_cdr(cur);
-        }
-        cell_release(entries);
-    }
+    /* Copy all from t1, then t2 (overwrites on conflict) */
+    if (t1 && cell_is_trie(t1) && t1->data.trie.root)
+        art_walk(t1, art_copy_cb, result);
+    if (t2 && cell_is_trie(t2) && t2->data.trie.root)
+        art_walk(t2, art_copy_cb, result);
     return result;
 }
 
@@ -4558,24 +6894,29 @@ Cell* cell_trie_prefix_keys(Cell* t, Cell* prefix) {
     uint32_t plen;
     art_key_from_cell(prefix, &pbytes, &plen);
 
-    void* subtree = art_find_prefix_node(t->data.trie.root, pbytes, plen);
-    if (!subtree) return cell_nil();
-
+    uint32_t seq = olc_lock(&t->data.trie.seq);
     ARTIterCtx ctx = { .list = cell_nil(), .mode = 1 };
-    art_iter_node(subtree, art_prefix_keys_cb, &ctx);
+    void* subtree = art_find_prefix_node(t->data.trie.root, pbytes, plen);
+    if (subtree) art_iter_node(subtree, art_prefix_keys_cb, &ctx);
+    olc_unlock(&t->data.trie.seq, seq, false);
     return art_reverse_list(ctx.list);
 }
 
+static void art_count_cb(ARTLeaf* leaf, void* ctx) {
+    (void)leaf;
+    (*(uint32_t*)ctx)++;
+}
+
 uint32_t cell_trie_prefix_count(Cell* t, Cell* prefix) {
     if (!t || !cell_is_trie(t) || !t->data.trie.root) return 0;
-    Cell* keys = cell_trie_prefix_keys(t, prefix);
+    uint8_t* pbytes;
+    uint32_t plen;
+    art_key_from_cell(prefix, &pbytes, &plen);
+    uint32_t seq = olc_lock(&t->data.trie.seq);
+    void* subtree = art_find_prefix_node(t->data.trie.root, pbytes, plen);
     uint32_t count = 0;
-    Cell* cur = keys;
-    while (cur && cell_is_pair(cur)) {
-        count++;
-        cur = cell_cdr(cur);
-    }
-    cell_release(keys);
+    if (subtree) art_iter_node(subtree, art_count_cb, &count);
+    olc_unlock(&t->data.trie.seq, seq, false);
     return count;
 }
 
@@ -4584,7 +6925,7 @@ Cell* cell_trie_longest_prefix(Cell* t, Cell* query) {
     uint8_t* kbytes;
     uint32_t klen;
     art_key_from_cell(query, &kbytes, &klen);
-    ARTLeaf* leaf = art_longest_prefix_match(t->data.trie.root, kbytes, klen);
+    ARTLeaf* leaf = art_read(t, art_longest_prefix_match, kbytes, klen);
     if (!leaf) return NULL;
     return cell_symbol((const char*)leaf->key);
 }
@@ -4592,40 +6933,995 @@ Cell* cell_trie_longest_prefix(Cell* t, Cell* query) {
 Cell* cell_trie_entries(Cell* t) {
     if (!t || !cell_is_trie(t) || !t->data.trie.root) return cell_nil();
     ARTIterCtx ctx = { .list = cell_nil(), .mode = 0 };
-    art_iter_node(t->data.trie.root, art_collect_cb, &ctx);
+    art_walk(t, art_collect_cb, &ctx);
     return art_reverse_list(ctx.list);
 }
 
 Cell* cell_trie_keys(Cell* t) {
     if (!t || !cell_is_trie(t) || !t->data.trie.root) return cell_nil();
     ARTIterCtx ctx = { .list = cell_nil(), .mode = 1 };
-    art_iter_node(t->data.trie.root, art_collect_cb, &ctx);
+    art_walk(t, art_collect_cb, &ctx);
     return art_reverse_list(ctx.list);
 }
 
 Cell* cell_trie_values(Cell* t) {
     if (!t || !cell_is_trie(t) || !t->data.trie.root) return cell_nil();
     ARTIterCtx ctx = { .list = cell_nil(), .mode = 2 };
-    art_iter_node(t->data.trie.root, art_collect_cb, &ctx);
+    art_walk(t, art_collect_cb, &ctx);
     return art_reverse_list(ctx.list);
 }
 
 /* =========================================================================
- * Iterator (⊣) — Morsel-Driven Batch Iteration (Day 118)
+ * Persistent Map / Set (⊞ᵖ ⊡ᵖ) — CHAMP
+ *
+ * Compressed Hash-Array Mapped Prefix-tree (Steindorfer & Vinju, 2015):
+ * 32-way nodes indexed by 5 hash bits per level, with two bitmaps — one
+ * for inline key/value entries, one for sub-nodes — so a node stores only
+ * what is present. Inline entries come first, sub-nodes last; deletes
+ * re-inline a sub-node left with a single entry, so equal contents always
+ * give the same shape. Below the 64 hash bits, collision nodes hold a flat
+ * list.
+ *
+ * Nodes are never modified once another version can see them. An update
+ * copies the path from the root to the changed slot (≤ 13 nodes) and the
+ * new version shares every other node with the old one. Readers touch no
+ * reference counts at all; node counts are only bumped by path copies, so
+ * a map handed to another scheduler is read without any RC traffic.
+ *
+ * Transients (Clojure-style): every node carries the edit token of the
+ * operation that created it. A transient owns a unique token and edits
+ * nodes stamped with it in place; anything else is copied once, then owned.
+ * A persistent update is the same code run under a fresh one-shot token.
  * ========================================================================= */
 
-bool cell_is_iterator(Cell* c) {
-    return c && c->type == CELL_ITERATOR;
+#define CHAMP_BITS       5
+#define CHAMP_MASK       31u
+#define CHAMP_MAX_SHIFT  60   /* Last level that still has hash bits */
+
+typedef struct ChampNode {
+    _Atomic uint32_t rc;       /* Versions / parents sharing this node */
+    uint32_t datamap;          /* Bitmap of inline entries (collision: entry count) */
+    uint32_t nodemap;          /* Bitmap of sub-nodes (collision: 0) */
+    bool     collision;        /* Flat entry list for keys with equal hashes */
+    uint64_t edit;             /* Token of the operation that owns it */
+    void*    slots[];          /* 2 × entries (key, value), then sub-nodes */
+} ChampNode;
+
+static _Atomic uint64_t g_champ_edit = 0;
+
+static inline uint64_t champ_new_edit(void) {
+    return atomic_fetch_add_explicit(&g_champ_edit, 1, memory_order_relaxed) + 1;
 }
 
-/* --- Batch fill functions (one per source kind) --- */
+static inline uint32_t champ_n_data(const ChampNode* n) {
+    return n->collision ? n->datamap : (uint32_t)__builtin_popcount(n->datamap);
+}
 
-static uint16_t fill_list(Cell* it, IterBatch* b) {
-    IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
-    Cell* cur = d->state.list.current;
-    uint16_t n = 0;
-    while (n < ITER_BATCH_CAP && cur && cell_is_pair(cur)) {
-        Cell* elem = cell_car(cur);
+static inline uint32_t champ_n_nodes(const ChampNode* n) {
+    return n->collision ? 0 : (uint32_t)__builtin_popcount(n->nodemap);
+}
+
+static inline uint32_t champ_index(uint32_t bitmap, uint32_t bit) {
+    return (uint32_t)__builtin_popcount(bitmap & (bit - 1));
+}
+
+#define CHAMP_KEY(n, i)    ((Cell*)(n)->slots[2 * (i)])
+#define CHAMP_VAL(n, i)    ((Cell*)(n)->slots[2 * (i) + 1])
+#define CHAMP_CHILD(n, i)  ((ChampNode**)&(n)->slots[2 * champ_n_data(n) + (i)])
+
+static ChampNode* champ_alloc(uint32_t n_data, uint32_t n_nodes, uint64_t edit) {
+    ChampNode* n = (ChampNode*)malloc(sizeof(ChampNode) +
+                                      (2 * n_data + n_nodes) * sizeof(void*));
+    atomic_init(&n->rc, 1);
+    n->datamap = 0;
+    n->nodemap = 0;
+    n->collision = false;
+    n->edit = edit;
+    return n;
+}
+
+static void champ_node_release(ChampNode* n) {
+    if (!n) return;
+    if (atomic_fetch_sub_explicit(&n->rc, 1, memory_order_acq_rel) != 1) return;
+    uint32_t nd = champ_n_data(n), nn = champ_n_nodes(n);
+    for (uint32_t i = 0; i < nd; i++) {
+        cell_release(CHAMP_KEY(n, i));
+        cell_release(CHAMP_VAL(n, i));
+    }
+    for (uint32_t i = 0; i < nn; i++) champ_node_release(*CHAMP_CHILD(n, i));
+    free(n);
+}
+
+/* Take the caller's reference to n and return a node the edit may change
+ * in place: n itself if the edit owns it (or nobody else can see it),
+ * otherwise a copy stamped with the edit. */
+static ChampNode* champ_editable(ChampNode* n, uint64_t edit) {
+    if (n->edit == edit) return n;
+    if (atomic_load_explicit(&n->rc, memory_order_acquire) == 1) {
+        n->edit = edit;
+        return n;
+    }
+    uint32_t nd = champ_n_data(n), nn = champ_n_nodes(n);
+    ChampNode* c = champ_alloc(nd, nn, edit);
+    c->datamap = n->datamap;
+    c->nodemap = n->nodemap;
+    c->collision = n->collision;
+    memcpy(c->slots, n->slots, (2 * nd + nn) * sizeof(void*));
+    for (uint32_t i = 0; i < nd; i++) {
+        cell_retain(CHAMP_KEY(c, i));
+        cell_retain(CHAMP_VAL(c, i));
+    }
+    for (uint32_t i = 0; i < nn; i++)
+        atomic_fetch_add_explicit(&(*CHAMP_CHILD(c, i))->rc, 1, memory_order_relaxed);
+    champ_node_release(n);
+    return c;
+}
+
+/* Reshape an editable node: drop inline entry `del_at` and/or sub-node
+ * `node_del_at`, insert an entry at `add_at` and/or a sub-node at
+ * `node_add_at` (UINT32_MAX = none). Moved slots keep their references;
+ * the old node is freed, so this is only valid on nodes the edit owns. */
+static ChampNode* champ_reshape(ChampNode* n, uint32_t del_at, uint32_t add_at,
+                                Cell* key, Cell* value,
+                                uint32_t node_del_at, uint32_t node_add_at,
+                                ChampNode* child) {
+    uint32_t nd = champ_n_data(n), nn = champ_n_nodes(n);
+    uint32_t nd2 = nd - (del_at != UINT32_MAX) + (add_at != UINT32_MAX);
+    uint32_t nn2 = nn - (node_del_at != UINT32_MAX) + (node_add_at != UINT32_MAX);
+    ChampNode* m = champ_alloc(nd2, nn2, n->edit);
+    m->datamap = n->datamap;     /* Callers fix up the bitmaps */
+    m->nodemap = n->nodemap;
+    m->collision = n->collision;
+
+    uint32_t o = 0;
+    for (uint32_t i = 0; i <= nd; i++) {
+        if (i == add_at) {
+            m->slots[2 * o] = key;
+            m->slots[2 * o + 1] = value;
+            o++;
+        }
+        if (i < nd && i != del_at) {
+            m->slots[2 * o] = n->slots[2 * i];
+            m->slots[2 * o + 1] = n->slots[2 * i + 1];
+            o++;
+        }
+    }
+    void** src = &n->slots[2 * nd];
+    void** dst = &m->slots[2 * nd2];
+    o = 0;
+    for (uint32_t i = 0; i <= nn; i++) {
+        if (i == node_add_at) dst[o++] = child;
+        if (i < nn && i != node_del_at) dst[o++] = src[i];
+    }
+    free(n);
+    return m;
+}
+
+static inline uint32_t champ_bit(uint64_t hash, uint32_t shift) {
+    return 1u << ((hash >> shift) & CHAMP_MASK);
+}
+
+/* Smallest subtree holding two distinct keys (references are retained) */
+static ChampNode* champ_pair(Cell* k0, Cell* v0, uint64_t h0,
+                             Cell* k1, Cell* v1, uint64_t h1,
+                             uint32_t shift, uint64_t edit) {
+    ChampNode* n;
+    if (shift > CHAMP_MAX_SHIFT) {
+        n = champ_alloc(2, 0, edit);
+        n->collision = true;
+        n->datamap = 2;
+        n->slots[0] = k0; n->slots[1] = v0;
+        n->slots[2] = k1; n->slots[3] = v1;
+    } else {
+        uint32_t b0 = champ_bit(h0, shift), b1 = champ_bit(h1, shift);
+        if (b0 == b1) {
+            n = champ_alloc(0, 1, edit);
+            n->nodemap = b0;
+            n->slots[0] = champ_pair(k0, v0, h0, k1, v1, h1, shift + CHAMP_BITS, edit);
+            return n;
+        }
+        n = champ_alloc(2, 0, edit);
+        n->datamap = b0 | b1;
+        int first = b0 < b1 ? 0 : 2;
+        n->slots[first] = k0;     n->slots[first + 1] = v0;
+        n->slots[2 - first] = k1; n->slots[3 - first] = v1;
+    }
+    cell_retain(k0); cell_retain(v0);
+    cell_retain(k1); cell_retain(v1);
+    return n;
+}
+
+/* Entry slot holding key, or NULL */
+static void** champ_find(ChampNode* n, Cell* key, uint64_t hash) {
+    uint32_t shift = 0;
+    while (n) {
+        if (n->collision) {
+            for (uint32_t i = 0; i < n->datamap; i++)
+                if (cell_equal(CHAMP_KEY(n, i), key)) return &n->slots[2 * i];
+            return NULL;
+        }
+        uint32_t bit = champ_bit(hash, shift);
+        if (n->datamap & bit) {
+            void** slot = &n->slots[2 * champ_index(n->datamap, bit)];
+            return cell_equal((Cell*)slot[0], key) ? slot : NULL;
+        }
+        if (!(n->nodemap & bit)) return NULL;
+        n = *CHAMP_CHILD(n, champ_index(n->nodemap, bit));
+        shift += CHAMP_BITS;
+    }
+    return NULL;
+}
+
+/* Insert or overwrite; the caller has checked that this changes the map.
+ * Takes the caller's reference to n and returns the updated node. */
+static ChampNode* champ_put(ChampNode* n, Cell* key, Cell* value, uint64_t hash,
+                            uint32_t shift, uint64_t edit) {
+    n = champ_editable(n, edit);
+    if (n->collision) {
+        for (uint32_t i = 0; i < n->datamap; i++) {
+            if (cell_equal(CHAMP_KEY(n, i), key)) {
+                cell_retain(value);
+                cell_release(CHAMP_VAL(n, i));
+                n->slots[2 * i + 1] = value;
+                return n;
+            }
+        }
+        cell_retain(key); cell_retain(value);
+        n = champ_reshape(n, UINT32_MAX, n->datamap, key, value,
+                          UINT32_MAX, UINT32_MAX, NULL);
+        n->datamap++;
+        return n;
+    }
+
+    uint32_t bit = champ_bit(hash, shift);
+    if (n->datamap & bit) {
+        uint32_t i = champ_index(n->datamap, bit);
+        Cell* k0 = CHAMP_KEY(n, i);
+        if (cell_equal(k0, key)) {
+            cell_retain(value);
+            cell_release(CHAMP_VAL(n, i));
+            n->slots[2 * i + 1] = value;
+            return n;
+        }
+        /* Push both entries one level down */
+        Cell* v0 = CHAMP_VAL(n, i);
+        ChampNode* sub = champ_pair(k0, v0, cell_hash(k0), key, value, hash,
+                                    shift + CHAMP_BITS, edit);
+        cell_release(k0);
+        cell_release(v0);
+        uint32_t nodemap = n->nodemap | bit;
+        n = champ_reshape(n, i, UINT32_MAX, NULL, NULL,
+                          UINT32_MAX, champ_index(nodemap, bit), sub);
+        n->datamap &= ~bit;
+        n->nodemap = nodemap;
+        return n;
+    }
+    if (n->nodemap & bit) {
+        ChampNode** child = CHAMP_CHILD(n, champ_index(n->nodemap, bit));
+        *child = champ_put(*child, key, value, hash, shift + CHAMP_BITS, edit);
+        return n;
+    }
+    cell_retain(key); cell_retain(value);
+    uint32_t datamap = n->datamap | bit;
+    n = champ_reshape(n, UINT32_MAX, champ_index(datamap, bit), key, value,
+                      UINT32_MAX, UINT32_MAX, NULL);
+    n->datamap = datamap;
+    return n;
+}
+
+/* Remove a key the caller has found. Takes the reference to n. */
+static ChampNode* champ_del(ChampNode* n, Cell* key, uint64_t hash,
+                            uint32_t shift, uint64_t edit) {
+    n = champ_editable(n, edit);
+    if (n->collision) {
+        for (uint32_t i = 0; i < n->datamap; i++) {
+            if (cell_equal(CHAMP_KEY(n, i), key)) {
+                cell_release(CHAMP_KEY(n, i));
+                cell_release(CHAMP_VAL(n, i));
+                n = champ_reshape(n, i, UINT32_MAX, NULL, NULL,
+                                  UINT32_MAX, UINT32_MAX, NULL);
+                n->datamap--;
+                return n;
+            }
+        }
+        return n;
+    }
+
+    uint32_t bit = champ_bit(hash, shift);
+    if (n->datamap & bit) {
+        uint32_t i = champ_index(n->datamap, bit);
+        cell_release(CHAMP_KEY(n, i));
+        cell_release(CHAMP_VAL(n, i));
+        n = champ_reshape(n, i, UINT32_MAX, NULL, NULL,
+                          UINT32_MAX, UINT32_MAX, NULL);
+        n->datamap &= ~bit;
+        return n;
+    }
+
+    uint32_t j = champ_index(n->nodemap, bit);
+    ChampNode* child = champ_del(*CHAMP_CHILD(n, j), key, hash, shift + CHAMP_BITS, edit);
+    if (champ_n_nodes(child) == 0 && champ_n_data(child) == 1) {
+        /* Canonical form: a lone entry moves back up into its parent */
+        Cell* k = CHAMP_KEY(child, 0);
+        Cell* v = CHAMP_VAL(child, 0);
+        cell_retain(k); cell_retain(v);
+        champ_node_release(child);
+        uint32_t datamap = n->datamap | bit;
+        n = champ_reshape(n, UINT32_MAX, champ_index(datamap, bit), k, v,
+                          j, UINT32_MAX, NULL);
+        n->datamap = datamap;
+        n->nodemap &= ~bit;
+        return n;
+    }
+    *CHAMP_CHILD(n, j) = child;
+    return n;
+}
+
+typedef struct {
+    Cell* list;
+    int   mode;   /* 0 = ⟨k v⟩ entries, 1 = keys, 2 = values */
+} ChampCollect;
+
+static void champ_collect(ChampNode* n, ChampCollect* cc) {
+    uint32_t nn = champ_n_nodes(n);
+    for (uint32_t i = nn; i-- > 0; ) champ_collect(*CHAMP_CHILD(n, i), cc);
+    for (uint32_t i = champ_n_data(n); i-- > 0; ) {
+        Cell* k = CHAMP_KEY(n, i);
+        Cell* v = CHAMP_VAL(n, i);
+        Cell* item;
+        if (cc->mode == 0) item = cell_cons(k, v ? v : cell_nil());
+        else if (cc->mode == 1) { item = k; cell_retain(k); }
+        else { item = v ? v : cell_nil(); if (v) cell_retain(v); }
+        Cell* next = cell_cons(item, cc->list);
+        cell_release(item);
+        cell_release(cc->list);
+        cc->list = next;
+    }
+}
+
+static Cell* champ_new_cell(CellType type, ChampNode* root, uint32_t size, uint64_t edit) {
+    Cell* c = cell_alloc(type);
+    c->data.champ.root = root;
+    c->data.champ.size = size;
+    c->data.champ.edit = edit;
+    c->data.champ.sealed = false;
+    return c;
+}
+
+static void champ_free(Cell* c) {
+    champ_node_release((ChampNode*)c->data.champ.root);
+}
+
+static bool champ_equal(Cell* a, Cell* b) {
+    if (a->data.champ.size != b->data.champ.size) return false;
+    if (a->data.champ.root == b->data.champ.root) return true;
+    Cell* entries = cell_pmap_entries(a);
+    bool eq = true;
+    for (Cell* cur = entries; eq && cell_is_pair(cur); cur = cell_cdr(cur)) {
+        Cell* e = cell_car(cur);
+        void** slot = champ_find((ChampNode*)b->data.champ.root, cell_car(e),
+                                 cell_hash(cell_car(e)));
+        if (!slot) eq = false;
+        else if (a->type == CELL_PMAP) {
+            Cell* bv = (Cell*)slot[1];
+            eq = cell_equal(cell_cdr(e), bv ? bv : cell_nil());
+        }
+    }
+    cell_release(entries);
+    return eq;
+}
+
+/* Order-independent: sum of per-entry hashes */
+static uint64_t champ_hash(Cell* c) {
+    uint64_t h = c->type == CELL_PMAP ? 0xC4A3ull : 0xC4A5ull;
+    Cell* entries = cell_pmap_entries(c);
+    for (Cell* cur = entries; cell_is_pair(cur); cur = cell_cdr(cur)) {
+        Cell* e = cell_car(cur);
+        h += cell_hash(cell_car(e)) * 0x9E3779B97F4A7C15ULL + cell_hash(cell_cdr(e));
+    }
+    cell_release(entries);
+    return h;
+}
+
+/* === Public persistent map/set API === */
+
+Cell* cell_pmap_new(void) {
+    return champ_new_cell(CELL_PMAP, champ_alloc(0, 0, 0), 0, 0);
+}
+
+Cell* cell_pset_new(void) {
+    return champ_new_cell(CELL_PSET, champ_alloc(0, 0, 0), 0, 0);
+}
+
+bool cell_is_pmap(Cell* c) {
+    return c && c->type == CELL_PMAP;
+}
+
+bool cell_is_pset(Cell* c) {
+    return c && c->type == CELL_PSET;
+}
+
+bool cell_champ_is_transient(Cell* c) {
+    return c && (c->type == CELL_PMAP || c->type == CELL_PSET) &&
+           (c->data.champ.edit != 0 || c->data.champ.sealed);
+}
+
+Cell* cell_pmap_get(Cell* m, Cell* key) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    void** slot = m->data.champ.size
+        ? champ_find((ChampNode*)m->data.champ.root, key, cell_hash(key)) : NULL;
+    if (!slot || !slot[1]) return cell_nil();
+    cell_retain((Cell*)slot[1]);
+    return (Cell*)slot[1];
+}
+
+bool cell_pmap_has(Cell* m, Cell* key) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    return m->data.champ.size &&
+           champ_find((ChampNode*)m->data.champ.root, key, cell_hash(key)) != NULL;
+}
+
+uint32_t cell_pmap_size(Cell* m) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    return m->data.champ.size;
+}
+
+/* Apply one edit to `root` (whose reference is taken); *size is adjusted */
+static ChampNode* champ_apply(ChampNode* root, uint32_t* size, Cell* key,
+                              Cell* value, bool del, uint64_t edit) {
+    uint64_t hash = cell_hash(key);
+    void** slot = *size ? champ_find(root, key, hash) : NULL;
+    if (del) {
+        if (!slot) return root;
+        (*size)--;
+        return champ_del(root, key, hash, 0, edit);
+    }
+    if (slot && slot[1] == value) return root;
+    if (!slot) (*size)++;
+    return champ_put(root, key, value, hash, 0, edit);
+}
+
+Cell* cell_pmap_put(Cell* m, Cell* key, Cell* value) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    ChampNode* root = (ChampNode*)m->data.champ.root;
+    uint32_t size = m->data.champ.size;
+    atomic_fetch_add_explicit(&root->rc, 1, memory_order_relaxed);
+    root = champ_apply(root, &size, key, m->type == CELL_PSET ? NULL : value,
+                       false, champ_new_edit());
+    return champ_new_cell(m->type, root, size, 0);
+}
+
+Cell* cell_pmap_del(Cell* m, Cell* key) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    ChampNode* root = (ChampNode*)m->data.champ.root;
+    uint32_t size = m->data.champ.size;
+    atomic_fetch_add_explicit(&root->rc, 1, memory_order_relaxed);
+    root = champ_apply(root, &size, key, NULL, true, champ_new_edit());
+    return champ_new_cell(m->type, root, size, 0);
+}
+
+Cell* cell_pmap_keys(Cell* m) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    ChampCollect cc = { cell_nil(), 1 };
+    champ_collect((ChampNode*)m->data.champ.root, &cc);
+    return cc.list;
+}
+
+Cell* cell_pmap_values(Cell* m) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    ChampCollect cc = { cell_nil(), 2 };
+    champ_collect((ChampNode*)m->data.champ.root, &cc);
+    return cc.list;
+}
+
+Cell* cell_pmap_entries(Cell* m) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    ChampCollect cc = { cell_nil(), 0 };
+    champ_collect((ChampNode*)m->data.champ.root, &cc);
+    return cc.list;
+}
+
+/* m2 wins on conflicts. The result shares structure with the larger input
+ * and only the smaller one's entries are inserted. */
+Cell* cell_pmap_merge(Cell* m1, Cell* m2) {
+    assert(m1->type == m2->type && (m1->type == CELL_PMAP || m1->type == CELL_PSET));
+    bool base_is_m2 = m2->data.champ.size > m1->data.champ.size;
+    Cell* base = base_is_m2 ? m2 : m1;
+    Cell* other = base_is_m2 ? m1 : m2;
+    if (other->data.champ.size == 0) {
+        atomic_fetch_add_explicit(&((ChampNode*)base->data.champ.root)->rc, 1,
+                                  memory_order_relaxed);
+        return champ_new_cell(base->type, (ChampNode*)base->data.champ.root,
+                              base->data.champ.size, 0);
+    }
+    Cell* t = cell_champ_transient(base);
+    Cell* entries = cell_pmap_entries(other);
+    for (Cell* cur = entries; cell_is_pair(cur); cur = cell_cdr(cur)) {
+        Cell* e = cell_car(cur);
+        if (base_is_m2 && cell_pmap_has(t, cell_car(e))) continue;
+        cell_pmap_put_mut(t, cell_car(e), cell_cdr(e));
+    }
+    cell_release(entries);
+    Cell* result = cell_champ_persistent(t);
+    cell_release(t);
+    return result;
+}
+
+Cell* cell_champ_transient(Cell* m) {
+    assert(m->type == CELL_PMAP || m->type == CELL_PSET);
+    ChampNode* root = (ChampNode*)m->data.champ.root;
+    atomic_fetch_add_explicit(&root->rc, 1, memory_order_relaxed);
+    return champ_new_cell(m->type, root, m->data.champ.size, champ_new_edit());
+}
+
+void cell_pmap_put_mut(Cell* t, Cell* key, Cell* value) {
+    assert(t->data.champ.edit != 0);
+    t->data.champ.root = champ_apply((ChampNode*)t->data.champ.root, &t->data.champ.size,
+                                     key, t->type == CELL_PSET ? NULL : value,
+                                     false, t->data.champ.edit);
+}
+
+void cell_pmap_del_mut(Cell* t, Cell* key) {
+    assert(t->data.champ.edit != 0);
+    t->data.champ.root = champ_apply((ChampNode*)t->data.champ.root, &t->data.champ.size,
+                                     key, NULL, true, t->data.champ.edit);
+}
+
+/* The transient hands its tree to a new persistent value and is sealed:
+ * its token is retired, so no node it owned can be edited again. */
+Cell* cell_champ_persistent(Cell* t) {
+    assert(t->data.champ.edit != 0);
+    Cell* m = champ_new_cell(t->type, (ChampNode*)t->data.champ.root,
+                             t->data.champ.size, 0);
+    t->data.champ.root = champ_alloc(0, 0, 0);
+    t->data.champ.size = 0;
+    t->data.champ.edit = 0;
+    t->data.champ.sealed = true;
+    return m;
+}
+
+/* =========================================================================
+ * Record Table (⊙▦) — columnar struct-of-arrays
+ *
+ * A table holds the rows of one leaf struct type as one array per field;
+ * all columns share the row capacity and grow together. A column's kind is
+ * fixed by the first value stored in it: integers go to an int64 array,
+ * numbers to a double array, anything else to retained Cell pointers. A
+ * later value of another kind boxes the whole column once, so a read always
+ * returns exactly the value that was pushed.
+ *
+ * Kernels take a morsel of ITER_BATCH_CAP rows at a time. A predicate over
+ * an unboxed column is a branch-free compare: every row index is written to
+ * the selection vector and the output advances by the compare result, so
+ * the loop has no data-dependent branch. Filters gather the selected rows
+ * column by column; scans turn only the selected rows into structs.
+ * ========================================================================= */
+
+typedef enum { COL_EMPTY, COL_INT, COL_FLOAT, COL_BOXED } TableColKind;
+
+typedef struct {
+    Cell*   name;             /* Field symbol (borrowed from table.fields) */
+    uint8_t kind;             /* TableColKind */
+    union {
+        int64_t* i64;
+        double*  f64;
+        Cell**   cells;
+        void*    raw;         /* Every kind uses 8-byte slots */
+    };
+} TableColumn;
+
+#define TABLE_MIN_CAP 16
+
+static inline TableColumn* table_cols(Cell* t) {
+    return (TableColumn*)t->data.table.columns;
+}
+
+Cell* cell_table_new(Cell* type_tag, Cell* fields) {
+    uint16_t n = 0;
+    for (Cell* f = fields; cell_is_pair(f); f = cell_cdr(f)) n++;
+    Cell* c = cell_alloc(CELL_TABLE);
+    TableColumn* cols = (TableColumn*)calloc(n ? n : 1, sizeof(TableColumn));
+    assert(cols != NULL);
+    uint16_t j = 0;
+    for (Cell* f = fields; cell_is_pair(f); f = cell_cdr(f)) cols[j++].name = cell_car(f);
+    c->data.table.columns = cols;
+    c->data.table.type_tag = type_tag;
+    c->data.table.fields = fields;
+    c->data.table.layout = cell_struct_layout_new(fields);
+    c->data.table.n_cols = n;
+    cell_retain(type_tag);
+    cell_retain(fields);
+    return c;
+}
+
+bool cell_is_table(Cell* c) {
+    return c && c->type == CELL_TABLE;
+}
+
+uint32_t cell_table_size(Cell* t) {
+    assert(t->type == CELL_TABLE);
+    return t->data.table.size;
+}
+
+static void table_free(Cell* c) {
+    TableColumn* cols = table_cols(c);
+    for (uint16_t j = 0; j < c->data.table.n_cols; j++) {
+        if (cols[j].kind == COL_BOXED)
+            for (uint32_t i = 0; i < c->data.table.size; i++) cell_release(cols[j].cells[i]);
+        free(cols[j].raw);
+    }
+    free(cols);
+    cell_release(c->data.table.type_tag);
+    cell_release(c->data.table.fields);
+    cell_release(c->data.table.layout);
+}
+
+static void table_visit_children(Cell* c, void (*fn)(Cell*, void*), void* ctx) {
+    TableColumn* cols = table_cols(c);
+    fn(c->data.table.type_tag, ctx);
+    fn(c->data.table.fields, ctx);
+    for (uint16_t j = 0; j < c->data.table.n_cols; j++)
+        if (cols[j].kind == COL_BOXED)
+            for (uint32_t i = 0; i < c->data.table.size; i++) fn(cols[j].cells[i], ctx);
+}
+
+static void table_reserve(Cell* t, uint32_t need) {
+    if (need <= t->data.table.capacity) return;
+    uint32_t cap = t->data.table.capacity ? t->data.table.capacity : TABLE_MIN_CAP;
+    while (cap < need) cap *= 2;
+    TableColumn* cols = table_cols(t);
+    for (uint16_t j = 0; j < t->data.table.n_cols; j++) {
+        void* p = realloc(cols[j].raw, (size_t)cap * sizeof(int64_t));
+        assert(p != NULL);
+        cols[j].raw = p;
+    }
+    t->data.table.capacity = cap;
+}
+
+static inline uint8_t table_value_kind(Cell* v) {
+    if (cell_is_integer(v)) return COL_INT;
+    if (cell_is_number(v)) return COL_FLOAT;
+    return COL_BOXED;
+}
+
+/* Slots are the same width for every kind, so boxing is done in place */
+static void table_col_box(TableColumn* col, uint32_t size) {
+    if (col->kind == COL_INT)
+        for (uint32_t i = 0; i < size; i++) col->cells[i] = cell_integer(col->i64[i]);
+    else if (col->kind == COL_FLOAT)
+        for (uint32_t i = 0; i < size; i++) col->cells[i] = cell_number(col->f64[i]);
+    col->kind = COL_BOXED;
+}
+
+/* Store v at row i (== rows already stored) */
+static void table_col_store(TableColumn* col, uint32_t i, Cell* v) {
+    uint8_t k = table_value_kind(v);
+    if (col->kind == COL_EMPTY) col->kind = k;
+    else if (col->kind != k && col->kind != COL_BOXED) table_col_box(col, i);
+    switch (col->kind) {
+        case COL_INT:   col->i64[i] = cell_get_integer(v); break;
+        case COL_FLOAT: col->f64[i] = cell_get_number(v); break;
+        default:        cell_retain(v); col->cells[i] = v; break;
+    }
+}
+
+static inline Cell* table_col_get(const TableColumn* col, uint32_t i) {
+    switch (col->kind) {
+        case COL_INT:   return cell_integer(col->i64[i]);
+        case COL_FLOAT: return cell_number(col->f64[i]);
+        default:        cell_retain(col->cells[i]); return col->cells[i];
+    }
+}
+
+int cell_table_column(Cell* t, Cell* field) {
+    assert(t->type == CELL_TABLE);
+    TableColumn* cols = table_cols(t);
+    for (uint16_t j = 0; j < t->data.table.n_cols; j++)
+        if (cell_equal(cols[j].name, field)) return j;
+    return -1;
+}
+
+const char* cell_table_column_kind(Cell* t, int col) {
+    assert(t->type == CELL_TABLE && col >= 0 && col < t->data.table.n_cols);
+    static const char* names[] = { ":empty", ":int", ":float", ":boxed" };
+    return names[table_cols(t)[col].kind];
+}
+
+/* Append the fields of a struct; false (nothing stored) if one is missing */
+bool cell_table_push(Cell* t, Cell* row) {
+    assert(t->type == CELL_TABLE && row->type == CELL_STRUCT);
+    TableColumn* cols = table_cols(t);
+    uint16_t n = t->data.table.n_cols;
+    Cell* layout = row->data.structure.layout;
+    if (layout && (layout == t->data.table.layout || cell_equal(layout, t->data.table.layout))) {
+        /* Same slot order as the columns: copy straight across */
+        uint32_t i = t->data.table.size;
+        table_reserve(t, i + 1);
+        cols = table_cols(t);
+        for (uint16_t j = 0; j < n; j++)
+            table_col_store(&cols[j], i, row->data.structure.slots[j]);
+        t->data.table.size = i + 1;
+        return true;
+    }
+    for (uint16_t j = 0; j < n; j++)
+        if (!cell_struct_get_field(row, cols[j].name)) return false;
+    uint32_t i = t->data.table.size;
+    table_reserve(t, i + 1);
+    cols = table_cols(t);
+    for (uint16_t j = 0; j < n; j++)
+        table_col_store(&cols[j], i, cell_struct_get_field(row, cols[j].name));
+    t->data.table.size = i + 1;
+    return true;
+}
+
+Cell* cell_table_get(Cell* t, uint32_t row, int col) {
+    assert(t->type == CELL_TABLE && row < t->data.table.size);
+    assert(col >= 0 && col < t->data.table.n_cols);
+    return table_col_get(&table_cols(t)[col], row);
+}
+
+/* Materialize one row as a leaf struct, fields in column order */
+Cell* cell_table_row(Cell* t, uint32_t row) {
+    assert(t->type == CELL_TABLE && row < t->data.table.size);
+    TableColumn* cols = table_cols(t);
+    uint16_t n = t->data.table.n_cols;
+    Cell* small[8];
+    Cell** values = n <= 8 ? small : (Cell**)malloc(n * sizeof(Cell*));
+    for (uint16_t j = 0; j < n; j++) values[j] = table_col_get(&cols[j], row);
+    Cell* s = cell_struct_slotted(STRUCT_LEAF, t->data.table.type_tag, NULL,
+                                  t->data.table.layout, values);
+    for (uint16_t j = 0; j < n; j++) cell_release(values[j]);
+    if (values != small) free(values);
+    return s;
+}
+
+Cell* cell_table_column_values(Cell* t, int col) {
+    assert(t->type == CELL_TABLE && col >= 0 && col < t->data.table.n_cols);
+    uint32_t n = t->data.table.size;
+    const TableColumn* c = &table_cols(t)[col];
+    Cell* v = cell_vector_new(n);
+    for (uint32_t i = 0; i < n; i++) {
+        Cell* x = table_col_get(c, i);
+        cell_vector_push(v, x);
+        cell_release(x);
+    }
+    return v;
+}
+
+/* --- Kernels --- */
+
+#define TABLE_SELECT_LOOP(PASS)                                  \
+    for (uint32_t i = 0; i < n; i++) {                           \
+        sel[k] = (uint8_t)i;                                     \
+        k += (PASS) ? 1u : 0u;                                   \
+    }
+
+#define TABLE_SELECT(X)                                          \
+    switch (op) {                                                \
+        case TABLE_OP_LT: TABLE_SELECT_LOOP((X) <  b); break;    \
+        case TABLE_OP_LE: TABLE_SELECT_LOOP((X) <= b); break;    \
+        case TABLE_OP_GT: TABLE_SELECT_LOOP((X) >  b); break;    \
+        case TABLE_OP_GE: TABLE_SELECT_LOOP((X) >= b); break;    \
+        case TABLE_OP_EQ: TABLE_SELECT_LOOP((X) == b); break;    \
+        case TABLE_OP_NE: TABLE_SELECT_LOOP((X) != b); break;    \
+    }
+
+static inline bool table_op_holds(TableOp op, int cmp) {
+    switch (op) {
+        case TABLE_OP_LT: return cmp < 0;
+        case TABLE_OP_LE: return cmp <= 0;
+        case TABLE_OP_GT: return cmp > 0;
+        case TABLE_OP_GE: return cmp >= 0;
+        case TABLE_OP_EQ: return cmp == 0;
+        case TABLE_OP_NE: return cmp != 0;
+    }
+    return false;
+}
+
+/* Rows [start, start+n) of column col passing (value op bound), as offsets
+ * from start in sel[]; n ≤ ITER_BATCH_CAP. Returns how many passed. */
+static uint32_t table_select(Cell* t, int col, TableOp op, Cell* bound,
+                             uint32_t start, uint32_t n, uint8_t* sel) {
+    const TableColumn* c = &table_cols(t)[col];
+    uint32_t k = 0;
+    bool num_bound = cell_is_integer(bound) || cell_is_number(bound);
+    if (c->kind == COL_INT && cell_is_integer(bound)) {
+        const int64_t* xs = c->i64 + start;
+        int64_t b = cell_get_integer(bound);
+        TABLE_SELECT(xs[i]);
+    } else if (c->kind == COL_INT && num_bound) {
+        const int64_t* xs = c->i64 + start;
+        double b = cell_get_number(bound);
+        TABLE_SELECT((double)xs[i]);
+    } else if (c->kind == COL_FLOAT && num_bound) {
+        const double* xs = c->f64 + start;
+        double b = cell_is_integer(bound) ? (double)cell_get_integer(bound)
+                                          : cell_get_number(bound);
+        TABLE_SELECT(xs[i]);
+    } else {
+        /* Boxed column or non-numeric operand: the generic term order */
+        bool eq = (op == TABLE_OP_EQ || op == TABLE_OP_NE);
+        for (uint32_t i = 0; i < n; i++) {
+            Cell* x = table_col_get(c, start + i);
+            int cmp = eq ? !cell_equal(x, bound) : cell_compare(x, bound);
+            cell_release(x);
+            sel[k] = (uint8_t)i;
+            k += table_op_holds(op, cmp) ? 1u : 0u;
+        }
+    }
+    return k;
+}
+
+/* Empty table over the given columns of t, each keeping its kind */
+static Cell* table_like(Cell* t, const int* cols, uint16_t n) {
+    TableColumn* src = table_cols(t);
+    Cell* fields = cell_nil();
+    for (int q = (int)n - 1; q >= 0; q--) {
+        Cell* next = cell_cons(src[cols[q]].name, fields);
+        cell_release(fields);
+        fields = next;
+    }
+    Cell* r = cell_table_new(t->data.table.type_tag, fields);
+    cell_release(fields);
+    TableColumn* dst = table_cols(r);
+    for (uint16_t q = 0; q < n; q++) dst[q].kind = src[cols[q]].kind;
+    return r;
+}
+
+Cell* cell_table_filter(Cell* t, int col, TableOp op, Cell* value) {
+    assert(t->type == CELL_TABLE && col >= 0 && col < t->data.table.n_cols);
+    uint16_t nc = t->data.table.n_cols;
+    int* all = (int*)malloc((nc ? nc : 1) * sizeof(int));
+    assert(all != NULL);
+    for (uint16_t j = 0; j < nc; j++) all[j] = j;
+    Cell* r = table_like(t, all, nc);
+    free(all);
+
+    uint8_t sel[ITER_BATCH_CAP];
+    uint32_t size = t->data.table.size;
+    for (uint32_t start = 0; start < size; start += ITER_BATCH_CAP) {
+        uint32_t n = size - start < ITER_BATCH_CAP ? size - start : ITER_BATCH_CAP;
+        uint32_t k = table_select(t, col, op, value, start, n, sel);
+        if (k == 0) continue;
+        uint32_t at = r->data.table.size;
+        table_reserve(r, at + k);
+        TableColumn* src = table_cols(t);
+        TableColumn* dst = table_cols(r);
+        for (uint16_t j = 0; j < nc; j++) {
+            switch (src[j].kind) {
+                case COL_INT:
+                    for (uint32_t q = 0; q < k; q++) dst[j].i64[at + q] = src[j].i64[start + sel[q]];
+                    break;
+                case COL_FLOAT:
+                    for (uint32_t q = 0; q < k; q++) dst[j].f64[at + q] = src[j].f64[start + sel[q]];
+                    break;
+                default:
+                    for (uint32_t q = 0; q < k; q++) {
+                        Cell* x = src[j].cells[start + sel[q]];
+                        cell_retain(x);
+                        dst[j].cells[at + q] = x;
+                    }
+                    break;
+            }
+        }
+        r->data.table.size = at + k;
+    }
+    return r;
+}
+
+Cell* cell_table_project(Cell* t, const int* cols, uint16_t n_cols) {
+    assert(t->type == CELL_TABLE);
+    Cell* r = table_like(t, cols, n_cols);
+    uint32_t size = t->data.table.size;
+    table_reserve(r, size);
+    TableColumn* src = table_cols(t);
+    TableColumn* dst = table_cols(r);
+    for (uint16_t q = 0; q < n_cols; q++) {
+        const TableColumn* s = &src[cols[q]];
+        if (size) memcpy(dst[q].raw, s->raw, (size_t)size * sizeof(int64_t));
+        if (s->kind == COL_BOXED)
+            for (uint32_t i = 0; i < size; i++) cell_retain(dst[q].cells[i]);
+    }
+    r->data.table.size = size;
+    return r;
+}
+
+Cell* cell_table_aggregate(Cell* t, int col, TableAgg agg) {
+    assert(t->type == CELL_TABLE && col >= 0 && col < t->data.table.n_cols);
+    uint32_t n = t->data.table.size;
+    const TableColumn* c = &table_cols(t)[col];
+    if (agg == TABLE_AGG_COUNT) return cell_number((double)n);
+    if (n == 0) {
+        if (agg != TABLE_AGG_SUM) return cell_nil();
+        return c->kind == COL_FLOAT ? cell_number(0) : cell_integer(0);
+    }
+
+    switch (c->kind) {
+        case COL_INT: {
+            const int64_t* xs = c->i64;
+            if (agg == TABLE_AGG_SUM || agg == TABLE_AGG_MEAN) {
+                int64_t s = 0;    /* Overflow is an error, as with + */
+                for (uint32_t i = 0; i < n; i++)
+                    if (UNLIKELY(__builtin_add_overflow(s, xs[i], &s)))
+                        return cell_error("integer-overflow", t);
+                if (agg == TABLE_AGG_SUM) return cell_integer(s);
+                return cell_number((double)s / n);
+            }
+            int64_t m = xs[0];
+            if (agg == TABLE_AGG_MIN)
+                for (uint32_t i = 1; i < n; i++) m = xs[i] < m ? xs[i] : m;
+            else
+                for (uint32_t i = 1; i < n; i++) m = xs[i] > m ? xs[i] : m;
+            return cell_integer(m);
+        }
+        case COL_FLOAT: {
+            const double* xs = c->f64;
+            if (agg == TABLE_AGG_SUM || agg == TABLE_AGG_MEAN) {
+                /* Four independent accumulators keep the adds pipelined */
+                double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+                uint32_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    s0 += xs[i]; s1 += xs[i + 1]; s2 += xs[i + 2]; s3 += xs[i + 3];
+                }
+                for (; i < n; i++) s0 += xs[i];
+                double s = (s0 + s1) + (s2 + s3);
+                return cell_number(agg == TABLE_AGG_SUM ? s : s / n);
+            }
+            double m = xs[0];
+            if (agg == TABLE_AGG_MIN)
+                for (uint32_t i = 1; i < n; i++) m = xs[i] < m ? xs[i] : m;
+            else
+                for (uint32_t i = 1; i < n; i++) m = xs[i] > m ? xs[i] : m;
+            return cell_number(m);
+        }
+        default: {
+            Cell** xs = c->cells;
+            if (agg == TABLE_AGG_SUM || agg == TABLE_AGG_MEAN) {
+                int64_t si = 0;
+                double sd = 0;
+                bool all_int = true;
+                for (uint32_t i = 0; i < n; i++) {
+                    if (cell_is_integer(xs[i])) {
+                        if (UNLIKELY(__builtin_add_overflow(si, cell_get_integer(xs[i]), &si)))
+                            return cell_error("integer-overflow", t);
+                    } else if (cell_is_number(xs[i])) {
+                        sd += cell_get_number(xs[i]);
+                        all_int = false;
+                    } else {
+                        return cell_error("table-agg-not-numeric", xs[i]);
+                    }
+                }
+                if (agg == TABLE_AGG_SUM && all_int) return cell_integer(si);
+                double s = sd + (double)si;
+                return cell_number(agg == TABLE_AGG_SUM ? s : s / n);
+            }
+            Cell* m = xs[0];
+            for (uint32_t i = 1; i < n; i++) {
+                int cmp = cell_compare(xs[i], m);
+                if (agg == TABLE_AGG_MIN ? cmp < 0 : cmp > 0) m = xs[i];
+            }
+            cell_retain(m);
+            return m;
+        }
+    }
+}
+
+/* =========================================================================
+ * Iterator (⊣) — Morsel-Driven Batch Iteration (Day 118)
+ * ========================================================================= */
+
+bool cell_is_iterator(Cell* c) {
+    return c && c->type == CELL_ITERATOR;
+}
+
+/* --- Batch fill functions (one per source kind) --- */
+
+static uint16_t fill_list(Cell* it, IterBatch* b) {
+    IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
+    Cell* cur = d->state.list.current;
+    uint16_t n = 0;
+    while (n < ITER_BATCH_CAP && cur && cell_is_pair(cur)) {
+        Cell* elem = cell_car(cur);
         cell_retain(elem);
         b->elems[n++] = elem;
         Cell* next = cell_cdr(cur);
@@ -4703,6 +7999,7 @@ static uint16_t fill_buffer(Cell* it, IterBatch* b) {
 static uint16_t fill_hashmap(Cell* it, IterBatch* b) {
     IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
     Cell* src = d->source;
+    cell_hashmap_settle(src);
     uint32_t slot = d->state.hashmap.slot_idx;
     uint32_t cap = src->data.hashmap.capacity;
     uint8_t* ctrl = src->data.hashmap.ctrl;
@@ -4738,6 +8035,7 @@ static uint16_t fill_hashmap(Cell* it, IterBatch* b) {
 static uint16_t fill_hashset(Cell* it, IterBatch* b) {
     IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
     Cell* src = d->source;
+    cell_hashset_settle(src);
     uint32_t grp = d->state.hashset.group;
     uint8_t sl = d->state.hashset.slot;
     uint32_t ng = src->data.hashset.n_groups;
@@ -4763,33 +8061,96 @@ static uint16_t fill_hashset(Cell* it, IterBatch* b) {
     return n;
 }
 
-static uint16_t fill_sorted_map(Cell* it, IterBatch* b) {
+/* Sorted-map cursor: a (leaf, slot) position walked along the leaf chain in
+ * either direction, stopping at the inclusive [lo, hi] bounds. Each batch
+ * remembers its last key; if the map was changed in between, the next fill
+ * re-seeks just past that key instead of trusting the stale slot. */
+static void sm_cursor_seek(IteratorData* d, Cell* src, Cell* key, bool strict) {
+    SMPool* pool = (SMPool*)src->data.sorted_map.node_pool;
+    uint64_t sk = cell_sort_key(key);
+    unsigned pos;
+    int found;
+    uint32_t leaf = sm_search(pool, src->data.sorted_map.root_idx,
+                              src->data.sorted_map.height, sk, key, &pos, &found);
+    if (!d->state.sorted_map.reverse) {
+        d->state.sorted_map.key_idx = (int16_t)(pos + (found && strict ? 1 : 0));
+    } else {
+        d->state.sorted_map.key_idx = (int16_t)((found && !strict) ? (int)pos : (int)pos - 1);
+    }
+    d->state.sorted_map.leaf_idx = leaf;
+    d->state.sorted_map.version = src->data.sorted_map.version;
+}
+
+/* Position at the first entry in iteration order */
+static void sm_cursor_start(IteratorData* d, Cell* src) {
+    SMPool* pool = (SMPool*)src->data.sorted_map.node_pool;
+    Cell* bound = d->state.sorted_map.reverse ? d->state.sorted_map.hi : d->state.sorted_map.lo;
+    if (bound) {
+        sm_cursor_seek(d, src, bound, false);
+        return;
+    }
+    if (!d->state.sorted_map.reverse) {
+        d->state.sorted_map.leaf_idx = src->data.sorted_map.first_leaf;
+        d->state.sorted_map.key_idx = 0;
+    } else {
+        uint32_t last = src->data.sorted_map.last_leaf;
+        d->state.sorted_map.leaf_idx = last;
+        d->state.sorted_map.key_idx = (int16_t)pool->nodes[last].n_keys - 1;
+    }
+    d->state.sorted_map.version = src->data.sorted_map.version;
+}
+
+static uint16_t sm_cursor_fill(Cell* it, IterBatch* b) {
     IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
     Cell* src = d->source;
     SMPool* pool = (SMPool*)src->data.sorted_map.node_pool;
+    if (d->exhausted) return 0;
     if (!pool) { d->exhausted = true; return 0; }
+    if (d->state.sorted_map.version != src->data.sorted_map.version) {
+        if (d->state.sorted_map.last) sm_cursor_seek(d, src, d->state.sorted_map.last, true);
+        else sm_cursor_start(d, src);
+    }
+    bool reverse = d->state.sorted_map.reverse;
+    Cell* lo = d->state.sorted_map.lo;
+    Cell* hi = d->state.sorted_map.hi;
     uint32_t leaf_idx = d->state.sorted_map.leaf_idx;
-    uint8_t key_idx = d->state.sorted_map.key_idx;
+    int key_idx = d->state.sorted_map.key_idx;
     uint16_t n = 0;
     while (n < ITER_BATCH_CAP && leaf_idx != SM_NIL) {
         SMNode* leaf = &pool->nodes[leaf_idx];
-        while (key_idx < leaf->n_keys && n < ITER_BATCH_CAP) {
-            Cell* k = leaf->keys[key_idx];
-            Cell* v = leaf->values[key_idx];
-            cell_retain(k);
-            cell_retain(v);
-            b->elems[n++] = cell_cons(k, v);
-            cell_release(k);
-            cell_release(v);
-            key_idx++;
-        }
-        if (key_idx >= leaf->n_keys) {
+        if (!reverse && key_idx >= leaf->n_keys) {
             leaf_idx = leaf->next_leaf;
             key_idx = 0;
+            continue;
+        }
+        if (reverse && key_idx < 0) {
+            leaf_idx = leaf->prev_leaf;
+            if (leaf_idx != SM_NIL) key_idx = pool->nodes[leaf_idx].n_keys - 1;
+            continue;
         }
+        Cell* k = leaf->keys[key_idx];
+        uint64_t sk = leaf->sort_keys[key_idx];
+        if ((!reverse && hi && sm_order(sk, k, d->state.sorted_map.hi_sk, hi) > 0) ||
+            (reverse && lo && sm_order(sk, k, d->state.sorted_map.lo_sk, lo) < 0)) {
+            leaf_idx = SM_NIL;  /* Past the bound */
+            break;
+        }
+        Cell* v = leaf->values[key_idx];
+        cell_retain(k);
+        cell_retain(v);
+        b->elems[n++] = cell_cons(k, v);
+        cell_release(k);
+        cell_release(v);
+        key_idx += reverse ? -1 : 1;
+    }
+    if (n > 0) {
+        Cell* last = cell_car(b->elems[n - 1]);
+        cell_retain(last);
+        if (d->state.sorted_map.last) cell_release(d->state.sorted_map.last);
+        d->state.sorted_map.last = last;
     }
     d->state.sorted_map.leaf_idx = leaf_idx;
-    d->state.sorted_map.key_idx = key_idx;
+    d->state.sorted_map.key_idx = (int16_t)key_idx;
     if (leaf_idx == SM_NIL) d->exhausted = true;
     b->count = n;
     b->use_sel = false;
@@ -4797,39 +8158,264 @@ static uint16_t fill_sorted_map(Cell* it, IterBatch* b) {
     return n;
 }
 
-/* Trie iterator: use existing art_iter_node to collect into batch via callback */
-typedef struct {
-    IterBatch* batch;
-    uint16_t   count;
-} TrieBatchCtx;
-
-static void trie_batch_cb(ARTLeaf* leaf, void* ctx) {
-    TrieBatchCtx* tc = (TrieBatchCtx*)ctx;
-    if (tc->count >= ITER_BATCH_CAP) return;
-    /* Yield ⟨key value⟩ */
-    Cell* k = cell_symbol((const char*)leaf->key);
-    Cell* v = leaf->value;
-    cell_retain(v);
-    tc->batch->elems[tc->count++] = cell_cons(k, v);
-    cell_release(k);
-    cell_release(v);
+/* Trie cursor: resumable DFS over the ART with an explicit stack of
+ * (inner node, next child ordinal). Ordinals are array slots for Node4/16
+ * (kept sorted) and key bytes for Node48/256, so stepping an ordinal walks
+ * children in byte order either way. */
+
+static int art_ord_first(void* node, bool reverse) {
+    ARTHeader* hdr = art_node_header(node);
+    if (hdr->type == ART_NODE4 || hdr->type == ART_NODE16)
+        return reverse ? hdr->num_children - 1 : 0;
+    return reverse ? 255 : 0;
 }
 
-static uint16_t fill_trie(Cell* it, IterBatch* b) {
+/* Child at ordinal *ord or the next one in the walk direction (NULL when
+ * the node is done); *byte gets its key byte */
+static void* art_child_from(void* node, int* ord, bool reverse, uint8_t* byte) {
+    ARTHeader* hdr = art_node_header(node);
+    int step = reverse ? -1 : 1;
+    switch (hdr->type) {
+        case ART_NODE4:
+        case ART_NODE16: {
+            uint8_t* keys = hdr->type == ART_NODE4 ? ((ARTNode4*)node)->keys : ((ARTNode16*)node)->keys;
+            void** children = hdr->type == ART_NODE4 ? ((ARTNode4*)node)->children
+                                                     : ((ARTNode16*)node)->children;
+            if (*ord < 0 || *ord >= hdr->num_children) return NULL;
+            *byte = keys[*ord];
+            return children[*ord];
+        }
+        case ART_NODE48: {
+            ARTNode48* n = (ARTNode48*)node;
+            for (; *ord >= 0 && *ord < 256; *ord += step) {
+                if (n->child_index[*ord] != 0xFF) {
+                    *byte = (uint8_t)*ord;
+                    return n->children[n->child_index[*ord]];
+                }
+            }
+            return NULL;
+        }
+        case ART_NODE256: {
+            ARTNode256* n = (ARTNode256*)node;
+            for (; *ord >= 0 && *ord < 256; *ord += step) {
+                if (n->children[*ord]) {
+                    *byte = (uint8_t)*ord;
+                    return n->children[*ord];
+                }
+            }
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+/* First child (in walk direction) whose byte is >= tb (forward) or <= tb
+ * (reverse); *ord gets its ordinal */
+static void* art_child_bound(void* node, int tb, bool reverse, int* ord, uint8_t* byte) {
+    ARTHeader* hdr = art_node_header(node);
+    if (hdr->type == ART_NODE4 || hdr->type == ART_NODE16) {
+        uint8_t* keys = hdr->type == ART_NODE4 ? ((ARTNode4*)node)->keys : ((ARTNode16*)node)->keys;
+        int i;
+        if (!reverse) { for (i = 0; i < hdr->num_children && keys[i] < tb; i++) {} }
+        else { for (i = hdr->num_children - 1; i >= 0 && keys[i] > tb; i--) {} }
+        *ord = i;
+    } else {
+        *ord = tb > 255 ? 255 : tb;
+    }
+    return art_child_from(node, ord, reverse, byte);
+}
+
+/* Any leaf below node: holds the full compressed prefix when it is longer
+ * than the ART_MAX_PREFIX bytes kept in the header */
+static ARTLeaf* art_any_leaf(void* node) {
+    while (!ART_IS_LEAF(node)) {
+        int ord = 0;
+        uint8_t byte;
+        node = art_child_from(node, &ord, false, &byte);
+    }
+    return ART_LEAF_RAW(node);
+}
+
+/* Lexicographic byte order, a proper prefix first; with `inf` the target
+ * stands for itself followed by +∞, i.e. every key it prefixes is below it */
+static int art_key_cmp(const uint8_t* k, uint32_t klen, const uint8_t* t, uint32_t tlen, bool inf) {
+    uint32_t n = klen < tlen ? klen : tlen;
+    int c = memcmp(k, t, n);
+    if (c != 0) return c < 0 ? -1 : 1;
+    if (klen >= tlen && inf) return -1;
+    if (klen == tlen) return 0;
+    return klen < tlen ? -1 : 1;
+}
+
+static void trie_cursor_push(IteratorData* d, void* node, int ord) {
+    if (d->state.trie.depth >= d->state.trie.cap) {
+        uint32_t cap = d->state.trie.cap ? d->state.trie.cap * 2 : 16;
+        d->state.trie.nodes = (void**)realloc(d->state.trie.nodes, cap * sizeof(void*));
+        d->state.trie.slots = (int16_t*)realloc(d->state.trie.slots, cap * sizeof(int16_t));
+        d->state.trie.cap = cap;
+    }
+    d->state.trie.nodes[d->state.trie.depth] = node;
+    d->state.trie.slots[d->state.trie.depth] = (int16_t)ord;
+    d->state.trie.depth++;
+}
+
+/* Enter a whole subtree: its first leaf (in walk direction) comes next */
+static void trie_cursor_enter(IteratorData* d, void* node) {
+    if (ART_IS_LEAF(node)) d->state.trie.pending = node;
+    else trie_cursor_push(d, node, art_ord_first(node, d->state.trie.reverse));
+}
+
+/* Reposition so the next leaf is the first key >= target (reverse: the
+ * last key <= target); strict excludes target itself. One root-to-leaf
+ * descent: subtrees wholly on the far side of target are skipped, the
+ * path's remaining siblings stay on the stack. */
+static void trie_cursor_seek(IteratorData* d, Cell* src, const uint8_t* t, uint32_t tlen,
+                             bool strict, bool inf) {
+    bool reverse = d->state.trie.reverse;
+    d->state.trie.depth = 0;
+    d->state.trie.pending = NULL;
+    d->state.trie.version = src->data.trie.version;
+    void* node = src->data.trie.root;
+    uint32_t depth = 0;
+    while (node) {
+        if (ART_IS_LEAF(node)) {
+            ARTLeaf* leaf = ART_LEAF_RAW(node);
+            int c = art_key_cmp(leaf->key, leaf->key_len, t, tlen, inf);
+            if ((reverse ? c < 0 : c > 0) || (c == 0 && !strict))
+                d->state.trie.pending = node;
+            return;
+        }
+        ARTHeader* hdr = art_node_header(node);
+        if (hdr->full_prefix_len > 0) {
+            ARTLeaf* any = art_any_leaf(node);
+            uint32_t end = depth + hdr->full_prefix_len;
+            int c = 0;
+            for (uint32_t i = depth; i < end && c == 0; i++) {
+                if (i >= tlen) c = inf ? -1 : 1;
+                else if (any->key[i] != t[i]) c = any->key[i] < t[i] ? -1 : 1;
+            }
+            if (c != 0) {
+                /* Whole subtree lies on one side of target */
+                if (reverse ? c < 0 : c > 0) trie_cursor_enter(d, node);
+                return;
+            }
+            depth = end;
+        }
+        if (depth >= tlen && inf) {
+            trie_cursor_enter(d, node);
+            return;
+        }
+        int tb = depth < tlen ? t[depth] : 0;
+        int ord;
+        uint8_t byte;
+        void* child = art_child_bound(node, tb, reverse, &ord, &byte);
+        if (!child) return;
+        if (byte != tb) {
+            trie_cursor_push(d, node, ord);
+            return;
+        }
+        trie_cursor_push(d, node, ord + (reverse ? -1 : 1));
+        node = child;
+        depth++;
+    }
+}
+
+static void trie_cursor_start(IteratorData* d, Cell* src) {
+    d->state.trie.depth = 0;
+    d->state.trie.pending = NULL;
+    d->state.trie.version = src->data.trie.version;
+    if (d->state.trie.prefix) {
+        trie_cursor_seek(d, src, d->state.trie.prefix, d->state.trie.prefix_len,
+                         false, d->state.trie.reverse);
+    } else if (src->data.trie.root) {
+        trie_cursor_enter(d, src->data.trie.root);
+    }
+}
+
+static ARTLeaf* trie_cursor_next(IteratorData* d) {
+    if (d->state.trie.pending) {
+        ARTLeaf* leaf = ART_LEAF_RAW(d->state.trie.pending);
+        d->state.trie.pending = NULL;
+        return leaf;
+    }
+    bool reverse = d->state.trie.reverse;
+    while (d->state.trie.depth > 0) {
+        uint32_t top = d->state.trie.depth - 1;
+        int ord = d->state.trie.slots[top];
+        uint8_t byte;
+        void* child = art_child_from(d->state.trie.nodes[top], &ord, reverse, &byte);
+        if (!child) {
+            d->state.trie.depth--;
+            continue;
+        }
+        d->state.trie.slots[top] = (int16_t)(ord + (reverse ? -1 : 1));
+        if (ART_IS_LEAF(child)) return ART_LEAF_RAW(child);
+        trie_cursor_push(d, child, art_ord_first(child, reverse));
+    }
+    return NULL;
+}
+
+static uint16_t trie_cursor_fill(Cell* it, IterBatch* b) {
     IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
     Cell* src = d->source;
-    /* For simplicity, collect all entries on first call.
-     * ART iteration is recursive; a resumable DFS is complex.
-     * For typical trie sizes this is acceptable. */
     if (d->exhausted) return 0;
-    if (!src->data.trie.root) { d->exhausted = true; return 0; }
-    TrieBatchCtx tc = { .batch = b, .count = 0 };
-    art_iter_node(src->data.trie.root, trie_batch_cb, &tc);
-    d->exhausted = true;  /* Single-shot: all entries collected */
-    b->count = tc.count;
+    if (d->state.trie.version != src->data.trie.version) {
+        if (d->state.trie.last)
+            trie_cursor_seek(d, src, d->state.trie.last, d->state.trie.last_len, true, false);
+        else
+            trie_cursor_start(d, src);
+    }
+    uint16_t n = 0;
+    ARTLeaf* leaf = NULL;
+    ARTLeaf* last = NULL;
+    while (n < ITER_BATCH_CAP && (leaf = trie_cursor_next(d)) != NULL) {
+        if (d->state.trie.prefix &&
+            !art_leaf_prefix_matches(leaf, d->state.trie.prefix, d->state.trie.prefix_len)) {
+            leaf = NULL;  /* Left the prefix range */
+            break;
+        }
+        /* Yield ⟨key value⟩ */
+        Cell* k = cell_symbol((const char*)leaf->key);
+        Cell* v = leaf->value;
+        cell_retain(v);
+        b->elems[n++] = cell_cons(k, v);
+        cell_release(k);
+        cell_release(v);
+        last = leaf;
+    }
+    if (last) {
+        d->state.trie.last = (uint8_t*)realloc(d->state.trie.last, last->key_len + 1);
+        memcpy(d->state.trie.last, last->key, last->key_len + 1);
+        d->state.trie.last_len = last->key_len;
+    }
+    if (!leaf) {
+        d->exhausted = true;
+        d->state.trie.depth = 0;
+        d->state.trie.pending = NULL;
+    }
+    b->count = n;
     b->use_sel = false;
     b->cursor = 0;
-    return tc.count;
+    return n;
+}
+
+/* Cursor batches hold the source still while they walk it: a batch only
+ * trusts its saved position if no write landed in between (version), and
+ * that check and the walk must see the same tree */
+static uint16_t fill_sorted_map(Cell* it, IterBatch* b) {
+    Cell* src = ((IteratorData*)it->data.iterator.iter_data)->source;
+    uint32_t seq = olc_lock(&src->data.sorted_map.seq);
+    uint16_t n = sm_cursor_fill(it, b);
+    olc_unlock(&src->data.sorted_map.seq, seq, false);
+    return n;
+}
+
+static uint16_t fill_trie(Cell* it, IterBatch* b) {
+    Cell* src = ((IteratorData*)it->data.iterator.iter_data)->source;
+    uint32_t seq = olc_lock(&src->data.trie.seq);
+    uint16_t n = trie_cursor_fill(it, b);
+    olc_unlock(&src->data.trie.seq, seq, false);
+    return n;
 }
 
 /* Heap iterator: auxiliary min-heap for lazy sorted drain */
@@ -4933,6 +8519,33 @@ static uint16_t fill_graph(Cell* it, IterBatch* b) {
     return n;
 }
 
+/* Next morsel of rows passing the scan predicate, if any. The selection
+ * vector is computed on the raw column; only passing rows become structs. */
+static uint16_t fill_table(Cell* it, IterBatch* b) {
+    IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
+    Cell* t = d->source;
+    while (d->state.table.row < t->data.table.size) {
+        uint32_t start = d->state.table.row;
+        uint32_t n = t->data.table.size - start;
+        if (n > ITER_BATCH_CAP) n = ITER_BATCH_CAP;
+        d->state.table.row = start + n;
+        int32_t col = d->state.table.col;
+        uint32_t k = n;
+        if (col >= 0)
+            k = table_select(t, col, (TableOp)d->state.table.op, d->state.table.bound,
+                             start, n, b->sel);
+        for (uint32_t q = 0; q < k; q++)
+            b->elems[q] = cell_table_row(t, start + (col >= 0 ? b->sel[q] : q));
+        if (k == 0) continue;
+        b->count = (uint16_t)k;
+        b->use_sel = false;
+        b->cursor = 0;
+        return (uint16_t)k;
+    }
+    d->exhausted = true;
+    return 0;
+}
+
 /* --- Transformer fill functions --- */
 
 /* Helper: call a lambda/builtin on one argument using eval */
@@ -5158,12 +8771,20 @@ Cell* cell_iterator_new(Cell* source) {
             d->kind = ITER_SORTED_MAP;
             d->fill = fill_sorted_map;
             d->state.sorted_map.pool = source->data.sorted_map.node_pool;
-            d->state.sorted_map.leaf_idx = source->data.sorted_map.first_leaf;
-            d->state.sorted_map.key_idx = 0;
+            {
+                uint32_t seq = olc_lock(&source->data.sorted_map.seq);
+                sm_cursor_start(d, source);
+                olc_unlock(&source->data.sorted_map.seq, seq, false);
+            }
             break;
         case CELL_TRIE:
             d->kind = ITER_TRIE;
             d->fill = fill_trie;
+            {
+                uint32_t seq = olc_lock(&source->data.trie.seq);
+                trie_cursor_start(d, source);
+                olc_unlock(&source->data.trie.seq, seq, false);
+            }
             break;
         case CELL_HEAP:
             d->kind = ITER_HEAP;
@@ -5185,6 +8806,12 @@ Cell* cell_iterator_new(Cell* source) {
             d->state.graph.remaining = source->data.graph.nodes;
             cell_retain(source->data.graph.nodes);
             break;
+        case CELL_TABLE:
+            d->kind = ITER_TABLE;
+            d->fill = fill_table;
+            d->state.table.row = 0;
+            d->state.table.col = -1;
+            break;
         default:
             /* Not iterable */
             free(d);
@@ -5195,6 +8822,18 @@ Cell* cell_iterator_new(Cell* source) {
     return it;
 }
 
+/* Iterator over the rows of t where (column col) op value holds */
+Cell* cell_table_scan(Cell* t, int col, TableOp op, Cell* value) {
+    assert(t->type == CELL_TABLE && col >= 0 && col < t->data.table.n_cols);
+    Cell* it = cell_iterator_new(t);
+    IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
+    d->state.table.col = col;
+    d->state.table.op = (uint8_t)op;
+    cell_retain(value);
+    d->state.table.bound = value;
+    return it;
+}
+
 Cell* cell_iterator_next(Cell* it) {
     if (!it || !cell_is_iterator(it)) return cell_nil();
     IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
@@ -5273,6 +8912,114 @@ Cell* cell_iterator_collect(Cell* it) {
     return result;
 }
 
+/* Range cursor over a sorted map: entries with lo <= key <= hi (either
+ * bound may be NULL for open), ascending or descending. Positioned with one
+ * tree descent; nothing is materialized until the first batch. */
+Cell* cell_sorted_map_iter(Cell* m, Cell* lo, Cell* hi, bool reverse) {
+    assert(m->type == CELL_SORTED_MAP);
+    Cell* it = cell_iterator_new(m);
+    IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
+    d->state.sorted_map.reverse = reverse;
+    if (lo) {
+        cell_retain(lo);
+        d->state.sorted_map.lo = lo;
+        d->state.sorted_map.lo_sk = cell_sort_key(lo);
+    }
+    if (hi) {
+        cell_retain(hi);
+        d->state.sorted_map.hi = hi;
+        d->state.sorted_map.hi_sk = cell_sort_key(hi);
+    }
+    uint32_t seq = olc_lock(&m->data.sorted_map.seq);
+    sm_cursor_start(d, m);
+    olc_unlock(&m->data.sorted_map.seq, seq, false);
+    return it;
+}
+
+/* Cursor over the trie keys starting with prefix (NULL = all), in byte
+ * order or reversed */
+Cell* cell_trie_iter(Cell* t, Cell* prefix, bool reverse) {
+    assert(t->type == CELL_TRIE);
+    Cell* it = cell_iterator_new(t);
+    IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
+    d->state.trie.reverse = reverse;
+    if (prefix) {
+        uint8_t* pbytes;
+        uint32_t plen;
+        art_key_from_cell(prefix, &pbytes, &plen);
+        d->state.trie.prefix = (uint8_t*)malloc(plen + 1);
+        memcpy(d->state.trie.prefix, pbytes, plen);
+        d->state.trie.prefix_len = plen;
+    }
+    uint32_t seq = olc_lock(&t->data.trie.seq);
+    trie_cursor_start(d, t);
+    olc_unlock(&t->data.trie.seq, seq, false);
+    return it;
+}
+
+/* Reposition a sorted-map or trie cursor: the next element is the first
+ * key >= key (descending cursors: the last key <= key), clamped to the
+ * cursor's bounds. Returns false for other iterators. */
+bool cell_iterator_seek(Cell* it, Cell* key) {
+    if (!it || !cell_is_iterator(it)) return false;
+    IteratorData* d = (IteratorData*)it->data.iterator.iter_data;
+    if (d->kind != ITER_SORTED_MAP && d->kind != ITER_TRIE) return false;
+
+    IterBatch* b = &d->batch;
+    for (uint16_t i = 0; i < b->count; i++) {
+        if (b->elems[i]) cell_release(b->elems[i]);
+        b->elems[i] = NULL;
+    }
+    b->count = 0;
+    b->sel_count = 0;
+    b->cursor = 0;
+    b->use_sel = false;
+    d->exhausted = false;
+
+    Cell* src = d->source;
+    if (d->kind == ITER_SORTED_MAP) {
+        bool reverse = d->state.sorted_map.reverse;
+        Cell* bound = reverse ? d->state.sorted_map.hi : d->state.sorted_map.lo;
+        uint64_t bound_sk = reverse ? d->state.sorted_map.hi_sk : d->state.sorted_map.lo_sk;
+        if (bound) {
+            int c = sm_order(cell_sort_key(key), key, bound_sk, bound);
+            if (reverse ? c > 0 : c < 0) key = bound;
+        }
+        /* Seek and refill under one hold, so the fill starts where the
+         * seek left the cursor */
+        uint32_t seq = olc_lock(&src->data.sorted_map.seq);
+        sm_cursor_seek(d, src, key, false);
+        sm_cursor_fill(it, b);
+        olc_unlock(&src->data.sorted_map.seq, seq, false);
+    } else {
+        bool reverse = d->state.trie.reverse;
+        uint8_t* kb;
+        uint32_t klen;
+        art_key_from_cell(key, &kb, &klen);
+        uint8_t* tb = (uint8_t*)malloc(klen + 1);
+        memcpy(tb, kb, klen);
+        bool inf = false;
+        if (d->state.trie.prefix) {
+            const uint8_t* p = d->state.trie.prefix;
+            uint32_t plen = d->state.trie.prefix_len;
+            int c = art_key_cmp(tb, klen, p, plen, reverse);
+            if (reverse ? c > 0 : c < 0) {
+                /* Before the prefix range: start at its edge */
+                tb = (uint8_t*)realloc(tb, plen + 1);
+                memcpy(tb, p, plen);
+                klen = plen;
+                inf = reverse;
+            }
+        }
+        uint32_t seq = olc_lock(&src->data.trie.seq);
+        trie_cursor_seek(d, src, tb, klen, false, inf);
+        trie_cursor_fill(it, b);
+        olc_unlock(&src->data.trie.seq, seq, false);
+        free(tb);
+    }
+    return true;
+}
+
 /* --- Transformer iterator constructors --- */
 
 /* Helper: auto-coerce collection to iterator */
@@ -81,9 +81,18 @@ typedef enum {
     CELL_PORT,           /* ⊞⊳ - I/O port (FILE* wrapper) */
     CELL_DIR,            /* ≋⊙ - directory stream (DIR* wrapper) */
     CELL_FFI_PTR,        /* ⌁ - opaque C pointer with GC finalizer */
-    CELL_ATOM_INTEGER    /* #42i - native int64 (HFT-grade zero-conversion) */
+    CELL_ATOM_INTEGER,   /* #42i - native int64 (HFT-grade zero-conversion) */
+    CELL_PMAP,           /* ⊞ᵖ - persistent hash map (CHAMP, structural sharing) */
+    CELL_PSET,           /* ⊡ᵖ - persistent hash set (CHAMP, structural sharing) */
+    CELL_TABLE           /* ⊙▦ - record table (columnar, one array per struct field) */
 } CellType;
 
+/* Operand kinds recorded at application sites (pair.site_types):
+ * operand 0 in the low nibble, operand 1 in the high nibble */
+#define SITE_T_INT    0x1
+#define SITE_T_NUM    0x2
+#define SITE_T_OTHER  0x4
+
 /* Port Type Flags */
 typedef enum {
     PORT_INPUT     = 1 << 0,
@@ -136,6 +145,13 @@ typedef enum {
 /* Forward declaration */
 typedef struct Cell Cell;
 
+/* Arena residency of a cell (see cell_arena_* below) */
+enum {
+    ARENA_NONE = 0,   /* Shared per-thread slab heap (or tenured out of an arena) */
+    ARENA_LIVE = 1,   /* Allocated in a per-actor arena, still referenced */
+    ARENA_FREE = 2    /* Released back to its arena's free list */
+};
+
 /* Hash map slot (key-value pair) */
 typedef struct {
     Cell* key;
@@ -174,6 +190,9 @@ struct Cell {
     /* GC mark bit */
     bool marked;
 
+    /* Arena residency (ARENA_NONE = shared slab heap) */
+    uint8_t arena_state;
+
     /* Source location (8 bytes) — every cell knows where it came from */
     Span span;
 
@@ -183,13 +202,22 @@ struct Cell {
         struct {
             Cell* car;  /* Head (◁) */
             Cell* cdr;  /* Tail (▷) */
+            /* Inline cache, used when this pair is an application site */
+            Cell* site_callee;    /* Primitive the head resolved to */
+            uint64_t site_epoch;  /* Global epoch it was resolved at */
+            uint8_t site_types;   /* SITE_T_* seen, one nibble per operand */
+            uint8_t hash_memo_family; /* 1 + CellHashFamily of hash_memo, 0 = none */
+            uint16_t site_slot;   /* Struct field slot last resolved here (a hint) */
+            uint64_t hash_memo;   /* Structural hash, cached once the subtree is stable */
         } pair;
         struct {
             Cell* env;     /* Lexical environment */
             Cell* body;    /* Lambda body */
             int arity;     /* Number of parameters */
+            uint32_t jit_calls;         /* Hot-call counter (jit.c) */
             const char* source_module;  /* Module/file where defined - Day 27 */
             int source_line;            /* Line number in source - Day 27 */
+            uint32_t jit_slot;          /* JIT code cache entry + 1, 0 = none */
             Cell* constraints;          /* List of (param_idx . :TraitName) pairs, or NULL */
             const char** param_names;  /* Preserved from source (strdup'd, NULL if unavailable) */
         } lambda;
@@ -206,18 +234,23 @@ struct Cell {
             StructKind kind;      /* LEAF, NODE, or GRAPH */
             Cell* type_tag;       /* :Point, :List, :Tree, etc */
             Cell* variant;        /* :Nil, :Cons, etc (for ADTs) or NULL */
-            Cell* fields;         /* Alist of (field . value) pairs */
+            Cell* fields;         /* Alist of (field . value) pairs (slotted: built on first request) */
+            Cell* layout;         /* Slotted: field-symbol vector shared by the type, NULL = alist */
+            Cell** slots;         /* Slotted: values by field position */
         } structure;
         struct {
             GraphType graph_type; /* CFG, DFG, CALL, DEP, or GENERIC */
+            uint32_t index_ops;   /* Node/edge additions of the index this graph sees */
             Cell* nodes;          /* List of node cells */
             Cell* edges;          /* List of edge cells ⟨from to label⟩ */
             Cell* metadata;       /* Additional properties (alist) */
             Cell* entry;          /* Entry point (for CFG) or NULL */
             Cell* exit;           /* Exit point (for CFG) or NULL */
+            void* index;          /* GraphIndex* adjacency (cell.c), NULL until first needed */
         } graph;
         struct {
             int actor_id;         /* Actor registry ID */
+            uint32_t call_ref;    /* actor-call reply tag (0 = plain handle) */
         } actor;
         struct {
             int channel_id;       /* Channel registry ID */
@@ -234,6 +267,11 @@ struct Cell {
             uint32_t size;        /* Live entries */
             uint32_t capacity;    /* Total slots (power of 2, min GROUP_WIDTH) */
             uint32_t growth_left; /* Slots remaining before resize */
+            uint32_t old_capacity; /* Capacity of the table being drained (0 = none) */
+            uint8_t* old_ctrl;    /* Incremental resize: previous table, drained */
+            HashSlot* old_slots;  /*   a few groups per put/delete */
+            uint32_t migrate_pos; /* Next old slot to move into the live table */
+            uint8_t hash_family;  /* CellHashFamily used for keys */
         } hashmap;
         struct {
             uint8_t* metadata;    /* 16-byte aligned: n_groups × 16 bytes (15 tags + 1 overflow) */
@@ -241,6 +279,11 @@ struct Cell {
             uint32_t size;        /* Live elements */
             uint32_t n_groups;    /* Power of 2 */
             uint32_t ml_left;     /* Remaining inserts before rehash */
+            uint32_t old_n_groups; /* Groups of the table being drained (0 = none) */
+            uint8_t* old_metadata; /* Incremental resize: previous table, drained */
+            Cell** old_elements;  /*   a few groups per add/remove */
+            uint32_t migrate_group; /* Next old group to move into the live table */
+            uint8_t hash_family;  /* CellHashFamily used for elements */
         } hashset;
         struct {
             Cell** buffer;        /* Cache-line aligned (64-byte) circular buffer */
@@ -260,6 +303,8 @@ struct Cell {
             };
             uint32_t size;        /* Element count */
             uint32_t capacity;    /* ≤4 = SBO mode, >4 = heap mode */
+            uint64_t hash_memo;   /* Structural hash, cleared by every mutation */
+            uint8_t hash_memo_family; /* 1 + CellHashFamily of hash_memo, 0 = none */
         } vector;
         struct {
             double*  keys;        /* Cache-line aligned priority array */
@@ -273,12 +318,32 @@ struct Cell {
             uint32_t first_leaf;  /* Leftmost leaf index (O(1) min) */
             uint32_t last_leaf;   /* Rightmost leaf index (O(1) max) */
             uint32_t size;        /* Total entries */
+            uint32_t version;     /* Bumped by inserts/deletes (cursors re-seek) */
+            uint32_t seq;         /* Odd while written (optimistic readers retry) */
             uint8_t  height;      /* Tree height (for search loop bound) */
         } sorted_map;
         struct {
             void*    root;        /* ART root node (ARTNode* or ARTLeaf*, tagged) */
             uint32_t size;        /* Total key-value pairs */
+            uint32_t version;     /* Bumped by inserts/deletes (cursors re-seek) */
+            uint32_t seq;         /* Odd while written (optimistic readers retry) */
+            void*    retired;     /* RetireList* of unlinked nodes/leaves (cell.c) */
         } trie;
+        struct {
+            void*    root;        /* ChampNode* (defined in cell.c), shared between versions */
+            uint64_t edit;        /* Transient edit token, 0 = persistent */
+            uint32_t size;        /* Total entries */
+            bool     sealed;      /* Transient already turned persistent */
+        } champ;
+        struct {
+            void*    columns;     /* TableColumn[n_cols] (defined in cell.c) */
+            Cell*    type_tag;    /* Leaf struct type of the rows */
+            Cell*    fields;      /* Field symbols, in column order */
+            Cell*    layout;      /* Slot layout of materialized rows */
+            uint32_t size;        /* Rows */
+            uint32_t capacity;    /* Rows allocated in every column */
+            uint16_t n_cols;
+        } table;
         struct {
             void*    iter_data;   /* IteratorData* (defined in iter_batch.h) */
         } iterator;
@@ -304,6 +369,48 @@ struct Cell {
 /* Allocation stats (for leak detection) */
 uint64_t cell_get_alloc_count(void);
 
+/* ── Per-actor cell arenas (BEAM-style private heaps) ──
+ * While an arena is entered on a thread, every new cell comes from it.
+ * cell_arena_destroy frees the whole arena in one sweep; cells still
+ * referenced from outside are tenured in place instead of freed. */
+typedef struct CellArena CellArena;
+
+CellArena* cell_arena_new(void);
+void       cell_arena_destroy(CellArena* arena);
+CellArena* cell_arena_enter(CellArena* arena);  /* Returns previously entered arena */
+CellArena* cell_arena_current(void);
+uint32_t   cell_arena_slab_count(CellArena* arena);
+uint64_t   cell_arena_alloc_count(CellArena* arena);
+/* Copy-on-send: returns an owned reference that lives outside any arena.
+ * Immutable data (atoms, strings, lists, structs, errors) is copied out;
+ * other arena cells are shared and tenured when the arena is destroyed. */
+Cell*      cell_arena_promote(Cell* c);
+
+/* Frozen subgraphs — zero-copy sharing of large immutable values.
+ * cell_freeze turns every cell reachable from root into a member of one
+ * frozen region: biased = BRC_IMMORTAL, owner_tid = FROZEN_TID_BASE + region.
+ * Retain/release of a member only touches the region's single counter (one
+ * cache line per region, never per cell), so fan-out to many receivers
+ * costs one atomic add per pair. The release that drops the counter to
+ * zero frees the whole region. Only cells owned by the freezing thread
+ * become members; the root must be one of them. */
+#define FROZEN_TID_BASE    0x8000u
+#define FROZEN_MAX_REGIONS 4096u
+
+static inline bool cell_is_frozen(const Cell* c) {
+    return c && c->rc.biased == BRC_IMMORTAL &&
+           (uint16_t)(c->rc.owner_tid - FROZEN_TID_BASE) < FROZEN_MAX_REGIONS;
+}
+
+/* Only the owning thread may read a cell's biased counter; cells disowned
+ * to the shared domain have none left to race on */
+static inline bool cell_owned_here(const Cell* c) {
+    return c->rc.owner_tid == tls_scheduler_id || c->rc.owner_tid == UINT16_MAX;
+}
+
+Cell*    cell_freeze(Cell* root);        /* Returns NULL on success, else the offender */
+uint32_t cell_frozen_region_count(void);
+
 /* Cell creation functions */
 Cell* cell_integer(int64_t n);
 Cell* cell_number(double n);
@@ -399,7 +506,17 @@ void cell_weak_release(Cell* c);
 /* HashMap operations */
 Cell* cell_hashmap_new(uint32_t initial_capacity);
 bool cell_is_hashmap(Cell* c);
+/* Hash families for keys. SipHash-2-4 (keyed PRF) is the default and safe
+ * for untrusted input; FAST (wyhash-style, fasthash.h) is several times
+ * cheaper but offers no flooding resistance — opt in per map for trusted keys. */
+typedef enum {
+    CELL_HASH_SIP = 0,
+    CELL_HASH_FAST = 1
+} CellHashFamily;
+
 uint64_t cell_hash(Cell* c);
+uint64_t cell_hash_with(Cell* c, CellHashFamily family);
+Cell* cell_hashmap_new_with(uint32_t initial_capacity, CellHashFamily family);
 Cell* cell_hashmap_get(Cell* map, Cell* key);
 Cell* cell_hashmap_put(Cell* map, Cell* key, Cell* value);
 Cell* cell_hashmap_delete(Cell* map, Cell* key);
@@ -409,9 +526,12 @@ Cell* cell_hashmap_keys(Cell* map);
 Cell* cell_hashmap_values(Cell* map);
 Cell* cell_hashmap_entries(Cell* map);
 Cell* cell_hashmap_merge(Cell* m1, Cell* m2);
+void cell_hashmap_reserve(Cell* map, uint32_t n);
+void cell_hashmap_settle(Cell* map);
 
 /* HashSet operations (Boost-style groups-of-15 + overflow Bloom byte) */
 Cell* cell_hashset_new(uint32_t initial_n_groups);
+Cell* cell_hashset_new_with(uint32_t initial_n_groups, CellHashFamily family);
 bool cell_is_hashset(Cell* c);
 bool cell_hashset_add(Cell* set, Cell* val);
 bool cell_hashset_remove(Cell* set, Cell* val);
@@ -422,6 +542,7 @@ Cell* cell_hashset_union(Cell* s1, Cell* s2);
 Cell* cell_hashset_intersection(Cell* s1, Cell* s2);
 Cell* cell_hashset_difference(Cell* s1, Cell* s2);
 bool cell_hashset_subset(Cell* s1, Cell* s2);
+void cell_hashset_settle(Cell* set);
 
 /* Deque operations (DPDK-grade cache-optimized circular buffer) */
 Cell* cell_deque_new(uint32_t initial_cap);
@@ -481,11 +602,15 @@ Cell* cell_sorted_map_keys(Cell* m);
 Cell* cell_sorted_map_values(Cell* m);
 Cell* cell_sorted_map_entries(Cell* m);
 Cell* cell_sorted_map_merge(Cell* m1, Cell* m2);
+Cell* cell_sorted_map_from_sorted(Cell** keys, Cell** values, uint32_t n);
 Cell* cell_sorted_map_min(Cell* m);
 Cell* cell_sorted_map_max(Cell* m);
 Cell* cell_sorted_map_range(Cell* m, Cell* lo, Cell* hi);
 Cell* cell_sorted_map_floor(Cell* m, Cell* key);
 Cell* cell_sorted_map_ceiling(Cell* m, Cell* key);
+uint32_t cell_sorted_map_rank(Cell* m, Cell* key);
+Cell* cell_sorted_map_nth(Cell* m, uint32_t n);
+uint32_t cell_sorted_map_count_range(Cell* m, Cell* lo, Cell* hi);
 
 /* Trie operations (ART — Adaptive Radix Tree with SIMD Node16) */
 Cell* cell_trie_new(void);
@@ -503,6 +628,58 @@ Cell* cell_trie_entries(Cell* t);
 Cell* cell_trie_keys(Cell* t);
 Cell* cell_trie_values(Cell* t);
 
+/* Persistent map/set operations (CHAMP — path-copying, structural sharing).
+ * Maps and sets share one implementation; a set's entries have no value.
+ * cell_pmap_put/del return a new version and leave the argument untouched.
+ * A transient takes the _mut edits in place until cell_champ_persistent
+ * seals it; nodes it has not copied yet stay shared with its source. */
+Cell* cell_pmap_new(void);
+Cell* cell_pset_new(void);
+bool cell_is_pmap(Cell* c);
+bool cell_is_pset(Cell* c);
+bool cell_champ_is_transient(Cell* c);
+Cell* cell_pmap_get(Cell* m, Cell* key);
+bool cell_pmap_has(Cell* m, Cell* key);
+uint32_t cell_pmap_size(Cell* m);
+Cell* cell_pmap_put(Cell* m, Cell* key, Cell* value);
+Cell* cell_pmap_del(Cell* m, Cell* key);
+Cell* cell_pmap_keys(Cell* m);
+Cell* cell_pmap_values(Cell* m);
+Cell* cell_pmap_entries(Cell* m);
+Cell* cell_pmap_merge(Cell* m1, Cell* m2);
+Cell* cell_champ_transient(Cell* m);
+void  cell_pmap_put_mut(Cell* t, Cell* key, Cell* value);
+void  cell_pmap_del_mut(Cell* t, Cell* key);
+Cell* cell_champ_persistent(Cell* t);
+
+/* Record table operations (⊙▦ — struct-of-arrays over a leaf struct type).
+ * Each column stays unboxed (int64 or double) while every value pushed
+ * into it has that type, and turns into boxed cells at the first value
+ * that does not. Filter/aggregate kernels run over the raw column arrays
+ * a morsel (ITER_BATCH_CAP rows) at a time; rows become structs only when
+ * read. Column indexes come from cell_table_column (-1 = no such field). */
+typedef enum {
+    TABLE_OP_LT, TABLE_OP_LE, TABLE_OP_GT, TABLE_OP_GE, TABLE_OP_EQ, TABLE_OP_NE
+} TableOp;
+
+typedef enum {
+    TABLE_AGG_COUNT, TABLE_AGG_SUM, TABLE_AGG_MIN, TABLE_AGG_MAX, TABLE_AGG_MEAN
+} TableAgg;
+
+Cell* cell_table_new(Cell* type_tag, Cell* fields);
+bool cell_is_table(Cell* c);
+uint32_t cell_table_size(Cell* t);
+int cell_table_column(Cell* t, Cell* field);
+const char* cell_table_column_kind(Cell* t, int col);
+bool cell_table_push(Cell* t, Cell* row);
+Cell* cell_table_get(Cell* t, uint32_t row, int col);
+Cell* cell_table_row(Cell* t, uint32_t row);
+Cell* cell_table_column_values(Cell* t, int col);
+Cell* cell_table_filter(Cell* t, int col, TableOp op, Cell* value);
+Cell* cell_table_project(Cell* t, const int* cols, uint16_t n_cols);
+Cell* cell_table_aggregate(Cell* t, int col, TableAgg agg);
+Cell* cell_table_scan(Cell* t, int col, TableOp op, Cell* value);
+
 /* Iterator operations (⊣ — morsel-driven batch iteration) */
 Cell* cell_iterator_new(Cell* source);
 Cell* cell_iterator_next(Cell* it);
@@ -515,6 +692,9 @@ Cell* cell_iterator_take(Cell* it, uint32_t n);
 Cell* cell_iterator_drop(Cell* it, uint32_t n);
 Cell* cell_iterator_chain(Cell* it1, Cell* it2);
 Cell* cell_iterator_zip(Cell* it1, Cell* it2);
+bool  cell_iterator_seek(Cell* it, Cell* key);
+Cell* cell_sorted_map_iter(Cell* m, Cell* lo, Cell* hi, bool reverse);
+Cell* cell_trie_iter(Cell* t, Cell* prefix, bool reverse);
 
 /* Port/Dir predicates and accessors */
 bool cell_is_port(Cell* c);
@@ -567,6 +747,19 @@ Cell* cell_struct_variant(Cell* c);
 Cell* cell_struct_fields(Cell* c);
 Cell* cell_struct_get_field(Cell* c, Cell* field_name);
 
+/* Slotted structs: values stored by field position. A layout is a vector of
+ * field symbols built once per struct type (or ADT variant) and shared by
+ * all its instances; cell_struct_fields builds the alist view on demand.
+ * cell_struct_slot_of tries slot `hint` first (-1 = none). */
+Cell* cell_struct_layout_new(Cell* field_names);
+uint16_t cell_struct_layout_size(Cell* layout);
+Cell* cell_struct_slotted(StructKind kind, Cell* type_tag, Cell* variant,
+                          Cell* layout, Cell** values);
+Cell* cell_struct_layout(Cell* c);
+int cell_struct_slot_of(Cell* c, Cell* field_name, int hint);
+Cell* cell_struct_slot(Cell* c, int slot);
+Cell* cell_struct_with_slot(Cell* c, int slot, Cell* value);
+
 /* Graph accessors */
 GraphType cell_graph_type(Cell* c);
 Cell* cell_graph_nodes(Cell* c);
@@ -581,6 +774,19 @@ Cell* cell_graph_add_edge(Cell* graph, Cell* from, Cell* to, Cell* label);
 Cell* cell_graph_set_entry(Cell* graph, Cell* entry);
 Cell* cell_graph_set_exit(Cell* graph, Cell* exit);
 
+/* Graph algorithms over the adjacency index. Node values are interned to
+ * dense ids the first time a graph is queried; graph-add-node/-add-edge
+ * then extend that index in place, and each graph version sees only the
+ * additions it was built from. */
+Cell* cell_graph_successors(Cell* graph, Cell* node);
+Cell* cell_graph_predecessors(Cell* graph, Cell* node);
+Cell* cell_graph_walk(Cell* graph, Cell* start, bool depth_first);
+bool cell_graph_reachable(Cell* graph, Cell* from, Cell* to);
+Cell* cell_graph_path(Cell* graph, Cell* from, Cell* to);
+Cell* cell_graph_cycles(Cell* graph);
+Cell* cell_graph_topo_sort(Cell* graph);
+Cell* cell_graph_shortest(Cell* graph, Cell* from, Cell* to);
+
 /* Printing */
 void cell_print(Cell* c);
 void cell_println(Cell* c);
@@ -59,6 +59,10 @@ uint64_t g_prof_env_steps = 0;
 /* ── O(1) global binding table (indexed by intern sym_id) ── */
 static Cell* g_global_table[4096];
 
+/* Bumped when a definition rebinds a name that meant a builtin; inline
+ * caches and JIT traces revalidate on change */
+static uint64_t g_global_epoch = 0;
+
 /* ============ Helper Data Structures for Dependency Extraction ============ */
 
 /* Set of symbols (for tracking parameters) */
@@ -271,8 +275,20 @@ static void extract_dependencies(Cell* expr, SymbolSet* params, DepList* deps) {
 
 /* ============ Documentation API ============ */
 
-/* Forward declaration */
+/* Forward declarations */
 static FunctionDoc* doc_find(EvalContext* ctx, const char* name);
+static void doc_complete(EvalContext* ctx, FunctionDoc* doc);
+
+/* Production mode: document lambdas on first lookup instead of on define */
+static bool g_lazy_docs = false;
+
+void eval_set_lazy_docs(bool lazy) {
+    g_lazy_docs = lazy;
+}
+
+bool eval_lazy_docs(void) {
+    return g_lazy_docs;
+}
 
 /* Thread-local current context (for primitives to access user docs) */
 static _Thread_local EvalContext* g_current_context = NULL;
@@ -305,20 +321,25 @@ static FunctionDoc* doc_create(const char* name) {
     doc->arity = 0;
     doc->dependencies = NULL;
     doc->dependency_count = 0;
+    doc->pending = NULL;
     doc->next = NULL;
     return doc;
 }
 
-/* Find documentation by name */
+/* Add to the context's doc list; the index points at the newest entry */
+static void doc_add(EvalContext* ctx, FunctionDoc* doc) {
+    doc->next = ctx->user_docs;
+    ctx->user_docs = doc;
+    strtable_put(&ctx->doc_index, doc->name, doc);
+}
+
+/* Find documentation by name, documenting a pending lambda first */
 static FunctionDoc* doc_find(EvalContext* ctx, const char* name) {
-    FunctionDoc* current = ctx->user_docs;
-    while (current) {
-        if (strcmp(current->name, name) == 0) {
-            return current;
-        }
-        current = current->next;
+    FunctionDoc* doc = (FunctionDoc*)strtable_get(&ctx->doc_index, name);
+    if (doc && doc->pending) {
+        doc_complete(ctx, doc);
     }
-    return NULL;
+    return doc;
 }
 
 /* Get description of a dependency (primitive or user function) */
@@ -1257,6 +1278,30 @@ static void doc_generate_description(EvalContext* ctx, FunctionDoc* doc, Cell* b
     symbol_set_free(params);
 }
 
+/* Description and type for a lambda, with fallbacks */
+static void doc_fill(EvalContext* ctx, FunctionDoc* doc, Cell* lambda, const char* name) {
+    /* Generate docs - graceful degradation on failure */
+    doc_generate_description(ctx, doc, lambda->data.lambda.body,
+                             lambda->data.lambda.param_names,
+                             lambda->data.lambda.arity, name);
+    if (!doc->description) {
+        doc->description = strdup("undocumented");
+    }
+
+    doc_infer_type(doc, lambda);
+    if (!doc->type_signature) {
+        doc->type_signature = strdup("α -> β");
+    }
+}
+
+/* Document a lambda recorded in production mode */
+static void doc_complete(EvalContext* ctx, FunctionDoc* doc) {
+    Cell* lambda = doc->pending;
+    doc->pending = NULL;  /* Lookups from mutual recursion see it as undocumented */
+    doc_fill(ctx, doc, lambda, doc->name);
+    cell_release(lambda);
+}
+
 /* ============ End Documentation API ============ */
 
 /* Create new evaluation context */
@@ -1266,29 +1311,48 @@ EvalContext* eval_context_new(void) {
     ctx->global_env = ctx->env;
     ctx->primitives = primitives_init();
     ctx->user_docs = NULL;  /* Initialize doc list */
+    strtable_init(&ctx->doc_index, 64);
     ctx->type_registry = cell_nil();  /* Initialize type registry */
+    ctx->struct_layouts = cell_hashmap_new(16);
     ctx->effect_registry = cell_nil();  /* Initialize effect registry */
     ctx->reductions_left = 0;    /* 0 = disabled (REPL/non-actor eval) */
     ctx->continuation = NULL;
     ctx->continuation_env = NULL;
+    ctx->eval_depth = 0;
+    ctx->stack_limit = NULL;
     macro_init();  /* Initialize macro system */
     return ctx;
 }
 
+/* Drop everything a doc entry holds except its name and list link */
+static void doc_reset(FunctionDoc* doc) {
+    free(doc->summary);
+    free(doc->description);
+    free(doc->flow_info);
+    free(doc->type_signature);
+    /* param_names are borrowed from lambda, not freed here */
+    for (size_t i = 0; i < doc->dependency_count; i++) {
+        free(doc->dependencies[i]);
+    }
+    free(doc->dependencies);
+    if (doc->pending) cell_release(doc->pending);
+    doc->summary = NULL;
+    doc->description = NULL;
+    doc->flow_info = NULL;
+    doc->type_signature = NULL;
+    doc->param_names = NULL;
+    doc->arity = 0;
+    doc->dependencies = NULL;
+    doc->dependency_count = 0;
+    doc->pending = NULL;
+}
+
 /* Free documentation list */
 static void doc_free_all(FunctionDoc* head) {
     while (head) {
         FunctionDoc* next = head->next;
+        doc_reset(head);
         free(head->name);
-        free(head->summary);
-        free(head->description);
-        free(head->flow_info);
-        free(head->type_signature);
-        /* param_names are borrowed from lambda, not freed here */
-        for (size_t i = 0; i < head->dependency_count; i++) {
-            free(head->dependencies[i]);
-        }
-        free(head->dependencies);
         free(head);
         head = next;
     }
@@ -1299,8 +1363,10 @@ void eval_context_free(EvalContext* ctx) {
     cell_release(ctx->env);
     cell_release(ctx->primitives);
     cell_release(ctx->type_registry);
+    cell_release(ctx->struct_layouts);
     cell_release(ctx->effect_registry);
     doc_free_all(ctx->user_docs);
+    strtable_free(&ctx->doc_index, NULL);
     free(ctx);
 }
 
@@ -1361,6 +1427,54 @@ Cell* eval_lookup(EvalContext* ctx, const char* name) {
     return primitives_lookup(ctx->primitives, name);
 }
 
+/* Lookup ignoring local bindings: global table, then primitives */
+Cell* eval_lookup_global(EvalContext* ctx, const char* name) {
+    InternResult r = intern(name);
+    Cell* val = g_global_table[r.id];
+    if (val) {
+        cell_retain(val);
+        return val;
+    }
+    return primitives_lookup(ctx->primitives, name);
+}
+
+_Thread_local Cell* tls_apply_site = NULL;
+
+uint64_t eval_global_epoch(void) {
+    return __atomic_load_n(&g_global_epoch, __ATOMIC_ACQUIRE);
+}
+
+/* Remember the primitive an application site's head resolved to. Only
+ * primitive-table entries are cached: they are never freed, and any
+ * definition that could shadow one moves the epoch on. */
+static void site_cache_callee(Cell* site, Cell* head, Cell* fn, uint64_t epoch) {
+    if (fn->type != CELL_BUILTIN || g_global_table[head->sym_id]) return;
+    const char* name = cell_get_symbol(head);
+    const char* dot = strchr(name, '.');
+    if (name[0] == ':' || (dot && dot != name && dot[1] != '\0')) return;
+    __atomic_store_n(&site->data.pair.site_callee, fn, __ATOMIC_RELAXED);
+    __atomic_store_n(&site->data.pair.site_epoch, epoch, __ATOMIC_RELEASE);
+}
+
+static inline uint8_t site_kind(Cell* v) {
+    if (v->type == CELL_ATOM_INTEGER) return SITE_T_INT;
+    if (v->type == CELL_ATOM_NUMBER) return SITE_T_NUM;
+    return SITE_T_OTHER;
+}
+
+/* Type feedback: OR the kinds of the first two operands into the site,
+ * for the JIT to specialise on. Only writes when something new shows up. */
+static void site_note_types(Cell* site, Cell* args) {
+    if (!cell_is_pair(args)) return;
+    uint8_t t = site_kind(cell_car(args));
+    Cell* rest = cell_cdr(args);
+    if (cell_is_pair(rest)) t |= (uint8_t)(site_kind(cell_car(rest)) << 4);
+    uint8_t seen = __atomic_load_n(&site->data.pair.site_types, __ATOMIC_RELAXED);
+    if ((seen | t) != seen) {
+        __atomic_fetch_or(&site->data.pair.site_types, t, __ATOMIC_RELAXED);
+    }
+}
+
 /* Define global binding */
 void eval_define(EvalContext* ctx, const char* name, Cell* value) {
     /* Track this symbol in module registry */
@@ -1391,32 +1505,54 @@ void eval_define(EvalContext* ctx, const char* name, Cell* value) {
     {
         InternResult r = intern(name);
         Cell* old = g_global_table[r.id];
+        /* Inline caches and JIT guards only ever hold builtins, so only a
+         * name that meant one can invalidate them */
+        Cell* prim = old ? NULL : primitives_lookup(ctx->primitives, name);
+        bool was_builtin = old ? old->type == CELL_BUILTIN : prim != NULL;
+        if (prim) cell_release(prim);
         if (value) cell_retain(value);
         g_global_table[r.id] = value;
         if (old) cell_release(old);
+        if (was_builtin) __atomic_add_fetch(&g_global_epoch, 1, __ATOMIC_RELEASE);
     }
 
     /* Generate documentation if value is a lambda */
-    if (value && cell_is_lambda(value)) {
-        bool already_documented = (doc_find(ctx, name) != NULL);
-        FunctionDoc* doc = doc_create(name);
-
-        /* Generate docs - graceful degradation on failure */
-        doc_generate_description(ctx, doc, value->data.lambda.body,
-                                 value->data.lambda.param_names,
-                                 value->data.lambda.arity, name);
-        if (!doc->description) {
-            doc->description = strdup("undocumented");
+    if (!value || !cell_is_lambda(value)) {
+        /* Rebound to a non-function: drop the stale docs and release a
+         * pending lambda rather than pinning it for the context's life */
+        FunctionDoc* doc = (FunctionDoc*)strtable_get(&ctx->doc_index, name);
+        if (doc) doc_reset(doc);
+    } else {
+        /* Redefinition reuses the entry, so per-call helper defines
+         * (__agent_fn_N, __vec_fn_N, ...) do not grow the list */
+        FunctionDoc* doc = (FunctionDoc*)strtable_get(&ctx->doc_index, name);
+        bool already_documented = (doc != NULL);
+        if (g_lazy_docs) {
+            /* Production mode: nothing is built or printed until asked for.
+             * Internal names are never documented, so do not pin them. */
+            if (strncmp(name, "__", 2) == 0) {
+                if (doc) doc_reset(doc);
+                return;
+            }
+            if (doc) {
+                doc_reset(doc);
+            } else {
+                doc = doc_create(name);
+                doc_add(ctx, doc);
+            }
+            cell_retain(value);
+            doc->pending = value;
+            return;
         }
 
-        doc_infer_type(doc, value);
-        if (!doc->type_signature) {
-            doc->type_signature = strdup("α -> β");
+        if (doc) {
+            doc_reset(doc);
+        } else {
+            doc = doc_create(name);
+            /* Add to context's doc list (always, for lookup by parent docs) */
+            doc_add(ctx, doc);
         }
-
-        /* Add to context's doc list (always, for lookup by parent docs) */
-        doc->next = ctx->user_docs;
-        ctx->user_docs = doc;
+        doc_fill(ctx, doc, value, name);
 
         /* Print documentation — skip internal/anonymous names AND redefinitions */
         if (!already_documented && strncmp(name, "__", 2) != 0) {
@@ -1765,8 +1901,65 @@ bool env_is_indexed(Cell* env) {
     return true;
 }
 
-/* Evaluate expression with proper tail call optimization */
+static Cell* eval_frame(EvalContext* ctx, Cell* env, Cell* expr);
+
+/* Evaluate expression with proper tail call optimization. The depth count
+ * tells a fiber's root frame, the only one a reduction yield can resume.
+ * On a fiber, recursion that reaches the stack reserve is an error value,
+ * so the actor fails instead of the process faulting on the guard page. */
 Cell* eval_internal(EvalContext* ctx, Cell* env, Cell* expr) {
+    if (UNLIKELY(ctx->stack_limit && (char*)__builtin_frame_address(0) < ctx->stack_limit))
+        return cell_error("stack-overflow", expr);
+    ctx->eval_depth++;
+    Cell* result = eval_frame(ctx, env, expr);
+    ctx->eval_depth--;
+    return result;
+}
+
+/* Apply a function value to evaluated arguments, for primitives that call
+ * back into user code. Plain lambdas and builtins are entered directly;
+ * trait-constrained lambdas and arity mismatches go through the evaluator
+ * as ((quote fn) (quote arg) ...) so they get its checks and errors.
+ * Borrows fn and args. */
+Cell* eval_apply(EvalContext* ctx, Cell* fn, Cell* args) {
+    if (fn->type == CELL_BUILTIN) {
+        Cell* (*builtin_fn)(Cell*) = (Cell* (*)(Cell*))fn->data.atom.builtin;
+        return builtin_fn(args);
+    }
+    if (fn->type == CELL_LAMBDA && !fn->data.lambda.constraints &&
+        list_length(args) == fn->data.lambda.arity) {
+        Cell* env = extend_env(fn->data.lambda.env, args);
+        Cell* result = eval_internal(ctx, env, fn->data.lambda.body);
+        cell_release(env);
+        return result;
+    }
+    Cell* quote = cell_symbol("quote");
+    Cell* rev = cell_nil();
+    for (Cell* a = args; cell_is_pair(a); a = cell_cdr(a)) {
+        Cell* q = cell_cons(quote, cell_cons(cell_car(a), cell_nil()));
+        Cell* next = cell_cons(q, rev);
+        cell_release(q);
+        cell_release(rev);
+        rev = next;
+    }
+    Cell* call = cell_nil();
+    for (Cell* a = rev; cell_is_pair(a); a = cell_cdr(a)) {
+        Cell* next = cell_cons(cell_car(a), call);
+        cell_release(call);
+        call = next;
+    }
+    cell_release(rev);
+    Cell* qfn = cell_cons(quote, cell_cons(fn, cell_nil()));
+    Cell* full = cell_cons(qfn, call);
+    cell_release(qfn);
+    cell_release(call);
+    cell_release(quote);
+    Cell* result = eval_internal(ctx, ctx->env, full);
+    cell_release(full);
+    return result;
+}
+
+static Cell* eval_frame(EvalContext* ctx, Cell* env, Cell* expr) {
     Cell* owned_env = NULL;   /* Track owned environments for cleanup */
     Cell* owned_expr = NULL;  /* Track owned expressions for cleanup */
 
@@ -1774,8 +1967,16 @@ tail_call:  /* TCO: loop back here instead of recursive call */
     if (UNLIKELY(g_profile_enabled)) g_prof_eval_steps++;
     /* BEAM-style reduction counting: yield when budget exhausted */
     if (ctx->reductions_left > 0) {
-        if (--ctx->reductions_left <= 0) {
-            /* Save continuation for scheduler to resume */
+        if (--ctx->reductions_left <= 0 && ctx->eval_depth > 1) {
+            /* Nested frame: the yield waits until the root frame runs */
+            ctx->reductions_left = 1;
+        } else if (ctx->reductions_left <= 0) {
+            /* Save continuation for scheduler to resume (owned; a stale
+             * one from a yield inside a nested eval is dropped) */
+            if (ctx->continuation) cell_release(ctx->continuation);
+            if (ctx->continuation_env) cell_release(ctx->continuation_env);
+            cell_retain(expr);
+            cell_retain(env);
             ctx->continuation = expr;
             ctx->continuation_env = env;
             if (owned_expr) cell_release(owned_expr);
@@ -3450,7 +3651,14 @@ tail_call:  /* TCO: loop back here instead of recursive call */
         /* Function application */
         /* Special case: :? primitive lookup (keyword exception) */
         Cell* fn;
-        if (cell_is_symbol(first)) {
+        bool site_global = cell_is_symbol(first) && ctx->env == ctx->global_env;
+        uint64_t epoch = eval_global_epoch();
+        if (site_global &&
+            __atomic_load_n(&expr->data.pair.site_epoch, __ATOMIC_ACQUIRE) == epoch &&
+            (fn = __atomic_load_n(&expr->data.pair.site_callee, __ATOMIC_RELAXED))) {
+            /* Inline cache hit: same primitive as last time */
+            cell_retain(fn);
+        } else if (cell_is_symbol(first)) {
             const char* fn_name = cell_get_symbol(first);
             if (strcmp(fn_name, "symbol?") == 0) {
                 /* Look up :? as primitive, not keyword */
@@ -3466,18 +3674,24 @@ tail_call:  /* TCO: loop back here instead of recursive call */
             } else {
                 fn = eval_internal(ctx, env, first);
             }
+            if (site_global) site_cache_callee(expr, first, fn, epoch);
         } else {
             fn = eval_internal(ctx, env, first);
         }
 
         Cell* args = eval_list(ctx, env, rest);
+        if (fn->type == CELL_BUILTIN) site_note_types(expr, args);
 
+apply_fn:
         /* Inline apply() for TCO */
         if (fn->type == CELL_BUILTIN) {
             if (UNLIKELY(g_profile_enabled)) g_prof_builtin_calls++;
             /* Call builtin primitive - not a tail call */
             Cell* (*builtin_fn)(Cell*) = (Cell* (*)(Cell*))fn->data.atom.builtin;
+            Cell* outer_site = tls_apply_site;
+            tls_apply_site = expr;
             Cell* result = builtin_fn(args);
+            tls_apply_site = outer_site;
             cell_release(fn);
             cell_release(args);
             return result;
@@ -3486,29 +3700,59 @@ tail_call:  /* TCO: loop back here instead of recursive call */
         if (fn->type == CELL_LAMBDA) {
             if (UNLIKELY(g_profile_enabled)) g_prof_lambda_calls++;
 
-            /* JIT hot tracking - record call for potential compilation */
-            if (jit_is_enabled()) {
-                jit_record_call(fn);
+            /* JIT: hot lambdas run their compiled trace. In preemptible
+             * contexts only loop back-edges (a self tail call from the body
+             * being interpreted) count and enter; the trace charges
+             * reductions per iteration and hands the loop back to be
+             * yielded here when the budget runs out. */
+            if (jit_is_enabled() &&
+                (ctx->reductions_left == 0 ||
+                 (owned_expr && owned_expr == fn->data.lambda.body))) {
+                jit_record_call(ctx, fn);
 
-                /* Check for JIT trace and execute if available */
                 JITTrace* trace = jit_get_trace(fn);
-                if (trace && trace->native_code) {
-                    /* Build environment with args for JIT execution */
-                    Cell* closure_env = fn->data.lambda.env;
-                    Cell* new_env = extend_env(closure_env, args);
-
-                    /* Execute JIT'd code */
-                    Cell* result = jit_execute(trace, new_env);
-
+                if (trace && trace->native_code && !fn->data.lambda.constraints &&
+                    list_length(args) == fn->data.lambda.arity) {
+                    Cell* new_env = extend_env(fn->data.lambda.env, args);
+                    JITExit jexit;
+                    Cell* result = jit_execute(trace, ctx, new_env, &jexit);
                     cell_release(new_env);
-                    cell_release(fn);
-                    cell_release(args);
 
-                    /* If JIT returned NULL, we need to deopt - fall through */
+                    if (result || jexit.kind != JIT_EXIT_DEOPT) {
+                        cell_release(fn);
+                        cell_release(args);
+                    }
                     if (result) {
+                        /* Frame of the interpreted tail call that got here */
+                        if (owned_env) {
+                            cell_release(owned_env);
+                        }
+                        if (owned_expr) {
+                            cell_release(owned_expr);
+                        }
                         return result;
                     }
-                    /* Fall through to interpreter on deopt */
+                    if (jexit.kind == JIT_EXIT_APPLY) {
+                        /* Tail call out of the trace */
+                        fn = jexit.fn;
+                        args = jexit.args;
+                        goto apply_fn;
+                    }
+                    if (jexit.kind == JIT_EXIT_EVAL) {
+                        /* Tail form the trace leaves to the interpreter */
+                        if (owned_env) {
+                            cell_release(owned_env);
+                        }
+                        if (owned_expr) {
+                            cell_release(owned_expr);
+                        }
+                        env = jexit.env;
+                        owned_env = jexit.env;
+                        expr = jexit.expr;
+                        owned_expr = jexit.expr;
+                        goto tail_call;
+                    }
+                    /* JIT_EXIT_DEOPT: guard failed before any work - interpret */
                 }
             }
 
@@ -3606,6 +3850,37 @@ Cell* eval(EvalContext* ctx, Cell* expr) {
 
 /* ============ Type Registry Operations ============ */
 
+/* Fix the slot order of a struct type's fields at definition time:
+ * :leaf schemas map to one layout, :node schemas to (variant . layout)
+ * per variant. Other schemas (e.g. type descriptors) get none. */
+static void register_layout(EvalContext* ctx, Cell* type_tag, Cell* schema) {
+    Cell* old = cell_hashmap_delete(ctx->struct_layouts, type_tag);
+    if (old) cell_release(old);
+    if (!cell_is_pair(schema) || !cell_is_symbol(cell_car(schema))) return;
+    const char* kind = cell_get_symbol(cell_car(schema));
+    Cell* entry = NULL;
+    if (strcmp(kind, ":leaf") == 0) {
+        entry = cell_struct_layout_new(cell_cdr(schema));
+    } else if (strcmp(kind, ":node") == 0) {
+        entry = cell_nil();
+        for (Cell* v = cell_cdr(schema); cell_is_pair(v); v = cell_cdr(v)) {
+            Cell* variant = cell_car(v);
+            if (!cell_is_pair(variant)) continue;
+            Cell* layout = cell_struct_layout_new(cell_cdr(variant));
+            Cell* binding = cell_cons(cell_car(variant), layout);
+            Cell* next = cell_cons(binding, entry);
+            cell_release(layout);
+            cell_release(binding);
+            cell_release(entry);
+            entry = next;
+        }
+    }
+    if (!entry) return;
+    Cell* prev = cell_hashmap_put(ctx->struct_layouts, type_tag, entry);
+    if (prev) cell_release(prev);
+    cell_release(entry);
+}
+
 /* Register a type definition in the type registry
  * type_tag: symbol like :Point, :List, :Tree
  * schema: structure definition (fields, variants, etc)
@@ -3640,6 +3915,44 @@ void eval_register_type(EvalContext* ctx, Cell* type_tag, Cell* schema) {
     cell_retain(schema);
     Cell* binding = cell_cons(type_tag, schema);
     ctx->type_registry = cell_cons(binding, ctx->type_registry);
+
+    register_layout(ctx, type_tag, schema);
+}
+
+/* Lookup the slot layout fixed when a struct type was defined
+ * variant: NULL for :leaf types, the variant tag for :node types
+ * Returns retained layout vector, or NULL (instances fall back to alists)
+ */
+Cell* eval_lookup_layout(EvalContext* ctx, Cell* type_tag, Cell* variant) {
+    Cell* entry = cell_hashmap_get(ctx->struct_layouts, type_tag);
+    if (!entry) return NULL;
+    if (variant == NULL) {
+        if (entry->type == CELL_VECTOR) return entry;
+        cell_release(entry);
+        return NULL;
+    }
+    Cell* layout = NULL;
+    for (Cell* v = entry; cell_is_pair(v); v = cell_cdr(v)) {
+        Cell* binding = cell_car(v);
+        if (cell_car(binding) == variant || cell_equal(cell_car(binding), variant)) {
+            layout = cell_cdr(binding);
+            cell_retain(layout);
+            break;
+        }
+    }
+    cell_release(entry);
+    return layout;
+}
+
+/* Recompute every layout from the registry (after an image load) */
+void eval_rebuild_layouts(EvalContext* ctx) {
+    cell_release(ctx->struct_layouts);
+    ctx->struct_layouts = cell_hashmap_new(16);
+    for (Cell* r = ctx->type_registry; cell_is_pair(r); r = cell_cdr(r)) {
+        Cell* binding = cell_car(r);
+        if (cell_is_pair(binding) && cell_is_symbol(cell_car(binding)))
+            register_layout(ctx, cell_car(binding), cell_cdr(binding));
+    }
 }
 
 /* Lookup a type definition in the type registry
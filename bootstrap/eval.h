@@ -4,6 +4,7 @@
 #include <stddef.h>
 #include "cell.h"
 #include "fiber.h"
+#include "strtable.h"
 
 /* Evaluator
  *
@@ -25,6 +26,7 @@ typedef struct FunctionDoc {
     int arity;                     /* Number of parameters */
     char** dependencies;           /* Array of dependency names */
     size_t dependency_count;       /* Number of dependencies */
+    Cell* pending;                 /* Lazy docs: lambda still to document (owned) */
     struct FunctionDoc* next;      /* Linked list */
 } FunctionDoc;
 
@@ -46,13 +48,17 @@ struct EvalContext {
     Cell* global_env;   /* Base global env — when env==global_env, no local bindings */
     Cell* primitives;   /* Primitive bindings */
     FunctionDoc* user_docs;  /* User function documentation */
+    StrTable doc_index;      /* name → newest FunctionDoc in user_docs */
     Cell* type_registry;     /* Type definitions (alist: type_tag -> schema) */
+    Cell* struct_layouts;    /* type_tag -> slot layout (:leaf) or alist variant -> layout (:node) */
     Cell* effect_registry;   /* Effect definitions (alist: name -> ops-list) */
 
     /* BEAM-style reduction counting (Day 130) */
     int32_t reductions_left;  /* Decremented per eval step; yield when <= 0 */
     Cell* continuation;       /* Saved expression on yield */
     Cell* continuation_env;   /* Saved environment on yield */
+    int32_t eval_depth;       /* eval_internal frames on the running fiber */
+    char* stack_limit;        /* Lowest frame address an eval may start at (NULL off-fiber) */
 };
 
 /* Create new evaluation context */
@@ -67,18 +73,32 @@ Cell* eval(EvalContext* ctx, Cell* expr);
 /* Evaluate expression in specific environment (for pattern matching with closures) */
 Cell* eval_internal(EvalContext* ctx, Cell* env, Cell* expr);
 
+/* Apply a function value to already-evaluated arguments (borrows both) */
+Cell* eval_apply(EvalContext* ctx, Cell* fn, Cell* args);
+
 /* Define global binding */
 void eval_define(EvalContext* ctx, const char* name, Cell* value);
 
 /* Lookup variable in context */
 Cell* eval_lookup(EvalContext* ctx, const char* name);
 
+/* Lookup global binding, ignoring local (pattern) bindings */
+Cell* eval_lookup_global(EvalContext* ctx, const char* name);
+
+/* Counter bumped by every global definition */
+uint64_t eval_global_epoch(void);
+
 /* Lookup variable in local environment */
 Cell* eval_lookup_env(Cell* env, const char* name);
 
 /* Find user function documentation by name (for primitives to use) */
 FunctionDoc* eval_find_user_doc(const char* name);
 
+/* Production mode: define records lambdas without documenting or printing
+ * them; docs, types and flow info are built on the first lookup */
+void eval_set_lazy_docs(bool lazy);
+bool eval_lazy_docs(void);
+
 /* Set current eval context (for primitives to access user docs) */
 void eval_set_current_context(EvalContext* ctx);
 
@@ -88,6 +108,11 @@ EvalContext* eval_get_current_context(void);
 /* Type registry operations */
 void eval_register_type(EvalContext* ctx, Cell* type_tag, Cell* schema);
 Cell* eval_lookup_type(EvalContext* ctx, Cell* type_tag);
+Cell* eval_lookup_layout(EvalContext* ctx, Cell* type_tag, Cell* variant);
+void eval_rebuild_layouts(EvalContext* ctx);
+
+/* Application site whose builtin is running (NULL outside a builtin call) */
+extern _Thread_local Cell* tls_apply_site;
 bool eval_has_type(EvalContext* ctx, Cell* type_tag);
 
 /* Effect registry operations */
@@ -0,0 +1,91 @@
+#ifndef GUAGE_FASTHASH_H
+#define GUAGE_FASTHASH_H
+
+/*
+ * Fast non-cryptographic hash — wyhash (final v4) construction
+ * Based on wyhash by Wang Yi (public domain / Unlicense)
+ * https://github.com/wangyi-fudan/wyhash
+ *
+ * One 64×64→128 multiply-fold per 16 input bytes; good avalanche on every
+ * output bit, so it feeds Swiss-table H1/H2 and the set's tag/group bits
+ * directly. NOT collision-resistant against chosen keys: only for maps the
+ * program opts in with the :fast hash family (trusted keys). SipHash-2-4
+ * (siphash.h) stays the default.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define FASTHASH_S0 0x2d358dccaa6c78a5ULL
+#define FASTHASH_S1 0x8bb84b93962eacc9ULL
+#define FASTHASH_S2 0x4b33a62ed433d4a3ULL
+#define FASTHASH_S3 0x4d5a2da51de1aa47ULL
+
+/* 128-bit multiply, folded: lo ^ hi */
+static inline uint64_t fasthash_mix(uint64_t a, uint64_t b) {
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+static inline uint64_t fasthash_r8(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t fasthash_r4(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+/* Hash one 64-bit word (integers, pointers, double bit patterns) */
+static inline uint64_t guage_fasthash64(uint64_t x) {
+    __uint128_t r = (__uint128_t)(x ^ FASTHASH_S0) * FASTHASH_S1;
+    return fasthash_mix((uint64_t)r ^ FASTHASH_S0, (uint64_t)(r >> 64) ^ FASTHASH_S1);
+}
+
+/* Hash a byte string */
+static inline uint64_t guage_fasthash(const void* key, size_t len) {
+    const uint8_t* p = (const uint8_t*)key;
+    uint64_t seed = fasthash_mix(FASTHASH_S0, FASTHASH_S1);
+    uint64_t a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (fasthash_r4(p) << 32) | fasthash_r4(p + ((len >> 3) << 2));
+            b = (fasthash_r4(p + len - 4) << 32) | fasthash_r4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = fasthash_mix(fasthash_r8(p) ^ FASTHASH_S1, fasthash_r8(p + 8) ^ seed);
+                see1 = fasthash_mix(fasthash_r8(p + 16) ^ FASTHASH_S2, fasthash_r8(p + 24) ^ see1);
+                see2 = fasthash_mix(fasthash_r8(p + 32) ^ FASTHASH_S3, fasthash_r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = fasthash_mix(fasthash_r8(p) ^ FASTHASH_S1, fasthash_r8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = fasthash_r8(p + i - 16);
+        b = fasthash_r8(p + i - 8);
+    }
+
+    __uint128_t r = (__uint128_t)(a ^ FASTHASH_S1) * (b ^ seed);
+    return fasthash_mix((uint64_t)r ^ FASTHASH_S0 ^ len, (uint64_t)(r >> 64) ^ FASTHASH_S1);
+}
+
+#endif /* GUAGE_FASTHASH_H */
@@ -33,12 +33,19 @@ static void fiber_entry_wrapper(fctx_transfer_t transfer) {
         fctx_transfer_t t = fctx_jump(fiber->caller_ctx, fiber);
         fiber->caller_ctx = t.ctx;
 
-        /* Resumed by scheduler — reset reduction budget and continue */
+        /* Resumed by scheduler — reset reduction budget and continue.
+         * It may be another scheduler, with its own context. */
+        ctx = fiber->eval_ctx;
         ctx->reductions_left = CONTEXT_REDS;
         if (ctx->continuation) {
-            result = eval_internal(ctx, ctx->continuation_env, ctx->continuation);
+            /* Take the continuation first: evaluating it may yield again */
+            Cell* cont = ctx->continuation;
+            Cell* cont_env = ctx->continuation_env;
             ctx->continuation = NULL;
             ctx->continuation_env = NULL;
+            result = eval_internal(ctx, cont_env, cont);
+            cell_release(cont);
+            cell_release(cont_env);
         } else {
             /* No continuation saved — shouldn't happen, but handle gracefully */
             result = cell_nil();
@@ -106,11 +113,32 @@ void fiber_destroy(Fiber* fiber) {
     free(fiber);
 }
 
+/* Run the fiber until it next switches out. Its eval depth and stack
+ * limit are swapped in and out with it, since the context is shared with
+ * the caller. The
+ * caller's application site is kept too: the fiber may finish, freeing
+ * sites it left behind, before the caller reads it again. */
+static void fiber_switch_in(Fiber* fiber) {
+    EvalContext* ctx = fiber->eval_ctx;
+    int32_t caller_depth = ctx->eval_depth;
+    char* caller_limit = ctx->stack_limit;
+    Cell* caller_site = tls_apply_site;
+    ctx->eval_depth = fiber->eval_depth;
+    ctx->stack_limit = fiber->stack + FIBER_STACK_RESERVE;
+    tls_apply_site = NULL;
+    fctx_transfer_t t = fctx_jump(fiber->ctx, fiber);
+    fiber->ctx = t.ctx;  /* Save fiber's updated context for next resume */
+    ctx = fiber->eval_ctx;
+    fiber->eval_depth = ctx->eval_depth;
+    ctx->eval_depth = caller_depth;
+    ctx->stack_limit = caller_limit;
+    tls_apply_site = caller_site;
+}
+
 /* Start a fiber (first resume — transitions READY -> RUNNING) */
 void fiber_start(Fiber* fiber) {
     fiber->state = FIBER_RUNNING;
-    fctx_transfer_t t = fctx_jump(fiber->ctx, fiber);
-    fiber->ctx = t.ctx;  /* Save fiber's updated context for next resume */
+    fiber_switch_in(fiber);
 }
 
 /* Resume a suspended fiber with a value */
@@ -122,8 +150,7 @@ void fiber_resume(Fiber* fiber, Cell* value) {
     if (value) cell_retain(value);
 
     fiber->state = FIBER_RUNNING;
-    fctx_transfer_t t = fctx_jump(fiber->ctx, fiber);
-    fiber->ctx = t.ctx;  /* Save fiber's updated context for next resume */
+    fiber_switch_in(fiber);
 }
 
 /* Yield from inside a fiber (transitions RUNNING -> SUSPENDED) */
@@ -4,6 +4,7 @@
 #include "fcontext.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /* Forward declarations */
 typedef struct Cell Cell;
@@ -25,6 +26,7 @@ typedef enum {
     SUSPEND_CHAN_SEND,   /* ⟿→ on full channel */
     SUSPEND_SELECT,      /* ⟿⊞ waiting on multiple channels */
     SUSPEND_TASK_AWAIT,  /* ⟳⊲ waiting for actor to finish */
+    SUSPEND_CALL,        /* ⟳⇅ waiting for a ref-tagged reply */
     SUSPEND_REDUCTION,   /* Reduction budget exhausted — immediately runnable */
 } SuspendReason;
 
@@ -71,6 +73,7 @@ typedef struct Fiber {
     /* Per-fiber continuation save (for multi-scheduler correctness) */
     Cell* saved_continuation;
     Cell* saved_continuation_env;
+    int32_t eval_depth;            /* ctx->eval_depth while switched out */
 
     /* Evaluation context */
     EvalContext* eval_ctx;
@@ -78,8 +81,17 @@ typedef struct Fiber {
     Cell* body_env;
 } Fiber;
 
-/* Default stack size: 256KB */
+/* Default stack size: 256KB of address space. Only the top
+ * FIBER_PREFAULT_SIZE bytes are committed up front; deeper pages are
+ * faulted in by the OS as the fiber actually uses them. The bottom
+ * FIBER_STACK_RESERVE bytes are kept for C code between two evaluator
+ * frames: an eval that would start below it fails with stack-overflow
+ * instead of running into the guard page. */
 #define FIBER_DEFAULT_STACK_SIZE (256 * 1024)
+#define FIBER_MIN_STACK_SIZE     (128 * 1024)
+#define FIBER_MAX_STACK_SIZE     (64 * 1024 * 1024)
+#define FIBER_PREFAULT_SIZE      (16 * 1024)
+#define FIBER_STACK_RESERVE      (32 * 1024)
 
 /* Lifecycle */
 Fiber* fiber_create(EvalContext* ctx, Cell* body, Cell* env, size_t stack_size);
@@ -0,0 +1,394 @@
+/* gcache.c — Persistent parsed-module cache (.gcache)
+ *
+ * File layout (host byte order, mmap'd read-only):
+ *   GCacheHeader
+ *   GCacheNode  nodes[n_nodes]   children always precede their parent
+ *   uint32_t    roots[n_forms]   top-level forms, in source order
+ *   char        strtab[]         NUL-terminated symbol and string text
+ *
+ * The whole file is validated before any cell is built, so a damaged or
+ * hostile cache is a miss, never a crash.
+ */
+
+#include "gcache.h"
+#include "siphash.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define GCACHE_MAGIC   "GUAGEGC"   /* 8 bytes with the NUL */
+#define GCACHE_VERSION 1
+#define GCACHE_NO_SPAN 0xFFFFFFFFu
+
+enum {
+    GC_NIL, GC_PAIR, GC_NUMBER, GC_INTEGER, GC_BOOL, GC_SYMBOL, GC_STRING
+};
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t n_forms;
+    uint64_t source_hash;
+    uint64_t source_len;
+    uint32_t n_nodes;
+    uint32_t strtab_len;
+} GCacheHeader;
+
+typedef struct {
+    uint8_t  kind;
+    uint8_t  pad;
+    uint16_t span_len;   /* Span.inline_span.len */
+    uint32_t span_lo;    /* Relative to the file's base, or GCACHE_NO_SPAN */
+    uint64_t payload;    /* PAIR: car | cdr << 32; NUMBER/INTEGER/BOOL: value;
+                            SYMBOL/STRING: strtab offset | length << 32 */
+} GCacheNode;
+
+/* Fixed key: the hash must be stable across runs */
+static const unsigned char g_gcache_key[16] = "guage.gcache.v1";
+
+static uint64_t gcache_hash(const char* source, size_t len) {
+    return siphash24(source, len, g_gcache_key);
+}
+
+static bool gcache_disabled(void) {
+    return getenv("GUAGE_NO_GCACHE") != NULL;
+}
+
+/* Loads that were served from the cache (parse workers count too) */
+static _Atomic uint64_t g_gcache_hits = 0;
+
+uint64_t gcache_hits(void) {
+    return atomic_load_explicit(&g_gcache_hits, memory_order_relaxed);
+}
+
+/* $GUAGE_CACHE_DIR, else $XDG_CACHE_HOME/guage, else ~/.cache/guage */
+static bool gcache_dir(char* out, size_t cap) {
+    const char* dir = getenv("GUAGE_CACHE_DIR");
+    if (dir && *dir) return (size_t)snprintf(out, cap, "%s", dir) < cap;
+    dir = getenv("XDG_CACHE_HOME");
+    if (dir && *dir) return (size_t)snprintf(out, cap, "%s/guage", dir) < cap;
+    dir = getenv("HOME");
+    if (dir && *dir) return (size_t)snprintf(out, cap, "%s/.cache/guage", dir) < cap;
+    return (size_t)snprintf(out, cap, "/tmp/guage-%ld/cache", (long)getuid()) < cap;
+}
+
+/* mkdir -p; existing directories are fine */
+static void gcache_mkdirs(char* dir) {
+    for (char* p = dir + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        mkdir(dir, 0700);
+        *p = '/';
+    }
+    mkdir(dir, 0700);
+}
+
+/* Cache file for a source: <cache dir>/<hash of its real path>.gcache, so
+ * every spelling of the same file shares one entry */
+char* gcache_file(const char* path) {
+    char dir[PATH_MAX];
+    if (!gcache_dir(dir, sizeof(dir))) return NULL;
+    char real[PATH_MAX];
+    const char* key = realpath(path, real) ? real : path;
+    size_t n = strlen(dir) + 1 + 16 + sizeof(".gcache");
+    char* p = malloc(n);
+    if (!p) return NULL;
+    snprintf(p, n, "%s/%016llx.gcache", dir,
+             (unsigned long long)siphash24(key, strlen(key), g_gcache_key));
+    return p;
+}
+
+/* ============================================================================
+ * Reading
+ * ============================================================================ */
+
+/* Every index, string and ownership edge in range before anything is built */
+static bool gcache_validate(const GCacheNode* nodes, uint32_t n_nodes,
+                            const uint32_t* roots, uint32_t n_forms,
+                            const char* strtab, uint32_t strtab_len) {
+    uint8_t* used = calloc(n_nodes ? n_nodes : 1, 1);
+    if (!used) return false;
+    bool ok = true;
+    for (uint32_t i = 0; ok && i < n_nodes; i++) {
+        const GCacheNode* nd = &nodes[i];
+        switch (nd->kind) {
+            case GC_PAIR: {
+                uint32_t car = (uint32_t)nd->payload;
+                uint32_t cdr = (uint32_t)(nd->payload >> 32);
+                ok = car < i && cdr < i && car != cdr && !used[car] && !used[cdr];
+                if (ok) used[car] = used[cdr] = 1;
+                break;
+            }
+            case GC_SYMBOL:
+            case GC_STRING: {
+                uint64_t off = (uint32_t)nd->payload;
+                uint64_t len = nd->payload >> 32;
+                ok = off + len < strtab_len && strtab[off + len] == '\0' &&
+                     memchr(strtab + off, '\0', len) == NULL;
+                break;
+            }
+            case GC_NIL:
+            case GC_NUMBER:
+            case GC_INTEGER:
+            case GC_BOOL:
+                break;
+            default:
+                ok = false;
+        }
+    }
+    for (uint32_t i = 0; ok && i < n_forms; i++) {
+        ok = roots[i] < n_nodes && !used[roots[i]];
+        if (ok) used[roots[i]] = 1;
+    }
+    free(used);
+    return ok;
+}
+
+static Cell* gcache_build(const GCacheNode* nd, Cell** cells, const char* strtab,
+                          uint32_t file_base) {
+    Cell* c = NULL;
+    switch (nd->kind) {
+        case GC_NIL:     c = cell_nil(); break;
+        case GC_NUMBER: {
+            double d;
+            memcpy(&d, &nd->payload, sizeof(d));
+            c = cell_number(d);
+            break;
+        }
+        case GC_INTEGER: c = cell_integer((int64_t)nd->payload); break;
+        case GC_BOOL:    c = cell_bool(nd->payload != 0); break;
+        case GC_SYMBOL:  c = cell_symbol(strtab + (uint32_t)nd->payload); break;
+        case GC_STRING:  c = cell_string(strtab + (uint32_t)nd->payload); break;
+        case GC_PAIR: {
+            /* Same ownership as parse_list: the element keeps the
+             * reference it was created with, the tail is handed over */
+            Cell* cdr = cells[(uint32_t)(nd->payload >> 32)];
+            c = cell_cons(cells[(uint32_t)nd->payload], cdr);
+            cell_release(cdr);
+            break;
+        }
+    }
+    if (nd->span_lo != GCACHE_NO_SPAN) {
+        c->span.inline_span.lo = file_base + nd->span_lo;
+        c->span.inline_span.len = nd->span_len;
+        c->span.inline_span.ctxt = 0;
+    }
+    return c;
+}
+
+Cell** gcache_read(const char* path, const char* source, size_t len,
+                   uint32_t file_base, uint32_t* n_forms) {
+    if (gcache_disabled()) return NULL;
+    char* cpath = gcache_file(path);
+    if (!cpath) return NULL;
+    int fd = open(cpath, O_RDONLY);
+    free(cpath);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GCacheHeader)) {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    Cell** forms = NULL;
+    const GCacheHeader* h = map;
+    uint64_t expect = sizeof(GCacheHeader) + (uint64_t)h->n_nodes * sizeof(GCacheNode) +
+                      (uint64_t)h->n_forms * sizeof(uint32_t) + h->strtab_len;
+    if (memcmp(h->magic, GCACHE_MAGIC, 8) != 0 || h->version != GCACHE_VERSION ||
+        h->source_len != len || expect != size || h->n_forms == 0 ||
+        h->source_hash != gcache_hash(source, len)) {
+        goto done;
+    }
+
+    const GCacheNode* nodes = (const GCacheNode*)(h + 1);
+    const uint32_t* roots = (const uint32_t*)(nodes + h->n_nodes);
+    const char* strtab = (const char*)(roots + h->n_forms);
+    if (!gcache_validate(nodes, h->n_nodes, roots, h->n_forms, strtab, h->strtab_len)) {
+        goto done;
+    }
+
+    Cell** cells = malloc((size_t)h->n_nodes * sizeof(Cell*));
+    forms = malloc((size_t)h->n_forms * sizeof(Cell*));
+    if (!cells || !forms) {
+        free(cells);
+        free(forms);
+        forms = NULL;
+        goto done;
+    }
+    for (uint32_t i = 0; i < h->n_nodes; i++) {
+        cells[i] = gcache_build(&nodes[i], cells, strtab, file_base);
+    }
+    for (uint32_t i = 0; i < h->n_forms; i++) {
+        forms[i] = cells[roots[i]];
+    }
+    *n_forms = h->n_forms;
+    free(cells);
+    atomic_fetch_add_explicit(&g_gcache_hits, 1, memory_order_relaxed);
+
+done:
+    munmap(map, size);
+    return forms;
+}
+
+/* ============================================================================
+ * Writing
+ * ============================================================================ */
+
+typedef struct {
+    GCacheNode* nodes;
+    uint32_t    n_nodes, cap_nodes;
+    char*       strtab;
+    uint32_t    strtab_len, cap_strtab;
+    uint32_t    file_base;
+    bool        ok;
+} GCacheWriter;
+
+static uint32_t gcw_push(GCacheWriter* w, Cell* c, uint8_t kind, uint64_t payload) {
+    if (w->n_nodes == w->cap_nodes) {
+        uint32_t cap = w->cap_nodes ? w->cap_nodes * 2 : 256;
+        GCacheNode* nodes = realloc(w->nodes, (size_t)cap * sizeof(GCacheNode));
+        if (!nodes) { w->ok = false; return 0; }
+        w->nodes = nodes;
+        w->cap_nodes = cap;
+    }
+    GCacheNode* nd = &w->nodes[w->n_nodes];
+    memset(nd, 0, sizeof(*nd));
+    nd->kind = kind;
+    nd->payload = payload;
+    if (c->span.raw == 0 || c->span.inline_span.lo < w->file_base) {
+        nd->span_lo = GCACHE_NO_SPAN;
+    } else {
+        nd->span_lo = c->span.inline_span.lo - w->file_base;
+        nd->span_len = c->span.inline_span.len;
+    }
+    return w->n_nodes++;
+}
+
+static uint64_t gcw_string(GCacheWriter* w, const char* s) {
+    size_t len = strlen(s);
+    if (w->strtab_len + len + 1 > w->cap_strtab) {
+        size_t cap = w->cap_strtab ? w->cap_strtab : 1024;
+        while (cap < w->strtab_len + len + 1) cap *= 2;
+        char* tab = cap <= UINT32_MAX ? realloc(w->strtab, cap) : NULL;
+        if (!tab) { w->ok = false; return 0; }
+        w->strtab = tab;
+        w->cap_strtab = (uint32_t)cap;
+    }
+    uint32_t off = w->strtab_len;
+    memcpy(w->strtab + off, s, len + 1);
+    w->strtab_len += (uint32_t)len + 1;
+    return (uint64_t)off | ((uint64_t)len << 32);
+}
+
+/* Post-order: recursion on elements, iteration along each list */
+static uint32_t gcw_cell(GCacheWriter* w, Cell* c) {
+    if (!w->ok) return 0;
+    switch (c->type) {
+        case CELL_ATOM_NIL:     return gcw_push(w, c, GC_NIL, 0);
+        case CELL_ATOM_INTEGER: return gcw_push(w, c, GC_INTEGER, (uint64_t)c->data.atom.integer);
+        case CELL_ATOM_BOOL:    return gcw_push(w, c, GC_BOOL, c->data.atom.boolean ? 1 : 0);
+        case CELL_ATOM_NUMBER: {
+            uint64_t bits;
+            memcpy(&bits, &c->data.atom.number, sizeof(bits));
+            return gcw_push(w, c, GC_NUMBER, bits);
+        }
+        case CELL_ATOM_SYMBOL:
+            return gcw_push(w, c, GC_SYMBOL, gcw_string(w, cell_get_symbol(c)));
+        case CELL_ATOM_STRING:
+            return gcw_push(w, c, GC_STRING, gcw_string(w, cell_get_string(c)));
+        case CELL_PAIR: {
+            uint32_t n = 0;
+            Cell* p = c;
+            while (cell_is_pair(p)) { n++; p = cell_cdr(p); }
+            uint32_t* cars = malloc((size_t)n * sizeof(uint32_t));
+            Cell** pairs = malloc((size_t)n * sizeof(Cell*));
+            if (!cars || !pairs) {
+                free(cars);
+                free(pairs);
+                w->ok = false;
+                return 0;
+            }
+            p = c;
+            for (uint32_t i = 0; i < n; i++, p = cell_cdr(p)) {
+                pairs[i] = p;
+                cars[i] = gcw_cell(w, cell_car(p));
+            }
+            uint32_t tail = gcw_cell(w, p);
+            /* Pairs from the end of the list back to c */
+            for (uint32_t i = n; i-- > 0;) {
+                tail = gcw_push(w, pairs[i], GC_PAIR, (uint64_t)cars[i] | ((uint64_t)tail << 32));
+            }
+            free(cars);
+            free(pairs);
+            return tail;
+        }
+        default:
+            w->ok = false;  /* Not something the parser produces */
+            return 0;
+    }
+}
+
+bool gcache_write(const char* path, const char* source, size_t len,
+                  uint32_t file_base, Cell** forms, uint32_t n_forms) {
+    if (gcache_disabled() || n_forms == 0) return false;
+
+    GCacheWriter w = {0};
+    w.file_base = file_base;
+    w.ok = true;
+    uint32_t* roots = malloc((size_t)n_forms * sizeof(uint32_t));
+    if (!roots) return false;
+    for (uint32_t i = 0; i < n_forms && w.ok; i++) {
+        roots[i] = gcw_cell(&w, forms[i]);
+    }
+
+    bool written = false;
+    char* cpath = gcache_file(path);
+    size_t tlen = cpath ? strlen(cpath) + 32 : 0;
+    char* tmp = cpath ? malloc(tlen) : NULL;
+    if (w.ok && tmp) {
+        char* slash = strrchr(cpath, '/');
+        if (slash && slash != cpath) {
+            *slash = '\0';
+            gcache_mkdirs(cpath);
+            *slash = '/';
+        }
+        /* Write aside and rename, so readers never see a partial file */
+        snprintf(tmp, tlen, "%s.%ld.tmp", cpath, (long)getpid());
+        FILE* f = fopen(tmp, "wb");
+        if (f) {
+            GCacheHeader h;
+            memset(&h, 0, sizeof(h));
+            memcpy(h.magic, GCACHE_MAGIC, 8);
+            h.version = GCACHE_VERSION;
+            h.n_forms = n_forms;
+            h.source_hash = gcache_hash(source, len);
+            h.source_len = len;
+            h.n_nodes = w.n_nodes;
+            h.strtab_len = w.strtab_len;
+            written = fwrite(&h, sizeof(h), 1, f) == 1 &&
+                      fwrite(w.nodes, sizeof(GCacheNode), w.n_nodes, f) == w.n_nodes &&
+                      fwrite(roots, sizeof(uint32_t), n_forms, f) == n_forms &&
+                      fwrite(w.strtab, 1, w.strtab_len, f) == w.strtab_len;
+            written = (fclose(f) == 0) && written;
+            if (written) written = rename(tmp, cpath) == 0;
+            if (!written) unlink(tmp);
+        }
+    }
+    free(tmp);
+    free(cpath);
+    free(roots);
+    free(w.nodes);
+    free(w.strtab);
+    return written;
+}
@@ -0,0 +1,35 @@
+/* gcache.h — Persistent parsed-module cache (.gcache)
+ *
+ * `load` keeps the parsed top-level forms of each source file in a
+ * per-user cache directory ($GUAGE_CACHE_DIR, else $XDG_CACHE_HOME/guage,
+ * else ~/.cache/guage), one <hash>.gcache per source path, keyed by a hash
+ * of the source text. A later load of the same unchanged source maps the
+ * cache and rebuilds the forms (with their spans) instead of parsing. Any mismatch — version, size, hash, truncated
+ * file — just means a miss; the source is parsed and the cache rewritten.
+ *
+ * Set GUAGE_NO_GCACHE to bypass the cache entirely.
+ */
+#ifndef GUAGE_GCACHE_H
+#define GUAGE_GCACHE_H
+
+#include "cell.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Forms cached for this exact source, spans rebased onto file_base.
+ * Returns a malloc'd array of owned forms (count in *n_forms), or NULL. */
+Cell** gcache_read(const char* path, const char* source, size_t len,
+                   uint32_t file_base, uint32_t* n_forms);
+
+/* Cache file used for the source at path (malloc'd), or NULL */
+char* gcache_file(const char* path);
+
+/* Number of reads served from the cache since startup */
+uint64_t gcache_hits(void);
+
+/* Store the parsed forms of source; false if it could not be written */
+bool gcache_write(const char* path, const char* source, size_t len,
+                  uint32_t file_base, Cell** forms, uint32_t n_forms);
+
+#endif /* GUAGE_GCACHE_H */
@@ -0,0 +1,953 @@
+/* image.c — Heap image save/restore
+ *
+ * File layout (host byte order, mmap'd read-only):
+ *   ImageHeader
+ *   ImageNode   nodes[n_nodes]      children always precede their parent
+ *   uint32_t    edges[n_edges]      child lists of variable-arity nodes
+ *   ImageRecord records[n_records]  restore steps, applied in order
+ *   uint32_t    symbols[n_symbols]  interned strings in ID order (strtab offsets)
+ *   char        strtab[]            NUL-terminated text
+ *
+ * Nodes are cells with pointers replaced by node indices, so the image is
+ * position independent and shared structure stays shared. Builtins are
+ * stored by primitive name. The whole file is validated before anything is
+ * interned, built or defined.
+ */
+
+#include "image.h"
+#include "intern.h"
+#include "macro.h"
+#include "module.h"
+#include "primitives.h"
+#include "siphash.h"
+#include "strtable.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define IMAGE_MAGIC   "GUAGEIM"   /* 8 bytes with the NUL */
+#define IMAGE_VERSION 1
+#define IMAGE_NONE    0xFFFFFFFFu
+#define IMAGE_STALE   0xFFFFFFFEu   /* Writer map: rolled back, treat as unseen */
+
+enum {
+    IM_NIL, IM_NUMBER, IM_INTEGER, IM_BOOL, IM_SYMBOL, IM_STRING, IM_PAIR,
+    IM_LAMBDA, IM_BUILTIN, IM_ERROR, IM_STRUCT, IM_BOX, IM_VECTOR,
+    IM_HASHMAP, IM_SET
+};
+
+/* Restore steps */
+enum {
+    IR_MODULE,      /* str name, a exports, b dependencies, c version */
+    IR_DEFINE,      /* str module (NONE = REPL), a symbol name, b value */
+    IR_LOADED,      /* str module, a cached load result */
+    IR_MACRO,       /* str name, a params, b body; c = 1: a NONE, b clauses */
+    IR_REGISTRIES   /* a type registry, b effect registry */
+};
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t n_symbols;
+    uint64_t build_hash;   /* Fingerprint of the primitive table */
+    uint32_t n_nodes;
+    uint32_t n_edges;
+    uint32_t n_records;
+    uint32_t strtab_len;
+} ImageHeader;
+
+typedef struct {
+    uint8_t  kind;
+    uint8_t  aux;        /* LAMBDA: 1 = has param names; STRUCT: StructKind;
+                          * HASHMAP/SET: CellHashFamily */
+    uint16_t pad;
+    uint32_t str;        /* strtab offset or IMAGE_NONE */
+    uint32_t edge_off;
+    uint32_t n_edges;
+    uint64_t payload;    /* PAIR: car | cdr << 32; LAMBDA: arity | line << 32;
+                            NUMBER/INTEGER/BOOL: value */
+} ImageNode;
+
+typedef struct {
+    uint32_t op, str, a, b, c;
+} ImageRecord;
+
+/* Fixed key: the fingerprint must be stable across runs */
+static const unsigned char g_image_key[16] = "guage.image.v1";
+
+/* Images only load into the binary that wrote them: same primitives in the
+ * same order means builtins resolve and preloaded symbol IDs line up */
+static uint64_t image_build_hash(void) {
+    const Primitive* prims = primitives_table();
+    uint64_t h = 0;
+    for (int i = 0; prims[i].name != NULL; i++) {
+        uint64_t name_hash = siphash24(prims[i].name, strlen(prims[i].name), g_image_key);
+        h = (h ^ name_hash) * 0x100000001b3ULL + (uint64_t)i;
+    }
+    return h;
+}
+
+/* ============================================================================
+ * Writing
+ * ============================================================================ */
+
+/* Cell* → node index, open addressing. IMAGE_NONE marks a cell still being
+ * written (a cycle if seen again), IMAGE_STALE one that was rolled back. */
+typedef struct {
+    Cell*    key;
+    uint32_t idx;
+} ImageMapSlot;
+
+typedef struct {
+    ImageNode*    nodes;
+    uint32_t      n_nodes, cap_nodes;
+    uint32_t*     edges;
+    uint32_t      n_edges, cap_edges;
+    ImageRecord*  records;
+    uint32_t      n_records, cap_records;
+    char*         strtab;
+    uint32_t      strtab_len, cap_strtab;
+    StrTable      strings;        /* text → strtab offset + 1 */
+    ImageMapSlot* map;
+    uint32_t      map_cap, map_size;
+    Cell**        log;            /* Cells mapped since the current root began */
+    uint32_t      n_log, cap_log;
+    bool          oom;            /* Out of memory: give up on the whole image */
+    bool          bad;            /* Current root is unsupported or cyclic */
+} ImageWriter;
+
+static bool imw_grow(void** buf, uint32_t* cap, uint32_t need, size_t elem) {
+    if (need <= *cap) return true;
+    uint32_t c = *cap ? *cap : 256;
+    while (c < need) c *= 2;
+    void* p = realloc(*buf, (size_t)c * elem);
+    if (!p) return false;
+    *buf = p;
+    *cap = c;
+    return true;
+}
+
+static uint32_t imw_hash(Cell* c) {
+    uint64_t x = (uint64_t)(uintptr_t)c;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+static ImageMapSlot* imw_map_find(ImageWriter* w, Cell* c) {
+    uint32_t mask = w->map_cap - 1;
+    uint32_t i = imw_hash(c) & mask;
+    while (w->map[i].key && w->map[i].key != c) i = (i + 1) & mask;
+    return &w->map[i];
+}
+
+static bool imw_map_put(ImageWriter* w, Cell* c, uint32_t idx) {
+    if ((w->map_size + 1) * 2 > w->map_cap) {
+        uint32_t old_cap = w->map_cap;
+        ImageMapSlot* old = w->map;
+        uint32_t cap = old_cap ? old_cap * 2 : 1024;
+        w->map = calloc(cap, sizeof(ImageMapSlot));
+        if (!w->map) { w->map = old; return false; }
+        w->map_cap = cap;
+        for (uint32_t i = 0; i < old_cap; i++) {
+            if (old[i].key) *imw_map_find(w, old[i].key) = old[i];
+        }
+        free(old);
+    }
+    ImageMapSlot* s = imw_map_find(w, c);
+    if (!s->key) {
+        s->key = c;
+        w->map_size++;
+    }
+    s->idx = idx;
+    if (!imw_grow((void**)&w->log, &w->cap_log, w->n_log + 1, sizeof(Cell*))) return false;
+    w->log[w->n_log++] = c;
+    return true;
+}
+
+/* Slot of a cell written (or being written) for the current image, or NULL */
+static ImageMapSlot* imw_seen(ImageWriter* w, Cell* c) {
+    if (!w->map_cap) return NULL;
+    ImageMapSlot* s = imw_map_find(w, c);
+    return (s->key && s->idx != IMAGE_STALE) ? s : NULL;
+}
+
+static uint32_t imw_string(ImageWriter* w, const char* s) {
+    uintptr_t known = (uintptr_t)strtable_get(&w->strings, s);
+    if (known) return (uint32_t)(known - 1);
+    size_t len = strlen(s);
+    if (w->strtab_len + len + 1 > UINT32_MAX / 2 ||
+        !imw_grow((void**)&w->strtab, &w->cap_strtab, w->strtab_len + (uint32_t)len + 1, 1)) {
+        w->oom = true;
+        return 0;
+    }
+    uint32_t off = w->strtab_len;
+    memcpy(w->strtab + off, s, len + 1);
+    w->strtab_len += (uint32_t)len + 1;
+    strtable_put(&w->strings, s, (void*)(uintptr_t)(off + 1));
+    return off;
+}
+
+static uint32_t imw_node(ImageWriter* w, Cell* c, uint8_t kind, uint8_t aux,
+                         uint32_t str, const uint32_t* edges, uint32_t n_edges,
+                         uint64_t payload) {
+    if (!imw_grow((void**)&w->nodes, &w->cap_nodes, w->n_nodes + 1, sizeof(ImageNode)) ||
+        !imw_grow((void**)&w->edges, &w->cap_edges, w->n_edges + n_edges, sizeof(uint32_t))) {
+        w->oom = true;
+        return 0;
+    }
+    ImageNode* nd = &w->nodes[w->n_nodes];
+    memset(nd, 0, sizeof(*nd));
+    nd->kind = kind;
+    nd->aux = aux;
+    nd->str = str;
+    nd->edge_off = w->n_edges;
+    nd->n_edges = n_edges;
+    nd->payload = payload;
+    if (n_edges) memcpy(w->edges + w->n_edges, edges, n_edges * sizeof(uint32_t));
+    w->n_edges += n_edges;
+    uint32_t idx = w->n_nodes++;
+    if (c && !imw_map_put(w, c, idx)) w->oom = true;
+    return idx;
+}
+
+static const char* imw_builtin_name(Cell* c) {
+    const Primitive* prims = primitives_table();
+    for (int i = 0; prims[i].name != NULL; i++) {
+        if ((void*)prims[i].fn == c->data.atom.builtin) return prims[i].name;
+    }
+    return NULL;
+}
+
+static uint32_t imw_cell(ImageWriter* w, Cell* c);
+
+/* Children of c, in the order imw_build expects them */
+static uint32_t* imw_children(ImageWriter* w, Cell* c, uint32_t* n_out) {
+    Cell* fixed[3];
+    Cell** kids = fixed;
+    uint32_t n = 0;
+    Cell* list = NULL;   /* Owned temporary, for sets */
+    switch (c->type) {
+        case CELL_LAMBDA:
+            fixed[0] = c->data.lambda.env;
+            fixed[1] = c->data.lambda.body;
+            fixed[2] = c->data.lambda.constraints;
+            n = 3;
+            break;
+        case CELL_ERROR:
+            fixed[0] = c->data.error.data;
+            fixed[1] = c->data.error.cause;
+            n = 2;
+            break;
+        case CELL_STRUCT:
+            fixed[0] = c->data.structure.type_tag;
+            fixed[1] = c->data.structure.variant;
+            fixed[2] = cell_struct_fields(c);
+            n = 3;
+            break;
+        case CELL_BOX:
+            fixed[0] = c->data.box.value;
+            n = 1;
+            break;
+        default:
+            break;
+    }
+
+    uint32_t extra = 0;
+    if (c->type == CELL_VECTOR) {
+        extra = c->data.vector.size;
+    } else if (c->type == CELL_HASHMAP) {
+        cell_hashmap_settle(c);  /* Entries below are read from ctrl/slots only */
+        extra = 2 * c->data.hashmap.size;
+    } else if (c->type == CELL_SET) {
+        list = cell_hashset_elements(c);
+        for (Cell* p = list; cell_is_pair(p); p = cell_cdr(p)) extra++;
+    } else if (c->type == CELL_LAMBDA && c->data.lambda.param_names) {
+        extra = (uint32_t)c->data.lambda.arity;
+    }
+
+    uint32_t* out = malloc(((size_t)n + extra + 1) * sizeof(uint32_t));
+    if (!out) {
+        w->oom = true;
+        if (list) cell_release(list);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = kids[i] ? imw_cell(w, kids[i]) : IMAGE_NONE;
+    }
+    if (c->type == CELL_VECTOR) {
+        for (uint32_t i = 0; i < extra; i++) out[n++] = imw_cell(w, cell_vector_get(c, i));
+    } else if (c->type == CELL_HASHMAP) {
+        uint8_t* ctrl = c->data.hashmap.ctrl;
+        HashSlot* slots = c->data.hashmap.slots;
+        for (uint32_t i = 0; i < c->data.hashmap.capacity; i++) {
+            if ((ctrl[i] & 0x80) == 0) {
+                out[n++] = imw_cell(w, slots[i].key);
+                out[n++] = imw_cell(w, slots[i].value);
+            }
+        }
+    } else if (c->type == CELL_SET) {
+        for (Cell* p = list; cell_is_pair(p); p = cell_cdr(p)) out[n++] = imw_cell(w, cell_car(p));
+        cell_release(list);
+    } else if (extra) {
+        /* Parameter names, kept for documentation */
+        for (uint32_t i = 0; i < extra; i++) {
+            uint32_t str = imw_string(w, c->data.lambda.param_names[i]);
+            out[n++] = imw_node(w, NULL, IM_SYMBOL, 0, str, NULL, 0, 0);
+        }
+    }
+    *n_out = n;
+    return out;
+}
+
+/* Post-order with sharing: a cell already written is referenced, not copied */
+static uint32_t imw_cell(ImageWriter* w, Cell* c) {
+    if (w->oom || w->bad) return 0;
+    ImageMapSlot* s = imw_seen(w, c);
+    if (s) {
+        if (s->idx == IMAGE_NONE) w->bad = true;   /* Cycle */
+        return s->idx;
+    }
+
+    switch (c->type) {
+        case CELL_ATOM_NIL:     return imw_node(w, c, IM_NIL, 0, IMAGE_NONE, NULL, 0, 0);
+        case CELL_ATOM_INTEGER: return imw_node(w, c, IM_INTEGER, 0, IMAGE_NONE, NULL, 0,
+                                                (uint64_t)c->data.atom.integer);
+        case CELL_ATOM_BOOL:    return imw_node(w, c, IM_BOOL, 0, IMAGE_NONE, NULL, 0,
+                                                c->data.atom.boolean ? 1 : 0);
+        case CELL_ATOM_NUMBER: {
+            uint64_t bits;
+            memcpy(&bits, &c->data.atom.number, sizeof(bits));
+            return imw_node(w, c, IM_NUMBER, 0, IMAGE_NONE, NULL, 0, bits);
+        }
+        case CELL_ATOM_SYMBOL:
+            return imw_node(w, c, IM_SYMBOL, 0, imw_string(w, cell_get_symbol(c)), NULL, 0, 0);
+        case CELL_ATOM_STRING:
+            return imw_node(w, c, IM_STRING, 0, imw_string(w, cell_get_string(c)), NULL, 0, 0);
+        case CELL_BUILTIN: {
+            const char* name = imw_builtin_name(c);
+            if (!name) { w->bad = true; return 0; }
+            return imw_node(w, c, IM_BUILTIN, 0, imw_string(w, name), NULL, 0, 0);
+        }
+        case CELL_PAIR: {
+            /* Iterate along the list; stop at a tail that is already written */
+            uint32_t n = 0;
+            Cell* p = c;
+            while (cell_is_pair(p) && (n == 0 || !imw_seen(w, p))) {
+                if (!imw_map_put(w, p, IMAGE_NONE)) { w->oom = true; return 0; }
+                n++;
+                p = cell_cdr(p);
+            }
+            uint32_t* cars = malloc((size_t)n * sizeof(uint32_t));
+            Cell** pairs = malloc((size_t)n * sizeof(Cell*));
+            if (!cars || !pairs) {
+                free(cars);
+                free(pairs);
+                w->oom = true;
+                return 0;
+            }
+            p = c;
+            for (uint32_t i = 0; i < n; i++, p = cell_cdr(p)) {
+                pairs[i] = p;
+                cars[i] = imw_cell(w, cell_car(p));
+            }
+            uint32_t tail = imw_cell(w, p);
+            for (uint32_t i = n; i-- > 0 && !w->oom && !w->bad;) {
+                tail = imw_node(w, pairs[i], IM_PAIR, 0, IMAGE_NONE, NULL, 0,
+                                (uint64_t)cars[i] | ((uint64_t)tail << 32));
+            }
+            free(cars);
+            free(pairs);
+            return tail;
+        }
+        case CELL_LAMBDA:
+        case CELL_ERROR:
+        case CELL_STRUCT:
+        case CELL_BOX:
+        case CELL_VECTOR:
+        case CELL_HASHMAP:
+        case CELL_SET:
+            break;
+        default:
+            w->bad = true;   /* Process-local: actors, ports, FFI pointers, ... */
+            return 0;
+    }
+
+    if (!imw_map_put(w, c, IMAGE_NONE)) { w->oom = true; return 0; }
+    uint32_t n = 0;
+    uint32_t* kids = imw_children(w, c, &n);
+    if (!kids || w->oom || w->bad) {
+        free(kids);
+        return 0;
+    }
+
+    uint32_t idx = 0;
+    switch (c->type) {
+        case CELL_LAMBDA: {
+            const char* module = c->data.lambda.source_module;
+            uint32_t str = module ? imw_string(w, module) : IMAGE_NONE;
+            uint64_t payload = (uint32_t)c->data.lambda.arity |
+                               ((uint64_t)(uint32_t)c->data.lambda.source_line << 32);
+            idx = imw_node(w, c, IM_LAMBDA, c->data.lambda.param_names ? 1 : 0,
+                           str, kids, n, payload);
+            break;
+        }
+        case CELL_ERROR:
+            idx = imw_node(w, c, IM_ERROR, 0, imw_string(w, c->data.error.message), kids, n, 0);
+            break;
+        case CELL_STRUCT:
+            idx = imw_node(w, c, IM_STRUCT, (uint8_t)c->data.structure.kind, IMAGE_NONE, kids, n, 0);
+            break;
+        case CELL_BOX:     idx = imw_node(w, c, IM_BOX, 0, IMAGE_NONE, kids, n, 0); break;
+        case CELL_VECTOR:  idx = imw_node(w, c, IM_VECTOR, 0, IMAGE_NONE, kids, n, 0); break;
+        case CELL_HASHMAP: idx = imw_node(w, c, IM_HASHMAP, c->data.hashmap.hash_family, IMAGE_NONE, kids, n, 0); break;
+        case CELL_SET:     idx = imw_node(w, c, IM_SET, c->data.hashset.hash_family, IMAGE_NONE, kids, n, 0); break;
+        default: break;
+    }
+    free(kids);
+    return idx;
+}
+
+/* Write one value as a unit: if any part of it cannot be imaged, everything
+ * it added is rolled back and IMAGE_NONE returned */
+static uint32_t imw_root(ImageWriter* w, Cell* c) {
+    if (!c || w->oom) return IMAGE_NONE;
+    uint32_t n_nodes = w->n_nodes, n_edges = w->n_edges;
+    w->n_log = 0;
+    w->bad = false;
+    uint32_t idx = imw_cell(w, c);
+    if (!w->bad) return w->oom ? IMAGE_NONE : idx;
+    for (uint32_t i = 0; i < w->n_log; i++) imw_map_find(w, w->log[i])->idx = IMAGE_STALE;
+    w->n_nodes = n_nodes;
+    w->n_edges = n_edges;
+    w->bad = false;
+    return IMAGE_NONE;
+}
+
+static void imw_record(ImageWriter* w, uint32_t op, uint32_t str,
+                       uint32_t a, uint32_t b, uint32_t c) {
+    if (!imw_grow((void**)&w->records, &w->cap_records, w->n_records + 1, sizeof(ImageRecord))) {
+        w->oom = true;
+        return;
+    }
+    w->records[w->n_records++] = (ImageRecord){ op, str, a, b, c };
+}
+
+static int module_by_load_order(const void* a, const void* b) {
+    const ModuleEntry* x = *(ModuleEntry* const*)a;
+    const ModuleEntry* y = *(ModuleEntry* const*)b;
+    return (x->load_order > y->load_order) - (x->load_order < y->load_order);
+}
+
+/* Registered modules, oldest first */
+static ModuleEntry** image_modules(uint32_t* n_out) {
+    Cell* names = module_registry_list_modules();
+    uint32_t n = 0;
+    for (Cell* p = names; cell_is_pair(p); p = cell_cdr(p)) n++;
+    ModuleEntry** mods = malloc(((size_t)n + 1) * sizeof(ModuleEntry*));
+    if (mods) {
+        n = 0;
+        for (Cell* p = names; cell_is_pair(p); p = cell_cdr(p)) {
+            ModuleEntry* e = module_registry_get_entry(cell_get_string(cell_car(p)));
+            if (e) mods[n++] = e;
+        }
+        qsort(mods, n, sizeof(ModuleEntry*), module_by_load_order);
+    }
+    cell_release(names);
+    *n_out = n;
+    return mods;
+}
+
+static void image_save_define(ImageWriter* w, uint32_t module, const char* name,
+                              Cell* value, int* saved, Cell** skipped) {
+    uint32_t idx = imw_root(w, value);
+    if (idx == IMAGE_NONE) {
+        Cell* sym = cell_symbol(name);
+        Cell* rest = *skipped;
+        *skipped = cell_cons(sym, rest);
+        cell_release(sym);
+        cell_release(rest);
+        return;
+    }
+    imw_record(w, IR_DEFINE, module, imw_string(w, name), idx, 0);
+    (*saved)++;
+}
+
+/* Definitions made while loading a module file, oldest first */
+static void image_save_module_defines(ImageWriter* w, ModuleEntry* e,
+                                      int* saved, Cell** skipped) {
+    uint32_t n = 0;
+    for (Cell* p = e->symbols; cell_is_pair(p); p = cell_cdr(p)) n++;
+    Cell** syms = malloc(((size_t)n + 1) * sizeof(Cell*));
+    if (!syms) { w->oom = true; return; }
+    n = 0;
+    for (Cell* p = e->symbols; cell_is_pair(p); p = cell_cdr(p)) syms[n++] = cell_car(p);
+
+    uint32_t module = imw_string(w, e->name);
+    while (n-- > 0 && !w->oom) {
+        const char* name = cell_get_symbol(syms[n]);
+        Cell* value = module_registry_lookup(e->name, name);
+        if (!value) continue;
+        image_save_define(w, module, name, value, saved, skipped);
+        cell_release(value);
+    }
+    free(syms);
+}
+
+/* Top-level definitions (REPL, test file, main script), oldest first. The
+ * global env lists every binding newest first, redefinitions included. */
+static void image_save_toplevel_defines(ImageWriter* w, EvalContext* ctx,
+                                        int* saved, Cell** skipped) {
+    uint32_t n = 0;
+    for (Cell* p = ctx->global_env; cell_is_pair(p); p = cell_cdr(p)) n++;
+    const char** names = malloc(((size_t)n + 1) * sizeof(char*));
+    if (!names) { w->oom = true; return; }
+
+    StrTable seen;
+    strtable_init(&seen, n + 1);
+    uint32_t k = 0;
+    for (Cell* p = ctx->global_env; cell_is_pair(p); p = cell_cdr(p)) {
+        Cell* binding = cell_car(p);
+        if (!cell_is_pair(binding) || !cell_is_symbol(cell_car(binding))) continue;
+        const char* name = cell_get_symbol(cell_car(binding));
+        if (strtable_get(&seen, name)) continue;
+        strtable_put(&seen, name, (void*)1);
+        const char* owner = module_registry_find_symbol(name);
+        if (owner && owner[0] != '<') continue;   /* Restored with its module */
+        names[k++] = name;
+    }
+    while (k-- > 0 && !w->oom) {
+        Cell* value = eval_lookup_global(ctx, names[k]);
+        if (!value) continue;
+        image_save_define(w, IMAGE_NONE, names[k], value, saved, skipped);
+        cell_release(value);
+    }
+    strtable_free(&seen, NULL);
+    free(names);
+}
+
+static void image_save_macros(ImageWriter* w, MacroEntry* m) {
+    if (!m || w->oom) return;
+    image_save_macros(w, m->next);   /* Oldest first, so restore rebuilds the same order */
+    uint32_t name = imw_string(w, m->name);
+    if (!m->is_pattern_based) {
+        uint32_t params = imw_root(w, m->params);
+        uint32_t body = imw_root(w, m->body);
+        if (params != IMAGE_NONE && body != IMAGE_NONE) {
+            imw_record(w, IR_MACRO, name, params, body, 0);
+        }
+        return;
+    }
+    /* Pattern clauses go back through macro_define_pattern as ((pattern template) ...) */
+    Cell* clauses = cell_nil();
+    Cell** tail = &clauses;
+    for (MacroClause* mc = m->clauses; mc; mc = mc->next) {
+        Cell* nil = cell_nil();
+        Cell* t = cell_cons(mc->templ, nil);
+        Cell* clause = cell_cons(mc->pattern, t);
+        Cell* node = cell_cons(clause, *tail);
+        cell_release(nil);
+        cell_release(t);
+        cell_release(clause);
+        cell_release(*tail);
+        *tail = node;
+        tail = &node->data.pair.cdr;
+    }
+    uint32_t idx = imw_root(w, clauses);
+    cell_release(clauses);
+    if (idx != IMAGE_NONE) imw_record(w, IR_MACRO, name, IMAGE_NONE, idx, 1);
+}
+
+int image_save(EvalContext* ctx, const char* path, Cell** skipped) {
+    ImageWriter w;
+    memset(&w, 0, sizeof(w));
+    strtable_init(&w.strings, 1024);
+    *skipped = cell_nil();
+    int saved = 0;
+
+    /* Interned strings first, so the restoring process assigns the same IDs */
+    uint16_t n_symbols = intern_count();
+    uint32_t* symbols = malloc(((size_t)n_symbols + 1) * sizeof(uint32_t));
+    if (!symbols) w.oom = true;
+    for (uint16_t i = 0; i < n_symbols && !w.oom; i++) {
+        symbols[i] = imw_string(&w, intern_name_by_id(i));
+    }
+
+    uint32_t n_mods = 0;
+    ModuleEntry** mods = w.oom ? NULL : image_modules(&n_mods);
+    if (!mods) w.oom = true;
+    for (uint32_t i = 0; i < n_mods && !w.oom; i++) {
+        ModuleEntry* e = mods[i];
+        imw_record(&w, IR_MODULE, imw_string(&w, e->name), imw_root(&w, e->exports),
+                   imw_root(&w, e->dependencies),
+                   e->version ? imw_string(&w, e->version) : IMAGE_NONE);
+    }
+    for (uint32_t i = 0; i < n_mods && !w.oom; i++) {
+        if (mods[i]->name[0] != '<') image_save_module_defines(&w, mods[i], &saved, skipped);
+    }
+    image_save_toplevel_defines(&w, ctx, &saved, skipped);
+    for (uint32_t i = 0; i < n_mods && !w.oom; i++) {
+        ModuleEntry* e = mods[i];
+        if (e->load_state == MODULE_LOADED) {
+            imw_record(&w, IR_LOADED, imw_string(&w, e->name), imw_root(&w, e->cached_result),
+                       0, 0);
+        }
+    }
+    free(mods);
+    image_save_macros(&w, macro_entries());
+    imw_record(&w, IR_REGISTRIES, IMAGE_NONE, imw_root(&w, ctx->type_registry),
+               imw_root(&w, ctx->effect_registry), 0);
+
+    bool written = false;
+    size_t tlen = strlen(path) + 32;
+    char* tmp = malloc(tlen);
+    if (!w.oom && tmp) {
+        /* Write aside and rename, so a crash never leaves half an image */
+        snprintf(tmp, tlen, "%s.%ld.tmp", path, (long)getpid());
+        FILE* f = fopen(tmp, "wb");
+        if (f) {
+            ImageHeader h;
+            memset(&h, 0, sizeof(h));
+            memcpy(h.magic, IMAGE_MAGIC, 8);
+            h.version = IMAGE_VERSION;
+            h.n_symbols = n_symbols;
+            h.build_hash = image_build_hash();
+            h.n_nodes = w.n_nodes;
+            h.n_edges = w.n_edges;
+            h.n_records = w.n_records;
+            h.strtab_len = w.strtab_len;
+            written = fwrite(&h, sizeof(h), 1, f) == 1 &&
+                      fwrite(w.nodes, sizeof(ImageNode), w.n_nodes, f) == w.n_nodes &&
+                      fwrite(w.edges, sizeof(uint32_t), w.n_edges, f) == w.n_edges &&
+                      fwrite(w.records, sizeof(ImageRecord), w.n_records, f) == w.n_records &&
+                      fwrite(symbols, sizeof(uint32_t), n_symbols, f) == n_symbols &&
+                      fwrite(w.strtab, 1, w.strtab_len, f) == w.strtab_len;
+            written = (fclose(f) == 0) && written;
+            if (written) written = rename(tmp, path) == 0;
+            if (!written) unlink(tmp);
+        }
+    }
+    free(tmp);
+    free(symbols);
+    free(w.nodes);
+    free(w.edges);
+    free(w.records);
+    free(w.strtab);
+    free(w.map);
+    free(w.log);
+    strtable_free(&w.strings, NULL);
+    return written ? saved : -1;
+}
+
+/* ============================================================================
+ * Reading
+ * ============================================================================ */
+
+typedef struct {
+    const ImageHeader* h;
+    const ImageNode*   nodes;
+    const uint32_t*    edges;
+    const ImageRecord* records;
+    const uint32_t*    symbols;
+    const char*        strtab;
+} ImageView;
+
+static bool imr_str(const ImageView* v, uint32_t off, bool optional) {
+    return off < v->h->strtab_len || (optional && off == IMAGE_NONE);
+}
+
+static bool imr_ref(uint32_t idx, uint32_t limit, bool optional) {
+    return idx < limit || (optional && idx == IMAGE_NONE);
+}
+
+/* Every index, string and builtin name in range before anything is built */
+static bool image_validate(const ImageView* v) {
+    const ImageHeader* h = v->h;
+    if (h->strtab_len == 0 || v->strtab[h->strtab_len - 1] != '\0') return false;
+    for (uint32_t i = 0; i < h->n_symbols; i++) {
+        if (!imr_str(v, v->symbols[i], false)) return false;
+    }
+
+    for (uint32_t i = 0; i < h->n_nodes; i++) {
+        const ImageNode* nd = &v->nodes[i];
+        if ((uint64_t)nd->edge_off + nd->n_edges > h->n_edges) return false;
+        const uint32_t* e = v->edges + nd->edge_off;
+        uint32_t n = nd->n_edges;
+        bool ok = true;
+        switch (nd->kind) {
+            case IM_NIL:
+            case IM_NUMBER:
+            case IM_INTEGER:
+            case IM_BOOL:
+                ok = n == 0;
+                break;
+            case IM_SYMBOL:
+            case IM_STRING:
+                ok = n == 0 && imr_str(v, nd->str, false);
+                break;
+            case IM_BUILTIN:
+                ok = n == 0 && imr_str(v, nd->str, false) &&
+                     primitive_lookup_by_name(v->strtab + nd->str) != NULL;
+                break;
+            case IM_PAIR:
+                ok = n == 0 && (uint32_t)nd->payload < i && (uint32_t)(nd->payload >> 32) < i;
+                break;
+            case IM_LAMBDA: {
+                uint32_t arity = (uint32_t)nd->payload;
+                uint32_t names = (nd->aux & 1) ? arity : 0;
+                ok = arity <= 0xFFFF && n == 3 + names && imr_str(v, nd->str, true) &&
+                     imr_ref(e[0], i, true) && imr_ref(e[1], i, false) && imr_ref(e[2], i, true);
+                for (uint32_t k = 3; ok && k < n; k++) {
+                    ok = e[k] < i && v->nodes[e[k]].kind == IM_SYMBOL;
+                }
+                break;
+            }
+            case IM_ERROR:
+                ok = n == 2 && imr_str(v, nd->str, false) &&
+                     imr_ref(e[0], i, true) && imr_ref(e[1], i, true);
+                break;
+            case IM_STRUCT:
+                ok = n == 3 && nd->aux <= STRUCT_GRAPH && imr_ref(e[0], i, true) &&
+                     imr_ref(e[1], i, true) && imr_ref(e[2], i, true);
+                break;
+            case IM_BOX:
+                ok = n == 1 && imr_ref(e[0], i, true);
+                break;
+            case IM_HASHMAP:
+            case IM_SET:
+                ok = nd->aux <= CELL_HASH_FAST && (nd->kind == IM_SET || (n % 2) == 0);
+                /* fall through */
+            case IM_VECTOR:
+                for (uint32_t k = 0; ok && k < n; k++) ok = e[k] < i;
+                break;
+            default:
+                ok = false;
+        }
+        if (!ok) return false;
+    }
+
+    uint32_t nn = h->n_nodes;
+    for (uint32_t i = 0; i < h->n_records; i++) {
+        const ImageRecord* r = &v->records[i];
+        bool ok;
+        switch (r->op) {
+            case IR_MODULE:
+                ok = imr_str(v, r->str, false) && imr_ref(r->a, nn, true) &&
+                     imr_ref(r->b, nn, true) && imr_str(v, r->c, true);
+                break;
+            case IR_DEFINE:
+                ok = imr_str(v, r->str, true) && imr_str(v, r->a, false) && r->b < nn;
+                break;
+            case IR_LOADED:
+                ok = imr_str(v, r->str, false) && imr_ref(r->a, nn, true);
+                break;
+            case IR_MACRO:
+                ok = imr_str(v, r->str, false) && r->b < nn &&
+                     (r->c == 1 ? r->a == IMAGE_NONE : r->a < nn);
+                break;
+            case IR_REGISTRIES:
+                ok = imr_ref(r->a, nn, true) && imr_ref(r->b, nn, true);
+                break;
+            default:
+                ok = false;
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+static Cell* imr_get(Cell** cells, uint32_t idx) {
+    return idx == IMAGE_NONE ? NULL : cells[idx];
+}
+
+static Cell* image_build(const ImageView* v, const ImageNode* nd, Cell** cells) {
+    const uint32_t* e = v->edges + nd->edge_off;
+    const char* str = nd->str == IMAGE_NONE ? NULL : v->strtab + nd->str;
+    switch (nd->kind) {
+        case IM_NIL:     return cell_nil();
+        case IM_INTEGER: return cell_integer((int64_t)nd->payload);
+        case IM_BOOL:    return cell_bool(nd->payload != 0);
+        case IM_NUMBER: {
+            double d;
+            memcpy(&d, &nd->payload, sizeof(d));
+            return cell_number(d);
+        }
+        case IM_SYMBOL:  return cell_symbol(str);
+        case IM_STRING:  return cell_string(str);
+        case IM_BUILTIN: return primitives_lookup(NULL, str);
+        case IM_PAIR:
+            return cell_cons(cells[(uint32_t)nd->payload], cells[(uint32_t)(nd->payload >> 32)]);
+        case IM_LAMBDA: {
+            int arity = (int)(uint32_t)nd->payload;
+            Cell* c = cell_lambda(imr_get(cells, e[0]), cells[e[1]], arity, str,
+                                  (int)(uint32_t)(nd->payload >> 32));
+            Cell* constraints = imr_get(cells, e[2]);
+            if (constraints) {
+                cell_retain(constraints);
+                c->data.lambda.constraints = constraints;
+            }
+            if (nd->aux & 1) {
+                c->data.lambda.param_names = malloc((size_t)(arity ? arity : 1) * sizeof(char*));
+                for (int i = 0; i < arity; i++) {
+                    c->data.lambda.param_names[i] = strdup(cell_get_symbol(cells[e[3 + i]]));
+                }
+            }
+            return c;
+        }
+        case IM_ERROR: {
+            Cell* c = cell_error(str, imr_get(cells, e[0]));
+            Cell* cause = imr_get(cells, e[1]);
+            if (cause) {
+                cell_retain(cause);
+                c->data.error.cause = cause;
+            }
+            return c;
+        }
+        case IM_STRUCT:
+            return cell_struct((StructKind)nd->aux, imr_get(cells, e[0]),
+                               imr_get(cells, e[1]), imr_get(cells, e[2]));
+        case IM_BOX:
+            return cell_box(imr_get(cells, e[0]));
+        case IM_VECTOR: {
+            Cell* c = cell_vector_new(nd->n_edges);
+            for (uint32_t i = 0; i < nd->n_edges; i++) cell_vector_push(c, cells[e[i]]);
+            return c;
+        }
+        case IM_HASHMAP: {
+            Cell* c = cell_hashmap_new_with(nd->n_edges, (CellHashFamily)nd->aux);
+            for (uint32_t i = 0; i < nd->n_edges; i += 2) {
+                Cell* old = cell_hashmap_put(c, cells[e[i]], cells[e[i + 1]]);
+                if (old) cell_release(old);
+            }
+            return c;
+        }
+        case IM_SET: {
+            Cell* c = cell_hashset_new_with(0, (CellHashFamily)nd->aux);
+            for (uint32_t i = 0; i < nd->n_edges; i++) cell_hashset_add(c, cells[e[i]]);
+            return c;
+        }
+    }
+    return cell_nil();
+}
+
+static void image_apply(EvalContext* ctx, const ImageView* v, const ImageRecord* r,
+                        Cell** cells) {
+    const char* str = r->str == IMAGE_NONE ? NULL : v->strtab + r->str;
+    switch (r->op) {
+        case IR_MODULE: {
+            module_registry_add(str);
+            Cell* exports = imr_get(cells, r->a);
+            if (exports) module_registry_set_exports(str, exports);
+            ModuleEntry* e = module_registry_get_entry(str);
+            Cell* deps = imr_get(cells, r->b);
+            if (e && deps) {
+                cell_retain(deps);
+                cell_release(e->dependencies);
+                e->dependencies = deps;
+            }
+            if (r->c != IMAGE_NONE) module_registry_set_version(str, v->strtab + r->c);
+            break;
+        }
+        case IR_DEFINE:
+            module_set_current_loading(str);
+            eval_define(ctx, v->strtab + r->a, cells[r->b]);
+            break;
+        case IR_LOADED: {
+            ModuleEntry* e = module_registry_get_entry(str);
+            if (!e) break;
+            Cell* result = imr_get(cells, r->a);
+            if (result) cell_retain(result);
+            if (e->cached_result) cell_release(e->cached_result);
+            e->cached_result = result;
+            e->load_state = MODULE_LOADED;
+            break;
+        }
+        case IR_MACRO:
+            if (r->c == 1) {
+                macro_define_pattern(str, cells[r->b]);
+            } else {
+                macro_define(str, cells[r->a], cells[r->b]);
+            }
+            break;
+        case IR_REGISTRIES: {
+            Cell* types = imr_get(cells, r->a);
+            Cell* effects = imr_get(cells, r->b);
+            if (types) {
+                cell_retain(types);
+                cell_release(ctx->type_registry);
+                ctx->type_registry = types;
+                eval_rebuild_layouts(ctx);
+            }
+            if (effects) {
+                cell_retain(effects);
+                cell_release(ctx->effect_registry);
+                ctx->effect_registry = effects;
+            }
+            break;
+        }
+    }
+}
+
+bool image_load(EvalContext* ctx, const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ImageHeader)) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    bool loaded = false;
+    ImageView v;
+    v.h = map;
+    uint64_t expect = sizeof(ImageHeader) + (uint64_t)v.h->n_nodes * sizeof(ImageNode) +
+                      (uint64_t)v.h->n_edges * sizeof(uint32_t) +
+                      (uint64_t)v.h->n_records * sizeof(ImageRecord) +
+                      (uint64_t)v.h->n_symbols * sizeof(uint32_t) + v.h->strtab_len;
+    if (memcmp(v.h->magic, IMAGE_MAGIC, 8) != 0 || v.h->version != IMAGE_VERSION ||
+        expect != size || v.h->build_hash != image_build_hash()) {
+        goto done;
+    }
+    v.nodes = (const ImageNode*)(v.h + 1);
+    v.edges = (const uint32_t*)(v.nodes + v.h->n_nodes);
+    v.records = (const ImageRecord*)(v.edges + v.h->n_edges);
+    v.symbols = (const uint32_t*)(v.records + v.h->n_records);
+    v.strtab = (const char*)(v.symbols + v.h->n_symbols);
+    if (!image_validate(&v)) goto done;
+
+    Cell** cells = malloc(((size_t)v.h->n_nodes + 1) * sizeof(Cell*));
+    if (!cells) goto done;
+
+    for (uint32_t i = 0; i < v.h->n_symbols; i++) intern(v.strtab + v.symbols[i]);
+    for (uint32_t i = 0; i < v.h->n_nodes; i++) {
+        cells[i] = image_build(&v, &v.nodes[i], cells);
+    }
+
+    /* Definitions come back without re-running documentation: it is built
+     * on first lookup, as in production mode */
+    bool lazy = eval_lazy_docs();
+    const char* loading = module_get_current_loading();
+    eval_set_lazy_docs(true);
+    for (uint32_t i = 0; i < v.h->n_records; i++) {
+        image_apply(ctx, &v, &v.records[i], cells);
+    }
+    module_set_current_loading(loading);
+    eval_set_lazy_docs(lazy);
+
+    for (uint32_t i = 0; i < v.h->n_nodes; i++) cell_release(cells[i]);
+    free(cells);
+    loaded = true;
+
+done:
+    munmap(map, size);
+    return loaded;
+}
@@ -0,0 +1,32 @@
+/* image.h — Heap image save/restore (instant startup)
+ *
+ * save-image writes everything a run has built up by evaluation — the
+ * interned symbol table, global definitions (with their module), the macro,
+ * module, type and effect registries, and every cell reachable from them —
+ * to one relocatable file. `guage --image <file>` maps it at startup and
+ * rebuilds that state directly instead of re-loading and re-evaluating the
+ * source, so a restarted process is ready in milliseconds.
+ *
+ * Values that only make sense inside the process that made them (actors,
+ * channels, ports, FFI pointers, ...) cannot be imaged, and neither can
+ * containers the image format has no node for yet (sorted maps, tries,
+ * persistent maps/sets, deques, heaps, buffers, graphs, record tables).
+ * Definitions whose value reaches one are left out and reported.
+ */
+#ifndef GUAGE_IMAGE_H
+#define GUAGE_IMAGE_H
+
+#include "eval.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Write ctx's state to path. Returns the number of definitions saved, or
+ * -1 if the file could not be written; *skipped is set to an owned list of
+ * the names of left-out definitions, newest first. */
+int image_save(EvalContext* ctx, const char* path, Cell** skipped);
+
+/* Restore an image into ctx. False (and nothing restored) if the file is
+ * missing, damaged, or was written by a different build. */
+bool image_load(EvalContext* ctx, const char* path);
+
+#endif /* GUAGE_IMAGE_H */
@@ -192,6 +192,18 @@ uint64_t intern_hash_by_id(uint16_t id) {
     return intern_id_hash[id];
 }
 
+uint16_t intern_count(void) {
+    pthread_rwlock_rdlock(&intern_rwlock);
+    uint16_t n = intern_next_id;
+    pthread_rwlock_unlock(&intern_rwlock);
+    return n;
+}
+
+const char* intern_name_by_id(uint16_t id) {
+    assert(id < intern_next_id);
+    return intern_id_canonical[id];
+}
+
 /* Pre-intern special forms — IDs must match SYM_ID_* constants exactly */
 void intern_preload(void) {
     static const char* specials[] = {
@@ -61,4 +61,10 @@ InternResult intern(const char* str);
 /* O(1) hash lookup by ID (direct array index) */
 uint64_t intern_hash_by_id(uint16_t id);
 
+/* Number of interned strings; IDs run from 0 to intern_count() - 1 */
+uint16_t intern_count(void);
+
+/* O(1) canonical string by ID (direct array index) */
+const char* intern_name_by_id(uint16_t id);
+
 #endif /* GUAGE_INTERN_H */
@@ -42,6 +42,7 @@ typedef enum {
     ITER_TRIE,
     ITER_BUFFER,
     ITER_GRAPH,
+    ITER_TABLE,
     /* Transformer iterators */
     ITER_MAP,
     ITER_FILTER,
@@ -76,19 +77,37 @@ typedef struct {
             uint32_t aux_cap;
         } heap;
         struct {
-            void* pool;
+            void*    pool;
             uint32_t leaf_idx;
-            uint8_t  key_idx;
+            int16_t  key_idx;     /* Next entry to yield in leaf_idx */
+            bool     reverse;
+            uint32_t version;     /* Map version the position belongs to */
+            uint64_t lo_sk, hi_sk;
+            Cell*    lo;          /* Inclusive bounds (NULL = open) */
+            Cell*    hi;
+            Cell*    last;        /* Last key yielded: resume point after a mutation */
         } sorted_map;
         struct {
-            void*    stack[32];
-            uint8_t  child_idx[32];
-            uint8_t  prefix[256];
-            uint16_t prefix_len;
-            int8_t   depth;
+            void**   nodes;       /* DFS stack of inner ART nodes */
+            int16_t* slots;       /* Next child ordinal per stacked node */
+            uint32_t depth;
+            uint32_t cap;
+            void*    pending;     /* Leaf to yield before resuming the stack */
+            uint8_t* prefix;      /* Owned prefix bound (NULL = whole trie) */
+            uint32_t prefix_len;
+            uint8_t* last;        /* Last key yielded: resume point after a mutation */
+            uint32_t last_len;
+            uint32_t version;     /* Trie version the stack belongs to */
+            bool     reverse;
         } trie;
         struct { uint32_t byte_idx; } buffer;
         struct { Cell* remaining; } graph;
+        struct {
+            uint32_t row;         /* Next row to test */
+            int32_t  col;         /* Predicate column (-1 = every row) */
+            uint8_t  op;          /* TableOp */
+            Cell*    bound;       /* Predicate operand (retained) */
+        } table;
 
         /* --- Transformer states --- */
         struct { Cell* upstream; Cell* fn; } map;
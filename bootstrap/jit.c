@@ -7,11 +7,15 @@
 #include "jit.h"
 #include "eval.h"
 #include "intern.h"
+#include "macro.h"
+#include "primitives.h"
+#include "scheduler.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <stddef.h>
 #include <sys/mman.h>
+#include <pthread.h>
 
 #ifdef __APPLE__
 #include <libkern/OSCacheControl.h>
@@ -48,6 +52,21 @@ static void init_struct_offsets(void) {
 
 JITCompiler g_jit_compiler = {0};
 
+/* Compile lock: owns the code cache, the arena and the retired list.
+ * Queue lock: only the compile request ring. */
+static pthread_mutex_t g_jit_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_jit_queue_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Per-thread hot counters, flushed to the lambda every JIT_HOT_BATCH calls.
+ * Only compared against the lambda being called, never dereferenced, so a
+ * stale entry just loses a few counts. */
+typedef struct {
+    Cell*    fn;
+    uint32_t count;
+} JITHotSlot;
+
+static _Thread_local JITHotSlot tls_jit_hot[JIT_HOT_LOCAL_SLOTS];
+
 /* Stencil table - populated by platform init */
 static JITStencil g_stencils[JOP_COUNT] = {0};
 
@@ -55,10 +74,30 @@ static JITStencil g_stencils[JOP_COUNT] = {0};
  * Arena Allocator
  * ============================================================================ */
 
+/* Code of evicted traces, reused first-fit before bumping */
+typedef struct JITCodeBlock {
+    size_t off;
+    size_t size;
+    struct JITCodeBlock* next;
+} JITCodeBlock;
+
 static void* arena_alloc(size_t size) {
     /* Align to 16 bytes */
     size = (size + 15) & ~15;
 
+    for (JITCodeBlock** p = &g_jit_compiler.free_code; *p; p = &(*p)->next) {
+        JITCodeBlock* b = *p;
+        if (b->size < size) continue;
+        void* ptr = g_jit_compiler.code_arena + b->off;
+        b->off += size;
+        b->size -= size;
+        if (b->size == 0) {
+            *p = b->next;
+            free(b);
+        }
+        return ptr;
+    }
+
     if (g_jit_compiler.code_arena_pos + size > g_jit_compiler.code_arena_size) {
         return NULL;  /* Arena exhausted */
     }
@@ -68,10 +107,57 @@ static void* arena_alloc(size_t size) {
     return ptr;
 }
 
+static void arena_free(void* ptr, size_t size) {
+    if (!ptr || size == 0) return;
+    size = (size + 15) & ~15;
+    size_t off = (size_t)((uint8_t*)ptr - g_jit_compiler.code_arena);
+
+    JITCodeBlock** p = &g_jit_compiler.free_code;
+    JITCodeBlock* prev = NULL;
+    while (*p && (*p)->off < off) {
+        prev = *p;
+        p = &(*p)->next;
+    }
+
+    /* Coalesce with neighbours */
+    if (prev && prev->off + prev->size == off) {
+        prev->size += size;
+        JITCodeBlock* next = prev->next;
+        if (next && prev->off + prev->size == next->off) {
+            prev->size += next->size;
+            prev->next = next->next;
+            free(next);
+        }
+    } else if (*p && off + size == (*p)->off) {
+        (*p)->off = off;
+        (*p)->size += size;
+        prev = *p;
+    } else {
+        JITCodeBlock* b = malloc(sizeof(JITCodeBlock));
+        if (!b) return;  /* Leaked until shutdown */
+        b->off = off;
+        b->size = size;
+        b->next = *p;
+        *p = b;
+        prev = b;
+    }
+
+    /* A block touching the bump pointer goes back to the bump region */
+    if (prev->off + prev->size == g_jit_compiler.code_arena_pos && !prev->next) {
+        g_jit_compiler.code_arena_pos = prev->off;
+        for (p = &g_jit_compiler.free_code; *p != prev; p = &(*p)->next) {}
+        *p = NULL;
+        free(prev);
+    }
+}
+
 /* ============================================================================
  * JIT Initialization
  * ============================================================================ */
 
+static void cache_evict(JITTrace* trace);
+static void cache_reclaim(bool all);
+
 void jit_init(void) {
     if (g_jit_compiler.code_arena) return;  /* Already initialized */
 
@@ -105,10 +191,23 @@ void jit_init(void) {
     jit_stencils_init_x64();
 #endif
 
-    g_jit_compiler.enabled = true;
-    g_jit_compiler.traces = NULL;
+    /* Code cache entries (GUAGE_JIT_CACHE overrides, mainly for testing) */
+    uint32_t cache_cap = JIT_CODE_CACHE_SIZE;
+    const char* cache_env = getenv("GUAGE_JIT_CACHE");
+    if (cache_env && atoi(cache_env) > 0) cache_cap = (uint32_t)atoi(cache_env);
+    g_jit_compiler.cache = calloc(cache_cap, sizeof(JITTrace*));
+    if (!g_jit_compiler.cache) {
+        munmap(g_jit_compiler.code_arena, JIT_CODE_ARENA_SIZE);
+        g_jit_compiler.code_arena = NULL;
+        fprintf(stderr, "JIT: Failed to allocate code cache\n");
+        return;
+    }
+    g_jit_compiler.cache_cap = cache_cap;
+    g_jit_compiler.cache_hand = 0;
     g_jit_compiler.trace_count = 0;
-    g_jit_compiler.hot_count = 0;
+    g_jit_compiler.free_code = NULL;
+
+    g_jit_compiler.enabled = true;
 
     fprintf(stderr, "JIT: Initialized with %zuMB code arena\n",
             (size_t)(JIT_CODE_ARENA_SIZE / (1024 * 1024)));
@@ -117,14 +216,21 @@ void jit_init(void) {
 void jit_shutdown(void) {
     if (!g_jit_compiler.code_arena) return;
 
-    /* Free all traces */
-    JITTrace* t = g_jit_compiler.traces;
-    while (t) {
-        JITTrace* next = t->next;
-        if (t->insts) free(t->insts);
-        if (t->constants) free(t->constants);
-        free(t);
-        t = next;
+    /* Free all traces (schedulers have stopped) */
+    for (uint32_t i = 0; i < g_jit_compiler.cache_cap; i++) {
+        if (g_jit_compiler.cache[i]) cache_evict(g_jit_compiler.cache[i]);
+    }
+    cache_reclaim(true);
+    while (g_jit_compiler.queue_head != g_jit_compiler.queue_tail) {
+        cell_release(g_jit_compiler.queue[g_jit_compiler.queue_head++ % JIT_COMPILE_QUEUE]);
+    }
+    free(g_jit_compiler.cache);
+    g_jit_compiler.cache = NULL;
+    g_jit_compiler.cache_cap = 0;
+    while (g_jit_compiler.free_code) {
+        JITCodeBlock* next = g_jit_compiler.free_code->next;
+        free(g_jit_compiler.free_code);
+        g_jit_compiler.free_code = next;
     }
 
     /* Unmap code arena */
@@ -210,43 +316,96 @@ double jit_helper_load_env_num(Cell* env, int index) {
 
 /* ============================================================================
  * Hot Function Tracking
+ *
+ * The call counter and the code cache entry live on the lambda cell, so
+ * counting a call and finding its trace are O(1) however many functions
+ * have been seen.
  * ============================================================================ */
 
-void jit_record_call(Cell* expr) {
-    if (!jit_is_enabled()) return;
+static JITTrace* jit_compile_locked(EvalContext* ctx, Cell* fn);
+
+/* Queue fn for compilation; false if the queue is full */
+static bool compile_enqueue(Cell* fn) {
+    bool queued = false;
+    pthread_mutex_lock(&g_jit_queue_lock);
+    if (g_jit_compiler.queue_tail - g_jit_compiler.queue_head < JIT_COMPILE_QUEUE) {
+        cell_retain(fn);
+        g_jit_compiler.queue[g_jit_compiler.queue_tail % JIT_COMPILE_QUEUE] = fn;
+        __atomic_store_n(&g_jit_compiler.queue_tail, g_jit_compiler.queue_tail + 1,
+                         __ATOMIC_RELEASE);
+        queued = true;
+    }
+    pthread_mutex_unlock(&g_jit_queue_lock);
+    return queued;
+}
 
-    /* Search for existing entry */
-    for (uint32_t i = 0; i < g_jit_compiler.hot_count; i++) {
-        if (g_jit_compiler.hot_functions[i].expr == expr) {
-            g_jit_compiler.hot_functions[i].count++;
+static Cell* compile_dequeue(void) {
+    Cell* fn = NULL;
+    pthread_mutex_lock(&g_jit_queue_lock);
+    if (g_jit_compiler.queue_head != g_jit_compiler.queue_tail) {
+        fn = g_jit_compiler.queue[g_jit_compiler.queue_head % JIT_COMPILE_QUEUE];
+        g_jit_compiler.queue_head++;
+    }
+    pthread_mutex_unlock(&g_jit_queue_lock);
+    return fn;
+}
 
-            /* Trigger compilation at threshold */
-            if (g_jit_compiler.hot_functions[i].count == JIT_HOT_THRESHOLD &&
-                g_jit_compiler.hot_functions[i].trace == NULL) {
-                g_jit_compiler.hot_functions[i].trace = jit_compile(expr);
+/* Compile queued lambdas unless another thread already is; that thread
+ * picks up our requests before it lets go of the lock. */
+static void compile_pending(EvalContext* ctx) {
+    while (__atomic_load_n(&g_jit_compiler.queue_tail, __ATOMIC_ACQUIRE) !=
+           __atomic_load_n(&g_jit_compiler.queue_head, __ATOMIC_RELAXED)) {
+        if (pthread_mutex_trylock(&g_jit_lock) != 0) return;
+        Cell* fn;
+        while ((fn = compile_dequeue()) != NULL) {
+            if (__atomic_load_n(&fn->data.lambda.jit_slot, __ATOMIC_ACQUIRE) == 0) {
+                jit_compile_locked(ctx, fn);
             }
-            return;
+            cell_release(fn);
         }
+        cache_reclaim(false);
+        pthread_mutex_unlock(&g_jit_lock);
     }
+}
 
-    /* Add new entry */
-    if (g_jit_compiler.hot_count < 1024) {
-        uint32_t idx = g_jit_compiler.hot_count++;
-        g_jit_compiler.hot_functions[idx].expr = expr;
-        g_jit_compiler.hot_functions[idx].count = 1;
-        g_jit_compiler.hot_functions[idx].trace = NULL;
+void jit_record_call(EvalContext* ctx, Cell* fn) {
+    if (!jit_is_enabled() || fn->type != CELL_LAMBDA) return;
+
+    /* Count locally; only every JIT_HOT_BATCH-th call touches the lambda */
+    JITHotSlot* hs = &tls_jit_hot[((uintptr_t)fn >> 4) & (JIT_HOT_LOCAL_SLOTS - 1)];
+    if (hs->fn != fn) {
+        hs->fn = fn;
+        hs->count = 0;
+    }
+    if (++hs->count < JIT_HOT_BATCH) return;
+    hs->count = 0;
+
+    uint32_t* counter = &fn->data.lambda.jit_calls;
+    if (__atomic_load_n(counter, __ATOMIC_RELAXED) >= JIT_HOT_THRESHOLD) return;
+    uint32_t calls = __atomic_add_fetch(counter, JIT_HOT_BATCH, __ATOMIC_RELAXED);
+
+    /* Exactly one thread sees the counter cross the threshold */
+    if (calls >= JIT_HOT_THRESHOLD && calls - JIT_HOT_BATCH < JIT_HOT_THRESHOLD &&
+        __atomic_load_n(&fn->data.lambda.jit_slot, __ATOMIC_ACQUIRE) == 0) {
+        if (!compile_enqueue(fn)) {
+            __atomic_store_n(counter, 0, __ATOMIC_RELAXED);  /* Retry later */
+            return;
+        }
+        compile_pending(ctx);
     }
 }
 
-JITTrace* jit_get_trace(Cell* expr) {
-    if (!jit_is_enabled()) return NULL;
+JITTrace* jit_get_trace(Cell* fn) {
+    if (!jit_is_enabled() || fn->type != CELL_LAMBDA) return NULL;
 
-    for (uint32_t i = 0; i < g_jit_compiler.hot_count; i++) {
-        if (g_jit_compiler.hot_functions[i].expr == expr) {
-            return g_jit_compiler.hot_functions[i].trace;
-        }
+    uint32_t slot = __atomic_load_n(&fn->data.lambda.jit_slot, __ATOMIC_ACQUIRE);
+    if (slot == 0) return NULL;
+    JITTrace* trace = __atomic_load_n(&g_jit_compiler.cache[slot - 1], __ATOMIC_ACQUIRE);
+    /* Entries are reused after eviction; a copied cell may carry a stale slot */
+    if (!trace || trace->lambda != fn || __atomic_load_n(&trace->invalid, __ATOMIC_RELAXED)) {
+        return NULL;
     }
-    return NULL;
+    return trace;
 }
 
 /* ============================================================================
@@ -274,319 +433,962 @@ static JITTrace* trace_new(void) {
     return trace;
 }
 
-static void trace_emit(JITTrace* trace, JITOpcode op, uint8_t dst,
-                       uint8_t src1, uint8_t src2) {
-    if (trace->n_insts >= trace->capacity) {
-        trace->capacity *= 2;
-        trace->insts = realloc(trace->insts, trace->capacity * sizeof(JITInst));
+static void trace_free(JITTrace* trace) {
+    if (trace->insts) free(trace->insts);
+    if (trace->constants) {
+        for (uint32_t i = 0; i < trace->n_constants; i++) {
+            if (trace->constants[i]) cell_release(trace->constants[i]);
+        }
+        free(trace->constants);
+    }
+    for (uint32_t i = 0; i < trace->n_guards; i++) {
+        cell_release(trace->guard_syms[i]);
+        cell_release(trace->guard_vals[i]);
     }
+    free(trace->guard_syms);
+    free(trace->guard_vals);
+    if (trace->root_expr) cell_release(trace->root_expr);
+    if (trace->lambda) cell_release(trace->lambda);
+    free(trace);
+}
 
-    JITInst* inst = &trace->insts[trace->n_insts++];
-    inst->op = op;
-    inst->dst = dst;
-    inst->src1 = src1;
-    inst->src2 = src2;
-    inst->flags = 0;
-    memset(&inst->imm, 0, sizeof(inst->imm));
+/* ============================================================================
+ * Code Cache
+ * ============================================================================ */
+
+/* Free a trace that no thread can be running */
+static void trace_discard(JITTrace* trace) {
+    arena_free(trace->native_code, trace->code_size);
+    arena_free(trace->numeric_code, trace->numeric_size);
+    trace_free(trace);
 }
 
-static void trace_emit_const_num(JITTrace* trace, uint8_t dst, double val) {
-    if (trace->n_insts >= trace->capacity) {
-        trace->capacity *= 2;
-        trace->insts = realloc(trace->insts, trace->capacity * sizeof(JITInst));
+/* Unpublish a trace; its lambda can warm up again. Threads that already
+ * loaded it may still be running it, so it is freed after a grace period.
+ * Caller holds the compile lock. */
+static void cache_evict(JITTrace* trace) {
+    if (g_jit_compiler.cache[trace->slot] == trace) {
+        __atomic_store_n(&g_jit_compiler.cache[trace->slot], NULL, __ATOMIC_RELEASE);
+        g_jit_compiler.trace_count--;
+    }
+    Cell* fn = trace->lambda;
+    if (__atomic_load_n(&fn->data.lambda.jit_slot, __ATOMIC_RELAXED) == trace->slot + 1) {
+        __atomic_store_n(&fn->data.lambda.jit_slot, 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&fn->data.lambda.jit_calls, 0, __ATOMIC_RELAXED);
+    }
+    trace->retire_epoch = atomic_load_explicit(&g_qsbr.global_epoch, memory_order_acquire);
+    trace->retired_next = g_jit_compiler.retired;
+    g_jit_compiler.retired = trace;
+}
+
+/* Free retired traces every scheduler has moved past (all: at shutdown).
+ * The activation count covers the same thread re-entering a trace. */
+static void cache_reclaim(bool all) {
+    JITTrace** p = &g_jit_compiler.retired;
+    while (*p) {
+        JITTrace* t = *p;
+        if (all || (__atomic_load_n(&t->active, __ATOMIC_ACQUIRE) == 0 &&
+                    qsbr_safe(t->retire_epoch))) {
+            *p = t->retired_next;
+            trace_discard(t);
+        } else {
+            p = &t->retired_next;
+        }
     }
+}
 
-    JITInst* inst = &trace->insts[trace->n_insts++];
-    inst->op = JOP_CONST_NUM;
-    inst->dst = dst;
-    inst->src1 = 0;
-    inst->src2 = 0;
-    inst->flags = 0;
-    inst->imm.num_const = val;
+/* Clock sweep: evict the first trace that has not run since the hand last
+ * passed it. Running traces are skipped. */
+static bool cache_evict_cold(void) {
+    uint32_t cap = g_jit_compiler.cache_cap;
+    for (uint32_t step = 0; step < 2 * cap; step++) {
+        uint32_t i = g_jit_compiler.cache_hand;
+        g_jit_compiler.cache_hand = (i + 1) % cap;
+        JITTrace* t = g_jit_compiler.cache[i];
+        if (!t || __atomic_load_n(&t->active, __ATOMIC_RELAXED)) continue;
+        if (__atomic_load_n(&t->referenced, __ATOMIC_RELAXED) &&
+            !__atomic_load_n(&t->invalid, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&t->referenced, false, __ATOMIC_RELAXED);
+            continue;
+        }
+        cache_evict(t);
+        g_jit_compiler.total_evictions++;
+        return true;
+    }
+    return false;
+}
+
+/* Give a compiled trace an entry and publish it to its lambda */
+static bool cache_insert(JITTrace* trace) {
+    if (g_jit_compiler.trace_count == g_jit_compiler.cache_cap && !cache_evict_cold()) {
+        return false;
+    }
+    uint32_t i = g_jit_compiler.cache_hand;
+    while (g_jit_compiler.cache[i]) i = (i + 1) % g_jit_compiler.cache_cap;
+
+    trace->slot = i;
+    trace->referenced = true;
+    g_jit_compiler.trace_count++;
+    __atomic_store_n(&g_jit_compiler.cache[i], trace, __ATOMIC_RELEASE);
+    __atomic_store_n(&trace->lambda->data.lambda.jit_slot, i + 1, __ATOMIC_RELEASE);
+    return true;
 }
 
-static void trace_emit_const_int(JITTrace* trace, uint8_t dst, int64_t val) {
+static JITInst* trace_emit(JITTrace* trace, JITOpcode op, uint8_t dst,
+                           uint8_t src1, uint8_t src2) {
     if (trace->n_insts >= trace->capacity) {
         trace->capacity *= 2;
         trace->insts = realloc(trace->insts, trace->capacity * sizeof(JITInst));
     }
 
     JITInst* inst = &trace->insts[trace->n_insts++];
-    inst->op = JOP_CONST_INT;
+    inst->op = op;
     inst->dst = dst;
-    inst->src1 = 0;
-    inst->src2 = 0;
+    inst->src1 = src1;
+    inst->src2 = src2;
     inst->flags = 0;
-    inst->imm.int_const = val;
+    inst->aux = 0;
+    memset(&inst->imm, 0, sizeof(inst->imm));
+    return inst;
+}
+
+/* ============================================================================
+ * Baseline Compiler
+ *
+ * Every value is a boxed Cell* living in a frame slot. Slots are allocated
+ * as a stack: an expression leaves its result in the next free slot and
+ * consumes the slots of its operands, so a call's arguments are always
+ * contiguous. Special forms the tier does not model are evaluated by
+ * eval_internal in the trace's environment (JOP_CALL_INTERP), so any lambda
+ * body compiles.
+ * ============================================================================ */
+
+typedef struct {
+    JITTrace*    trace;
+    EvalContext* ctx;
+    int          next;      /* Next free slot */
+    bool         ok;
+} BLState;
+
+static int bl_slot(BLState* st) {
+    if (st->next >= JIT_MAX_SLOTS) {
+        st->ok = false;
+        return 0;
+    }
+    int s = st->next++;
+    if (st->next > st->trace->n_slots) st->trace->n_slots = (uint16_t)st->next;
+    return s;
 }
 
-static uint32_t trace_add_constant(JITTrace* trace, Cell* cell) {
-    if (trace->n_constants >= JIT_MAX_CONSTANTS) return 0;
+static uint32_t bl_const(BLState* st, Cell* cell) {
+    JITTrace* trace = st->trace;
+    if (trace->n_constants >= JIT_MAX_CONSTANTS) {
+        st->ok = false;
+        return 0;
+    }
     uint32_t idx = trace->n_constants++;
     trace->constants[idx] = cell;
     cell_retain(cell);
     return idx;
 }
 
-/* ============================================================================
- * Expression Compilation
- * ============================================================================ */
+/* Record that sym must keep resolving to val for this trace to be valid */
+static void bl_guard(BLState* st, Cell* sym, Cell* val) {
+    JITTrace* trace = st->trace;
+    for (uint32_t i = 0; i < trace->n_guards; i++) {
+        if (trace->guard_syms[i]->sym_id == sym->sym_id) return;
+    }
+    uint32_t n = trace->n_guards + 1;
+    Cell** syms = realloc(trace->guard_syms, n * sizeof(Cell*));
+    if (!syms) { st->ok = false; return; }
+    trace->guard_syms = syms;
+    Cell** vals = realloc(trace->guard_vals, n * sizeof(Cell*));
+    if (!vals) { st->ok = false; return; }
+    trace->guard_vals = vals;
+    cell_retain(sym);
+    cell_retain(val);
+    syms[trace->n_guards] = sym;
+    vals[trace->n_guards] = val;
+    trace->n_guards = n;
+}
 
-/* Register allocation state */
-typedef struct {
-    uint8_t next_dreg;  /* Next double register (0-7) */
-    uint8_t next_ireg;  /* Next int register (8-15) */
-    uint8_t next_preg;  /* Next pointer register (16-23) */
-} RegAlloc;
+static int bl_compile(BLState* st, Cell* expr, bool tail);
 
-static uint8_t alloc_dreg(RegAlloc* ra) {
-    return ra->next_dreg < 8 ? ra->next_dreg++ : 0;
+/* Leave a constant in a fresh slot */
+static int bl_emit_const(BLState* st, Cell* value) {
+    int dst = bl_slot(st);
+    JITInst* inst = trace_emit(st->trace, JOP_CONST_CELL, dst, 0, 0);
+    inst->imm.const_index = bl_const(st, value);
+    return dst;
 }
 
-static uint8_t alloc_ireg(RegAlloc* ra) {
-    return ra->next_ireg < 16 ? ra->next_ireg++ : 8;
+/* Hand a whole subexpression to the interpreter */
+static int bl_emit_interp(BLState* st, Cell* expr, bool tail) {
+    int dst = bl_slot(st);
+    JITInst* inst = trace_emit(st->trace, JOP_CALL_INTERP, dst, 0, 0);
+    inst->flags = tail ? JIT_F_TAIL : 0;
+    inst->imm.const_index = bl_const(st, expr);
+    return dst;
 }
 
-static uint8_t alloc_preg(RegAlloc* ra) {
-    return ra->next_preg < 24 ? ra->next_preg++ : 16;
+static int bl_emit_label(BLState* st) {
+    return (int)st->trace->n_insts;
 }
 
-/* Forward declaration */
-static uint8_t compile_expr(JITTrace* trace, RegAlloc* ra, Cell* expr, int depth);
-
-/* Compile a primitive arithmetic operation */
-static uint8_t compile_arith(JITTrace* trace, RegAlloc* ra, const char* op,
-                             Cell* arg1, Cell* arg2, int depth) {
-    /* Compile operands */
-    uint8_t r1 = compile_expr(trace, ra, arg1, depth);
-    uint8_t r2 = compile_expr(trace, ra, arg2, depth);
-    uint8_t dst = alloc_dreg(ra);
-
-    /* Emit operation - handle both ASCII and Unicode operators */
-    JITOpcode jop;
-    if (strcmp(op, "+") == 0 || strcmp(op, "⊕") == 0)      jop = JOP_ADD_DD;
-    else if (strcmp(op, "-") == 0 || strcmp(op, "⊖") == 0) jop = JOP_SUB_DD;
-    else if (strcmp(op, "*") == 0 || strcmp(op, "⊗") == 0) jop = JOP_MUL_DD;
-    else if (strcmp(op, "/") == 0 || strcmp(op, "⊘") == 0) jop = JOP_DIV_DD;
-    else if (strcmp(op, "%") == 0) jop = JOP_MOD_DD;
-    else return r1;  /* Unknown op, return first arg */
+static void bl_patch(BLState* st, int at, int target) {
+    st->trace->insts[at].imm.jump_offset = (uint32_t)target;
+}
 
-    trace_emit(trace, jop, dst, r1, r2);
-    return dst;
+/* Specialised op for a builtin, or JOP_CALL_BUILTIN */
+static JITOpcode bl_builtin_op(Cell* builtin, int argc, uint8_t* flags) {
+    void* fn = builtin->data.atom.builtin;
+    *flags = 0;
+    if (argc == 1) {
+        if (fn == (void*)prim_car)        return JOP_CAR;
+        if (fn == (void*)prim_cdr)        return JOP_CDR;
+        if (fn == (void*)prim_box_create) return JOP_BOX_NEW;
+        if (fn == (void*)prim_box_deref)  return JOP_BOX_READ;
+    }
+    if (argc == 2) {
+        if (fn == (void*)prim_cons)    return JOP_CONS;
+        if (fn == (void*)prim_box_set) return JOP_BOX_WRITE;
+        static const struct { Cell* (*fn)(Cell*); JITArithOp op; } arith[] = {
+            {prim_add, JIT_ARITH_ADD}, {prim_sub, JIT_ARITH_SUB},
+            {prim_mul, JIT_ARITH_MUL}, {prim_div, JIT_ARITH_DIV},
+            {prim_lt, JIT_ARITH_LT},   {prim_gt, JIT_ARITH_GT},
+            {prim_le, JIT_ARITH_LE},   {prim_ge, JIT_ARITH_GE},
+        };
+        for (size_t i = 0; i < sizeof(arith) / sizeof(arith[0]); i++) {
+            if (fn == (void*)arith[i].fn) {
+                *flags = (uint8_t)arith[i].op;
+                return JOP_ARITH;
+            }
+        }
+    }
+    return JOP_CALL_BUILTIN;
 }
 
-/* Compile a comparison operation */
-static uint8_t compile_cmp(JITTrace* trace, RegAlloc* ra, const char* op,
-                           Cell* arg1, Cell* arg2, int depth) {
-    uint8_t r1 = compile_expr(trace, ra, arg1, depth);
-    uint8_t r2 = compile_expr(trace, ra, arg2, depth);
-    uint8_t dst = alloc_ireg(ra);
+/* Specialised arithmetic for a site whose two operands have always had
+ * the same kind (interpreter type feedback), or JOP_ARITH */
+static JITOpcode bl_arith_fast_op(Cell* site, uint8_t flags) {
+    uint8_t seen = __atomic_load_n(&site->data.pair.site_types, __ATOMIC_RELAXED);
+    static const JITOpcode ii[] = {
+        [JIT_ARITH_ADD] = JOP_ADD_II, [JIT_ARITH_SUB] = JOP_SUB_II,
+        [JIT_ARITH_MUL] = JOP_MUL_II, [JIT_ARITH_DIV] = JOP_ARITH,
+        [JIT_ARITH_LT] = JOP_LT_II,   [JIT_ARITH_GT] = JOP_GT_II,
+        [JIT_ARITH_LE] = JOP_LE_II,   [JIT_ARITH_GE] = JOP_GE_II,
+    };
+    static const JITOpcode dd[] = {
+        [JIT_ARITH_ADD] = JOP_ADD_DD, [JIT_ARITH_SUB] = JOP_SUB_DD,
+        [JIT_ARITH_MUL] = JOP_MUL_DD, [JIT_ARITH_DIV] = JOP_DIV_DD,
+        [JIT_ARITH_LT] = JOP_LT_DD,   [JIT_ARITH_GT] = JOP_GT_DD,
+        [JIT_ARITH_LE] = JOP_LE_DD,   [JIT_ARITH_GE] = JOP_GE_DD,
+    };
+    if (seen == (SITE_T_INT | SITE_T_INT << 4)) return ii[flags];
+    if (seen == (SITE_T_NUM | SITE_T_NUM << 4)) return dd[flags];
+    return JOP_ARITH;
+}
 
-    JITOpcode jop;
-    if (strcmp(op, "<") == 0)                                 jop = JOP_LT_DD;
-    else if (strcmp(op, "<=") == 0 || strcmp(op, "≤") == 0)   jop = JOP_LE_DD;
-    else if (strcmp(op, ">") == 0)                            jop = JOP_GT_DD;
-    else if (strcmp(op, ">=") == 0 || strcmp(op, "≥") == 0)   jop = JOP_GE_DD;
-    else if (strcmp(op, "equal?") == 0 || strcmp(op, "≡") == 0) jop = JOP_EQ_DD;
-    else return r1;
+static bool bl_arith_is_int(JITOpcode op) {
+    return (op >= JOP_ADD_II && op <= JOP_MOD_II) || (op >= JOP_LT_II && op <= JOP_EQ_II);
+}
 
-    trace_emit(trace, jop, dst, r1, r2);
-    return dst;
+/* Plain variable name: not a keyword and not module-qualified */
+static bool bl_plain_symbol(Cell* sym) {
+    const char* name = cell_get_symbol(sym);
+    if (name[0] == ':') return false;
+    const char* dot = strchr(name, '.');
+    return !(dot && dot != name && dot[1] != '\0');
 }
 
-/* Compile an expression to JIT IR */
-static uint8_t compile_expr(JITTrace* trace, RegAlloc* ra, Cell* expr, int depth) {
-    if (depth > JIT_MAX_INLINE_DEPTH) {
-        /* Too deep - emit call to interpreter */
-        uint32_t idx = trace_add_constant(trace, expr);
-        uint8_t dst = alloc_preg(ra);
-        JITInst* inst = &trace->insts[trace->n_insts++];
-        inst->op = JOP_CALL_INTERP;
-        inst->dst = dst;
-        inst->imm.const_index = idx;
-        return dst;
+static int bl_compile_application(BLState* st, Cell* expr, bool tail) {
+    Cell* head = cell_car(expr);
+    Cell* rest = cell_cdr(expr);
+
+    int argc = 0;
+    Cell* a = rest;
+    while (cell_is_pair(a)) { argc++; a = cell_cdr(a); }
+    if (!cell_is_nil(a)) return bl_emit_interp(st, expr, tail);
+
+    /* Globals bound to builtins are called directly; the trace's entry
+     * guard re-checks the binding whenever a builtin's name is redefined */
+    if (cell_is_symbol(head) && bl_plain_symbol(head)) {
+        Cell* val = eval_lookup_global(st->ctx, cell_get_symbol(head));
+        if (val && val->type == CELL_BUILTIN) {
+            bl_guard(st, head, val);
+            int first = st->next;
+            for (a = rest; cell_is_pair(a); a = cell_cdr(a)) {
+                bl_compile(st, cell_car(a), false);
+            }
+            st->next = first;
+            int dst = bl_slot(st);
+            uint8_t flags;
+            JITOpcode op = bl_builtin_op(val, argc, &flags);
+            JITOpcode fast = op == JOP_ARITH ? bl_arith_fast_op(expr, flags) : op;
+            uint32_t k = bl_const(st, val);
+            bl_const(st, head);  /* The name follows the builtin in the pool */
+            cell_release(val);
+
+            int guards = 0, skip = 0;
+            if (fast != op) {
+                /* Operands keep the types seen so far: guard, then the
+                 * specialised op; a failed guard takes the generic path */
+                JITOpcode guard = bl_arith_is_int(fast) ? JOP_GUARD_INT : JOP_GUARD_NUM;
+                guards = bl_emit_label(st);
+                trace_emit(st->trace, guard, 0, first, 0);
+                trace_emit(st->trace, guard, 0, first + 1, 0);
+                JITInst* inst = trace_emit(st->trace, fast, dst, first, first + 1);
+                inst->flags = flags;
+                inst->aux = (uint32_t)argc;
+                inst->imm.const_index = k;
+                skip = bl_emit_label(st);
+                trace_emit(st->trace, JOP_JUMP, 0, 0, 0);
+                bl_patch(st, guards, bl_emit_label(st));
+                bl_patch(st, guards + 1, bl_emit_label(st));
+            }
+            JITInst* inst = trace_emit(st->trace, op, dst, first, first + 1);
+            inst->flags = flags;
+            inst->aux = (uint32_t)argc;
+            inst->imm.const_index = k;
+            if (fast != op) bl_patch(st, skip, bl_emit_label(st));
+            return dst;
+        }
+        if (val) cell_release(val);
     }
 
-    if (!expr) {
-        trace_emit(trace, JOP_CONST_NIL, alloc_preg(ra), 0, 0);
-        return ra->next_preg - 1;
+    /* Generic application: callee first, then arguments, left to right */
+    int fn_slot = bl_compile(st, head, false);
+    for (a = rest; cell_is_pair(a); a = cell_cdr(a)) {
+        bl_compile(st, cell_car(a), false);
     }
+    st->next = fn_slot;
+    int dst = bl_slot(st);
+    JITInst* inst = trace_emit(st->trace, JOP_CALL, dst, fn_slot, 0);
+    inst->flags = tail ? JIT_F_TAIL : 0;
+    inst->aux = (uint32_t)argc;
+    inst->imm.const_index = bl_const(st, expr);
+    return dst;
+}
+
+/* (and a b) / (or a b): a is kept as the result when it decides */
+static int bl_compile_short_circuit(BLState* st, Cell* expr, uint8_t kind, bool tail) {
+    Cell* rest = cell_cdr(expr);
+    int dst = bl_compile(st, cell_car(rest), false);
+    int br = bl_emit_label(st);
+    JITInst* inst = trace_emit(st->trace, JOP_JUMP_IF, dst, dst, 0);
+    inst->flags = kind;
+    inst->aux = expr->span.inline_span.lo;
+    st->next = dst;
+    bl_compile(st, cell_car(cell_cdr(rest)), tail);
+    bl_patch(st, br, bl_emit_label(st));
+    return dst;
+}
 
-    /* After De Bruijn conversion:
-     * - Bare numbers are De Bruijn indices (variable references)
-     * - Number literals are wrapped in (quote <number>)
-     * So we check for bare numbers LAST after checking for quote forms
-     */
+static int bl_compile(BLState* st, Cell* expr, bool tail) {
+    if (!st->ok) return 0;
 
-    /* Boolean literal - self-evaluating */
-    if (cell_is_bool(expr)) {
-        uint8_t dst = alloc_ireg(ra);
-        JITInst* inst = &trace->insts[trace->n_insts++];
-        inst->op = JOP_CONST_BOOL;
-        inst->dst = dst;
-        inst->imm.int_const = cell_get_bool(expr) ? 1 : 0;
+    if (!expr || cell_is_nil(expr)) {
+        int dst = bl_slot(st);
+        trace_emit(st->trace, JOP_CONST_NIL, dst, 0, 0);
         return dst;
     }
 
-    /* Nil - self-evaluating */
-    if (cell_is_nil(expr)) {
-        uint8_t dst = alloc_preg(ra);
-        trace_emit(trace, JOP_CONST_NIL, dst, 0, 0);
-        return dst;
+    /* Bare numbers are De Bruijn indices when the frame has that slot,
+     * literals otherwise (same rule as eval_internal) */
+    if (cell_is_number(expr)) {
+        double num = cell_get_number(expr);
+        if (num >= 0 && num == (int)num) {
+            int dst = bl_slot(st);
+            JITInst* inst = trace_emit(st->trace, JOP_ENV_LOAD, dst, 0, 0);
+            inst->imm.const_index = bl_const(st, expr);
+            return dst;
+        }
+        return bl_emit_const(st, expr);
     }
 
-    /* String - self-evaluating */
-    if (cell_is_string(expr)) {
-        uint32_t idx = trace_add_constant(trace, expr);
-        uint8_t dst = alloc_preg(ra);
-        JITInst* inst = &trace->insts[trace->n_insts++];
-        inst->op = JOP_CONST_CELL;
-        inst->dst = dst;
-        inst->imm.const_index = idx;
-        return dst;
+    if (cell_is_integer(expr) || cell_is_bool(expr) || cell_is_string(expr)) {
+        return bl_emit_const(st, expr);
     }
 
-    /* Symbol - free variable or primitive (kept as symbol after De Bruijn) */
     if (cell_is_symbol(expr)) {
-        /* Free variable - emit as constant for interpreter lookup */
-        uint32_t idx = trace_add_constant(trace, expr);
-        uint8_t dst = alloc_preg(ra);
-        JITInst* inst = &trace->insts[trace->n_insts++];
-        inst->op = JOP_CONST_CELL;
-        inst->dst = dst;
-        inst->imm.const_index = idx;
+        if (cell_get_symbol(expr)[0] == ':') return bl_emit_const(st, expr);
+        if (!bl_plain_symbol(expr)) return bl_emit_interp(st, expr, false);
+        int dst = bl_slot(st);
+        JITInst* inst = trace_emit(st->trace, JOP_GLOBAL_LOAD, dst, 0, 0);
+        inst->imm.const_index = bl_const(st, expr);
         return dst;
     }
 
-    /* Integer literal - self-evaluating (native int64) */
-    if (cell_is_integer(expr)) {
-        uint8_t dst = alloc_ireg(ra);
-        trace_emit_const_int(trace, dst, cell_get_integer(expr));
-        return dst;
-    }
+    if (!cell_is_pair(expr)) return bl_emit_interp(st, expr, false);
 
-    /* Bare number after De Bruijn conversion = variable reference (index) */
-    if (cell_is_number(expr)) {
-        int index = (int)cell_get_number(expr);
-        uint8_t dst = alloc_preg(ra);
-        JITInst* inst = &trace->insts[trace->n_insts++];
-        inst->op = JOP_ENV_LOAD;
-        inst->dst = dst;
-        /* De Bruijn index is a single integer; depth/index encoding may vary.
-         * For now, use flat index (depth=0, index=idx) */
-        inst->imm.env.depth = 0;
-        inst->imm.env.index = (uint8_t)index;
-        return dst;
+    Cell* head = cell_car(expr);
+    Cell* rest = cell_cdr(expr);
+
+    if (cell_is_symbol(head) && macro_is_macro_call(expr)) {
+        return bl_emit_interp(st, expr, tail);
     }
 
-    /* Application (function call) or special form */
-    if (cell_is_pair(expr)) {
-        Cell* head = cell_car(expr);
-        Cell* args = cell_cdr(expr);
+    if (cell_is_symbol(head) && head->sym_id <= MAX_SPECIAL_FORM_ID) {
+        switch (head->sym_id) {
+            case SYM_ID_QUOTE:
+                if (cell_is_pair(rest)) return bl_emit_const(st, cell_car(rest));
+                break;
 
-        /* Check for special forms and primitive operations */
-        if (cell_is_symbol(head)) {
-            const char* sym = cell_get_symbol(head);
+            case SYM_ID_IF: {
+                if (!cell_is_pair(rest) || !cell_is_pair(cell_cdr(rest)) ||
+                    !cell_is_pair(cell_cdr(cell_cdr(rest)))) break;
+                int dst = bl_compile(st, cell_car(rest), false);
+                int br_else = bl_emit_label(st);
+                trace_emit(st->trace, JOP_JUMP_UNLESS, 0, dst, 0);
+                st->next = dst;
+                bl_compile(st, cell_car(cell_cdr(rest)), tail);
+                int br_end = bl_emit_label(st);
+                trace_emit(st->trace, JOP_JUMP, 0, 0, 0);
+                bl_patch(st, br_else, bl_emit_label(st));
+                st->next = dst;
+                bl_compile(st, cell_car(cell_cdr(cell_cdr(rest))), tail);
+                bl_patch(st, br_end, bl_emit_label(st));
+                return dst;
+            }
 
-            /* Quote: (quote <datum>) - this is how number literals appear after De Bruijn */
-            if (strcmp(sym, "quote") == 0 && cell_is_pair(args)) {
-                Cell* datum = cell_car(args);
-                if (cell_is_number(datum)) {
-                    /* Number literal */
-                    uint8_t dst = alloc_dreg(ra);
-                    trace_emit_const_num(trace, dst, cell_get_number(datum));
-                    return dst;
+            case SYM_ID_SEQUENCE: {
+                if (!cell_is_pair(rest)) break;
+                int dst = st->next;
+                int exits[64];
+                int n_exits = 0;
+                Cell* cur = rest;
+                while (cell_is_pair(cell_cdr(cur)) && n_exits < 64) {
+                    bl_compile(st, cell_car(cur), false);
+                    exits[n_exits++] = bl_emit_label(st);
+                    JITInst* inst = trace_emit(st->trace, JOP_JUMP_IF, dst, dst, 0);
+                    inst->flags = JIT_BR_ERROR;
+                    inst->aux = expr->span.inline_span.lo;
+                    st->next = dst;
+                    cur = cell_cdr(cur);
                 }
-                if (cell_is_integer(datum)) {
-                    /* Integer literal */
-                    uint8_t dst = alloc_ireg(ra);
-                    trace_emit_const_int(trace, dst, cell_get_integer(datum));
-                    return dst;
+                if (cell_is_pair(cell_cdr(cur))) {
+                    /* Very long block: leave the remainder to the interpreter */
+                    Cell* seq = cell_cons(head, cur);
+                    bl_emit_interp(st, seq, tail);
+                    cell_release(seq);
+                } else {
+                    bl_compile(st, cell_car(cur), tail);
                 }
-                /* Other quoted datum - emit as constant */
-                uint32_t idx = trace_add_constant(trace, datum);
-                uint8_t dst = alloc_preg(ra);
-                JITInst* inst = &trace->insts[trace->n_insts++];
-                inst->op = JOP_CONST_CELL;
-                inst->dst = dst;
-                inst->imm.const_index = idx;
+                int end = bl_emit_label(st);
+                for (int i = 0; i < n_exits; i++) bl_patch(st, exits[i], end);
                 return dst;
             }
 
-            /* Arithmetic: + ⊕ - ⊖ * ⊗ / ⊘ % */
-            if ((strcmp(sym, "+") == 0 || strcmp(sym, "⊕") == 0 ||
-                 strcmp(sym, "-") == 0 || strcmp(sym, "⊖") == 0 ||
-                 strcmp(sym, "*") == 0 || strcmp(sym, "⊗") == 0 ||
-                 strcmp(sym, "/") == 0 || strcmp(sym, "⊘") == 0 ||
-                 strcmp(sym, "%") == 0) && cell_is_pair(args)) {
-                Cell* a1 = cell_car(args);
-                Cell* rest = cell_cdr(args);
-                if (cell_is_pair(rest)) {
-                    Cell* a2 = cell_car(rest);
-                    return compile_arith(trace, ra, sym, a1, a2, depth + 1);
-                }
-            }
+            case SYM_ID_AND:
+            case SYM_ID_OR:
+                if (!cell_is_pair(rest) || !cell_is_pair(cell_cdr(rest))) break;
+                return bl_compile_short_circuit(st, expr,
+                    head->sym_id == SYM_ID_AND ? JIT_BR_AND : JIT_BR_OR, tail);
 
-            /* Comparisons: <, ≤, >, ≥, ≡ */
-            if ((strcmp(sym, "<") == 0 || strcmp(sym, "≤") == 0 ||
-                 strcmp(sym, ">") == 0 || strcmp(sym, "≥") == 0 ||
-                 strcmp(sym, "<=") == 0 || strcmp(sym, ">=") == 0 ||
-                 strcmp(sym, "equal?") == 0 || strcmp(sym, "≡") == 0) && cell_is_pair(args)) {
-                Cell* a1 = cell_car(args);
-                Cell* rest = cell_cdr(args);
-                if (cell_is_pair(rest)) {
-                    Cell* a2 = cell_car(rest);
-                    return compile_cmp(trace, ra, sym, a1, a2, depth + 1);
-                }
-            }
+            default:
+                break;
+        }
+        return bl_emit_interp(st, expr, tail);
+    }
 
-            /* car/cdr */
-            if (strcmp(sym, "car") == 0 && cell_is_pair(args)) {
-                uint8_t r = compile_expr(trace, ra, cell_car(args), depth + 1);
-                uint8_t dst = alloc_preg(ra);
-                trace_emit(trace, JOP_CAR, dst, r, 0);
-                return dst;
-            }
-            if (strcmp(sym, "cdr") == 0 && cell_is_pair(args)) {
-                uint8_t r = compile_expr(trace, ra, cell_car(args), depth + 1);
-                uint8_t dst = alloc_preg(ra);
-                trace_emit(trace, JOP_CDR, dst, r, 0);
-                return dst;
-            }
+    return bl_compile_application(st, expr, tail);
+}
 
-            /* cons */
-            if (strcmp(sym, "cons") == 0 && cell_is_pair(args)) {
-                Cell* a1 = cell_car(args);
-                Cell* rest = cell_cdr(args);
-                if (cell_is_pair(rest)) {
-                    Cell* a2 = cell_car(rest);
-                    uint8_t r1 = compile_expr(trace, ra, a1, depth + 1);
-                    uint8_t r2 = compile_expr(trace, ra, a2, depth + 1);
-                    uint8_t dst = alloc_preg(ra);
-                    trace_emit(trace, JOP_CONS, dst, r1, r2);
-                    return dst;
-                }
-            }
+/* ============================================================================
+ * Baseline Runtime
+ *
+ * Each IR instruction becomes a call to one of these ops, with the frame
+ * and the instruction patched in as arguments. Type-specialised ops guard
+ * their operands; on a miss they call the builtin they replaced, which
+ * produces the interpreter's exact result (including its errors).
+ * ============================================================================ */
+
+enum { JIT_NEXT = 0, JIT_TAKEN = 1 };   /* Branch ops */
+enum { JIT_DONE = 0, JIT_LOOP = 1 };    /* Terminal ops */
+
+static inline Cell* slot_take(JITFrame* f, uint8_t s) {
+    Cell* v = f->slots[s];
+    f->slots[s] = NULL;
+    return v;
+}
+
+static inline void slot_put(JITFrame* f, uint8_t s, Cell* v) {
+    if (f->slots[s]) cell_release(f->slots[s]);
+    f->slots[s] = v;
+}
+
+/* Take n contiguous slots as a fresh argument list */
+static Cell* slot_take_list(JITFrame* f, uint8_t first, uint32_t n) {
+    Cell* list = cell_nil();
+    for (uint32_t i = n; i > 0; i--) {
+        Cell* v = slot_take(f, (uint8_t)(first + i - 1));
+        Cell* next = cell_cons(v, list);
+        cell_release(v);
+        cell_release(list);
+        list = next;
+    }
+    return list;
+}
+
+static inline Cell* inst_const(JITFrame* f, const JITInst* in) {
+    return f->trace->constants[in->imm.const_index];
+}
+
+/* Call the builtin an op was specialised from */
+static Cell* call_builtin(Cell* builtin, Cell* args) {
+    Cell* (*fn)(Cell*) = (Cell* (*)(Cell*))builtin->data.atom.builtin;
+    return fn(args);
+}
+
+static Cell* builtin_slow1(JITFrame* f, const JITInst* in, Cell* a) {
+    Cell* args = cell_cons(a, cell_nil());
+    cell_release(cell_cdr(args));
+    Cell* r = call_builtin(inst_const(f, in), args);
+    cell_release(args);
+    return r;
+}
+
+static Cell* builtin_slow2(JITFrame* f, const JITInst* in, Cell* a, Cell* b) {
+    Cell* tail = cell_cons(b, cell_nil());
+    cell_release(cell_cdr(tail));
+    Cell* args = cell_cons(a, tail);
+    cell_release(tail);
+    Cell* r = call_builtin(inst_const(f, in), args);
+    cell_release(args);
+    return r;
+}
+
+static Cell* jit_apply(EvalContext* ctx, Cell* fn, Cell* args);
+
+/* Builtin ops trust the frame's guards until a builtin's name is redefined
+ * (the body may do that itself); after that each one looks its name up
+ * again. Returns what the name means now, or NULL if still the builtin. */
+static Cell* op_rebound(JITFrame* f, const JITInst* in) {
+    if (LIKELY(f->epoch == eval_global_epoch())) return NULL;
+    Cell* name = f->trace->constants[in->imm.const_index + 1];
+    Cell* v = eval_lookup(f->ctx, cell_get_symbol(name));
+    if (!v || v == inst_const(f, in)) {
+        if (v) cell_release(v);
+        return NULL;
+    }
+    return v;
+}
+
+/* Apply a rebound name to the op's operands */
+static intptr_t op_call_rebound(JITFrame* f, const JITInst* in, Cell* fn) {
+    Cell* args = slot_take_list(f, in->src1, in->aux);
+    slot_put(f, in->dst, jit_apply(f->ctx, fn, args));
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_const_cell(JITFrame* f, const JITInst* in) {
+    Cell* v = inst_const(f, in);
+    cell_retain(v);
+    slot_put(f, in->dst, v);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_const_nil(JITFrame* f, const JITInst* in) {
+    slot_put(f, in->dst, cell_nil());
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_env_load(JITFrame* f, const JITInst* in) {
+    Cell* lit = inst_const(f, in);
+    Cell* v = env_lookup_index(f->env, (int)cell_get_number(lit));
+    if (!v) {
+        cell_retain(lit);
+        v = lit;
+    }
+    slot_put(f, in->dst, v);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_global_load(JITFrame* f, const JITInst* in) {
+    Cell* sym = inst_const(f, in);
+    const char* name = cell_get_symbol(sym);
+    Cell* v = eval_lookup(f->ctx, name);
+    if (!v) {
+        Cell* var_name = cell_symbol(name);
+        v = cell_error_at("undefined-variable", var_name, sym->span);
+        cell_release(var_name);
+    }
+    slot_put(f, in->dst, v);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_car(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* p = slot_take(f, in->src1);
+    Cell* r;
+    if (LIKELY(cell_is_pair(p))) {
+        r = in->op == JOP_CAR ? cell_car(p) : cell_cdr(p);
+        cell_retain(r);
+    } else {
+        r = builtin_slow1(f, in, p);
+    }
+    cell_release(p);
+    slot_put(f, in->dst, r);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_cons(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* a = slot_take(f, in->src1);
+    Cell* b = slot_take(f, in->src2);
+    Cell* r = cell_cons(a, b);
+    cell_release(a);
+    cell_release(b);
+    slot_put(f, in->dst, r);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_box_new(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* v = slot_take(f, in->src1);
+    Cell* r = cell_box(v);
+    cell_release(v);
+    slot_put(f, in->dst, r);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_box_read(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* b = slot_take(f, in->src1);
+    Cell* r;
+    if (LIKELY(cell_is_box(b))) {
+        r = cell_box_get(b);
+        cell_retain(r);
+    } else {
+        r = builtin_slow1(f, in, b);
+    }
+    cell_release(b);
+    slot_put(f, in->dst, r);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_box_write(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* b = slot_take(f, in->src1);
+    Cell* v = slot_take(f, in->src2);
+    Cell* r = LIKELY(cell_is_box(b)) ? cell_box_set(b, v) : builtin_slow2(f, in, b, v);
+    cell_release(b);
+    cell_release(v);
+    slot_put(f, in->dst, r);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_arith(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* a = slot_take(f, in->src1);
+    Cell* b = slot_take(f, in->src2);
+    Cell* r = NULL;
+
+    if (cell_is_integer(a) && cell_is_integer(b)) {
+        int64_t x = a->data.atom.integer, y = b->data.atom.integer, z;
+        switch ((JITArithOp)in->flags) {
+            case JIT_ARITH_ADD: if (!__builtin_add_overflow(x, y, &z)) r = cell_integer(z); break;
+            case JIT_ARITH_SUB: if (!__builtin_sub_overflow(x, y, &z)) r = cell_integer(z); break;
+            case JIT_ARITH_MUL: if (!__builtin_mul_overflow(x, y, &z)) r = cell_integer(z); break;
+            case JIT_ARITH_LT:  r = cell_bool(x < y); break;
+            case JIT_ARITH_GT:  r = cell_bool(x > y); break;
+            case JIT_ARITH_LE:  r = cell_bool(x <= y); break;
+            case JIT_ARITH_GE:  r = cell_bool(x >= y); break;
+            default: break;
         }
+    } else if (cell_is_numeric(a) && cell_is_numeric(b)) {
+        double x = cell_to_double(a), y = cell_to_double(b);
+        switch ((JITArithOp)in->flags) {
+            case JIT_ARITH_ADD: r = cell_number(x + y); break;
+            case JIT_ARITH_SUB: r = cell_number(x - y); break;
+            case JIT_ARITH_MUL: r = cell_number(x * y); break;
+            case JIT_ARITH_DIV: if (y != 0.0) r = cell_number(x / y); break;
+            case JIT_ARITH_LT:  r = cell_bool(x < y); break;
+            case JIT_ARITH_GT:  r = cell_bool(x > y); break;
+            case JIT_ARITH_LE:  r = cell_bool(x <= y); break;
+            case JIT_ARITH_GE:  r = cell_bool(x >= y); break;
+        }
+    }
+    if (!r) r = builtin_slow2(f, in, a, b);
 
-        /* Generic call - fall back to interpreter for now */
-        uint32_t idx = trace_add_constant(trace, expr);
-        uint8_t dst = alloc_preg(ra);
-        JITInst* inst = &trace->insts[trace->n_insts++];
-        inst->op = JOP_CALL_INTERP;
-        inst->dst = dst;
-        inst->imm.const_index = idx;
-        return dst;
+    cell_release(a);
+    cell_release(b);
+    slot_put(f, in->dst, r);
+    return JIT_NEXT;
+}
+
+/* Operands passed JOP_GUARD_INT; only overflow goes the slow way */
+static intptr_t jit_op_arith_ii(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* a = slot_take(f, in->src1);
+    Cell* b = slot_take(f, in->src2);
+    int64_t x = a->data.atom.integer, y = b->data.atom.integer, z;
+    Cell* r = NULL;
+    switch ((JITArithOp)in->flags) {
+        case JIT_ARITH_ADD: if (!__builtin_add_overflow(x, y, &z)) r = cell_integer(z); break;
+        case JIT_ARITH_SUB: if (!__builtin_sub_overflow(x, y, &z)) r = cell_integer(z); break;
+        case JIT_ARITH_MUL: if (!__builtin_mul_overflow(x, y, &z)) r = cell_integer(z); break;
+        case JIT_ARITH_LT:  r = cell_bool(x < y); break;
+        case JIT_ARITH_GT:  r = cell_bool(x > y); break;
+        case JIT_ARITH_LE:  r = cell_bool(x <= y); break;
+        case JIT_ARITH_GE:  r = cell_bool(x >= y); break;
+        default: break;
     }
+    if (!r) r = builtin_slow2(f, in, a, b);
 
-    /* Unknown - emit as constant */
-    uint32_t idx = trace_add_constant(trace, expr);
-    uint8_t dst = alloc_preg(ra);
-    JITInst* inst = &trace->insts[trace->n_insts++];
-    inst->op = JOP_CONST_CELL;
-    inst->dst = dst;
-    inst->imm.const_index = idx;
-    return dst;
+    cell_release(a);
+    cell_release(b);
+    slot_put(f, in->dst, r);
+    return JIT_NEXT;
+}
+
+/* Operands passed JOP_GUARD_NUM */
+static intptr_t jit_op_arith_dd(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* a = slot_take(f, in->src1);
+    Cell* b = slot_take(f, in->src2);
+    double x = a->data.atom.number, y = b->data.atom.number;
+    Cell* r = NULL;
+    switch ((JITArithOp)in->flags) {
+        case JIT_ARITH_ADD: r = cell_number(x + y); break;
+        case JIT_ARITH_SUB: r = cell_number(x - y); break;
+        case JIT_ARITH_MUL: r = cell_number(x * y); break;
+        case JIT_ARITH_DIV: if (y != 0.0) r = cell_number(x / y); break;
+        case JIT_ARITH_LT:  r = cell_bool(x < y); break;
+        case JIT_ARITH_GT:  r = cell_bool(x > y); break;
+        case JIT_ARITH_LE:  r = cell_bool(x <= y); break;
+        case JIT_ARITH_GE:  r = cell_bool(x >= y); break;
+    }
+    if (!r) r = builtin_slow2(f, in, a, b);
+
+    cell_release(a);
+    cell_release(b);
+    slot_put(f, in->dst, r);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_call_builtin(JITFrame* f, const JITInst* in) {
+    Cell* rebound = op_rebound(f, in);
+    if (UNLIKELY(rebound)) return op_call_rebound(f, in, rebound);
+
+    Cell* args = slot_take_list(f, in->src1, in->aux);
+    Cell* r = call_builtin(inst_const(f, in), args);
+    cell_release(args);
+    slot_put(f, in->dst, r ? r : cell_nil());
+    return JIT_NEXT;
+}
+
+static bool jit_guards_hold(JITTrace* trace, EvalContext* ctx);
+
+static intptr_t jit_op_call(JITFrame* f, const JITInst* in) {
+    Cell* fn = slot_take(f, in->src1);
+    Cell* args = slot_take_list(f, (uint8_t)(in->src1 + 1), in->aux);
+
+    if (!(in->flags & JIT_F_TAIL)) {
+        slot_put(f, in->dst, jit_apply(f->ctx, fn, args));
+        return JIT_NEXT;
+    }
+
+    /* Self tail call: rebind the frame and jump back to the entry. This
+     * back-edge is where the loop pays for its reductions and re-checks
+     * its guards. A failed guard, or a spent budget in the fiber's root
+     * frame (the only one that can yield), resumes the interpreter at the
+     * top of the body with the new frame. */
+    JITTrace* trace = f->trace;
+    Cell* self = trace->lambda;
+    if (fn == self && !self->data.lambda.constraints &&
+        (int)in->aux == self->data.lambda.arity) {
+        Cell* env = extend_env(self->data.lambda.env, args);
+        cell_release(args);
+        cell_release(fn);
+        cell_release(f->env);
+        f->env = env;
+        if (f->budget > 0) f->budget -= (int32_t)trace->n_insts;
+        bool yield = f->budget <= 0 && f->ctx->eval_depth <= 1;
+        uint64_t epoch = eval_global_epoch();
+        if (!yield && (epoch == f->epoch || jit_guards_hold(trace, f->ctx))) {
+            f->epoch = epoch;
+            return JIT_LOOP;
+        }
+        f->env = NULL;
+        jit_deopt(trace, env, (uint32_t)(in - trace->insts), f->exit);
+        return JIT_DONE;
+    }
+
+    f->exit->kind = JIT_EXIT_APPLY;
+    f->exit->fn = fn;
+    f->exit->args = args;
+    return JIT_DONE;
+}
+
+static intptr_t jit_op_call_interp(JITFrame* f, const JITInst* in) {
+    Cell* expr = inst_const(f, in);
+    if (in->flags & JIT_F_TAIL) {
+        cell_retain(expr);
+        cell_retain(f->env);
+        f->exit->kind = JIT_EXIT_EVAL;
+        f->exit->expr = expr;
+        f->exit->env = f->env;
+        return JIT_DONE;
+    }
+    slot_put(f, in->dst, eval_internal(f->ctx, f->env, expr));
+    return JIT_NEXT;
+}
+
+/* (if c ...): anything but #t takes the else branch */
+static intptr_t jit_op_jump_unless(JITFrame* f, const JITInst* in) {
+    Cell* v = slot_take(f, in->src1);
+    bool truthy = cell_is_bool(v) && cell_get_bool(v);
+    cell_release(v);
+    return truthy ? JIT_NEXT : JIT_TAKEN;
+}
+
+/* and / or / begin: the deciding value stays in the slot as the result */
+static intptr_t jit_op_jump_if(JITFrame* f, const JITInst* in) {
+    Cell* v = f->slots[in->src1];
+    bool taken = cell_is_error(v);
+    if (!taken && cell_is_bool(v)) {
+        if (in->flags == JIT_BR_AND) taken = !cell_get_bool(v);
+        if (in->flags == JIT_BR_OR)  taken = cell_get_bool(v);
+    }
+    if (taken) {
+        if (cell_is_error(v)) error_stamp_return(v, in->aux);
+        return JIT_TAKEN;
+    }
+    slot_put(f, in->src1, NULL);
+    return JIT_NEXT;
+}
+
+static intptr_t jit_op_ret(JITFrame* f, const JITInst* in) {
+    Cell* v = slot_take(f, in->src1);
+    f->exit->kind = JIT_EXIT_VALUE;
+    f->exit->value = v ? v : cell_nil();
+    return JIT_DONE;
+}
+
+static void* baseline_op(JITOpcode op) {
+    switch (op) {
+        case JOP_CONST_CELL:   return (void*)jit_op_const_cell;
+        case JOP_CONST_NIL:    return (void*)jit_op_const_nil;
+        case JOP_ENV_LOAD:     return (void*)jit_op_env_load;
+        case JOP_GLOBAL_LOAD:  return (void*)jit_op_global_load;
+        case JOP_CAR:
+        case JOP_CDR:          return (void*)jit_op_car;
+        case JOP_CONS:         return (void*)jit_op_cons;
+        case JOP_BOX_NEW:      return (void*)jit_op_box_new;
+        case JOP_BOX_READ:     return (void*)jit_op_box_read;
+        case JOP_BOX_WRITE:    return (void*)jit_op_box_write;
+        case JOP_ARITH:        return (void*)jit_op_arith;
+        case JOP_ADD_II: case JOP_SUB_II: case JOP_MUL_II:
+        case JOP_LT_II: case JOP_GT_II: case JOP_LE_II:
+        case JOP_GE_II:        return (void*)jit_op_arith_ii;
+        case JOP_ADD_DD: case JOP_SUB_DD: case JOP_MUL_DD: case JOP_DIV_DD:
+        case JOP_LT_DD: case JOP_GT_DD: case JOP_LE_DD:
+        case JOP_GE_DD:        return (void*)jit_op_arith_dd;
+        case JOP_CALL_BUILTIN: return (void*)jit_op_call_builtin;
+        case JOP_CALL:         return (void*)jit_op_call;
+        case JOP_CALL_INTERP:  return (void*)jit_op_call_interp;
+        case JOP_JUMP_UNLESS:  return (void*)jit_op_jump_unless;
+        case JOP_JUMP_IF:      return (void*)jit_op_jump_if;
+        case JOP_RET:          return (void*)jit_op_ret;
+        default:               return NULL;
+    }
+}
+
+/* Non-tail call from compiled code. Hot callees run their own trace;
+ * anything else goes through eval_internal. Consumes fn and args. */
+static Cell* jit_apply(EvalContext* ctx, Cell* fn, Cell* args) {
+    for (;;) {
+        if (fn->type == CELL_BUILTIN) {
+            Cell* r = call_builtin(fn, args);
+            cell_release(fn);
+            cell_release(args);
+            return r;
+        }
+
+        if (fn->type != CELL_LAMBDA) {
+            Cell* r = cell_error("not-a-function", fn);
+            cell_release(fn);
+            cell_release(args);
+            return r;
+        }
+
+        if (fn->data.lambda.constraints ||
+            list_length(args) != fn->data.lambda.arity) {
+            /* Rare paths (arity errors, trait constraints): let the
+             * evaluator apply the already-evaluated values */
+            Cell* quote = cell_symbol("quote");
+            Cell* call = cell_nil();
+            Cell* rev = cell_nil();
+            for (Cell* a = args; cell_is_pair(a); a = cell_cdr(a)) {
+                Cell* q = cell_cons(quote, cell_cons(cell_car(a), cell_nil()));
+                Cell* next = cell_cons(q, rev);
+                cell_release(q);
+                cell_release(rev);
+                rev = next;
+            }
+            for (Cell* a = rev; cell_is_pair(a); a = cell_cdr(a)) {
+                Cell* next = cell_cons(cell_car(a), call);
+                cell_release(call);
+                call = next;
+            }
+            cell_release(rev);
+            Cell* qfn = cell_cons(quote, cell_cons(fn, cell_nil()));
+            Cell* full = cell_cons(qfn, call);
+            cell_release(qfn);
+            cell_release(call);
+            cell_release(quote);
+            Cell* r = eval_internal(ctx, ctx->env, full);
+            cell_release(full);
+            cell_release(fn);
+            cell_release(args);
+            return r;
+        }
+
+        Cell* env = extend_env(fn->data.lambda.env, args);
+        jit_record_call(ctx, fn);
+        JITTrace* trace = jit_get_trace(fn);
+        Cell* r = NULL;
+        JITExit exit = {0};
+        if (trace && trace->native_code) {
+            r = jit_execute(trace, ctx, env, &exit);
+        } else {
+            exit.kind = JIT_EXIT_DEOPT;
+        }
+        if (!r && exit.kind == JIT_EXIT_DEOPT) {
+            r = eval_internal(ctx, env, fn->data.lambda.body);
+        }
+        cell_release(env);
+        cell_release(fn);
+        cell_release(args);
+        if (r) return r;
+
+        if (exit.kind == JIT_EXIT_EVAL) {
+            r = eval_internal(ctx, exit.env, exit.expr);
+            cell_release(exit.env);
+            cell_release(exit.expr);
+            return r;
+        }
+        /* JIT_EXIT_APPLY: keep going without growing the C stack */
+        fn = exit.fn;
+        args = exit.args;
+    }
 }
 
 /* ============================================================================
@@ -612,69 +1414,303 @@ static void jit_write_end(void* code, size_t size) {
 }
 #endif
 
+/* Copy finished code into the executable arena */
+static void* code_install(EmitCtx* ctx) {
+    void* code = arena_alloc(ctx->pos);
+    while (!code && cache_evict_cold()) {
+        cache_reclaim(false);
+        code = arena_alloc(ctx->pos);
+    }
+    jit_write_begin();
+    if (code) memcpy(code, ctx->buf, ctx->pos);
+    jit_write_end(code, code ? ctx->pos : 0);
+    return code;
+}
+
 /* ============================================================================
- * Stack-based Code Generation
+ * Baseline Code Generation (call-threaded stencils)
  *
- * For simplicity and correctness, we use a stack-based approach:
- *   - Operands are pushed onto a virtual stack (D0-D7 on ARM64, XMM0-XMM7 on x86)
- *   - Operations pop operands and push results
- *   - At the end, D0/XMM0 contains the result
+ * Per instruction:  frame -> arg0, &inst -> arg1, call op
+ * Branch ops:       + jump to the target instruction if the op returned 1
+ * Terminal ops:     + jump to the entry (self tail call) or the epilogue
+ * Type guards:      inline type test, jump to the target on a mismatch
  *
- * This trades some performance for simplicity but still avoids boxing in hot loops.
+ * The frame pointer lives in a callee-saved register (RBX / X19).
  * ============================================================================ */
 
-/* Evaluate JIT IR and generate native code
- * Returns true if code generation succeeded, false to fall back to interpreter.
+typedef struct {
+    size_t   pos;       /* Patch site */
+    uint32_t target;    /* Instruction index (n_insts = epilogue) */
+} BLFixup;
+
+static bool baseline_codegen(JITTrace* trace) {
+    uint32_t n = trace->n_insts;
+    if (n == 0) return false;
+
+    EmitCtx ctx;
+    ctx.cap = (size_t)n * 64 + 64;
+    ctx.pos = 0;
+    ctx.buf = malloc(ctx.cap);
+    size_t* at = malloc((n + 1) * sizeof(size_t));
+    BLFixup* fix = malloc((size_t)n * 2 * sizeof(BLFixup));
+    uint32_t n_fix = 0;
+    if (!ctx.buf || !at || !fix) {
+        free(ctx.buf); free(at); free(fix);
+        return false;
+    }
+
+#if defined(__x86_64__) || defined(_M_X64)
+    emit_u8(&ctx, 0x55);                                           /* push rbp */
+    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x89); emit_u8(&ctx, 0xE5); /* mov rbp, rsp */
+    emit_u8(&ctx, 0x53);                                           /* push rbx */
+    emit_u8(&ctx, 0x41); emit_u8(&ctx, 0x54);                      /* push r12 (alignment) */
+    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x89); emit_u8(&ctx, 0xFB); /* mov rbx, rdi */
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    emit_u32(&ctx, 0xA9BE7BFD);  /* STP X29, X30, [SP, #-32]! */
+    emit_u32(&ctx, 0x910003FD);  /* MOV X29, SP */
+    emit_u32(&ctx, 0xF9000BF3);  /* STR X19, [SP, #16] */
+    emit_u32(&ctx, 0xAA0003F3);  /* MOV X19, X0 (frame) */
+#endif
+    size_t entry = ctx.pos;
+
+    for (uint32_t i = 0; i < n; i++) {
+        JITInst* inst = &trace->insts[i];
+        at[i] = ctx.pos;
+
+        if (inst->op == JOP_JUMP) {
+#if defined(__x86_64__) || defined(_M_X64)
+            emit_u8(&ctx, 0xE9);                               /* jmp rel32 */
+            fix[n_fix++] = (BLFixup){ctx.pos, inst->imm.jump_offset};
+            emit_u32(&ctx, 0);
+#elif defined(__aarch64__) || defined(_M_ARM64)
+            fix[n_fix++] = (BLFixup){ctx.pos, inst->imm.jump_offset};
+            emit_u32(&ctx, 0x14000000);                        /* B target */
+#endif
+            continue;
+        }
+
+        if (inst->op == JOP_GUARD_INT || inst->op == JOP_GUARD_NUM) {
+            /* Inline: jump to the target unless slot src1 holds a cell
+             * of the guarded type */
+            uint32_t type = inst->op == JOP_GUARD_INT ? CELL_ATOM_INTEGER : CELL_ATOM_NUMBER;
+            uint32_t slots_off = (uint32_t)offsetof(JITFrame, slots);
+            uint32_t slot_off = (uint32_t)inst->src1 * sizeof(Cell*);
+#if defined(__x86_64__) || defined(_M_X64)
+            emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x8B); emit_u8(&ctx, 0x83);  /* mov rax, [rbx + slots] */
+            emit_u32(&ctx, slots_off);
+            emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x8B); emit_u8(&ctx, 0x80);  /* mov rax, [rax + slot] */
+            emit_u32(&ctx, slot_off);
+            emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x85); emit_u8(&ctx, 0xC0);  /* test rax, rax */
+            emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x84);                       /* jz target */
+            fix[n_fix++] = (BLFixup){ctx.pos, inst->imm.jump_offset};
+            emit_u32(&ctx, 0);
+            emit_u8(&ctx, 0x81); emit_u8(&ctx, 0xB8);                       /* cmp dword [rax + type], imm32 */
+            emit_u32(&ctx, (uint32_t)CELL_TYPE_OFFSET);
+            emit_u32(&ctx, type);
+            emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x85);                       /* jne target */
+            fix[n_fix++] = (BLFixup){ctx.pos, inst->imm.jump_offset};
+            emit_u32(&ctx, 0);
+#elif defined(__aarch64__) || defined(_M_ARM64)
+            emit_u32(&ctx, 0xF9400269 | ((slots_off / 8) << 10));           /* LDR X9, [X19, #slots] */
+            emit_u32(&ctx, 0xF9400129 | ((slot_off / 8) << 10));            /* LDR X9, [X9, #slot] */
+            fix[n_fix++] = (BLFixup){ctx.pos, inst->imm.jump_offset};
+            emit_u32(&ctx, 0xB4000009);                                     /* CBZ X9, target */
+            emit_u32(&ctx, 0xB940012A | (((uint32_t)CELL_TYPE_OFFSET / 4) << 10)); /* LDR W10, [X9, #type] */
+            emit_u32(&ctx, 0x7100015F | (type << 10));                      /* CMP W10, #type */
+            fix[n_fix++] = (BLFixup){ctx.pos, inst->imm.jump_offset};
+            emit_u32(&ctx, 0x54000001);                                     /* B.NE target */
+#endif
+            continue;
+        }
+
+        void* op = baseline_op(inst->op);
+        if (!op) {
+            free(ctx.buf); free(at); free(fix);
+            return false;
+        }
+
+#if defined(__x86_64__) || defined(_M_X64)
+        emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x89); emit_u8(&ctx, 0xDF);  /* mov rdi, rbx */
+        emit_u8(&ctx, 0x48); emit_u8(&ctx, 0xBE);                       /* mov rsi, imm64 */
+        emit_u64(&ctx, (uint64_t)(uintptr_t)inst);
+        emit_u8(&ctx, 0x48); emit_u8(&ctx, 0xB8);                       /* mov rax, imm64 */
+        emit_u64(&ctx, (uint64_t)(uintptr_t)op);
+        emit_u8(&ctx, 0xFF); emit_u8(&ctx, 0xD0);                       /* call rax */
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        uint64_t ip = (uint64_t)(uintptr_t)inst;
+        uint64_t fp = (uint64_t)(uintptr_t)op;
+        emit_u32(&ctx, 0xAA1303E0);                                     /* MOV X0, X19 */
+        emit_u32(&ctx, 0xD2800001 | ((ip & 0xFFFF) << 5));              /* MOVZ X1, ... */
+        emit_u32(&ctx, 0xF2A00001 | (((ip >> 16) & 0xFFFF) << 5));
+        emit_u32(&ctx, 0xF2C00001 | (((ip >> 32) & 0xFFFF) << 5));
+        emit_u32(&ctx, 0xF2E00001 | (((ip >> 48) & 0xFFFF) << 5));
+        emit_u32(&ctx, 0xD2800009 | ((fp & 0xFFFF) << 5));              /* MOVZ X9, ... */
+        emit_u32(&ctx, 0xF2A00009 | (((fp >> 16) & 0xFFFF) << 5));
+        emit_u32(&ctx, 0xF2C00009 | (((fp >> 32) & 0xFFFF) << 5));
+        emit_u32(&ctx, 0xF2E00009 | (((fp >> 48) & 0xFFFF) << 5));
+        emit_u32(&ctx, 0xD63F0120);                                     /* BLR X9 */
+#endif
+
+        bool branch = inst->op == JOP_JUMP_IF || inst->op == JOP_JUMP_UNLESS;
+        bool loops = inst->op == JOP_CALL && (inst->flags & JIT_F_TAIL);
+        bool terminal = inst->op == JOP_RET || loops ||
+                        (inst->op == JOP_CALL_INTERP && (inst->flags & JIT_F_TAIL));
+
+#if defined(__x86_64__) || defined(_M_X64)
+        if (branch || loops) {
+            emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x85); emit_u8(&ctx, 0xC0);  /* test rax, rax */
+            emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x85);                       /* jnz rel32 */
+            if (branch) {
+                fix[n_fix++] = (BLFixup){ctx.pos, inst->imm.jump_offset};
+                emit_u32(&ctx, 0);
+            } else {
+                emit_u32(&ctx, (uint32_t)(int32_t)(entry - (ctx.pos + 4)));
+            }
+        }
+        if (terminal) {
+            emit_u8(&ctx, 0xE9);                                            /* jmp epilogue */
+            fix[n_fix++] = (BLFixup){ctx.pos, n};
+            emit_u32(&ctx, 0);
+        }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        if (branch) {
+            fix[n_fix++] = (BLFixup){ctx.pos, inst->imm.jump_offset};
+            emit_u32(&ctx, 0xB5000000);                                     /* CBNZ X0, target */
+        } else if (loops) {
+            int32_t back = (int32_t)((int64_t)entry - (int64_t)ctx.pos) / 4;
+            emit_u32(&ctx, 0xB5000000 | (((uint32_t)back & 0x7FFFF) << 5)); /* CBNZ X0, entry */
+        }
+        if (terminal) {
+            fix[n_fix++] = (BLFixup){ctx.pos, n};
+            emit_u32(&ctx, 0x14000000);                                     /* B epilogue */
+        }
+#endif
+    }
+
+    at[n] = ctx.pos;
+#if defined(__x86_64__) || defined(_M_X64)
+    emit_u8(&ctx, 0x41); emit_u8(&ctx, 0x5C);  /* pop r12 */
+    emit_u8(&ctx, 0x5B);                       /* pop rbx */
+    emit_u8(&ctx, 0x5D);                       /* pop rbp */
+    emit_u8(&ctx, 0xC3);                       /* ret */
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    emit_u32(&ctx, 0xF9400BF3);  /* LDR X19, [SP, #16] */
+    emit_u32(&ctx, 0xA8C27BFD);  /* LDP X29, X30, [SP], #32 */
+    emit_u32(&ctx, 0xD65F03C0);  /* RET */
+#endif
+
+    /* Resolve forward and backward jumps */
+    for (uint32_t i = 0; i < n_fix; i++) {
+        size_t target = at[fix[i].target];
+#if defined(__x86_64__) || defined(_M_X64)
+        int32_t rel = (int32_t)((int64_t)target - (int64_t)(fix[i].pos + 4));
+        memcpy(&ctx.buf[fix[i].pos], &rel, 4);
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        int32_t rel = (int32_t)(((int64_t)target - (int64_t)fix[i].pos) / 4);
+        uint32_t insn;
+        memcpy(&insn, &ctx.buf[fix[i].pos], 4);
+        uint32_t kind = insn & 0xFF000000;
+        if (kind == 0xB5000000 || kind == 0xB4000000 || kind == 0x54000000) {
+            insn |= ((uint32_t)rel & 0x7FFFF) << 5;
+        } else {
+            insn |= (uint32_t)rel & 0x3FFFFFF;
+        }
+        memcpy(&ctx.buf[fix[i].pos], &insn, 4);
+#endif
+    }
+    free(at);
+    free(fix);
+
+    bool fits = ctx.pos < ctx.cap;
+    void* code = fits ? code_install(&ctx) : NULL;
+    free(ctx.buf);
+    if (!code) return false;
+
+    trace->native_code = code;
+    trace->code_size = ctx.pos;
+    g_jit_compiler.total_compiles++;
+    return true;
+}
+
+/* ============================================================================
+ * Numeric Fast Path
  *
- * For now, we support only "constant folding" JIT:
- * - If expression reduces to a constant, we can return it directly
- * - Otherwise fall back to interpreter
- */
-static bool trace_codegen(JITTrace* trace) {
-    /* For Phase 2, let's start simple: only compile pure constant expressions */
-    if (trace->n_insts == 0) return false;
+ * Bodies that are straight-line +, -, * over number parameters and number
+ * literals also get an unboxed version: operands are pushed onto the FP
+ * register stack (D0-D7 / XMM0-XMM7) and only the result is boxed. It runs
+ * when every parameter it reads is a double held inline in the env vector;
+ * otherwise the boxed baseline code runs.
+ * ============================================================================ */
 
-    /* Scan for unsupported operations */
+/* Lower baseline IR to unboxed double IR, or return 0 if not eligible */
+static uint32_t numeric_lower(JITTrace* trace, JITInst* out, uint8_t* loads) {
+    uint32_t n = 0;
+    bool has_arith = false;
+    *loads = 0;
     for (uint32_t i = 0; i < trace->n_insts; i++) {
-        JITInst* inst = &trace->insts[i];
-        switch (inst->op) {
-            case JOP_CONST_NUM:
-            case JOP_CONST_INT:
-            case JOP_CONST_BOOL:
+        JITInst* in = &trace->insts[i];
+        JITInst* o = &out[n++];
+        memset(o, 0, sizeof(*o));
+        switch (in->op) {
+            case JOP_CONST_CELL: {
+                Cell* c = trace->constants[in->imm.const_index];
+                if (!c || c->type != CELL_ATOM_NUMBER) return 0;
+                o->op = JOP_CONST_NUM;
+                o->imm.num_const = cell_get_number(c);
+                break;
+            }
+            case JOP_ENV_LOAD: {
+                int idx = (int)cell_get_number(trace->constants[in->imm.const_index]);
+                if (idx > 3) return 0;
+                o->op = JOP_ENV_LOAD;
+                o->imm.env.index = (uint8_t)idx;
+                *loads |= (uint8_t)(1u << idx);
+                break;
+            }
+            case JOP_GUARD_NUM:
+                n--;  /* Unboxed operands are numbers already */
+                break;
+            case JOP_JUMP:
+                /* Only as the skip over a guarded op's generic fallback */
+                if (i + 1 >= trace->n_insts || trace->insts[i + 1].op != JOP_ARITH ||
+                    in->imm.jump_offset != i + 2) return 0;
+                n--;
+                i++;
+                break;
             case JOP_ADD_DD:
             case JOP_SUB_DD:
             case JOP_MUL_DD:
-            case JOP_DIV_DD:
-            case JOP_LT_DD:      /* Comparisons */
-            case JOP_LE_DD:
-            case JOP_GT_DD:
-            case JOP_GE_DD:
-            case JOP_EQ_DD:
-            case JOP_JUMP_IF:    /* Conditionals */
-            case JOP_JUMP_UNLESS:
-            case JOP_JUMP:
-            case JOP_ENV_LOAD:   /* Parameter access */
+                o->op = in->op;
+                has_arith = true;
+                break;
+            case JOP_ARITH:
+                if (in->flags == JIT_ARITH_ADD)      o->op = JOP_ADD_DD;
+                else if (in->flags == JIT_ARITH_SUB) o->op = JOP_SUB_DD;
+                else if (in->flags == JIT_ARITH_MUL) o->op = JOP_MUL_DD;
+                else return 0;
+                has_arith = true;
+                break;
             case JOP_RET:
-                /* Supported */
+                o->op = JOP_RET;
                 break;
             default:
-                /* Unsupported - fall back to interpreter */
-                return false;
+                return 0;
         }
     }
+    return has_arith ? n : 0;
+}
 
+static void* numeric_codegen(const JITInst* insts, uint32_t n_insts, size_t* size_out) {
     EmitCtx ctx;
-    ctx.cap = 4096;
+    ctx.cap = (size_t)n_insts * 32 + 128;
     ctx.pos = 0;
     ctx.buf = malloc(ctx.cap);
-    if (!ctx.buf) return false;
+    if (!ctx.buf) return NULL;
 
-    /* Virtual register stack: tracks which FP reg holds each IR reg's value */
-    int stack_depth = 0;  /* How many values on the FP stack (max 8) */
+    /* Virtual register stack: how many values are on the FP stack (max 8) */
+    int stack_depth = 0;
 
 #if defined(__aarch64__) || defined(_M_ARM64)
-    /* ARM64 codegen */
-
     /* Prologue - save callee-saved registers and frame pointer */
     emit_u32(&ctx, 0xA9BE7BFD);  /* STP X29, X30, [SP, #-32]! (save FP/LR, alloc 32 bytes) */
     emit_u32(&ctx, 0x910003FD);  /* MOV X29, SP */
@@ -682,11 +1718,12 @@ static bool trace_codegen(JITTrace* trace) {
     /* Save X0 (env pointer) to callee-saved X19 */
     emit_u32(&ctx, 0xAA0003F3);  /* MOV X19, X0 (save env in X19) */
 
-    for (uint32_t i = 0; i < trace->n_insts; i++) {
-        JITInst* inst = &trace->insts[i];
+    for (uint32_t i = 0; i < n_insts; i++) {
+        const JITInst* inst = &insts[i];
 
         switch (inst->op) {
             case JOP_CONST_NUM: {
+                if (stack_depth >= 8) { free(ctx.buf); return NULL; }
                 /* Load 64-bit double constant into D[stack_depth] */
                 int dreg = stack_depth++;
                 uint64_t bits;
@@ -703,7 +1740,7 @@ static bool trace_codegen(JITTrace* trace) {
             }
             case JOP_ADD_DD: {
                 /* D[n-2] = D[n-2] + D[n-1] */
-                if (stack_depth < 2) { free(ctx.buf); return false; }
+                if (stack_depth < 2) { free(ctx.buf); return NULL; }
                 int dst = stack_depth - 2;
                 int src = stack_depth - 1;
                 /* FADD Ddst, Ddst, Dsrc */
@@ -712,7 +1749,7 @@ static bool trace_codegen(JITTrace* trace) {
                 break;
             }
             case JOP_SUB_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
+                if (stack_depth < 2) { free(ctx.buf); return NULL; }
                 int dst = stack_depth - 2;
                 int src = stack_depth - 1;
                 /* FSUB Ddst, Ddst, Dsrc */
@@ -721,7 +1758,7 @@ static bool trace_codegen(JITTrace* trace) {
                 break;
             }
             case JOP_MUL_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
+                if (stack_depth < 2) { free(ctx.buf); return NULL; }
                 int dst = stack_depth - 2;
                 int src = stack_depth - 1;
                 /* FMUL Ddst, Ddst, Dsrc */
@@ -729,152 +1766,37 @@ static bool trace_codegen(JITTrace* trace) {
                 stack_depth--;
                 break;
             }
-            case JOP_DIV_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int dst = stack_depth - 2;
-                int src = stack_depth - 1;
-                /* FDIV Ddst, Ddst, Dsrc */
-                emit_u32(&ctx, 0x1E601800 | dst | (dst << 5) | (src << 16));
-                stack_depth--;
-                break;
-            }
-            case JOP_LT_DD: {
-                /* Compare D[n-2] < D[n-1], result in W10 (0 or 1) */
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                /* FCMP Dop1, Dop2 */
-                emit_u32(&ctx, 0x1E602000 | (op1 << 5) | (op2 << 16));
-                /* CSET W10, LT (MI = negative = less than) */
-                emit_u32(&ctx, 0x1A9F47EA);
-                stack_depth -= 2;  /* Pop both operands, comparison result in W10 */
-                break;
-            }
-            case JOP_LE_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                emit_u32(&ctx, 0x1E602000 | (op1 << 5) | (op2 << 16)); /* FCMP */
-                /* CSET W10, LS (LS = unsigned lower or same, for floats = LE) */
-                emit_u32(&ctx, 0x1A9F87EA);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_GT_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                emit_u32(&ctx, 0x1E602000 | (op1 << 5) | (op2 << 16)); /* FCMP */
-                /* CSET W10, GT */
-                emit_u32(&ctx, 0x1A9FD7EA);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_GE_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                emit_u32(&ctx, 0x1E602000 | (op1 << 5) | (op2 << 16)); /* FCMP */
-                /* CSET W10, GE */
-                emit_u32(&ctx, 0x1A9FA7EA);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_EQ_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                emit_u32(&ctx, 0x1E602000 | (op1 << 5) | (op2 << 16)); /* FCMP */
-                /* CSET W10, EQ */
-                emit_u32(&ctx, 0x1A9F17EA);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_CONST_BOOL: {
-                /* Load bool constant into W10 */
-                int val = inst->imm.int_const ? 1 : 0;
-                emit_u32(&ctx, 0x5280000A | (val << 5));  /* MOV W10, #val */
-                break;
-            }
-            case JOP_JUMP_IF: {
-                /* Jump if W10 != 0 (comparison result is true) */
-                /* CBZ/CBNZ with immediate offset - will be patched later */
-                /* For now, emit CBNZ W10, +offset */
-                uint32_t offset = inst->imm.jump_offset;
-                /* CBNZ W10, offset (offset in instructions, shifted left 2) */
-                emit_u32(&ctx, 0x3500000A | ((offset & 0x7FFFF) << 5));
-                break;
-            }
-            case JOP_JUMP_UNLESS: {
-                /* Jump if W10 == 0 (comparison result is false) */
-                uint32_t offset = inst->imm.jump_offset;
-                /* CBZ W10, offset */
-                emit_u32(&ctx, 0x3400000A | ((offset & 0x7FFFF) << 5));
-                break;
-            }
-            case JOP_JUMP: {
-                /* Unconditional jump */
-                uint32_t offset = inst->imm.jump_offset;
-                /* B offset */
-                emit_u32(&ctx, 0x14000000 | (offset & 0x3FFFFFF));
-                break;
-            }
             case JOP_ENV_LOAD: {
                 /* INLINE parameter load from environment vector
                  * env is in X19 (callee-saved), index is in imm.env.index
                  *
-                 * For SBO (Small Buffer Optimization) case (capacity <= 4):
+                 * SBO (Small Buffer Optimization) case, checked on entry:
                  *   Cell* cell = env->data.vector.sbo[index]
                  *   double val = cell->data.atom.number
-                 *
-                 * This is ~4 instructions vs ~25 with helper call
                  */
+                if (stack_depth >= 8) { free(ctx.buf); return NULL; }
                 int dreg = stack_depth++;
                 int index = inst->imm.env.index;
 
-                /* Load Cell* from env->data.vector.sbo[index] into X9
-                 * SBO array is at g_vec_sbo_offset, each element is 8 bytes */
+                /* Load Cell* from env->data.vector.sbo[index] into X9 */
                 uint32_t sbo_elem_offset = (uint32_t)(g_vec_sbo_offset + index * 8);
+                /* LDR X9, [X19, #sbo_elem_offset] - load Cell* */
+                emit_u32(&ctx, 0xF9400269 | ((sbo_elem_offset / 8) << 10));
 
-                if (sbo_elem_offset < 4096) {
-                    /* LDR X9, [X19, #sbo_elem_offset] - load Cell* */
-                    emit_u32(&ctx, 0xF9400269 | ((sbo_elem_offset / 8) << 10));
-                } else {
-                    /* Offset too large, use ADD + LDR */
-                    emit_u32(&ctx, 0x91000269 | ((sbo_elem_offset & 0xFFF) << 10)); /* ADD X9, X19, #off_lo */
-                    emit_u32(&ctx, 0xF9400129); /* LDR X9, [X9] */
-                }
-
-                /* Load double from cell->data.atom.number into Ddreg
-                 * Number is at g_atom_number_offset */
+                /* LDR Ddreg, [X9, #num_offset] */
                 uint32_t num_offset = (uint32_t)g_atom_number_offset;
-                if (num_offset < 32768) {
-                    /* LDR Ddreg, [X9, #num_offset] */
-                    emit_u32(&ctx, 0xFD400120 | dreg | ((num_offset / 8) << 10));
-                } else {
-                    /* Offset too large - shouldn't happen for Cell struct */
-                    emit_u32(&ctx, 0x91000129 | ((num_offset & 0xFFF) << 10)); /* ADD X9, X9, #off */
-                    emit_u32(&ctx, 0xFD400120 | dreg); /* LDR Ddreg, [X9] */
-                }
+                emit_u32(&ctx, 0xFD400120 | dreg | ((num_offset / 8) << 10));
                 break;
             }
             case JOP_RET:
                 /* Result will be boxed after the loop */
                 break;
             default:
-                break;
-        }
-    }
-
-    /* Box result: call cell_number(D0) and return Cell* */
-    /* Move result to D0 if needed */
-    if (stack_depth > 1) {
-        int src = stack_depth - 1;
-        if (src != 0) {
-            /* FMOV D0, Dsrc */
-            emit_u32(&ctx, 0x1E604000 | (src << 5));
+                free(ctx.buf);
+                return NULL;
         }
     }
+    if (stack_depth != 1) { free(ctx.buf); return NULL; }
 
     /* Call cell_number(double) - D0 holds the double argument */
     /* Load address of cell_number into X9 */
@@ -892,20 +1814,20 @@ static bool trace_codegen(JITTrace* trace) {
     emit_u32(&ctx, 0xD65F03C0);  /* RET */
 
 #elif defined(__x86_64__) || defined(_M_X64)
-    /* x86-64 codegen */
-
     /* Prologue - save callee-saved RBX */
     emit_u8(&ctx, 0x55);                              /* push rbp */
     emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x89); emit_u8(&ctx, 0xE5);  /* mov rbp, rsp */
     emit_u8(&ctx, 0x53);                              /* push rbx (callee-saved) */
+    emit_u8(&ctx, 0x41); emit_u8(&ctx, 0x54);         /* push r12 (keeps the call aligned) */
     /* Save RDI (env pointer) to callee-saved RBX */
     emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x89); emit_u8(&ctx, 0xFB);  /* mov rbx, rdi */
 
-    for (uint32_t i = 0; i < trace->n_insts; i++) {
-        JITInst* inst = &trace->insts[i];
+    for (uint32_t i = 0; i < n_insts; i++) {
+        const JITInst* inst = &insts[i];
 
         switch (inst->op) {
             case JOP_CONST_NUM: {
+                if (stack_depth >= 8) { free(ctx.buf); return NULL; }
                 /* Load 64-bit double constant into XMM[stack_depth] */
                 int xreg = stack_depth++;
                 uint64_t bits;
@@ -921,7 +1843,7 @@ static bool trace_codegen(JITTrace* trace) {
                 break;
             }
             case JOP_ADD_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
+                if (stack_depth < 2) { free(ctx.buf); return NULL; }
                 int dst = stack_depth - 2;
                 int src = stack_depth - 1;
                 /* ADDSD XMMdst, XMMsrc */
@@ -931,7 +1853,7 @@ static bool trace_codegen(JITTrace* trace) {
                 break;
             }
             case JOP_SUB_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
+                if (stack_depth < 2) { free(ctx.buf); return NULL; }
                 int dst = stack_depth - 2;
                 int src = stack_depth - 1;
                 /* SUBSD XMMdst, XMMsrc */
@@ -941,7 +1863,7 @@ static bool trace_codegen(JITTrace* trace) {
                 break;
             }
             case JOP_MUL_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
+                if (stack_depth < 2) { free(ctx.buf); return NULL; }
                 int dst = stack_depth - 2;
                 int src = stack_depth - 1;
                 /* MULSD XMMdst, XMMsrc */
@@ -950,672 +1872,219 @@ static bool trace_codegen(JITTrace* trace) {
                 stack_depth--;
                 break;
             }
-            case JOP_DIV_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int dst = stack_depth - 2;
-                int src = stack_depth - 1;
-                /* DIVSD XMMdst, XMMsrc */
-                emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x5E);
-                emit_u8(&ctx, 0xC0 | (dst << 3) | src);
-                stack_depth--;
-                break;
-            }
-            case JOP_LT_DD: {
-                /* Compare XMM[n-2] < XMM[n-1], result in AL (0 or 1) */
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                /* COMISD XMMop1, XMMop2 */
-                emit_u8(&ctx, 0x66); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x2F);
-                emit_u8(&ctx, 0xC0 | (op1 << 3) | op2);
-                /* SETB AL (below = less than for unsigned, which COMISD uses) */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x92); emit_u8(&ctx, 0xC0);
-                /* MOVZX EAX, AL */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0xB6); emit_u8(&ctx, 0xC0);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_LE_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                emit_u8(&ctx, 0x66); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x2F);
-                emit_u8(&ctx, 0xC0 | (op1 << 3) | op2);
-                /* SETBE AL (below or equal) */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x96); emit_u8(&ctx, 0xC0);
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0xB6); emit_u8(&ctx, 0xC0);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_GT_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                emit_u8(&ctx, 0x66); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x2F);
-                emit_u8(&ctx, 0xC0 | (op1 << 3) | op2);
-                /* SETA AL (above = greater than) */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x97); emit_u8(&ctx, 0xC0);
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0xB6); emit_u8(&ctx, 0xC0);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_GE_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                emit_u8(&ctx, 0x66); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x2F);
-                emit_u8(&ctx, 0xC0 | (op1 << 3) | op2);
-                /* SETAE AL (above or equal) */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x93); emit_u8(&ctx, 0xC0);
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0xB6); emit_u8(&ctx, 0xC0);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_EQ_DD: {
-                if (stack_depth < 2) { free(ctx.buf); return false; }
-                int op1 = stack_depth - 2;
-                int op2 = stack_depth - 1;
-                emit_u8(&ctx, 0x66); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x2F);
-                emit_u8(&ctx, 0xC0 | (op1 << 3) | op2);
-                /* SETE AL (equal) */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x94); emit_u8(&ctx, 0xC0);
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0xB6); emit_u8(&ctx, 0xC0);
-                stack_depth -= 2;
-                break;
-            }
-            case JOP_CONST_BOOL: {
-                /* MOV EAX, val */
-                int val = inst->imm.int_const ? 1 : 0;
-                emit_u8(&ctx, 0xB8);
-                emit_u8(&ctx, val); emit_u8(&ctx, 0); emit_u8(&ctx, 0); emit_u8(&ctx, 0);
-                break;
-            }
-            case JOP_JUMP_IF: {
-                /* Jump if EAX != 0 */
-                /* TEST EAX, EAX; JNZ offset */
-                emit_u8(&ctx, 0x85); emit_u8(&ctx, 0xC0);  /* TEST EAX, EAX */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x85); /* JNZ rel32 */
-                uint32_t offset = inst->imm.jump_offset;
-                emit_u8(&ctx, offset & 0xFF);
-                emit_u8(&ctx, (offset >> 8) & 0xFF);
-                emit_u8(&ctx, (offset >> 16) & 0xFF);
-                emit_u8(&ctx, (offset >> 24) & 0xFF);
-                break;
-            }
-            case JOP_JUMP_UNLESS: {
-                /* Jump if EAX == 0 */
-                emit_u8(&ctx, 0x85); emit_u8(&ctx, 0xC0);  /* TEST EAX, EAX */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x84); /* JZ rel32 */
-                uint32_t offset = inst->imm.jump_offset;
-                emit_u8(&ctx, offset & 0xFF);
-                emit_u8(&ctx, (offset >> 8) & 0xFF);
-                emit_u8(&ctx, (offset >> 16) & 0xFF);
-                emit_u8(&ctx, (offset >> 24) & 0xFF);
-                break;
-            }
-            case JOP_JUMP: {
-                /* JMP rel32 */
-                emit_u8(&ctx, 0xE9);
-                uint32_t offset = inst->imm.jump_offset;
-                emit_u8(&ctx, offset & 0xFF);
-                emit_u8(&ctx, (offset >> 8) & 0xFF);
-                emit_u8(&ctx, (offset >> 16) & 0xFF);
-                emit_u8(&ctx, (offset >> 24) & 0xFF);
-                break;
-            }
             case JOP_ENV_LOAD: {
-                /* INLINE parameter load from environment vector
-                 * env is in RBX, index is in imm.env.index
-                 *
-                 * For SBO case:
+                /* INLINE parameter load from environment vector (SBO case,
+                 * checked on entry):
                  *   Cell* cell = env->data.vector.sbo[index]
                  *   double val = cell->data.atom.number
                  */
+                if (stack_depth >= 8) { free(ctx.buf); return NULL; }
                 int xreg = stack_depth++;
                 int index = inst->imm.env.index;
 
-                /* Load Cell* from env->data.vector.sbo[index] into RAX
-                 * MOV RAX, [RBX + sbo_offset + index*8] */
+                /* MOV RAX, [RBX + sbo_offset + index*8] */
                 uint32_t sbo_elem_offset = (uint32_t)(g_vec_sbo_offset + index * 8);
                 emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x8B); emit_u8(&ctx, 0x83);  /* MOV RAX, [RBX + disp32] */
-                emit_u8(&ctx, sbo_elem_offset & 0xFF);
-                emit_u8(&ctx, (sbo_elem_offset >> 8) & 0xFF);
-                emit_u8(&ctx, (sbo_elem_offset >> 16) & 0xFF);
-                emit_u8(&ctx, (sbo_elem_offset >> 24) & 0xFF);
+                emit_u32(&ctx, sbo_elem_offset);
 
-                /* Load double from cell->data.atom.number into XMMxreg
-                 * MOVSD XMMxreg, [RAX + num_offset] */
+                /* MOVSD XMMxreg, [RAX + num_offset] */
                 uint32_t num_offset = (uint32_t)g_atom_number_offset;
-                emit_u8(&ctx, 0xF2);
-                if (xreg >= 8) emit_u8(&ctx, 0x44);  /* REX.R for XMM8-15 */
-                emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x10);
-                emit_u8(&ctx, 0x80 | ((xreg & 7) << 3));  /* ModR/M: [RAX + disp32] */
-                emit_u8(&ctx, num_offset & 0xFF);
-                emit_u8(&ctx, (num_offset >> 8) & 0xFF);
-                emit_u8(&ctx, (num_offset >> 16) & 0xFF);
-                emit_u8(&ctx, (num_offset >> 24) & 0xFF);
+                emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x10);
+                emit_u8(&ctx, 0x80 | (xreg << 3));  /* ModR/M: [RAX + disp32] */
+                emit_u32(&ctx, num_offset);
                 break;
             }
             case JOP_RET:
                 break;
             default:
-                break;
-        }
-    }
-
-    /* Box result: call cell_number(XMM0) and return Cell* */
-    /* Move result to XMM0 if needed */
-    if (stack_depth > 1) {
-        int src = stack_depth - 1;
-        if (src != 0) {
-            /* MOVSD XMM0, XMMsrc */
-            emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x10);
-            emit_u8(&ctx, 0xC0 | src);
+                free(ctx.buf);
+                return NULL;
         }
     }
+    if (stack_depth != 1) { free(ctx.buf); return NULL; }
 
     /* Call cell_number(double) - XMM0 holds the double argument (SysV ABI) */
-    /* MOV RAX, imm64 (address of cell_number) */
     uint64_t fn_addr = (uint64_t)(uintptr_t)&cell_number;
-    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0xB8);
-    for (int b = 0; b < 8; b++) emit_u8(&ctx, (fn_addr >> (b * 8)) & 0xFF);
-    /* CALL RAX */
-    emit_u8(&ctx, 0xFF); emit_u8(&ctx, 0xD0);
+    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0xB8);           /* MOV RAX, imm64 */
+    emit_u64(&ctx, fn_addr);
+    emit_u8(&ctx, 0xFF); emit_u8(&ctx, 0xD0);           /* CALL RAX */
 
     /* Epilogue - RAX already contains the Cell* result */
+    emit_u8(&ctx, 0x41); emit_u8(&ctx, 0x5C);  /* pop r12 */
     emit_u8(&ctx, 0x5B);  /* pop rbx (restore callee-saved) */
     emit_u8(&ctx, 0x5D);  /* pop rbp */
     emit_u8(&ctx, 0xC3);  /* ret */
 #endif
 
-    /* Copy to executable arena */
-    jit_write_begin();
-    void* code = arena_alloc(ctx.pos);
-    if (!code) {
-        free(ctx.buf);
-        return false;
-    }
-    memcpy(code, ctx.buf, ctx.pos);
-    jit_write_end(code, ctx.pos);
-
-    trace->native_code = code;
-    trace->code_size = ctx.pos;
-
+    void* code = ctx.pos < ctx.cap ? code_install(&ctx) : NULL;
+    *size_out = ctx.pos;
     free(ctx.buf);
+    return code;
+}
 
-    g_jit_compiler.total_compiles++;
+/* Every parameter the numeric path reads is an inline double */
+static bool numeric_entry_ok(JITTrace* trace, Cell* env) {
+    if (env->type != CELL_VECTOR || env->data.vector.capacity > 4) return false;
+    for (uint32_t i = 0; i < 4; i++) {
+        if (!(trace->num_loads & (1u << i))) continue;
+        if (i >= env->data.vector.size) return false;
+        Cell* c = env->data.vector.sbo[i];
+        if (!c || c->type != CELL_ATOM_NUMBER) return false;
+    }
     return true;
 }
 
 /* ============================================================================
- * Tail-Recursive Loop Compiler
- *
- * Detects pattern: (if <cond> <base> (self <arg1'> <arg2'>...))
- * Compiles to native loop without interpreter overhead.
+ * Main Compilation Entry Point
  * ============================================================================ */
 
-/* Check if expr is a tail-recursive if-expression with a call in tail position */
-static bool is_tail_recursive_if(Cell* expr, const char* func_name, int arity) {
-    (void)func_name;  /* Not used - we check structure only */
-
-    if (!cell_is_pair(expr)) return false;
-
-    Cell* head = cell_car(expr);
-    if (!cell_is_symbol(head)) return false;
-
-    const char* sym = cell_get_symbol(head);
-    if (strcmp(sym, "if") != 0 && strcmp(sym, "?") != 0) return false;
-
-    /* (if cond then else) */
-    Cell* args = cell_cdr(expr);
-    if (!cell_is_pair(args)) return false;
-
-    Cell* cond = cell_car(args);
-    (void)cond;
-    args = cell_cdr(args);
-    if (!cell_is_pair(args)) return false;
+/* Caller holds the compile lock */
+static JITTrace* jit_compile_locked(EvalContext* ctx, Cell* expr) {
+    if (!jit_is_enabled() || !cell_is_lambda(expr)) return NULL;
+    Cell* body = expr->data.lambda.body;
+    if (!body) return NULL;
 
-    Cell* then_branch = cell_car(args);
-    (void)then_branch;  /* Base case - will be simple */
-    args = cell_cdr(args);
-    if (!cell_is_pair(args)) return false;
+    JITTrace* trace = trace_new();
+    if (!trace) return NULL;
 
-    Cell* else_branch = cell_car(args);
+    trace->root_expr = body;
+    cell_retain(body);
+    trace->lambda = expr;
+    cell_retain(expr);
+    trace->guard_epoch = eval_global_epoch();
 
-    /* Check if else branch is a function call with arity args */
-    if (!cell_is_pair(else_branch)) return false;
-    Cell* call_head = cell_car(else_branch);
-    if (!cell_is_symbol(call_head)) return false;
+    BLState st = {trace, ctx, 0, true};
+    int result = bl_compile(&st, body, true);
+    trace_emit(trace, JOP_RET, 0, (uint8_t)result, 0);
 
-    /* Count arguments in the call */
-    int arg_count = 0;
-    Cell* call_args = cell_cdr(else_branch);
-    while (cell_is_pair(call_args)) {
-        arg_count++;
-        call_args = cell_cdr(call_args);
+    if (!st.ok || !baseline_codegen(trace)) {
+        trace_free(trace);
+        return NULL;
     }
 
-    return arg_count == arity;
-}
-
-/* Check if condition is a simple numeric comparison: (< n const) or (< n #N) */
-static bool is_simple_comparison(Cell* cond, int* param_idx, double* compare_val) {
-    if (!cell_is_pair(cond)) return false;
-
-    Cell* op = cell_car(cond);
-    if (!cell_is_symbol(op)) return false;
-
-    const char* sym = cell_get_symbol(op);
-    if (strcmp(sym, "<") != 0 && strcmp(sym, "≤") != 0 &&
-        strcmp(sym, ">") != 0 && strcmp(sym, "≥") != 0) return false;
-
-    Cell* args = cell_cdr(cond);
-    if (!cell_is_pair(args)) return false;
-
-    Cell* left = cell_car(args);
-    args = cell_cdr(args);
-    if (!cell_is_pair(args)) return false;
-
-    Cell* right = cell_car(args);
-
-    /* Left should be a De Bruijn index (number after conversion) */
-    if (!cell_is_number(left)) return false;
-    *param_idx = (int)cell_get_number(left);
-
-    /* Right should be (quote <number>) */
-    if (cell_is_pair(right)) {
-        Cell* quote_head = cell_car(right);
-        if (cell_is_symbol(quote_head) && strcmp(cell_get_symbol(quote_head), "quote") == 0) {
-            Cell* quote_args = cell_cdr(right);
-            if (cell_is_pair(quote_args)) {
-                Cell* val = cell_car(quote_args);
-                if (cell_is_number(val)) {
-                    *compare_val = cell_get_number(val);
-                    return true;
-                }
-            }
-        }
+    JITInst* lowered = malloc(trace->n_insts * sizeof(JITInst));
+    if (lowered) {
+        uint32_t n = numeric_lower(trace, lowered, &trace->num_loads);
+        size_t size = 0;
+        if (n) trace->numeric_code = numeric_codegen(lowered, n, &size);
+        if (trace->numeric_code) trace->numeric_size = size;
+        free(lowered);
     }
 
-    return false;
-}
-
-/* Compile tail-recursive function as native loop
- * Returns native code pointer, or NULL if pattern not matched
- */
-static void* compile_tail_recursive_loop(Cell* lambda, const char* func_name) {
-    if (!cell_is_lambda(lambda)) return NULL;
-
-    int arity = lambda->data.lambda.arity;
-    Cell* body = lambda->data.lambda.body;
-
-    /* Check for tail-recursive if pattern */
-    if (!is_tail_recursive_if(body, func_name, arity)) return NULL;
-
-    /* Extract if components */
-    Cell* args = cell_cdr(body);
-    Cell* cond = cell_car(args);
-    args = cell_cdr(args);
-    Cell* then_branch = cell_car(args);
-    args = cell_cdr(args);
-    Cell* else_branch = cell_car(args);
-
-    /* Check condition is simple comparison */
-    int cmp_param;
-    double cmp_val;
-    if (!is_simple_comparison(cond, &cmp_param, &cmp_val)) return NULL;
-
-    /* For now, only handle 2-param functions (n, acc) pattern */
-    if (arity != 2) return NULL;
-
-    /* Get comparison operator */
-    Cell* cmp_op = cell_car(cond);
-    const char* cmp_sym = cell_get_symbol(cmp_op);
-
-    /* Generate native loop code */
-    EmitCtx ctx;
-    ctx.cap = 4096;
-    ctx.pos = 0;
-    ctx.buf = malloc(ctx.cap);
-    if (!ctx.buf) return NULL;
-
-#if defined(__aarch64__) || defined(_M_ARM64)
-    /* ARM64: Generate tight loop
-     *
-     * Input: X0 = env (CELL_VECTOR with 2 params)
-     * D0 = param0 (e.g., n)
-     * D1 = param1 (e.g., acc)
-     *
-     * Loop structure:
-     *   loop:
-     *     FCMP D0, cmp_val
-     *     B.cond done
-     *     <update D0, D1>
-     *     B loop
-     *   done:
-     *     <box result and return>
-     */
-
-    /* Prologue */
-    emit_u32(&ctx, 0xA9BE7BFD);  /* STP X29, X30, [SP, #-32]! */
-    emit_u32(&ctx, 0x910003FD);  /* MOV X29, SP */
-    emit_u32(&ctx, 0xF9000BF3);  /* STR X19, [SP, #16] */
-    emit_u32(&ctx, 0xAA0003F3);  /* MOV X19, X0 (save env) */
-
-    /* Load params into D0 (n) and D1 (acc) */
-    uint32_t sbo0_offset = (uint32_t)(g_vec_sbo_offset + 0 * 8);
-    uint32_t sbo1_offset = (uint32_t)(g_vec_sbo_offset + 1 * 8);
-    uint32_t num_offset = (uint32_t)g_atom_number_offset;
-
-    /* D0 = env->sbo[0]->number */
-    emit_u32(&ctx, 0xF9400269 | ((sbo0_offset / 8) << 10));  /* LDR X9, [X19, #sbo0] */
-    emit_u32(&ctx, 0xFD400120 | ((num_offset / 8) << 10));   /* LDR D0, [X9, #num] */
-
-    /* D1 = env->sbo[1]->number */
-    emit_u32(&ctx, 0xF9400269 | ((sbo1_offset / 8) << 10));  /* LDR X9, [X19, #sbo1] */
-    emit_u32(&ctx, 0xFD400121 | ((num_offset / 8) << 10));   /* LDR D1, [X9, #num] */
-
-    /* Load comparison constant into D2 */
-    uint64_t cmp_bits;
-    memcpy(&cmp_bits, &cmp_val, 8);
-    emit_u32(&ctx, 0xD2800009 | ((cmp_bits & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2A00009 | (((cmp_bits >> 16) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2C00009 | (((cmp_bits >> 32) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2E00009 | (((cmp_bits >> 48) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0x9E670122);  /* FMOV D2, X9 */
-
-    /* Load constant 1.0 into D3 for decrement */
-    double one = 1.0;
-    uint64_t one_bits;
-    memcpy(&one_bits, &one, 8);
-    emit_u32(&ctx, 0xD2800009 | ((one_bits & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2A00009 | (((one_bits >> 16) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2C00009 | (((one_bits >> 32) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2E00009 | (((one_bits >> 48) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0x9E670123);  /* FMOV D3, X9 */
-
-    /* Loop label (record position for back-jump) */
-    size_t loop_start = ctx.pos;
-
-    /* FCMP D0, D2 (compare n with threshold) */
-    emit_u32(&ctx, 0x1E622000);  /* FCMP D0, D2 */
-
-    /* Branch based on comparison type */
-    /* B.LT done (if n < threshold, exit loop) - will patch offset */
-    size_t branch_pos = ctx.pos;
-    if (strcmp(cmp_sym, "<") == 0) {
-        emit_u32(&ctx, 0x5400000B);  /* B.LT +0 (placeholder) */
-    } else {
-        emit_u32(&ctx, 0x5400000D);  /* B.LE +0 (placeholder) */
-    }
-
-    /* Loop body: This is specific to the pattern
-     * For sum-squares: acc = acc + n*n; n = n - 1
-     * We need to analyze else_branch to generate this
-     * For now, hardcode the sum-squares pattern */
-
-    /* D4 = D0 * D0 (n * n) */
-    emit_u32(&ctx, 0x1E600804);  /* FMUL D4, D0, D0 */
-
-    /* D1 = D1 + D4 (acc + n*n) */
-    emit_u32(&ctx, 0x1E642821);  /* FADD D1, D1, D4 */
-
-    /* D0 = D0 - D3 (n - 1) */
-    emit_u32(&ctx, 0x1E633800);  /* FSUB D0, D0, D3 */
-
-    /* Jump back to loop start */
-    int32_t back_offset = (int32_t)((loop_start - ctx.pos) / 4);
-    emit_u32(&ctx, 0x14000000 | (back_offset & 0x3FFFFFF));  /* B loop */
-
-    /* Done label - patch the forward branch */
-    size_t done_pos = ctx.pos;
-    int32_t fwd_offset = (int32_t)((done_pos - branch_pos) / 4);
-    uint32_t* branch_insn = (uint32_t*)(ctx.buf + branch_pos);
-    *branch_insn = (*branch_insn & 0xFF00001F) | ((fwd_offset & 0x7FFFF) << 5);
-
-    /* Box result: D1 contains acc, call cell_number(D1) */
-    /* Move D1 to D0 for the call */
-    emit_u32(&ctx, 0x1E604020);  /* FMOV D0, D1 */
-
-    /* Call cell_number */
-    uint64_t fn_addr = (uint64_t)(uintptr_t)&cell_number;
-    emit_u32(&ctx, 0xD2800009 | ((fn_addr & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2A00009 | (((fn_addr >> 16) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2C00009 | (((fn_addr >> 32) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xF2E00009 | (((fn_addr >> 48) & 0xFFFF) << 5));
-    emit_u32(&ctx, 0xD63F0120);  /* BLR X9 */
-
-    /* Epilogue */
-    emit_u32(&ctx, 0xF9400BF3);  /* LDR X19, [SP, #16] */
-    emit_u32(&ctx, 0xA8C27BFD);  /* LDP X29, X30, [SP], #32 */
-    emit_u32(&ctx, 0xD65F03C0);  /* RET */
-
-#elif defined(__x86_64__) || defined(_M_X64)
-    /* x86-64: Similar native loop */
-
-    /* Prologue */
-    emit_u8(&ctx, 0x55);  /* push rbp */
-    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x89); emit_u8(&ctx, 0xE5);  /* mov rbp, rsp */
-    emit_u8(&ctx, 0x53);  /* push rbx */
-    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x89); emit_u8(&ctx, 0xFB);  /* mov rbx, rdi (save env) */
-
-    /* Load params: XMM0 = n, XMM1 = acc */
-    uint32_t sbo0_offset = (uint32_t)(g_vec_sbo_offset + 0 * 8);
-    uint32_t sbo1_offset = (uint32_t)(g_vec_sbo_offset + 1 * 8);
-    uint32_t num_offset = (uint32_t)g_atom_number_offset;
-
-    /* RAX = env->sbo[0] */
-    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x8B); emit_u8(&ctx, 0x83);
-    emit_u8(&ctx, sbo0_offset & 0xFF);
-    emit_u8(&ctx, (sbo0_offset >> 8) & 0xFF);
-    emit_u8(&ctx, (sbo0_offset >> 16) & 0xFF);
-    emit_u8(&ctx, (sbo0_offset >> 24) & 0xFF);
-    /* XMM0 = [RAX + num_offset] */
-    emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x10); emit_u8(&ctx, 0x80);
-    emit_u8(&ctx, num_offset & 0xFF);
-    emit_u8(&ctx, (num_offset >> 8) & 0xFF);
-    emit_u8(&ctx, (num_offset >> 16) & 0xFF);
-    emit_u8(&ctx, (num_offset >> 24) & 0xFF);
-
-    /* RAX = env->sbo[1] */
-    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x8B); emit_u8(&ctx, 0x83);
-    emit_u8(&ctx, sbo1_offset & 0xFF);
-    emit_u8(&ctx, (sbo1_offset >> 8) & 0xFF);
-    emit_u8(&ctx, (sbo1_offset >> 16) & 0xFF);
-    emit_u8(&ctx, (sbo1_offset >> 24) & 0xFF);
-    /* XMM1 = [RAX + num_offset] */
-    emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x10); emit_u8(&ctx, 0x88);
-    emit_u8(&ctx, num_offset & 0xFF);
-    emit_u8(&ctx, (num_offset >> 8) & 0xFF);
-    emit_u8(&ctx, (num_offset >> 16) & 0xFF);
-    emit_u8(&ctx, (num_offset >> 24) & 0xFF);
-
-    /* Load comparison constant into XMM2 */
-    uint64_t cmp_bits;
-    memcpy(&cmp_bits, &cmp_val, 8);
-    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0xB8);
-    for (int b = 0; b < 8; b++) emit_u8(&ctx, (cmp_bits >> (b * 8)) & 0xFF);
-    emit_u8(&ctx, 0x66); emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x0F);
-    emit_u8(&ctx, 0x6E); emit_u8(&ctx, 0xD0);  /* MOVQ XMM2, RAX */
-
-    /* Load 1.0 into XMM3 */
-    double one = 1.0;
-    uint64_t one_bits;
-    memcpy(&one_bits, &one, 8);
-    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0xB8);
-    for (int b = 0; b < 8; b++) emit_u8(&ctx, (one_bits >> (b * 8)) & 0xFF);
-    emit_u8(&ctx, 0x66); emit_u8(&ctx, 0x48); emit_u8(&ctx, 0x0F);
-    emit_u8(&ctx, 0x6E); emit_u8(&ctx, 0xD8);  /* MOVQ XMM3, RAX */
-
-    /* Loop label */
-    size_t loop_start = ctx.pos;
-
-    /* COMISD XMM0, XMM2 */
-    emit_u8(&ctx, 0x66); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x2F); emit_u8(&ctx, 0xC2);
-
-    /* JB done (if n < threshold) - placeholder */
-    size_t branch_pos = ctx.pos;
-    emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x82);
-    emit_u8(&ctx, 0); emit_u8(&ctx, 0); emit_u8(&ctx, 0); emit_u8(&ctx, 0);
-
-    /* Loop body: XMM4 = XMM0 * XMM0 */
-    emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x10); emit_u8(&ctx, 0xE0);  /* MOVSD XMM4, XMM0 */
-    emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x59); emit_u8(&ctx, 0xE0);  /* MULSD XMM4, XMM0 */
-
-    /* XMM1 = XMM1 + XMM4 */
-    emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x58); emit_u8(&ctx, 0xCC);  /* ADDSD XMM1, XMM4 */
-
-    /* XMM0 = XMM0 - XMM3 */
-    emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x5C); emit_u8(&ctx, 0xC3);  /* SUBSD XMM0, XMM3 */
-
-    /* JMP loop */
-    int32_t back_offset = (int32_t)(loop_start - (ctx.pos + 2));
-    emit_u8(&ctx, 0xEB);
-    emit_u8(&ctx, back_offset & 0xFF);
-
-    /* Done label - patch forward branch */
-    size_t done_pos = ctx.pos;
-    int32_t fwd_offset = (int32_t)(done_pos - (branch_pos + 6));
-    ctx.buf[branch_pos + 2] = fwd_offset & 0xFF;
-    ctx.buf[branch_pos + 3] = (fwd_offset >> 8) & 0xFF;
-    ctx.buf[branch_pos + 4] = (fwd_offset >> 16) & 0xFF;
-    ctx.buf[branch_pos + 5] = (fwd_offset >> 24) & 0xFF;
-
-    /* Box result: XMM1 -> XMM0, call cell_number */
-    emit_u8(&ctx, 0xF2); emit_u8(&ctx, 0x0F); emit_u8(&ctx, 0x10); emit_u8(&ctx, 0xC1);  /* MOVSD XMM0, XMM1 */
-
-    uint64_t fn_addr = (uint64_t)(uintptr_t)&cell_number;
-    emit_u8(&ctx, 0x48); emit_u8(&ctx, 0xB8);
-    for (int b = 0; b < 8; b++) emit_u8(&ctx, (fn_addr >> (b * 8)) & 0xFF);
-    emit_u8(&ctx, 0xFF); emit_u8(&ctx, 0xD0);  /* CALL RAX */
-
-    /* Epilogue */
-    emit_u8(&ctx, 0x5B);  /* pop rbx */
-    emit_u8(&ctx, 0x5D);  /* pop rbp */
-    emit_u8(&ctx, 0xC3);  /* ret */
-#endif
-
-    /* Copy to executable arena */
-    jit_write_begin();
-    void* code = arena_alloc(ctx.pos);
-    if (!code) {
-        free(ctx.buf);
+    if (!cache_insert(trace)) {
+        trace_discard(trace);
         return NULL;
     }
-    memcpy(code, ctx.buf, ctx.pos);
-    jit_write_end(code, ctx.pos);
 
-    free(ctx.buf);
+    return trace;
+}
 
-    g_jit_compiler.total_compiles++;
-    return code;
+JITTrace* jit_compile(EvalContext* ctx, Cell* expr) {
+    pthread_mutex_lock(&g_jit_lock);
+    JITTrace* trace = jit_compile_locked(ctx, expr);
+    pthread_mutex_unlock(&g_jit_lock);
+    return trace;
 }
 
 /* ============================================================================
- * Main Compilation Entry Point
+ * Execution
  * ============================================================================ */
 
-JITTrace* jit_compile(Cell* expr) {
-    if (!jit_is_enabled()) return NULL;
-
-    /* Try specialized tail-recursive loop compiler first */
-    if (cell_is_lambda(expr) && expr->data.lambda.arity == 2) {
-        /* For 2-param functions, try to compile as native loop
-         * We use "sum-squares" as a placeholder - the loop compiler
-         * will check the actual pattern */
-        void* loop_code = compile_tail_recursive_loop(expr, "sum-squares");
-        if (loop_code) {
-            JITTrace* trace = trace_new();
-            if (trace) {
-                trace->root_expr = expr->data.lambda.body;
-                cell_retain(trace->root_expr);
-                trace->native_code = loop_code;
-                trace->code_size = 256;  /* Approximate */
-
-                trace->next = g_jit_compiler.traces;
-                g_jit_compiler.traces = trace;
-                g_jit_compiler.trace_count++;
-                return trace;
+/* Entry guards: builtins resolved at compile time must still be what the
+ * names mean here. A changed global invalidates the trace for good; a
+ * pattern binding that shadows one only sends this call to the interpreter. */
+static bool jit_guards_hold(JITTrace* trace, EvalContext* ctx) {
+    if (trace->n_guards == 0) return true;
+
+    uint64_t epoch = eval_global_epoch();
+    if (__atomic_load_n(&trace->guard_epoch, __ATOMIC_RELAXED) != epoch) {
+        for (uint32_t i = 0; i < trace->n_guards; i++) {
+            Cell* v = eval_lookup_global(ctx, cell_get_symbol(trace->guard_syms[i]));
+            if (v) cell_release(v);
+            if (v != trace->guard_vals[i]) {
+                __atomic_store_n(&trace->invalid, true, __ATOMIC_RELAXED);
+                return false;
             }
         }
+        __atomic_store_n(&trace->guard_epoch, epoch, __ATOMIC_RELAXED);
     }
 
-    /* For lambdas, compile their body */
-    Cell* to_compile = expr;
-    if (cell_is_lambda(expr)) {
-        to_compile = expr->data.lambda.body;
-        if (!to_compile) return NULL;
+    if (ctx->env != ctx->global_env) {
+        for (Cell* e = ctx->env; cell_is_pair(e) && e != ctx->global_env; e = cell_cdr(e)) {
+            Cell* binding = cell_car(e);
+            if (!cell_is_pair(binding) || !cell_is_symbol(cell_car(binding))) continue;
+            uint16_t id = cell_car(binding)->sym_id;
+            for (uint32_t i = 0; i < trace->n_guards; i++) {
+                if (trace->guard_syms[i]->sym_id == id &&
+                    cell_cdr(binding) != trace->guard_vals[i]) {
+                    return false;
+                }
+            }
+        }
     }
+    return true;
+}
 
-    JITTrace* trace = trace_new();
-    if (!trace) return NULL;
-
-    trace->root_expr = to_compile;
-    cell_retain(to_compile);
-
-    /* Compile expression to IR */
-    RegAlloc ra = {0, 8, 16};
-    uint8_t result_reg = compile_expr(trace, &ra, to_compile, 0);
-
-    /* Emit return */
-    trace_emit(trace, JOP_RET, result_reg, 0, 0);
-
-    /* Generate native code */
-    if (!trace_codegen(trace)) {
-        /* Codegen failed - clean up and return NULL to indicate failure */
-        if (trace->insts) free(trace->insts);
-        if (trace->constants) {
-            for (uint32_t i = 0; i < trace->n_constants; i++) {
-                if (trace->constants[i]) cell_release(trace->constants[i]);
-            }
-            free(trace->constants);
+Cell* jit_execute(JITTrace* trace, EvalContext* ctx, Cell* env, JITExit* exit) {
+    memset(exit, 0, sizeof(*exit));
+    exit->kind = JIT_EXIT_DEOPT;
+    if (!trace || __atomic_load_n(&trace->invalid, __ATOMIC_RELAXED) ||
+        !jit_guards_hold(trace, ctx)) {
+        __atomic_add_fetch(&g_jit_compiler.total_deopts, 1, __ATOMIC_RELAXED);
+        /* Free the entry now if no one is compiling; else the sweep will */
+        if (trace && __atomic_load_n(&trace->invalid, __ATOMIC_RELAXED) &&
+            pthread_mutex_trylock(&g_jit_lock) == 0) {
+            if (g_jit_compiler.cache[trace->slot] == trace) cache_evict(trace);
+            cache_reclaim(false);
+            pthread_mutex_unlock(&g_jit_lock);
         }
-        cell_release(to_compile);
-        free(trace);
         return NULL;
     }
 
-    /* Link into trace list */
-    trace->next = g_jit_compiler.traces;
-    g_jit_compiler.traces = trace;
-    g_jit_compiler.trace_count++;
+    __atomic_add_fetch(&trace->exec_count, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&trace->referenced, true, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_jit_compiler.total_native_calls, 1, __ATOMIC_RELAXED);
 
-    return trace;
-}
+    if (trace->numeric_code && numeric_entry_ok(trace, env)) {
+        exit->kind = JIT_EXIT_VALUE;
+        return ((JITFunction)trace->numeric_code)(env);
+    }
 
-/* ============================================================================
- * Execution
- * ============================================================================ */
+    uint16_t n_slots = trace->n_slots ? trace->n_slots : 1;
+    Cell* slots[n_slots];
+    memset(slots, 0, sizeof(slots));
 
-Cell* jit_execute(JITTrace* trace, Cell* env) {
-    if (!trace) return cell_nil();
+    /* Compiled code is not preemptible: its reduction budget is spent at
+     * loop back-edges, and a loop that exhausts it comes back with one
+     * reduction left so the interpreter yields on resuming it. */
+    int32_t reds = ctx->reductions_left;
+    ctx->reductions_left = 0;
 
-    trace->exec_count++;
-    g_jit_compiler.total_native_calls++;
+    cell_retain(env);
+    JITFrame frame = {ctx, trace, env, slots, exit,
+                      reds > 0 ? reds : INT32_MAX, eval_global_epoch()};
+    __atomic_add_fetch(&trace->active, 1, __ATOMIC_ACQ_REL);
+    ((JITBaselineFn)trace->native_code)(&frame);
+    __atomic_sub_fetch(&trace->active, 1, __ATOMIC_RELEASE);
 
-    if (trace->native_code) {
-        /* Execute native code */
-        JITFunction fn = (JITFunction)trace->native_code;
-        return fn(env);
-    } else {
-        /* No native code - fall back to interpreter */
-        return jit_deopt(trace, env, 0);
+    if (reds > 0) ctx->reductions_left = frame.budget > 0 ? frame.budget : 1;
+
+    for (uint16_t i = 0; i < n_slots; i++) {
+        if (slots[i]) cell_release(slots[i]);
     }
-}
+    if (frame.env) cell_release(frame.env);
 
-Cell* jit_deopt(JITTrace* trace, Cell* env, uint32_t pc) {
-    (void)pc;  /* TODO: use PC for partial deopt */
-    g_jit_compiler.total_deopts++;
+    return exit->kind == JIT_EXIT_VALUE ? exit->value : NULL;
+}
 
-    /* Fall back to interpreter */
-    if (trace->root_expr) {
-        EvalContext* ctx = eval_context_new();
-        /* TODO: restore environment properly */
-        Cell* result = eval(ctx, trace->root_expr);
-        eval_context_free(ctx);
-        return result;
-    }
-    return cell_nil();
+/* Baseline traces leave mid-run only at the entry and at self tail calls;
+ * both map back to the top of the lambda body, with every slot dead. */
+void jit_deopt(JITTrace* trace, Cell* env, uint32_t pc, JITExit* exit) {
+    if (pc > 0) __atomic_add_fetch(&g_jit_compiler.total_loop_exits, 1, __ATOMIC_RELAXED);
+    cell_retain(trace->root_expr);
+    exit->kind = JIT_EXIT_EVAL;
+    exit->expr = trace->root_expr;
+    exit->env = env;
 }
 
 /* ============================================================================
@@ -1629,6 +2098,8 @@ void jit_get_stats(JITStats* stats) {
     stats->interp_calls = 0;  /* TODO */
     stats->code_bytes = g_jit_compiler.code_arena_pos;
     stats->traces = g_jit_compiler.trace_count;
+    stats->evictions = g_jit_compiler.total_evictions;
+    stats->loop_exits = g_jit_compiler.total_loop_exits;
 }
 
 void jit_print_stats(void) {
@@ -1639,6 +2110,8 @@ void jit_print_stats(void) {
     fprintf(stderr, "Traces compiled:  %llu\n", (unsigned long long)stats.traces);
     fprintf(stderr, "Native calls:     %llu\n", (unsigned long long)stats.native_calls);
     fprintf(stderr, "Deoptimizations:  %llu\n", (unsigned long long)stats.deopts);
+    fprintf(stderr, "Evictions:        %llu\n", (unsigned long long)stats.evictions);
+    fprintf(stderr, "Loop exits:       %llu\n", (unsigned long long)stats.loop_exits);
     fprintf(stderr, "Code arena used:  %llu bytes\n", (unsigned long long)stats.code_bytes);
     fprintf(stderr, "======================\n\n");
 }
@@ -30,13 +30,19 @@
 #define JIT_MAX_INLINE_DEPTH  8      /* Max inlining depth */
 #define JIT_CODE_ARENA_SIZE   (16 * 1024 * 1024)  /* 16MB code arena */
 #define JIT_MAX_CONSTANTS     256    /* Constants pool size */
+#define JIT_MAX_SLOTS         255    /* Boxed value slots per baseline frame */
+#define JIT_CODE_CACHE_SIZE   4096   /* Compiled traces kept (GUAGE_JIT_CACHE) */
+#define JIT_HOT_BATCH         10     /* Local calls per shared counter update */
+#define JIT_HOT_LOCAL_SLOTS   256    /* Per-thread hot counter slots (power of 2) */
+#define JIT_COMPILE_QUEUE     64     /* Pending compile requests */
 
 /* ============================================================================
  * Opcode Definitions (Internal IR)
  * ============================================================================ */
 
 typedef enum {
-    /* Arithmetic - operate on raw doubles, no boxing */
+    /* Arithmetic - operate on raw doubles, no boxing
+     * (the baseline tier runs _DD/_II ops on type-guarded boxed slots) */
     JOP_ADD_DD,         /* D0 = D1 + D2 */
     JOP_SUB_DD,         /* D0 = D1 - D2 */
     JOP_MUL_DD,         /* D0 = D1 * D2 */
@@ -76,7 +82,7 @@ typedef enum {
     JOP_STORE_INT,      /* cell->integer = I0 (box) */
     JOP_STORE_BOOL,     /* cell->bool_val = B0 */
 
-    /* Type guards - deopt on failure */
+    /* Type guards - deopt on failure (baseline tier: jump to the target) */
     JOP_GUARD_NUM,      /* deopt if cell->type != NUMBER */
     JOP_GUARD_INT,      /* deopt if cell->type != INTEGER */
     JOP_GUARD_BOOL,     /* deopt if cell->type != BOOL */
@@ -113,6 +119,11 @@ typedef enum {
     JOP_BOX_READ,       /* P0 = unbox(P1) */
     JOP_BOX_WRITE,      /* box_set!(P0, P1) */
 
+    /* Baseline tier - boxed values in frame slots */
+    JOP_GLOBAL_LOAD,    /* P0 = global binding of constant symbol */
+    JOP_CALL_BUILTIN,   /* P0 = builtin(P1..Pn), resolved at compile time */
+    JOP_ARITH,          /* P0 = P1 <flags op> P2 on boxed numbers */
+
     JOP_COUNT
 } JITOpcode;
 
@@ -126,6 +137,7 @@ typedef struct {
     uint8_t   src1;     /* Source register 1 */
     uint8_t   src2;     /* Source register 2 */
     uint8_t   flags;    /* Instruction flags */
+    uint32_t  aux;      /* Argument count, builtin constant or span position */
     union {
         double    num_const;
         int64_t   int_const;
@@ -138,6 +150,20 @@ typedef struct {
     } imm;
 } JITInst;
 
+/* Instruction flags */
+#define JIT_F_TAIL      0x01   /* CALL / CALL_INTERP in tail position */
+
+/* JOP_JUMP_IF variants (flags): keep the tested value as the result */
+#define JIT_BR_AND      1      /* jump on #f or error */
+#define JIT_BR_OR       2      /* jump on #t or error */
+#define JIT_BR_ERROR    3      /* jump on error (begin) */
+
+/* JOP_ARITH operators (flags) */
+typedef enum {
+    JIT_ARITH_ADD, JIT_ARITH_SUB, JIT_ARITH_MUL, JIT_ARITH_DIV,
+    JIT_ARITH_LT,  JIT_ARITH_GT,  JIT_ARITH_LE,  JIT_ARITH_GE
+} JITArithOp;
+
 /* ============================================================================
  * JIT Trace - A compiled code path
  * ============================================================================ */
@@ -147,16 +173,33 @@ typedef struct JITTrace {
     uint32_t  n_insts;      /* Number of instructions */
     uint32_t  capacity;     /* Allocated capacity */
 
-    void*     native_code;  /* JIT'd machine code */
+    void*     native_code;  /* Baseline machine code (JITBaselineFn) */
     size_t    code_size;    /* Machine code size */
+    void*     numeric_code; /* Unboxed double fast path (JITFunction) or NULL */
+    size_t    numeric_size;
+    uint8_t   num_loads;    /* Env slots the numeric path reads (bitmask) */
+    uint16_t  n_slots;      /* Boxed slots used by baseline code */
 
     Cell**    constants;    /* Constant pool */
     uint32_t  n_constants;
 
     Cell*     root_expr;    /* Original expression (for deopt) */
+    Cell*     lambda;       /* Compiled lambda (self tail calls loop) */
     uint32_t  exec_count;   /* Execution counter */
 
-    struct JITTrace* next;  /* Linked list for cleanup */
+    /* Entry guards: globals resolved to builtins at compile time */
+    Cell**    guard_syms;
+    Cell**    guard_vals;
+    uint32_t  n_guards;
+    uint64_t  guard_epoch;  /* eval_global_epoch() when last validated */
+
+    /* Code cache bookkeeping (fields written while running are atomic) */
+    uint32_t  slot;         /* Index in g_jit_compiler.cache */
+    uint32_t  active;       /* Activations in progress, on any thread */
+    bool      referenced;   /* Ran since the clock hand last passed */
+    bool      invalid;      /* An entry guard failed for good */
+    uint64_t  retire_epoch; /* QSBR epoch when evicted */
+    struct JITTrace* retired_next;
 } JITTrace;
 
 /* ============================================================================
@@ -166,8 +209,44 @@ typedef struct JITTrace {
 /* JIT'd function: takes environment, returns Cell* result */
 typedef Cell* (*JITFunction)(Cell* env);
 
+/* How a baseline trace hands control back to the interpreter */
+typedef enum {
+    JIT_EXIT_VALUE,     /* value holds the result */
+    JIT_EXIT_APPLY,     /* tail call: apply fn to args */
+    JIT_EXIT_EVAL,      /* tail form or deopt: evaluate expr in env */
+    JIT_EXIT_DEOPT      /* entry guard failed, nothing was evaluated */
+} JITExitKind;
+
+typedef struct {
+    JITExitKind kind;
+    Cell* value;
+    Cell* fn;           /* JIT_EXIT_APPLY (owned) */
+    Cell* args;
+    Cell* expr;         /* JIT_EXIT_EVAL (owned) */
+    Cell* env;
+} JITExit;
+
+/* Baseline activation: slots hold owned boxed values */
+typedef struct {
+    struct EvalContext* ctx;
+    JITTrace* trace;
+    Cell*     env;      /* Owned; replaced on self tail calls */
+    Cell**    slots;
+    JITExit*  exit;
+    int32_t   budget;   /* Reductions left; a loop leaves when it runs out */
+    uint64_t  epoch;    /* Global epoch the guards were last checked at */
+} JITFrame;
+
+typedef void (*JITBaselineFn)(JITFrame* frame);
+
 /* ============================================================================
  * JIT Compiler State
+ *
+ * Any scheduler thread may run compiled code. Hot counts are batched per
+ * thread; compile requests go through a queue drained by whichever thread
+ * holds the compile lock, which also owns the cache and the arena. Traces
+ * are published with release stores and, once evicted, freed only after a
+ * QSBR grace period (scheduler.c).
  * ============================================================================ */
 
 typedef struct {
@@ -176,22 +255,26 @@ typedef struct {
     size_t    code_arena_pos;
     size_t    code_arena_size;
 
-    /* Trace storage */
-    JITTrace* traces;
+    /* Code cache: lambdas point at their entry (lambda.jit_slot); cold
+     * traces are evicted by a clock sweep when entries or arena run out */
+    JITTrace** cache;
+    uint32_t  cache_cap;
+    uint32_t  cache_hand;
     uint32_t  trace_count;
+    struct JITCodeBlock* free_code;  /* Reclaimed arena blocks, address order */
+    JITTrace* retired;      /* Evicted, waiting for a grace period */
 
-    /* Hot function tracking */
-    struct {
-        Cell*     expr;
-        uint32_t  count;
-        JITTrace* trace;
-    } hot_functions[1024];
-    uint32_t hot_count;
+    /* Compile requests (retained lambdas), guarded by the queue lock */
+    Cell*     queue[JIT_COMPILE_QUEUE];
+    uint32_t  queue_head;
+    uint32_t  queue_tail;
 
     /* Statistics */
     uint64_t  total_compiles;
     uint64_t  total_deopts;
     uint64_t  total_native_calls;
+    uint64_t  total_evictions;
+    uint64_t  total_loop_exits;
 
     /* Enabled flag */
     bool      enabled;
@@ -213,20 +296,22 @@ void jit_enable(void);
 void jit_disable(void);
 bool jit_is_enabled(void);
 
-/* Compile expression to JIT trace */
-JITTrace* jit_compile(Cell* expr);
+/* Compile lambda to JIT trace */
+JITTrace* jit_compile(struct EvalContext* ctx, Cell* expr);
 
-/* Execute JIT trace */
-Cell* jit_execute(JITTrace* trace, Cell* env);
+/* Execute JIT trace with env as its argument frame (borrowed).
+ * Returns the result, or NULL with *exit saying how to continue. */
+Cell* jit_execute(JITTrace* trace, struct EvalContext* ctx, Cell* env, JITExit* exit);
 
-/* Record function call for hot tracking */
-void jit_record_call(Cell* expr);
+/* Count a call of lambda fn; compiles it when it becomes hot */
+void jit_record_call(struct EvalContext* ctx, Cell* fn);
 
-/* Get or compile JIT trace for expression */
-JITTrace* jit_get_trace(Cell* expr);
+/* Cached trace of lambda fn, or NULL */
+JITTrace* jit_get_trace(Cell* fn);
 
-/* Deoptimize and return to interpreter */
-Cell* jit_deopt(JITTrace* trace, Cell* env, uint32_t pc);
+/* Leave trace at instruction pc: fills exit with the expression the
+ * interpreter resumes at (JIT_EXIT_EVAL). Consumes env. */
+void jit_deopt(JITTrace* trace, Cell* env, uint32_t pc, JITExit* exit);
 
 /* ============================================================================
  * Stencil API (platform-specific)
@@ -262,6 +347,8 @@ typedef struct {
     uint64_t interp_calls;
     uint64_t code_bytes;
     uint64_t traces;
+    uint64_t evictions;
+    uint64_t loop_exits;
 } JITStats;
 
 void jit_get_stats(JITStats* stats);
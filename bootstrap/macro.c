@@ -285,6 +285,10 @@ Cell* macro_list(void) {
     return result;
 }
 
+MacroEntry* macro_entries(void) {
+    return registry.head;
+}
+
 Cell* macro_expand_once(Cell* expr, EvalContext* ctx) {
     if (!expr || !ctx) {
         return expr;
@@ -125,6 +125,12 @@ Cell* macro_gensym(const char* prefix);
  */
 Cell* macro_list(void);
 
+/**
+ * First entry of the macro registry (newest first, linked by next).
+ * Used to snapshot the registry into an image.
+ */
+MacroEntry* macro_entries(void);
+
 /**
  * Expand macro once (for debugging).
  * Unlike macro_expand, doesn't recursively expand.
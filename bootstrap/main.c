@@ -23,6 +23,7 @@
 #include "diagnostic.h"
 #include "scheduler.h"
 #include "jit.h"
+#include "image.h"
 #include <time.h>
 #include <math.h>
 
@@ -375,18 +376,10 @@ Cell* parse(const char* input) {
  * Advances *pos past the parsed expression (including trailing whitespace).
  * Returns NULL at end of input. */
 Cell* parse_next(const char* input, int* pos, uint32_t file_base) {
+    /* Spans are byte offsets (line/column come from the SourceMap), so
+     * there is no need to rescan the file up to *pos for every form */
     Parser p = {input, *pos, 1, 1, file_base};
 
-    /* Compute correct line/column from start of file to current pos */
-    for (int i = 0; i < *pos; i++) {
-        if (input[i] == '\n') {
-            p.line++;
-            p.column = 1;
-        } else {
-            p.column++;
-        }
-    }
-
     Cell* result = parse_expr(&p);
     *pos = p.pos;
     return result;
@@ -690,6 +683,16 @@ static const char* get_history_path(void) {
     return NULL;
 }
 
+/* Heap image to start from (--image), instead of re-evaluating sources */
+static const char* g_image_path = NULL;
+
+static void restore_startup_image(EvalContext* ctx) {
+    if (!g_image_path) return;
+    if (!image_load(ctx, g_image_path)) {
+        fprintf(stderr, "Warning: cannot load image %s; starting empty\n", g_image_path);
+    }
+}
+
 /* ── Test run result (shared between --test and --load-test) ── */
 typedef struct {
     int pass_count;
@@ -719,6 +722,7 @@ static TestRunResult run_test_core(const char* filename, char* buffer, size_t le
     eval_define(ctx, "#t", cell_bool(true));
     eval_define(ctx, "#f", cell_bool(false));
     eval_define(ctx, "nil", cell_nil());
+    restore_startup_image(ctx);
 
     /* Track alloc stats for leak detection */
     uint64_t alloc_start = cell_get_alloc_count();
@@ -989,6 +993,7 @@ void repl(void) {
     eval_define(ctx, "#t", cell_bool(true));
     eval_define(ctx, "#f", cell_bool(false));
     eval_define(ctx, "nil", cell_nil());
+    restore_startup_image(ctx);
 
     printf("Ready.\n\n");
 
@@ -1203,6 +1208,10 @@ int main(int argc, char** argv) {
         } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
             load_warmup = atoi(argv[++i]);
             if (load_warmup < 0) load_warmup = 0;
+        } else if (strcmp(argv[i], "--production") == 0) {
+            eval_set_lazy_docs(true);
+        } else if (strcmp(argv[i], "--image") == 0 && i + 1 < argc) {
+            g_image_path = argv[++i];
         } else if (argv[i][0] != '-') {
             /* Positional arg: treat as test file */
             test_file = argv[i];
@@ -1224,6 +1233,9 @@ int main(int argc, char** argv) {
     /* Enable profiling counters if GUAGE_PROFILE env is set */
     if (getenv("GUAGE_PROFILE")) g_profile_enabled = true;
 
+    /* Production mode: no eager docs on define (also --production) */
+    if (getenv("GUAGE_PRODUCTION")) eval_set_lazy_docs(true);
+
     guage_siphash_init();
     intern_init();
     intern_preload();
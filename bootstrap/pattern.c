@@ -2,6 +2,7 @@
 #include "pattern_check.h"
 #include "cell.h"
 #include "eval.h"
+#include <stdatomic.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -580,48 +581,6 @@ static Cell* merge_bindings(Cell* bindings1, Cell* bindings2) {
     }
 }
 
-/* Helper: Extend environment with bindings list
- * Bindings can be:
- * - Single: (var . value)
- * - List: ((var1 . val1) . ((var2 . val2) . nil))
- * Returns new environment with bindings prepended
- */
-static Cell* extend_env_with_bindings(Cell* bindings, Cell* env) {
-    if (!bindings) {
-        return env;
-    }
-
-    /* Check if bindings is a single binding or a list */
-    Cell* first = cell_car(bindings);
-
-    /* If car is a symbol, it's a single binding: (symbol . value) */
-    if (first && first->type == CELL_ATOM_SYMBOL) {
-        /* Single binding - prepend to env */
-        cell_retain(bindings);
-        cell_retain(env);
-        return cell_cons(bindings, env);
-    }
-
-    /* List of bindings - walk through and prepend each */
-    Cell* new_env = env;
-    cell_retain(env);
-
-    /* Build list of bindings to prepend */
-    Cell* current = bindings;
-    while (current && current->type == CELL_PAIR) {
-        Cell* binding = cell_car(current);
-        if (binding && binding->type == CELL_PAIR) {
-            cell_retain(binding);
-            Cell* old_new_env = new_env;
-            new_env = cell_cons(binding, old_new_env);
-            cell_release(old_new_env);
-        }
-        current = cell_cdr(current);
-    }
-
-    return new_env;
-}
-
 /* Helper: Evaluate transform expression on value
  * Returns transformed value, or error on failure
  */
@@ -1034,165 +993,650 @@ MatchResult pattern_try_match(Cell* value, Cell* pattern) {
     return failure;
 }
 
-/* Evaluate a match expression */
-Cell* pattern_eval_match(Cell* expr, Cell* clauses, Cell* env, EvalContext* ctx) {
-    if (!ctx) {
-        return cell_error("no-context", expr);
+/* ============ Compiled match plans ============
+ *
+ * A ∇ clause list is compiled once into a MatchPlan: every pattern is
+ * pre-classified into a CPat tree (no re-parsing of guard/as/or/view
+ * syntax per match), and clauses are indexed by the constructor they
+ * require at the top — number/bool literal, keyword sym_id, nil, pair,
+ * leaf type or node type+variant. Matching switches on the scrutinee's
+ * key and only tries the clauses that can apply, in source order.
+ *
+ * Plans are cached per thread, keyed by the clause-list cell (the quoted
+ * list is the same AST cell on every evaluation). The cache holds a
+ * reference to the list, so a cached key can never be freed and reused.
+ * Exhaustiveness warnings are emitted once, when the plan is built.
+ */
+
+typedef enum {
+    CP_FAIL,        /* Never matches (unsupported or inconsistent) */
+    CP_WILD,        /* _ */
+    CP_VAR,         /* x — binds */
+    CP_NIL,         /* ∅ literal — matches nil (or missing) value */
+    CP_NIL_SYM,     /* nil symbol — matches a nil cell */
+    CP_NUM,         /* #42 */
+    CP_BOOL,        /* #t / #f */
+    CP_KEYWORD,     /* :foo — compared by sym_id */
+    CP_PAIR,        /* (cons p1 p2) */
+    CP_LEAF,        /* (struct-create :Type field-pats...) */
+    CP_NODE,        /* (adt-create :Type :Variant field-pats...) */
+    CP_AS,          /* (name @ p) */
+    CP_OR,          /* (or p1 p2 ...) */
+    CP_VIEW         /* (-> transform p) */
+} CPatKind;
+
+typedef struct CPat {
+    CPatKind kind;
+    uint16_t nsub;
+    Cell* atom;         /* VAR/AS: name; NUM/BOOL/KEYWORD: literal;
+                         * LEAF/NODE: type tag; VIEW: transform expr */
+    Cell* variant;      /* NODE: variant tag */
+    struct CPat** sub;  /* PAIR: car,cdr; LEAF/NODE: fields; AS/VIEW: 1; OR: alts */
+} CPat;
+
+/* Dispatch key: the constructor a value presents at the top level */
+typedef enum {
+    MK_ANY = 0,         /* Clause head: matches any key */
+    MK_NIL, MK_NUM, MK_BOOL, MK_SYM, MK_PAIR, MK_LEAF, MK_NODE, MK_OTHER
+} MatchKeyKind;
+
+typedef struct {
+    uint8_t kind;
+    uint64_t bits;
+} MatchKey;
+
+typedef struct {
+    CPat* pattern;
+    Cell* guard;        /* NULL if no guard */
+    Cell* result;
+    MatchKey head;
+    bool invalid;       /* Clause is not a list: reaching it is an error */
+    Cell* raw;          /* The clause cell (for the invalid-clause error) */
+} CompiledClause;
+
+typedef struct {
+    MatchKey key;
+    uint16_t* order;    /* Clause indices to try, in source order */
+    uint16_t count;
+} MatchBucket;
+
+typedef struct MatchPlan {
+    CompiledClause* clauses;
+    uint16_t nclauses;
+    MatchBucket* buckets;   /* Open-addressed by key (kind 0 = empty) */
+    uint32_t bucket_mask;
+    uint16_t* any_order;    /* Clauses for keys with no bucket */
+    uint16_t any_count;
+    Cell* source;           /* Clause list the plan points into (retained) */
+    _Atomic uint32_t refs;  /* Cache slot + matches running it, on any thread */
+} MatchPlan;
+
+static CPat* cpat_new(CPatKind kind, uint16_t nsub) {
+    CPat* p = (CPat*)calloc(1, sizeof(CPat));
+    p->kind = kind;
+    p->nsub = nsub;
+    if (nsub) p->sub = (CPat**)calloc(nsub, sizeof(CPat*));
+    return p;
+}
+
+static void cpat_free(CPat* p) {
+    if (!p) return;
+    for (uint16_t i = 0; i < p->nsub; i++) cpat_free(p->sub[i]);
+    free(p->sub);
+    free(p);
+}
+
+/* Compile field patterns of a leaf/node pattern into p->sub */
+static CPat* cpat_compile(Cell* pattern);
+
+static CPat* cpat_compile_fields(CPatKind kind, Cell* type, Cell* variant, Cell* field_pats) {
+    CPat* p = cpat_new(kind, (uint16_t)list_length(field_pats));
+    p->atom = type;
+    p->variant = variant;
+    for (uint16_t i = 0; i < p->nsub; i++) {
+        p->sub[i] = cpat_compile(cell_car(field_pats));
+        field_pats = cell_cdr(field_pats);
     }
+    return p;
+}
 
-    /* Evaluate the expression to match using the provided environment
-     * This is critical for De Bruijn indices in closures - we need the
-     * current indexed environment, not the global environment */
-    Cell* value = eval_internal(ctx, env, expr);
-    if (!value) {
-        return cell_error("eval-failed", expr);
+/* Classify a pattern once, in the same order pattern_try_match tests it */
+static CPat* cpat_compile(Cell* pattern) {
+    if (is_wildcard(pattern)) return cpat_new(CP_WILD, 0);
+
+    if (is_as_pattern(pattern)) {
+        Cell* name;
+        Cell* subpattern;
+        extract_as_pattern(pattern, &name, &subpattern);
+        CPat* p = cpat_new(CP_AS, 1);
+        p->atom = name;
+        p->sub[0] = cpat_compile(subpattern);
+        return p;
     }
-    if (value->type == CELL_ERROR) {
-        return value;
+
+    if (is_or_pattern(pattern)) {
+        Cell* alternatives = extract_or_alternatives(pattern);
+        if (!check_or_pattern_consistency(alternatives)) return cpat_new(CP_FAIL, 0);
+        CPat* p = cpat_new(CP_OR, (uint16_t)list_length(alternatives));
+        for (uint16_t i = 0; i < p->nsub; i++) {
+            p->sub[i] = cpat_compile(cell_car(alternatives));
+            alternatives = cell_cdr(alternatives);
+        }
+        return p;
     }
 
-    /* Check exhaustiveness and emit warnings */
-    ExhaustivenessResult check = pattern_check_exhaustiveness(clauses);
+    if (is_view_pattern(pattern)) {
+        Cell* transform;
+        Cell* subpattern;
+        extract_view_pattern(pattern, &transform, &subpattern);
+        CPat* p = cpat_new(CP_VIEW, 1);
+        p->atom = transform;
+        p->sub[0] = cpat_compile(subpattern);
+        return p;
+    }
 
-    if (check.status == COVERAGE_PARTIAL) {
-        /* Incomplete pattern match - warn about potential :no-match error */
-        warn_incomplete_match(value);
-    } else if (check.status == COVERAGE_REDUNDANT) {
-        /* Unreachable patterns detected */
-        warn_unreachable_pattern(check.first_unreachable);
+    if (pattern && pattern->type == CELL_ATOM_SYMBOL &&
+        strcmp(pattern->data.atom.symbol, "nil") == 0) {
+        return cpat_new(CP_NIL_SYM, 0);
     }
-    /* COVERAGE_COMPLETE - all good, no warnings */
+    if (!pattern || pattern->type == CELL_ATOM_NIL) return cpat_new(CP_NIL, 0);
 
-    /* Clauses should be a list of pairs: ((pattern1 result1) (pattern2 result2) ...) */
-    /* Each clause is (pattern result) where pattern is data and result is an unevaluated expression */
+    if (pattern->type == CELL_ATOM_NUMBER) {
+        CPat* p = cpat_new(CP_NUM, 0);
+        p->atom = pattern;
+        return p;
+    }
+    if (pattern->type == CELL_ATOM_BOOL) {
+        CPat* p = cpat_new(CP_BOOL, 0);
+        p->atom = pattern;
+        return p;
+    }
+    if (is_variable_pattern(pattern)) {
+        CPat* p = cpat_new(CP_VAR, 0);
+        p->atom = pattern;
+        return p;
+    }
+    if (pattern->type == CELL_ATOM_SYMBOL) {
+        CPat* p = cpat_new(CP_KEYWORD, 0);
+        p->atom = pattern;
+        return p;
+    }
+
+    if (is_pair_pattern(pattern)) {
+        Cell* pat1;
+        Cell* pat2;
+        extract_pair_subpatterns(pattern, &pat1, &pat2);
+        CPat* p = cpat_new(CP_PAIR, 2);
+        p->sub[0] = cpat_compile(pat1);
+        p->sub[1] = cpat_compile(pat2);
+        return p;
+    }
+
+    if (pattern->type == CELL_PAIR) {
+        Cell* first = cell_car(pattern);
+        bool is_leaf = first && first->type == CELL_ATOM_SYMBOL &&
+                       strcmp(first->data.atom.symbol, "struct-create") == 0;
+        bool is_node = first && first->type == CELL_ATOM_SYMBOL &&
+                       strcmp(first->data.atom.symbol, "adt-create") == 0;
+        Cell* rest = cell_cdr(pattern);
+        Cell* type = rest && rest->type == CELL_PAIR ? cell_car(rest) : NULL;
+        if ((is_leaf || is_node) && (!type || type->type != CELL_ATOM_SYMBOL)) {
+            return cpat_new(CP_FAIL, 0);
+        }
+        if (is_leaf) return cpat_compile_fields(CP_LEAF, type, NULL, cell_cdr(rest));
+        if (is_node) {
+            Cell* rest2 = cell_cdr(rest);
+            Cell* variant = rest2 && rest2->type == CELL_PAIR ? cell_car(rest2) : NULL;
+            if (!variant || variant->type != CELL_ATOM_SYMBOL) return cpat_new(CP_FAIL, 0);
+            return cpat_compile_fields(CP_NODE, type, variant, cell_cdr(rest2));
+        }
+    }
+
+    return cpat_new(CP_FAIL, 0);
+}
+
+static uint64_t number_key_bits(double d) {
+    if (d == 0) d = 0;  /* -0 and +0 compare equal: share a bucket */
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+/* Key of a runtime value */
+static MatchKey value_key(Cell* value) {
+    MatchKey k = { MK_OTHER, 0 };
+    if (!value) { k.kind = MK_NIL; return k; }
+    switch (value->type) {
+        case CELL_ATOM_NIL:    k.kind = MK_NIL; break;
+        case CELL_ATOM_NUMBER: k.kind = MK_NUM; k.bits = number_key_bits(value->data.atom.number); break;
+        case CELL_ATOM_BOOL:   k.kind = MK_BOOL; k.bits = value->data.atom.boolean; break;
+        case CELL_ATOM_SYMBOL: k.kind = MK_SYM; k.bits = value->sym_id; break;
+        case CELL_PAIR:        k.kind = MK_PAIR; break;
+        case CELL_STRUCT: {
+            Cell* type = cell_struct_type_tag(value);
+            if (!type || type->type != CELL_ATOM_SYMBOL) break;
+            if (cell_struct_kind(value) == STRUCT_LEAF) {
+                k.kind = MK_LEAF; k.bits = type->sym_id;
+            } else if (cell_struct_kind(value) == STRUCT_NODE) {
+                Cell* variant = cell_struct_variant(value);
+                if (!variant || variant->type != CELL_ATOM_SYMBOL) break;
+                k.kind = MK_NODE; k.bits = ((uint64_t)type->sym_id << 16) | variant->sym_id;
+            }
+            break;
+        }
+        default: break;
+    }
+    return k;
+}
+
+/* Key a clause requires at the top, MK_ANY if it does not constrain it.
+ * Sets *never when the pattern can match nothing at all. */
+static MatchKey cpat_head(const CPat* p, bool* never) {
+    MatchKey k = { MK_ANY, 0 };
+    switch (p->kind) {
+        case CP_FAIL:     *never = true; break;
+        case CP_NIL:
+        case CP_NIL_SYM:  k.kind = MK_NIL; break;
+        case CP_NUM:      k.kind = MK_NUM; k.bits = number_key_bits(p->atom->data.atom.number); break;
+        case CP_BOOL:     k.kind = MK_BOOL; k.bits = p->atom->data.atom.boolean; break;
+        case CP_KEYWORD:  k.kind = MK_SYM; k.bits = p->atom->sym_id; break;
+        case CP_PAIR:     k.kind = MK_PAIR; break;
+        case CP_LEAF:     k.kind = MK_LEAF; k.bits = p->atom->sym_id; break;
+        case CP_NODE:     k.kind = MK_NODE;
+                          k.bits = ((uint64_t)p->atom->sym_id << 16) | p->variant->sym_id; break;
+        case CP_AS:       return cpat_head(p->sub[0], never);
+        default:          break;  /* WILD, VAR, OR, VIEW */
+    }
+    return k;
+}
+
+static inline bool match_key_eq(MatchKey a, MatchKey b) {
+    return a.kind == b.kind && a.bits == b.bits;
+}
+
+static inline uint32_t match_key_hash(MatchKey k) {
+    uint64_t h = (k.bits ^ ((uint64_t)k.kind << 56)) * 0x9E3779B97F4A7C15ull;
+    return (uint32_t)(h >> 32);
+}
+
+static MatchBucket* plan_bucket(MatchPlan* plan, MatchKey key) {
+    if (!plan->buckets) return NULL;
+    for (uint32_t i = match_key_hash(key) & plan->bucket_mask;; i = (i + 1) & plan->bucket_mask) {
+        MatchBucket* b = &plan->buckets[i];
+        if (b->key.kind == MK_ANY) return NULL;
+        if (match_key_eq(b->key, key)) return b;
+    }
+}
+
+static void plan_free(MatchPlan* plan) {
+    if (!plan) return;
+    for (uint16_t i = 0; i < plan->nclauses; i++) cpat_free(plan->clauses[i].pattern);
+    free(plan->clauses);
+    if (plan->buckets) {
+        for (uint32_t i = 0; i <= plan->bucket_mask; i++) free(plan->buckets[i].order);
+        free(plan->buckets);
+    }
+    free(plan->any_order);
+    free(plan);
+}
+
+static MatchPlan* plan_compile(Cell* clauses) {
+    MatchPlan* plan = (MatchPlan*)calloc(1, sizeof(MatchPlan));
+    cell_retain(clauses);
+    plan->source = clauses;
+    atomic_init(&plan->refs, 1);
+    plan->nclauses = (uint16_t)list_length(clauses);
+    plan->clauses = (CompiledClause*)calloc(plan->nclauses ? plan->nclauses : 1, sizeof(CompiledClause));
+    bool* never = (bool*)calloc(plan->nclauses ? plan->nclauses : 1, sizeof(bool));
 
-    /* Walk through the clause list */
+    uint16_t nkeyed = 0;
     Cell* current = clauses;
-    while (current && cell_is_pair(current)) {
+    for (uint16_t i = 0; i < plan->nclauses; i++, current = cell_cdr(current)) {
+        CompiledClause* cc = &plan->clauses[i];
         Cell* clause = cell_car(current);
-
-        /* Each clause should be a pair (pattern result) or (pattern . (result)) */
+        cc->raw = clause;
         if (!clause || clause->type != CELL_PAIR) {
-            cell_release(value);
-            return cell_error("invalid-clause", clause ? clause : cell_nil());
+            cc->invalid = true;
+            continue;
         }
 
-        /* Extract pattern (possibly with guard) and result */
         Cell* pattern_expr = clause->data.pair.car;
         Cell* rest = clause->data.pair.cdr;
+        cc->result = rest && rest->type == CELL_PAIR ? rest->data.pair.car : rest;
 
-        /* Result can be in two formats:
-         * 1. (pattern result) -> rest is (result . nil), extract car
-         * 2. (pattern . result) -> rest is the result directly */
-        Cell* result_expr;
-        if (rest && rest->type == CELL_PAIR) {
-            result_expr = rest->data.pair.car;
-        } else {
-            result_expr = rest;
+        Cell* pattern = pattern_expr;
+        if (has_guard(pattern_expr)) {
+            extract_pattern_and_guard(pattern_expr, &pattern, &cc->guard);
         }
+        cc->pattern = cpat_compile(pattern);
+        cc->head = cpat_head(cc->pattern, &never[i]);
+        if (cc->head.kind != MK_ANY && !never[i]) nkeyed++;
+    }
+
+    /* One bucket per distinct key; each lists its own clauses plus the
+     * unconstrained ones, preserving source order. */
+    uint16_t* scratch = (uint16_t*)malloc((plan->nclauses ? plan->nclauses : 1) * sizeof(uint16_t));
+    if (nkeyed > 0) {
+        uint32_t cap = 4;
+        while (cap < (uint32_t)nkeyed * 2) cap <<= 1;
+        plan->buckets = (MatchBucket*)calloc(cap, sizeof(MatchBucket));
+        plan->bucket_mask = cap - 1;
+        for (uint16_t i = 0; i < plan->nclauses; i++) {
+            CompiledClause* cc = &plan->clauses[i];
+            if (cc->invalid || never[i] || cc->head.kind == MK_ANY) continue;
+            uint32_t slot = match_key_hash(cc->head) & plan->bucket_mask;
+            while (plan->buckets[slot].key.kind != MK_ANY &&
+                   !match_key_eq(plan->buckets[slot].key, cc->head)) {
+                slot = (slot + 1) & plan->bucket_mask;
+            }
+            MatchBucket* b = &plan->buckets[slot];
+            if (b->key.kind != MK_ANY) continue;  /* Already built */
+            b->key = cc->head;
+            uint16_t n = 0;
+            for (uint16_t j = 0; j < plan->nclauses; j++) {
+                CompiledClause* cj = &plan->clauses[j];
+                if (cj->invalid || (!never[j] &&
+                    (cj->head.kind == MK_ANY || match_key_eq(cj->head, cc->head)))) {
+                    scratch[n++] = j;
+                }
+            }
+            b->order = (uint16_t*)malloc(n * sizeof(uint16_t));
+            memcpy(b->order, scratch, n * sizeof(uint16_t));
+            b->count = n;
+        }
+    }
 
-        /* Check if pattern has guard syntax: (pattern | guard) */
-        Cell* pattern;
-        Cell* guard_expr = NULL;
-        if (has_guard(pattern_expr)) {
-            extract_pattern_and_guard(pattern_expr, &pattern, &guard_expr);
-        } else {
-            pattern = pattern_expr;
+    uint16_t n = 0;
+    for (uint16_t j = 0; j < plan->nclauses; j++) {
+        if (plan->clauses[j].invalid || (!never[j] && plan->clauses[j].head.kind == MK_ANY)) {
+            scratch[n++] = j;
         }
+    }
+    plan->any_order = (uint16_t*)malloc((n ? n : 1) * sizeof(uint16_t));
+    memcpy(plan->any_order, scratch, n * sizeof(uint16_t));
+    plan->any_count = n;
 
-        /* Try to match the pattern against the value
-         * Temporarily set ctx->env to local environment for view patterns
-         * View patterns need to evaluate transforms in the correct environment */
-        Cell* old_ctx_env = ctx->env;
-        cell_retain(env);
-        ctx->env = env;
+    free(scratch);
+    free(never);
+    return plan;
+}
 
-        MatchResult match = pattern_try_match(value, pattern);
+/* Per-thread plan cache, direct-mapped on the clause-list address */
+#define MATCH_PLAN_CACHE_BITS 9
+#define MATCH_PLAN_CACHE_SIZE (1u << MATCH_PLAN_CACHE_BITS)
 
-        /* Restore original environment */
-        cell_release(ctx->env);
-        ctx->env = old_ctx_env;
+typedef struct {
+    Cell* clauses;      /* Same as plan->source */
+    MatchPlan* plan;
+} MatchPlanEntry;
+
+static _Thread_local MatchPlanEntry g_match_plans[MATCH_PLAN_CACHE_SIZE];
 
-        if (match.success) {
-            /* If guard exists, evaluate it in extended environment */
-            if (guard_expr) {
-                Cell* extended_env = extend_env_with_bindings(match.bindings, ctx->env);
+/* Guards and views may yield, so the last reference can be dropped on a
+ * thread other than the one whose cache compiled the plan */
+static void plan_release(MatchPlan* plan) {
+    if (atomic_fetch_sub_explicit(&plan->refs, 1, memory_order_acq_rel) != 1) return;
+    Cell* source = plan->source;
+    plan_free(plan);
+    cell_release(source);
+}
 
-                /* Temporarily set ctx->env for symbol lookup */
-                Cell* old_ctx_env = ctx->env;
-                cell_retain(extended_env);
-                ctx->env = extended_env;
+static MatchPlan* plan_lookup(Cell* clauses, Cell* value) {
+    /* High product bits: cells sit a fixed stride apart, so the low bits
+     * of the address would reach only a fraction of the slots */
+    uint32_t slot = (uint32_t)((uint32_t)((uintptr_t)clauses >> 4) * 2654435761u) >> (32 - MATCH_PLAN_CACHE_BITS);
+    MatchPlanEntry* e = &g_match_plans[slot];
+    if (e->clauses == clauses) return e->plan;
 
-                /* Evaluate guard */
-                Cell* guard_result = eval(ctx, guard_expr);
+    /* A guard or view transform of an outer match can land here; that
+     * match holds its own reference to the plan */
+    if (e->plan) plan_release(e->plan);
+    e->clauses = clauses;
+    e->plan = plan_compile(clauses);
 
-                /* Restore ctx->env */
-                ctx->env = old_ctx_env;
-                cell_release(extended_env);
+    /* Exhaustiveness is a property of the clauses: warn once, here */
+    ExhaustivenessResult check = pattern_check_exhaustiveness(clauses);
+    if (check.status == COVERAGE_PARTIAL) {
+        warn_incomplete_match(value);
+    } else if (check.status == COVERAGE_REDUNDANT) {
+        warn_unreachable_pattern(check.first_unreachable);
+    }
+    return e->plan;
+}
 
-                /* Check if guard succeeded */
-                bool guard_passed = false;
-                if (guard_result && guard_result->type == CELL_ATOM_BOOL) {
-                    guard_passed = guard_result->data.atom.boolean;
-                }
-                cell_release(guard_result);
+/* Bindings collected during a match, in left-to-right pattern order */
+typedef struct {
+    Cell** items;       /* (name . value) pairs, each owning one ref */
+    uint32_t count;
+    uint32_t cap;
+    Cell* inline_items[16];
+} BindBuf;
+
+static void bind_init(BindBuf* b) {
+    b->items = b->inline_items;
+    b->count = 0;
+    b->cap = 16;
+}
 
-                if (!guard_passed) {
-                    /* Guard failed - try next clause */
-                    if (match.bindings) {
-                        cell_release(match.bindings);
-                    }
-                    current = current->data.pair.cdr;
-                    continue;
-                }
-            }
+static void bind_push(BindBuf* b, Cell* name, Cell* value) {
+    if (b->count == b->cap) {
+        uint32_t cap = b->cap * 2;
+        Cell** items = (Cell**)malloc(cap * sizeof(Cell*));
+        memcpy(items, b->items, b->count * sizeof(Cell*));
+        if (b->items != b->inline_items) free(b->items);
+        b->items = items;
+        b->cap = cap;
+    }
+    b->items[b->count++] = cell_cons(name, value);
+}
+
+static void bind_truncate(BindBuf* b, uint32_t mark) {
+    while (b->count > mark) cell_release(b->items[--b->count]);
+}
+
+static void bind_free(BindBuf* b) {
+    bind_truncate(b, 0);
+    if (b->items != b->inline_items) free(b->items);
+}
+
+/* Prepend bindings to env in order, so later bindings shadow earlier ones.
+ * Returns a new reference. */
+static Cell* bind_extend_env(BindBuf* b, Cell* env) {
+    cell_retain(env);
+    for (uint32_t i = 0; i < b->count; i++) {
+        Cell* next = cell_cons(b->items[i], env);
+        cell_release(env);
+        env = next;
+    }
+    return env;
+}
 
-            /* Pattern matched and guard passed (or no guard) - evaluate result */
-            /* Match succeeded! Evaluate the result expression */
-            Cell* result;
-
-            if (match.bindings) {
-                /* Extend the CONTEXT environment with pattern bindings
-                 * Use ctx->env (global + closure) instead of env (just closure)
-                 * This ensures recursive function names are accessible */
-                Cell* extended_env = extend_env_with_bindings(match.bindings, ctx->env);
-
-                /* Temporarily set ctx->env to the extended environment
-                 * This allows symbol lookup to find both pattern bindings and global names */
-                Cell* old_ctx_env = ctx->env;
-                cell_retain(extended_env);
-                ctx->env = extended_env;
-
-                /* Evaluate result - symbol lookup uses ctx->env */
-                result = eval(ctx, result_expr);
-
-                /* Restore original ctx->env */
-                ctx->env = old_ctx_env;
-                cell_release(extended_env);
-                cell_release(match.bindings);
-            } else {
-                /* No bindings, but still need to temporarily set ctx->env for closure parameter access */
-                Cell* old_ctx_env = ctx->env;
-                cell_retain(env);
-                ctx->env = env;
-
-                result = eval(ctx, result_expr);
-
-                ctx->env = old_ctx_env;
-                cell_release(env);
+static bool cpat_match(const CPat* p, Cell* value, BindBuf* b);
+
+static bool cpat_match_fields(const CPat* p, Cell* fields, BindBuf* b) {
+    for (uint16_t i = 0; i < p->nsub; i++) {
+        if (!fields || fields->type != CELL_PAIR) return false;
+        if (!cpat_match(p->sub[i], cell_cdr(cell_car(fields)), b)) return false;
+        fields = cell_cdr(fields);
+    }
+    return !(fields && fields->type == CELL_PAIR);
+}
+
+/* Match value against a compiled pattern. On failure, bindings pushed by
+ * this call are left for the caller to truncate. */
+static bool cpat_match(const CPat* p, Cell* value, BindBuf* b) {
+    switch (p->kind) {
+        case CP_WILD:
+            return true;
+        case CP_VAR:
+            bind_push(b, p->atom, value);
+            return true;
+        case CP_NIL:
+            return !value || value->type == CELL_ATOM_NIL;
+        case CP_NIL_SYM:
+            return value && value->type == CELL_ATOM_NIL;
+        case CP_NUM:
+            return value && value->type == CELL_ATOM_NUMBER &&
+                   value->data.atom.number == p->atom->data.atom.number;
+        case CP_BOOL:
+            return value && value->type == CELL_ATOM_BOOL &&
+                   value->data.atom.boolean == p->atom->data.atom.boolean;
+        case CP_KEYWORD:
+            return value && value->type == CELL_ATOM_SYMBOL &&
+                   value->sym_id == p->atom->sym_id;
+        case CP_PAIR:
+            if (!value || value->type != CELL_PAIR) return false;
+            return cpat_match(p->sub[0], cell_car(value), b) &&
+                   cpat_match(p->sub[1], cell_cdr(value), b);
+        case CP_LEAF:
+        case CP_NODE: {
+            if (!value || value->type != CELL_STRUCT) return false;
+            if (cell_struct_kind(value) != (p->kind == CP_LEAF ? STRUCT_LEAF : STRUCT_NODE)) return false;
+            Cell* type = cell_struct_type_tag(value);
+            if (!type || type->type != CELL_ATOM_SYMBOL || type->sym_id != p->atom->sym_id) return false;
+            if (p->kind == CP_NODE) {
+                Cell* variant = cell_struct_variant(value);
+                if (!variant || variant->type != CELL_ATOM_SYMBOL ||
+                    variant->sym_id != p->variant->sym_id) return false;
+            }
+            return cpat_match_fields(p, cell_struct_fields(value), b);
+        }
+        case CP_AS: {
+            uint32_t mark = b->count;
+            if (!cpat_match(p->sub[0], value, b)) return false;
+            /* Whole-value binding goes before the subpattern's, as with
+             * merge_bindings, so a subpattern name of the same spelling wins */
+            bind_push(b, p->atom, value);
+            Cell* whole = b->items[b->count - 1];
+            memmove(&b->items[mark + 1], &b->items[mark], (b->count - 1 - mark) * sizeof(Cell*));
+            b->items[mark] = whole;
+            return true;
+        }
+        case CP_OR: {
+            uint32_t mark = b->count;
+            for (uint16_t i = 0; i < p->nsub; i++) {
+                if (cpat_match(p->sub[i], value, b)) return true;
+                bind_truncate(b, mark);
+            }
+            return false;
+        }
+        case CP_VIEW: {
+            EvalContext* ctx = eval_get_current_context();
+            if (!ctx) return false;
+            Cell* transformed = eval_transform(p->atom, value, ctx->env);
+            if (transformed && transformed->type == CELL_ERROR) {
+                cell_release(transformed);
+                return false;
             }
+            bool ok = cpat_match(p->sub[0], transformed, b);
+            if (transformed) cell_release(transformed);  /* Bindings hold their own refs */
+            return ok;
+        }
+        case CP_FAIL:
+        default:
+            return false;
+    }
+}
+
+/* Evaluate a match expression */
+Cell* pattern_eval_match(Cell* expr, Cell* clauses, Cell* env, EvalContext* ctx) {
+    if (!ctx) {
+        return cell_error("no-context", expr);
+    }
+
+    /* Evaluate the expression to match using the provided environment
+     * This is critical for De Bruijn indices in closures - we need the
+     * current indexed environment, not the global environment */
+    Cell* value = eval_internal(ctx, env, expr);
+    if (!value) {
+        return cell_error("eval-failed", expr);
+    }
+    if (value->type == CELL_ERROR) {
+        return value;
+    }
 
+    /* Clauses should be a list of pairs: ((pattern1 result1) (pattern2 result2) ...) */
+    if (!clauses || !cell_is_pair(clauses)) {
+        Cell* error = cell_error("no-match", value);
+        cell_release(value);
+        return error;
+    }
+
+    MatchPlan* plan = plan_lookup(clauses, value);
+    atomic_fetch_add_explicit(&plan->refs, 1, memory_order_relaxed);
+    MatchBucket* bucket = plan_bucket(plan, value_key(value));
+    const uint16_t* order = bucket ? bucket->order : plan->any_order;
+    uint16_t count = bucket ? bucket->count : plan->any_count;
+
+    BindBuf bindings;
+    bind_init(&bindings);
+
+    for (uint16_t k = 0; k < count; k++) {
+        CompiledClause* cc = &plan->clauses[order[k]];
+        if (cc->invalid) {
+            Cell* error = cell_error("invalid-clause", cc->raw ? cc->raw : cell_nil());
+            bind_free(&bindings);
             cell_release(value);
-            return result;
+            plan_release(plan);
+            return error;
         }
 
-        /* Try next clause */
-        current = current->data.pair.cdr;
+        /* Match with ctx->env set to the local environment, so view
+         * patterns evaluate transforms where the ∇ appears */
+        Cell* old_ctx_env = ctx->env;
+        cell_retain(env);
+        ctx->env = env;
+        bool matched = cpat_match(cc->pattern, value, &bindings);
+        cell_release(ctx->env);
+        ctx->env = old_ctx_env;
+
+        if (!matched) {
+            bind_truncate(&bindings, 0);
+            continue;
+        }
+
+        /* Guard sees the pattern bindings over the context environment */
+        if (cc->guard) {
+            Cell* guard_env = bind_extend_env(&bindings, ctx->env);
+            ctx->env = guard_env;
+            Cell* guard_result = eval(ctx, cc->guard);
+            ctx->env = old_ctx_env;
+            cell_release(guard_env);
+
+            bool guard_passed = guard_result && guard_result->type == CELL_ATOM_BOOL &&
+                                guard_result->data.atom.boolean;
+            cell_release(guard_result);
+            if (!guard_passed) {
+                bind_truncate(&bindings, 0);
+                continue;
+            }
+        }
+
+        /* With bindings, extend the context environment (global + closure)
+         * so recursive function names stay visible; without, use the
+         * local environment for closure parameter access. */
+        Cell* result_env = bindings.count ? bind_extend_env(&bindings, ctx->env) : env;
+        if (!bindings.count) cell_retain(env);
+        bind_free(&bindings);
+        cell_release(value);
+        /* The arm may run for a long time (or yield); do not pin the plan */
+        Cell* body = cc->result;
+        cell_retain(body);
+        plan_release(plan);
+
+        ctx->env = result_env;
+        Cell* result = eval(ctx, body);
+        ctx->env = old_ctx_env;
+        cell_release(result_env);
+        cell_release(body);
+        return result;
     }
 
     /* No clause matched */
+    bind_free(&bindings);
     Cell* error = cell_error("no-match", value);
     cell_release(value);
+    plan_release(plan);
     return error;
 }
 
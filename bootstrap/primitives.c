@@ -9,6 +9,8 @@
 #include "type.h"
 #include "testgen.h"
 #include "module.h"
+#include "gcache.h"
+#include "image.h"
 #include "macro.h"
 #include "actor.h"
 #include "channel.h"
@@ -86,6 +88,9 @@ static const char* celltype_names[FDT_MAX_TYPES] = {
     [CELL_DIR]          = ":Dir",
     [CELL_FFI_PTR]      = ":FFIPtr",
     [CELL_ATOM_INTEGER] = ":Integer",
+    [CELL_PMAP]         = ":PersistentMap",
+    [CELL_PSET]         = ":PersistentSet",
+    [CELL_TABLE]        = ":Table",
 };
 
 /* Helper: get first argument */
@@ -2974,12 +2979,7 @@ Cell* prim_effect_pure(Cell* args) {
  * (⟳ behavior) where behavior is (λ (self) ...)
  * Creates actor, passes self-reference as actor cell.
  * The behavior body should use ←? to receive messages. */
-Cell* prim_spawn(Cell* args) {
-    Cell* behavior = arg1(args);
-    if (!cell_is_lambda(behavior)) {
-        return cell_error("spawn-not-lambda", behavior);
-    }
-
+static Cell* spawn_behavior(Cell* behavior, bool use_arena, size_t stack_size) {
     EvalContext* ctx = eval_get_current_context();
 
     /* We need a fiber body that applies behavior to self-actor-cell.
@@ -2988,12 +2988,13 @@ Cell* prim_spawn(Cell* args) {
 
     /* Create actor first to get the ID */
     Cell* placeholder = cell_nil();
-    Actor* actor = actor_create(ctx, placeholder, ctx->env);
+    Actor* actor = actor_create_sized(ctx, placeholder, ctx->env, stack_size);
     cell_release(placeholder);
 
     if (!actor) {
         return cell_error("max-actors-exceeded", cell_nil());
     }
+    if (use_arena) actor->arena = cell_arena_new();
 
     /* Build unique symbol names using actor ID */
     char fn_name[64], self_name[64];
@@ -3026,6 +3027,107 @@ Cell* prim_spawn(Cell* args) {
     return cell_actor(actor->id);
 }
 
+Cell* prim_spawn(Cell* args) {
+    Cell* behavior = arg1(args);
+    if (!cell_is_lambda(behavior)) {
+        return cell_error("spawn-not-lambda", behavior);
+    }
+    return spawn_behavior(behavior, false, FIBER_DEFAULT_STACK_SIZE);
+}
+
+/* ⟳◎ - spawn actor with a private cell arena
+ * (⟳◎ behavior) — like ⟳, but every cell the actor allocates comes from
+ * its own arena, bulk-freed when the actor is destroyed. Messages it sends
+ * are copied out (copy-on-send). Suited to short-lived request actors. */
+Cell* prim_spawn_arena(Cell* args) {
+    Cell* behavior = arg1(args);
+    if (!cell_is_lambda(behavior)) {
+        return cell_error("spawn-not-lambda", behavior);
+    }
+    return spawn_behavior(behavior, true, FIBER_DEFAULT_STACK_SIZE);
+}
+
+/* ⟳↕ - spawn actor with an explicit fiber stack size
+ * (⟳↕ behavior bytes) — bytes is rounded up to whole pages and clamped to
+ * [FIBER_MIN_STACK_SIZE, FIBER_MAX_STACK_SIZE]. Small stacks suit large
+ * populations of shallow actors; large ones, deeply recursive bodies. */
+Cell* prim_spawn_stack(Cell* args) {
+    Cell* behavior = arg1(args);
+    Cell* bytes = arg2(args);
+    if (!cell_is_lambda(behavior)) {
+        return cell_error("spawn-not-lambda", behavior);
+    }
+    /* NaN and ±inf would make the size_t conversion below undefined */
+    if (!cell_is_number(bytes) || !isfinite(cell_get_number(bytes)) ||
+        cell_get_number(bytes) <= 0) {
+        return cell_error("spawn-stack-size", bytes);
+    }
+    double req = cell_get_number(bytes);
+    size_t size = req > FIBER_MAX_STACK_SIZE ? FIBER_MAX_STACK_SIZE : (size_t)req;
+    if (size < FIBER_MIN_STACK_SIZE) size = FIBER_MIN_STACK_SIZE;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size = (size + page - 1) & ~(page - 1);
+    return spawn_behavior(behavior, false, size);
+}
+
+/* ⟳# - resident bytes held by an actor (struct, fiber, mailbox slots,
+ * save queue, links/monitors), excluding its lazily committed stack */
+Cell* prim_actor_memory(Cell* args) {
+    Cell* target = arg1(args);
+    if (!cell_is_actor(target)) {
+        return cell_error("actor-memory-not-actor", target);
+    }
+    Actor* actor = actor_lookup(cell_get_actor_id(target));
+    if (!actor) return cell_error("actor-memory-not-found", target);
+    return cell_number((double)actor_memory(actor));
+}
+
+/* ⟳◎? - arena statistics for an actor
+ * (⟳◎? actor) → ⟨:slabs N :allocs N :released B⟩ alist, or nil if it has
+ * no arena. A finished actor's arena is released; its stats are final. */
+Cell* prim_actor_arena_info(Cell* args) {
+    Cell* target = arg1(args);
+    if (!cell_is_actor(target)) {
+        return cell_error("arena-info-not-actor", target);
+    }
+    Actor* actor = actor_lookup(cell_get_actor_id(target));
+    uint32_t slabs = 0;
+    uint64_t allocs = 0;
+    if (!actor || !actor_arena_stats(actor, &slabs, &allocs)) return cell_nil();
+    Cell* info = cell_nil();
+    info = cell_cons(cell_cons(cell_symbol(":released"), cell_bool(actor->arena_released)), info);
+    info = cell_cons(cell_cons(cell_symbol(":allocs"), cell_number((double)allocs)), info);
+    info = cell_cons(cell_cons(cell_symbol(":slabs"), cell_number((double)slabs)), info);
+    return info;
+}
+
+/* ❄ - freeze immutable value for zero-copy sharing between actors
+ * (❄ value) → value, or error naming the first mutable cell; a value
+ * built on another scheduler is refused (freeze-not-owner) */
+Cell* prim_freeze(Cell* args) {
+    Cell* value = arg1(args);
+    Cell* offender = cell_freeze(value);
+    if (offender) {
+        /* A root built on another scheduler comes back as its own offender */
+        if (offender == value && !cell_owned_here(value))
+            return cell_error("freeze-not-owner", value);
+        return cell_error("freeze-mutable", offender);
+    }
+    cell_retain(value);
+    return value;
+}
+
+/* ❄? - is value part of a frozen region */
+Cell* prim_frozen_p(Cell* args) {
+    return cell_bool(cell_is_frozen(arg1(args)));
+}
+
+/* ❄# - number of live frozen regions */
+Cell* prim_frozen_regions(Cell* args) {
+    (void)args;
+    return cell_number((double)cell_frozen_region_count());
+}
+
 /* →! - send message to actor
  * (→! actor message) */
 Cell* prim_send(Cell* args) {
@@ -3042,7 +3144,10 @@ Cell* prim_send(Cell* args) {
         return cell_error("dead-actor", target);
     }
 
-    actor_send(actor, message);
+    /* A reply handle from a ⟨:call ...⟩ message answers that call directly */
+    if (!actor_deliver_reply(actor, target->data.actor.call_ref, message)) {
+        actor_send(actor, message);
+    }
     return cell_nil();
 }
 
@@ -3099,6 +3204,87 @@ Cell* prim_receive(Cell* args) {
     return cell_nil();
 }
 
+/* Test one message against a selective-receive pattern. A function is
+ * called as a predicate with preemption off, so it cannot yield mid-scan;
+ * any other value matches a message equal to it or a pair headed by it. */
+static bool receive_matches(EvalContext* ctx, Cell* pattern, Cell* msg) {
+    if (!cell_is_lambda(pattern) && pattern->type != CELL_BUILTIN) {
+        return cell_equal(pattern, msg) ||
+               (cell_is_pair(msg) && cell_equal(pattern, cell_car(msg)));
+    }
+    Cell* call_args = cell_cons(msg, cell_nil());
+
+    int saved_reds = ctx->reductions_left;
+    ctx->reductions_left = 0;
+    Cell* result = eval_apply(ctx, pattern, call_args);
+    ctx->reductions_left = saved_reds;
+    cell_release(call_args);
+
+    bool hit = result && !cell_is_error(result) &&
+               !(cell_is_bool(result) && !cell_get_bool(result)) && !cell_is_nil(result);
+    if (result) cell_release(result);
+    return hit;
+}
+
+/* ←?⊙ - selective receive
+ * (←?⊙ pattern) — oldest message matching pattern (predicate or tag).
+ * Saved messages are scanned first; mailbox messages that do not match
+ * move to the save queue in arrival order, so later receives still see
+ * them oldest-first. Yields until a matching message arrives. */
+Cell* prim_receive_match(Cell* args) {
+    Cell* pattern = arg1(args);
+
+    Actor* actor = actor_current();
+    if (!actor) {
+        return cell_error("receive-no-actor", cell_nil());
+    }
+    EvalContext* ctx = eval_get_current_context();
+
+    for (uint32_t i = 0; i < actor->save_len; i++) {
+        Cell* saved = actor->save_queue[(actor->save_head + i) & (actor->save_cap - 1)];
+        if (receive_matches(ctx, pattern, saved)) {
+            return actor_save_remove(actor, i);
+        }
+    }
+
+    Fiber* fiber = actor->fiber;
+    for (;;) {
+        Cell* msg;
+        while ((msg = actor_mailbox_take(actor)) != NULL) {
+            if (receive_matches(ctx, pattern, msg)) return msg;
+            actor_save(actor, msg);
+        }
+        if (!fiber) return cell_nil();
+
+        /* Same 2-phase suspend as ←?; the scheduler resumes with the next
+         * mailbox message, never one from the save queue. */
+        fiber->suspend_reason = SUSPEND_MAILBOX;
+        atomic_store_explicit(&actor->wait_flag, 1, memory_order_release);
+        msg = actor_mailbox_take(actor);
+        if (msg) {
+            atomic_store_explicit(&actor->wait_flag, 0, memory_order_relaxed);
+            fiber->suspend_reason = 0;
+        } else {
+            fiber_yield(fiber);
+            msg = fiber->resume_value;
+            if (!msg || cell_is_nil(msg)) continue;
+            cell_retain(msg);
+        }
+        if (receive_matches(ctx, pattern, msg)) return msg;
+        actor_save(actor, msg);
+    }
+}
+
+/* ←?# - number of messages waiting in the save queue */
+Cell* prim_receive_saved(Cell* args) {
+    (void)args;
+    Actor* actor = actor_current();
+    if (!actor) {
+        return cell_error("receive-no-actor", cell_nil());
+    }
+    return cell_number((double)actor->save_len);
+}
+
 /* ⟳! - run scheduler
  * (⟳! max-ticks) — run cooperative round-robin scheduler */
 Cell* prim_actor_run(Cell* args) {
@@ -3520,7 +3706,9 @@ Cell* prim_actor_link(Cell* args) {
         /* Normal exit, no trap → do nothing (don't kill) */
         return cell_nil();
     }
-    actor_link(current, other);
+    if (!actor_link(current, other)) {
+        return cell_error("link-out-of-memory", target);
+    }
     return cell_nil();
 }
 
@@ -3562,7 +3750,11 @@ Cell* prim_actor_monitor(Cell* args) {
     /* Atomically add monitor under stripe lock. If target is already dead
      * (or dies between our check and the lock), actor_add_monitor returns false
      * and we send :DOWN immediately. This closes the TOCTOU race. */
-    if (!actor_add_monitor(other, current)) {
+    MonitorResult added = actor_add_monitor(other, current);
+    if (added == MONITOR_NO_MEMORY) {
+        return cell_error("monitor-out-of-memory", target);
+    }
+    if (added == MONITOR_TARGET_DEAD) {
         /* Target already dead — immediately send :DOWN */
         Cell* reason = other->result && other->result->type == CELL_ERROR
             ? other->result : cell_symbol(":normal");
@@ -4052,9 +4244,17 @@ Cell* prim_call(Cell* args) {
         return cell_error("call-dead-actor", target_cell);
     }
 
-    /* Build message: ⟨:call caller-id request⟩ */
+    /* Build message: ⟨:call caller-id request⟩. The caller handle carries a
+     * fresh ref, so the reply lands in the caller's reply slot instead of
+     * the mailbox and is found in O(1) however deep the mailbox is. */
+    uint32_t ref = ++caller->call_seq;
+    if (ref == 0) ref = ++caller->call_seq;
+    atomic_store_explicit(&caller->call_reply, NULL, memory_order_relaxed);
+    atomic_store_explicit(&caller->call_ref, ref, memory_order_release);
+
     Cell* tag = cell_symbol(":call");
     Cell* caller_cell = cell_actor(caller->id);
+    caller_cell->data.actor.call_ref = ref;
     Cell* inner = cell_cons(request, cell_nil());
     Cell* mid = cell_cons(caller_cell, inner);
     Cell* msg = cell_cons(tag, mid);
@@ -4065,16 +4265,22 @@ Cell* prim_call(Cell* args) {
     actor_send(target, msg);
     cell_release(msg);
 
-    /* Now yield to wait for reply (same as ←?) */
+    /* Wait on the reply slot with the same 2-phase suspend as ←? */
     Fiber* fiber = caller->fiber;
-    Cell* reply = actor_receive(caller);
+    Cell* reply = atomic_exchange_explicit(&caller->call_reply, NULL, memory_order_acq_rel);
     if (reply) {
         return reply;
     }
 
     if (fiber) {
-        fiber->suspend_reason = SUSPEND_MAILBOX;
+        fiber->suspend_reason = SUSPEND_CALL;
         atomic_store_explicit(&caller->wait_flag, 1, memory_order_release);
+        reply = atomic_exchange_explicit(&caller->call_reply, NULL, memory_order_acq_rel);
+        if (reply) {
+            atomic_store_explicit(&caller->wait_flag, 0, memory_order_relaxed);
+            fiber->suspend_reason = 0;
+            return reply;
+        }
         fiber_yield(fiber);
         Cell* resumed = fiber->resume_value;
         if (resumed) {
@@ -4083,6 +4289,7 @@ Cell* prim_call(Cell* args) {
         }
     }
 
+    atomic_store_explicit(&caller->call_ref, 0, memory_order_release);
     return cell_nil();
 }
 
@@ -4102,7 +4309,9 @@ Cell* prim_reply(Cell* args) {
         return cell_error("reply-dead-actor", caller_cell);
     }
 
-    actor_send(caller, response);
+    if (!actor_deliver_reply(caller, caller_cell->data.actor.call_ref, response)) {
+        actor_send(caller, response);
+    }
     return cell_nil();
 }
 
@@ -4178,6 +4387,12 @@ Cell* prim_timer_active(Cell* args) {
 
 /* ============ Process Dictionary Primitives ============ */
 
+/* The actor's dictionary, or NULL if it has never put a key */
+static Cell* proc_dict_of(Actor* actor) {
+    ActorCold* cold = atomic_load_explicit(&actor->cold, memory_order_acquire);
+    return cold ? cold->dict : NULL;
+}
+
 /* ⟳⊔⊕ - put key-value in current actor's dictionary
  * (⟳⊔⊕ key value) → old-value or ∅ */
 Cell* prim_proc_dict_put(Cell* args) {
@@ -4195,27 +4410,15 @@ Cell* prim_proc_dict_put(Cell* args) {
     }
     Cell* value = cell_car(rest);
 
-    /* Search for existing key */
-    for (int i = 0; i < actor->dict_count; i++) {
-        if (cell_equal(actor->dict_keys[i], key)) {
-            Cell* old = actor->dict_values[i];
-            cell_retain(value);
-            actor->dict_values[i] = value;
-            /* old already has a ref from the dict, return it to caller */
-            return old;
-        }
+    ActorCold* cold = actor_cold(actor);
+    if (!cold) {
+        return cell_error("proc-dict-out-of-memory", key);
     }
-
-    /* New entry */
-    if (actor->dict_count >= MAX_DICT_ENTRIES) {
-        return cell_error("proc-dict-full", cell_nil());
+    if (!cold->dict) {
+        cold->dict = cell_hashmap_new(16);
     }
-    cell_retain(key);
-    cell_retain(value);
-    actor->dict_keys[actor->dict_count] = key;
-    actor->dict_values[actor->dict_count] = value;
-    actor->dict_count++;
-    return cell_nil();
+    /* Returns the old value (ref transferred to caller) or ∅ */
+    return cell_hashmap_put(cold->dict, key, value);
 }
 
 /* ⟳⊔? - get value from current actor's dictionary
@@ -4230,14 +4433,9 @@ Cell* prim_proc_dict_get(Cell* args) {
     }
     Cell* key = cell_car(args);
 
-    for (int i = 0; i < actor->dict_count; i++) {
-        if (cell_equal(actor->dict_keys[i], key)) {
-            Cell* val = actor->dict_values[i];
-            cell_retain(val);
-            return val;
-        }
-    }
-    return cell_nil();
+    Cell* dict = proc_dict_of(actor);
+    if (!dict) return cell_nil();
+    return cell_hashmap_get(dict, key);
 }
 
 /* ⟳⊔⊖ - erase key from current actor's dictionary
@@ -4252,21 +4450,10 @@ Cell* prim_proc_dict_erase(Cell* args) {
     }
     Cell* key = cell_car(args);
 
-    for (int i = 0; i < actor->dict_count; i++) {
-        if (cell_equal(actor->dict_keys[i], key)) {
-            Cell* old_val = actor->dict_values[i];
-            cell_release(actor->dict_keys[i]);
-            /* Move last entry into this slot */
-            actor->dict_count--;
-            if (i < actor->dict_count) {
-                actor->dict_keys[i] = actor->dict_keys[actor->dict_count];
-                actor->dict_values[i] = actor->dict_values[actor->dict_count];
-            }
-            /* old_val already has ref from dict, return to caller */
-            return old_val;
-        }
-    }
-    return cell_nil();
+    Cell* dict = proc_dict_of(actor);
+    if (!dict) return cell_nil();
+    /* Old value's ref moves from the dict to the caller */
+    return cell_hashmap_delete(dict, key);
 }
 
 /* ⟳⊔* - get all entries from current actor's dictionary
@@ -4278,15 +4465,9 @@ Cell* prim_proc_dict_all(Cell* args) {
         return cell_error("not-in-actor", cell_nil());
     }
 
-    Cell* list = cell_nil();
-    for (int i = actor->dict_count - 1; i >= 0; i--) {
-        Cell* pair = cell_cons(actor->dict_keys[i], actor->dict_values[i]);
-        Cell* new_list = cell_cons(pair, list);
-        cell_release(pair);
-        cell_release(list);
-        list = new_list;
-    }
-    return list;
+    Cell* dict = proc_dict_of(actor);
+    if (!dict) return cell_nil();
+    return cell_hashmap_entries(dict);
 }
 
 /* ============ ETS Primitives ============ */
@@ -5793,6 +5974,42 @@ Cell* prim_struct_define_leaf(Cell* args) {
     return type_tag;
 }
 
+/* Slot of a field in a slotted struct. The application site running this
+ * builtin remembers the slot it resolved last; the hint is checked against
+ * the struct's layout, so a site that sees several types stays correct. */
+static int struct_site_slot(Cell* st, Cell* field_name) {
+    Cell* site = tls_apply_site;
+    int hint = site ? __atomic_load_n(&site->data.pair.site_slot, __ATOMIC_RELAXED) : -1;
+    int slot = cell_struct_slot_of(st, field_name, hint);
+    if (site && slot >= 0 && slot != hint)
+        __atomic_store_n(&site->data.pair.site_slot, (uint16_t)slot, __ATOMIC_RELAXED);
+    return slot;
+}
+
+/* Slotted instance from the argument list, or an error on arity mismatch */
+static Cell* struct_create_slotted(const char* who, StructKind kind, Cell* type_tag,
+                                   Cell* variant, Cell* layout, Cell* rest) {
+    uint16_t n = cell_struct_layout_size(layout);
+    Cell* small[8];
+    Cell** values = n <= 8 ? small : (Cell**)malloc(n * sizeof(Cell*));
+    uint16_t i = 0;
+    for (; i < n && cell_is_pair(rest); i++, rest = cell_cdr(rest))
+        values[i] = cell_car(rest);
+    Cell* result;
+    char msg[64];
+    if (i < n) {
+        snprintf(msg, sizeof msg, "%s not enough field values", who);
+        result = cell_error(msg, type_tag);
+    } else if (cell_is_pair(rest)) {
+        snprintf(msg, sizeof msg, "%s too many field values", who);
+        result = cell_error(msg, type_tag);
+    } else {
+        result = cell_struct_slotted(kind, type_tag, variant, layout, values);
+    }
+    if (values != small) free(values);
+    return result;
+}
+
 /* ⊙ - Create leaf structure instance
  * Args: type_tag followed by field values
  * Example: (⊙ :Point #3 #4)
@@ -5808,8 +6025,17 @@ Cell* prim_struct_create(Cell* args) {
         return cell_error("struct-create type tag must be a symbol", type_tag);
     }
 
-    /* Lookup type schema */
+    /* Fixed slot layout when the type was defined as a leaf */
     EvalContext* ctx = eval_get_current_context();
+    Cell* layout = eval_lookup_layout(ctx, type_tag, NULL);
+    if (layout) {
+        Cell* result = struct_create_slotted("struct-create", STRUCT_LEAF, type_tag, NULL,
+                                             layout, cell_cdr(args));
+        cell_release(layout);
+        return result;
+    }
+
+    /* Lookup type schema */
     Cell* schema = eval_lookup_type(ctx, type_tag);
     if (!schema) {
         return cell_error("struct-create undefined type", type_tag);
@@ -5898,12 +6124,18 @@ Cell* prim_struct_get_field(Cell* args) {
         return cell_error("struct-get field name must be symbol", field_name);
     }
 
-    /* Use existing accessor */
-    Cell* value = cell_struct_get_field(structure, field_name);
+    Cell* value;
+    if (cell_struct_layout(structure)) {
+        int slot = struct_site_slot(structure, field_name);
+        value = slot < 0 ? NULL : cell_struct_slot(structure, slot);
+    } else {
+        value = cell_struct_get_field(structure, field_name);
+    }
     if (!value) {
         return cell_error("struct-get field not found", field_name);
     }
 
+    cell_retain(value);
     return value;
 }
 
@@ -5939,6 +6171,14 @@ Cell* prim_struct_update_field(Cell* args) {
 
     Cell* new_value = cell_car(rest2);
 
+    if (cell_struct_layout(structure)) {
+        int slot = struct_site_slot(structure, field_name);
+        if (slot < 0) {
+            return cell_error("struct-set field not found", field_name);
+        }
+        return cell_struct_with_slot(structure, slot, new_value);
+    }
+
     /* Build new field list with updated value */
     Cell* old_fields = cell_struct_fields(structure);
     Cell* new_fields = cell_nil();
@@ -6144,8 +6384,17 @@ Cell* prim_struct_create_node(Cell* args) {
         return cell_error("adt-create variant tag must be a symbol", variant_tag);
     }
 
-    /* Lookup type schema */
+    /* Fixed slot layout of the variant */
     EvalContext* ctx = eval_get_current_context();
+    Cell* layout = eval_lookup_layout(ctx, type_tag, variant_tag);
+    if (layout) {
+        Cell* result = struct_create_slotted("adt-create", STRUCT_NODE, type_tag, variant_tag,
+                                             layout, cell_cdr(cell_cdr(args)));
+        cell_release(layout);
+        return result;
+    }
+
+    /* Lookup type schema */
     Cell* schema = eval_lookup_type(ctx, type_tag);
     if (!schema) {
         return cell_error("adt-create undefined type", type_tag);
@@ -6253,11 +6502,18 @@ Cell* prim_struct_get_node(Cell* args) {
         return cell_error("adt-get field name must be symbol", field_name);
     }
 
-    Cell* value = cell_struct_get_field(st, field_name);
+    Cell* value;
+    if (cell_struct_layout(st)) {
+        int slot = struct_site_slot(st, field_name);
+        value = slot < 0 ? NULL : cell_struct_slot(st, slot);
+    } else {
+        value = cell_struct_get_field(st, field_name);
+    }
     if (!value) {
         return cell_error("adt-get field not found", field_name);
     }
 
+    cell_retain(value);
     return value;
 }
 
@@ -6598,133 +6854,13 @@ Cell* prim_graph_traverse(Cell* args) {
         return cell_error("graph-traverse mode must be :bfs or :dfs", mode);
     }
 
-    /* Check if start node exists in graph */
-    Cell* nodes = cell_graph_nodes(graph);
-    bool start_exists = false;
-    Cell* node_iter = nodes;
-    while (cell_is_pair(node_iter)) {
-        if (cell_equal(cell_car(node_iter), start)) {
-            start_exists = true;
-            break;
-        }
-        node_iter = cell_cdr(node_iter);
-    }
-    if (!start_exists) {
-        return cell_nil();  /* Node not in graph, return empty list */
-    }
-
-    /* Get graph edges */
-    Cell* edges = cell_graph_edges(graph);
-
-    /* Build adjacency list: node -> list of successors */
-    /* Use a simple association list */
-    Cell* adj_list = cell_nil();
-
-    Cell* edge_iter = edges;
-    while (cell_is_pair(edge_iter)) {
-        Cell* edge = cell_car(edge_iter);
-        /* Edge format: ⟨from ⟨to ⟨label ∅⟩⟩⟩ */
-        if (cell_is_pair(edge)) {
-            Cell* from = cell_car(edge);
-            Cell* rest = cell_cdr(edge);
-            if (cell_is_pair(rest)) {
-                Cell* to = cell_car(rest);
-
-                /* Find or create entry for 'from' in adj_list */
-                Cell* entry = cell_nil();
-                Cell* adj_iter = adj_list;
-                bool found = false;
-
-                while (cell_is_pair(adj_iter)) {
-                    Cell* pair = cell_car(adj_iter);
-                    Cell* key = cell_car(pair);
-
-                    /* Compare nodes using deep equality */
-                    if (cell_equal(key, from)) {
-                        entry = pair;
-                        found = true;
-                        break;
-                    }
-                    adj_iter = cell_cdr(adj_iter);
-                }
-
-                if (found) {
-                    /* Add 'to' to existing successors list */
-                    Cell* successors = cell_cdr(entry);
-                    cell_retain(to);
-                    Cell* new_successors = cell_cons(to, successors);
-                    /* Update the entry (immutable, rebuild adj_list) */
-                    cell_retain(from);
-                    Cell* new_entry = cell_cons(from, new_successors);
-
-                    /* Replace old entry in adj_list */
-                    Cell* new_adj = cell_nil();
-                    adj_iter = adj_list;
-                    while (cell_is_pair(adj_iter)) {
-                        Cell* pair = cell_car(adj_iter);
-                        Cell* key = cell_car(pair);
-                        if (cell_equal(key, from)) {
-                            cell_retain(new_entry);
-                            new_adj = cell_cons(new_entry, new_adj);
-                        } else {
-                            cell_retain(pair);
-                            new_adj = cell_cons(pair, new_adj);
-                        }
-                        adj_iter = cell_cdr(adj_iter);
-                    }
-                    cell_release(adj_list);
-                    adj_list = new_adj;
-                } else {
-                    /* Create new entry */
-                    cell_retain(to);
-                    Cell* successors = cell_cons(to, cell_nil());
-                    cell_retain(from);
-                    Cell* new_entry = cell_cons(from, successors);
-                    adj_list = cell_cons(new_entry, adj_list);
-                }
-            }
-        }
-        edge_iter = cell_cdr(edge_iter);
-    }
-
-    /* Perform traversal */
-    Cell* visited = cell_nil();  /* List of visited nodes */
-    Cell* queue = cell_cons(start, cell_nil());  /* Queue/stack for traversal */
-    Cell* visited_set = cell_nil();  /* Set of visited nodes (for cycle detection) */
-
-    while (cell_is_pair(queue)) {
-        /* Pop from queue/stack (retain current, release old queue head) */
-        Cell* current = cell_car(queue);
-        cell_retain(current);
-        Cell* old_queue = queue;
-        queue = cell_cdr(queue);
-        cell_retain(queue);
-        cell_release(old_queue);
-
-        /* Check if already visited */
-        bool already_visited = false;
-        Cell* vs_iter = visited_set;
-        while (cell_is_pair(vs_iter)) {
-            if (cell_equal(cell_car(vs_iter), current)) {
-                already_visited = true;
-                break;
-            }
-            vs_iter = cell_cdr(vs_iter);
-        }
-
-        if (already_visited) {
-            cell_release(current);
-            continue;
-        }
-
-        /* Mark as visited (cons will retain current) */
-        Cell* old_visited_set = visited_set;
-        visited_set = cell_cons(current, visited_set);
-        cell_release(old_visited_set);
-
-        /* Apply visitor function */
-        EvalContext* ctx = eval_get_current_context();
-        Cell* visitor_arg = cell_cons(current, cell_nil());
+    /* The visit order depends on the graph alone: take it from the
+     * adjacency index first, then run the visitor over it */
+    Cell* order = cell_graph_walk(graph, start, is_dfs);
+    EvalContext* ctx = eval_get_current_context();
+    Cell* visited = cell_nil();
+    for (Cell* node_iter = order; cell_is_pair(node_iter); node_iter = cell_cdr(node_iter)) {
+        Cell* visitor_arg = cell_cons(cell_car(node_iter), cell_nil());
         Cell* visitor_env = extend_env(visitor->data.lambda.env, visitor_arg);
         Cell* result = eval_internal(ctx, visitor_env, visitor->data.lambda.body);
         cell_release(visitor_arg);
@@ -6734,64 +6870,22 @@ Cell* prim_graph_traverse(Cell* args) {
         Cell* old_visited = visited;
         visited = cell_cons(result, visited);
         cell_release(old_visited);
-
-        /* Add successors to queue */
-        Cell* adj_iter = adj_list;
-        while (cell_is_pair(adj_iter)) {
-            Cell* pair = cell_car(adj_iter);
-            Cell* key = cell_car(pair);
-
-            if (cell_equal(key, current)) {
-                Cell* successors = cell_cdr(pair);
-                Cell* succ_iter = successors;
-
-                while (cell_is_pair(succ_iter)) {
-                    Cell* succ = cell_car(succ_iter);
-
-                    /* Check if successor already in visited_set */
-                    bool succ_visited = false;
-                    Cell* vs_iter2 = visited_set;
-                    while (cell_is_pair(vs_iter2)) {
-                        if (cell_equal(cell_car(vs_iter2), succ)) {
-                            succ_visited = true;
-                            break;
-                        }
-                        vs_iter2 = cell_cdr(vs_iter2);
-                    }
-
-                    if (!succ_visited) {
-                        /* Add to queue (cons will retain succ) */
-                        Cell* old_q = queue;
-                        queue = cell_cons(succ, queue);
-                        cell_release(old_q);
-                    }
-
-                    succ_iter = cell_cdr(succ_iter);
-                }
-                break;
-            }
-            adj_iter = cell_cdr(adj_iter);
-        }
-
-        cell_release(current);
+        cell_release(result);
     }
-
-    /* Cleanup */
-    cell_release(adj_list);
-    cell_release(queue);
-    cell_release(visited_set);
-    /* Note: edges is a borrowed reference from the graph, don't release */
+    cell_release(order);
 
     /* Reverse visited list to get correct order */
     Cell* result = cell_nil();
     while (cell_is_pair(visited)) {
-        Cell* node = cell_car(visited);
-        cell_retain(node);
-        result = cell_cons(node, result);
+        Cell* next_result = cell_cons(cell_car(visited), result);
+        cell_release(result);
+        result = next_result;
         Cell* next = cell_cdr(visited);
+        cell_retain(next);
         cell_release(visited);
         visited = next;
     }
+    cell_release(visited);
 
     return result;
 }
@@ -6810,79 +6904,7 @@ Cell* prim_graph_reachable(Cell* args) {
         return cell_error("graph-reachable? first arg must be graph", graph);
     }
 
-    /* Use BFS to check reachability */
-    Cell* queue = cell_cons(from, cell_nil());
-    Cell* visited = cell_nil();
-    Cell* edges = cell_graph_edges(graph);
-    bool found = false;
-
-    while (cell_is_pair(queue) && !found) {
-        /* Pop from queue (retain current, release old queue head) */
-        Cell* current = cell_car(queue);
-        cell_retain(current);
-        Cell* old_queue = queue;
-        queue = cell_cdr(queue);
-        cell_retain(queue);
-        cell_release(old_queue);
-
-        /* Check if we've reached the target */
-        if (cell_equal(current, to)) {
-            found = true;
-            cell_release(current);
-            break;
-        }
-
-        /* Check if already visited */
-        bool already_visited = false;
-        Cell* v_iter = visited;
-        while (cell_is_pair(v_iter)) {
-            if (cell_equal(cell_car(v_iter), current)) {
-                already_visited = true;
-                break;
-            }
-            v_iter = cell_cdr(v_iter);
-        }
-
-        if (already_visited) {
-            cell_release(current);
-            continue;
-        }
-
-        /* Mark as visited (cons will retain current) */
-        Cell* old_visited = visited;
-        visited = cell_cons(current, visited);
-        cell_release(old_visited);
-
-        /* Add successors to queue */
-        Cell* edge_iter = edges;
-        while (cell_is_pair(edge_iter)) {
-            Cell* edge = cell_car(edge_iter);
-            if (cell_is_pair(edge)) {
-                Cell* edge_from = cell_car(edge);
-                Cell* rest = cell_cdr(edge);
-                if (cell_is_pair(rest)) {
-                    Cell* edge_to = cell_car(rest);
-
-                    if (cell_equal(edge_from, current)) {
-                        /* Add to queue (cons will retain edge_to) */
-                        Cell* old_q = queue;
-                        queue = cell_cons(edge_to, queue);
-                        cell_release(old_q);
-                    }
-                }
-            }
-            edge_iter = cell_cdr(edge_iter);
-        }
-
-        cell_release(current);
-    }
-
-    /* Cleanup */
-    cell_release(queue);
-    cell_release(visited);
-    /* Note: edges is a borrowed reference from the graph, don't release */
-
-    return cell_bool(found);
+    return cell_bool(cell_graph_reachable(graph, from, to));
 }
 
 /* ⊝⊚ - Get successors of a node
@@ -6898,32 +6920,7 @@ Cell* prim_graph_successors(Cell* args) {
         return cell_error("graph-successors first arg must be graph", graph);
     }
 
-    Cell* edges = cell_graph_edges(graph);
-    Cell* result = cell_nil();
-
-    /* Find all edges from 'node' */
-    Cell* edge_iter = edges;
-    while (cell_is_pair(edge_iter)) {
-        Cell* edge = cell_car(edge_iter);
-        if (cell_is_pair(edge)) {
-            Cell* from = cell_car(edge);
-            Cell* rest = cell_cdr(edge);
-            if (cell_is_pair(rest)) {
-                Cell* to = cell_car(rest);
-
-                if (cell_equal(from, node)) {
-                    /* Add to result (cons will retain to) */
-                    Cell* old_result = result;
-                    result = cell_cons(to, old_result);
-                    cell_release(old_result);
-                }
-            }
-        }
-        edge_iter = cell_cdr(edge_iter);
-    }
-
-    /* Note: edges is a borrowed reference from the graph, don't release */
-    return result;
+    return cell_graph_successors(graph, node);
 }
 
 /* ⊝⊙ - Get predecessors of a node
@@ -6939,32 +6936,7 @@ Cell* prim_graph_predecessors(Cell* args) {
         return cell_error("graph-predecessors first arg must be graph", graph);
     }
 
-    Cell* edges = cell_graph_edges(graph);
-    Cell* result = cell_nil();
-
-    /* Find all edges to 'node' */
-    Cell* edge_iter = edges;
-    while (cell_is_pair(edge_iter)) {
-        Cell* edge = cell_car(edge_iter);
-        if (cell_is_pair(edge)) {
-            Cell* from = cell_car(edge);
-            Cell* rest = cell_cdr(edge);
-            if (cell_is_pair(rest)) {
-                Cell* to = cell_car(rest);
-
-                if (cell_equal(to, node)) {
-                    /* Add to result (cons will retain from) */
-                    Cell* old_result = result;
-                    result = cell_cons(from, old_result);
-                    cell_release(old_result);
-                }
-            }
-        }
-        edge_iter = cell_cdr(edge_iter);
-    }
-
-    /* Note: edges is a borrowed reference from the graph, don't release */
-    return result;
+    return cell_graph_predecessors(graph, node);
 }
 
 /* ⊝⇝ - Find path from from_node to to_node
@@ -6981,143 +6953,8 @@ Cell* prim_graph_path(Cell* args) {
         return cell_error("graph-path first arg must be graph", graph);
     }
 
-    /* BFS with parent tracking */
-    Cell* queue = cell_cons(from, cell_nil());
-    Cell* visited = cell_nil();
-    Cell* parents = cell_nil();  /* Association list: node -> parent */
-    Cell* edges = cell_graph_edges(graph);
-    bool found = false;
-
-    while (cell_is_pair(queue) && !found) {
-        /* Pop from queue (retain current, release old queue head) */
-        Cell* current = cell_car(queue);
-        cell_retain(current);
-        Cell* old_queue = queue;
-        queue = cell_cdr(queue);
-        cell_retain(queue);
-        cell_release(old_queue);
-
-        /* Check if we've reached the target */
-        if (cell_equal(current, to)) {
-            found = true;
-            /* Don't release current yet - need it for path reconstruction */
-            break;
-        }
-
-        /* Check if already visited */
-        bool already_visited = false;
-        Cell* v_iter = visited;
-        while (cell_is_pair(v_iter)) {
-            if (cell_equal(cell_car(v_iter), current)) {
-                already_visited = true;
-                break;
-            }
-            v_iter = cell_cdr(v_iter);
-        }
-
-        if (already_visited) {
-            cell_release(current);
-            continue;
-        }
-
-        /* Mark as visited (cons will retain current) */
-        Cell* old_visited = visited;
-        visited = cell_cons(current, visited);
-        cell_release(old_visited);
-
-        /* Add successors to queue */
-        Cell* edge_iter = edges;
-        while (cell_is_pair(edge_iter)) {
-            Cell* edge = cell_car(edge_iter);
-            if (cell_is_pair(edge)) {
-                Cell* edge_from = cell_car(edge);
-                Cell* rest = cell_cdr(edge);
-                if (cell_is_pair(rest)) {
-                    Cell* edge_to = cell_car(rest);
-
-                    if (cell_equal(edge_from, current)) {
-                        /* Check if successor already visited */
-                        bool succ_visited = false;
-                        Cell* v_iter2 = visited;
-                        while (cell_is_pair(v_iter2)) {
-                            if (cell_equal(cell_car(v_iter2), edge_to)) {
-                                succ_visited = true;
-                                break;
-                            }
-                            v_iter2 = cell_cdr(v_iter2);
-                        }
-
-                        if (!succ_visited) {
-                            /* Record parent relationship (cons will retain both) */
-                            Cell* parent_entry = cell_cons(edge_to, current);
-                            Cell* old_parents = parents;
-                            parents = cell_cons(parent_entry, parents);
-                            cell_release(old_parents);
-
-                            /* Add to queue (cons will retain edge_to) */
-                            Cell* old_q = queue;
-                            queue = cell_cons(edge_to, queue);
-                            cell_release(old_q);
-                        }
-                    }
-                }
-            }
-            edge_iter = cell_cdr(edge_iter);
-        }
-
-        cell_release(current);
-    }
-
-    /* Reconstruct path if found */
-    Cell* result;
-    if (found) {
-        result = cell_nil();
-        Cell* current_node = to;
-        cell_retain(current_node);
-
-        /* Build path from end to start */
-        result = cell_cons(current_node, result);
-
-        while (!cell_equal(current_node, from)) {
-            /* Find parent of current_node */
-            Cell* parent = NULL;
-            Cell* p_iter = parents;
-            while (cell_is_pair(p_iter)) {
-                Cell* entry = cell_car(p_iter);
-                Cell* child = cell_car(entry);
-                if (cell_equal(child, current_node)) {
-                    parent = cell_cdr(entry);
-                    break;
-                }
-                p_iter = cell_cdr(p_iter);
-            }
-
-            if (parent) {
-                cell_retain(parent);
-                result = cell_cons(parent, result);
-                cell_release(current_node);
-                current_node = parent;
-            } else {
-                /* Path broken - should not happen if found==true */
-                cell_release(current_node);
-                cell_release(result);
-                result = cell_nil();
-                break;
-            }
-        }
-
-        cell_release(current_node);
-    } else {
-        result = cell_nil();
-    }
-
-    /* Cleanup */
-    cell_release(queue);
-    cell_release(visited);
-    cell_release(parents);
-    /* Note: edges is a borrowed reference from the graph, don't release */
-
-    return result;
+    /* BFS over the adjacency index: fewest edges */
+    return cell_graph_path(graph, from, to);
 }
 
 /* ⊝∘ - Detect cycles in graph
@@ -7132,162 +6969,43 @@ Cell* prim_graph_cycles(Cell* args) {
         return cell_error("graph-cycles first arg must be graph", graph);
     }
 
-    Cell* nodes = cell_graph_nodes(graph);
-    Cell* edges = cell_graph_edges(graph);
-    Cell* cycles = cell_nil();
-
-    /* Use DFS with colors: white (unvisited), gray (visiting), black (visited) */
-    Cell* white = nodes;  /* All nodes start as white */
-    Cell* gray = cell_nil();
-    Cell* black = cell_nil();
-    Cell* stack = cell_nil();  /* DFS stack */
+    return cell_graph_cycles(graph);
+}
 
-    /* Start DFS from each unvisited node */
-    Cell* node_iter = white;
-    while (cell_is_pair(node_iter)) {
-        Cell* start = cell_car(node_iter);
+/* ⊝≺ - Topological order of every node the graph mentions
+ * Args: graph
+ * Example: (⊝≺ deps)
+ * Returns: list of nodes, or error if the graph has a cycle
+ */
+Cell* prim_graph_topo_sort(Cell* args) {
+    Cell* graph = arg1(args);
 
-        /* Check if start is already black */
-        bool is_black = false;
-        Cell* b_iter = black;
-        while (cell_is_pair(b_iter)) {
-            if (cell_equal(cell_car(b_iter), start)) {
-                is_black = true;
-                break;
-            }
-            b_iter = cell_cdr(b_iter);
-        }
-
-        if (!is_black) {
-            /* DFS from start */
-            Cell* old_stack = stack;
-            stack = cell_cons(start, old_stack);
-            cell_release(old_stack);
-
-            Cell* old_gray = gray;
-            gray = cell_cons(start, old_gray);
-            cell_release(old_gray);
-
-            while (cell_is_pair(stack)) {
-                Cell* current = cell_car(stack);
-                bool has_unvisited_successor = false;
-
-                /* Check successors */
-                Cell* edge_iter = edges;
-                while (cell_is_pair(edge_iter)) {
-                    Cell* edge = cell_car(edge_iter);
-                    if (cell_is_pair(edge)) {
-                        Cell* from = cell_car(edge);
-                        Cell* rest = cell_cdr(edge);
-                        if (cell_is_pair(rest)) {
-                            Cell* to = cell_car(rest);
-
-                            if (cell_equal(from, current)) {
-                                /* Check if 'to' is gray (back edge - cycle detected) */
-                                bool is_gray = false;
-                                Cell* g_iter = gray;
-                                while (cell_is_pair(g_iter)) {
-                                    if (cell_equal(cell_car(g_iter), to)) {
-                                        is_gray = true;
-                                        break;
-                                    }
-                                    g_iter = cell_cdr(g_iter);
-                                }
-
-                                if (is_gray) {
-                                    /* Cycle detected! Record it */
-                                    Cell* cycle = cell_nil();
-                                    cycle = cell_cons(to, cycle);
-                                    Cell* old_cycle = cycle;
-                                    cycle = cell_cons(current, old_cycle);
-                                    cell_release(old_cycle);
-
-                                    Cell* old_cycles = cycles;
-                                    cycles = cell_cons(cycle, old_cycles);
-                                    cell_release(old_cycles);
-                                }
-
-                                /* Check if 'to' is white (unvisited) */
-                                bool is_white = true;
-                                g_iter = gray;
-                                while (cell_is_pair(g_iter)) {
-                                    if (cell_equal(cell_car(g_iter), to)) {
-                                        is_white = false;
-                                        break;
-                                    }
-                                    g_iter = cell_cdr(g_iter);
-                                }
-                                Cell* b_iter2 = black;
-                                while (cell_is_pair(b_iter2)) {
-                                    if (cell_equal(cell_car(b_iter2), to)) {
-                                        is_white = false;
-                                        break;
-                                    }
-                                    b_iter2 = cell_cdr(b_iter2);
-                                }
-
-                                if (is_white) {
-                                    /* Visit this successor */
-                                    Cell* old_stk = stack;
-                                    stack = cell_cons(to, old_stk);
-                                    cell_release(old_stk);
-
-                                    Cell* old_gry = gray;
-                                    gray = cell_cons(to, old_gry);
-                                    cell_release(old_gry);
-
-                                    has_unvisited_successor = true;
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                    edge_iter = cell_cdr(edge_iter);
-                }
+    if (!cell_is_graph(graph)) {
+        return cell_error("graph-topo-sort first arg must be graph", graph);
+    }
 
-                if (!has_unvisited_successor) {
-                    /* Finished with current node - mark as black */
-                    Cell* popped = cell_car(stack);
-                    cell_retain(popped);
-
-                    Cell* old_stack = stack;
-                    stack = cell_cdr(stack);
-                    cell_retain(stack);
-                    cell_release(old_stack);
-
-                    /* Move from gray to black */
-                    Cell* new_gray = cell_nil();
-                    Cell* g_iter = gray;
-                    while (cell_is_pair(g_iter)) {
-                        Cell* node = cell_car(g_iter);
-                        if (!cell_equal(node, popped)) {
-                            Cell* old_new_gray = new_gray;
-                            new_gray = cell_cons(node, old_new_gray);
-                            cell_release(old_new_gray);
-                        }
-                        g_iter = cell_cdr(g_iter);
-                    }
-                    cell_release(gray);
-                    gray = new_gray;
+    Cell* order = cell_graph_topo_sort(graph);
+    if (!order) {
+        return cell_error("graph-topo-sort graph has a cycle", graph);
+    }
+    return order;
+}
 
-                    Cell* old_black = black;
-                    black = cell_cons(popped, old_black);
-                    cell_release(old_black);
-                    cell_release(popped);
-                }
-            }
-        }
+/* ⊝⇝* - Least-cost path, edge labels as weights (non-numeric labels weigh 1)
+ * Args: graph from_node to_node
+ * Example: (⊝⇝* roads :a :b)
+ * Returns: (cost . path), ∅ if no path, error on a negative weight
+ */
+Cell* prim_graph_shortest_path(Cell* args) {
+    Cell* graph = arg1(args);
+    Cell* from = arg2(args);
+    Cell* to = arg3(args);
 
-        node_iter = cell_cdr(node_iter);
+    if (!cell_is_graph(graph)) {
+        return cell_error("graph-shortest-path first arg must be graph", graph);
     }
 
-    /* Cleanup */
-    /* Note: nodes and edges are borrowed references from the graph, don't release */
-    cell_release(stack);
-    cell_release(gray);
-    cell_release(black);
-
-    return cycles;
+    return cell_graph_shortest(graph, from, to);
 }
 
 /* String Operations */
@@ -8343,6 +8061,337 @@ Cell* prim_file_empty(Cell* args) {
 extern Cell* parse(const char* input);
 extern Cell* parse_next(const char* input, int* pos, uint32_t file_base);
 
+/* ── Module prefetch: parse a load's static dependencies in parallel ──
+ *
+ * Before evaluating a file, load follows its literal (load "path") forms
+ * transitively and parses every file it finds, one dependency level per
+ * wave, spreading each wave over up to sched_count() threads. The parser
+ * only builds cells (interning is thread-safe), so workers share nothing
+ * else. Evaluation is unchanged: the nested loads run in source order, i.e.
+ * dependencies first, and simply pick up the forms parsed ahead of time.
+ * Files are read and registered with the SourceMap on the calling thread.
+ * Waves run on a persistent worker pool, so worker cell pools are reused
+ * rather than stranded by exiting threads; a worker takes the requesting
+ * scheduler's id for the wave, so that scheduler owns every parsed cell.
+ * Loads may run on several scheduler threads at once. g_load_lock guards
+ * the unit table and SourceMap registration only: reading and parsing run
+ * unlocked, and units enter the table once parsed. */
+
+typedef struct {
+    char*    path;
+    char*    buffer;
+    size_t   len;
+    uint32_t file_base;
+    Cell**   forms;
+    uint32_t n_forms;
+} LoadUnit;
+
+static StrTable g_load_units;        /* path → LoadUnit*, parsed ahead of evaluation */
+static bool     g_load_units_init = false;
+static _Atomic int g_load_depth = 0; /* prim_load calls in progress, all threads */
+static pthread_mutex_t g_load_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void load_unit_free(void* p) {
+    LoadUnit* u = (LoadUnit*)p;
+    for (uint32_t k = 0; k < u->n_forms; k++) cell_release(u->forms[k]);
+    free(u->forms);
+    free(u->buffer);
+    free(u->path);
+    free(u);
+}
+
+static char* load_read_file(const char* filename, size_t* len) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* buffer = (char*)malloc(file_size + 1);
+    if (!buffer) {
+        fclose(file);
+        return NULL;
+    }
+    size_t bytes_read = fread(buffer, 1, file_size, file);
+    buffer[bytes_read] = '\0';
+    fclose(file);
+    *len = bytes_read;
+    return buffer;
+}
+
+/* Read a file and register it with the SourceMap; NULL if unreadable */
+static LoadUnit* load_unit_read(const char* filename) {
+    size_t len = 0;
+    char* buffer = load_read_file(filename, &len);
+    LoadUnit* u = buffer ? (LoadUnit*)calloc(1, sizeof(LoadUnit)) : NULL;
+    if (!u) {
+        free(buffer);
+        return NULL;
+    }
+    u->path = strdup(filename);
+    u->buffer = buffer;
+    u->len = len;
+    /* Register file with SourceMap for diagnostic span resolution */
+    if (g_source_map) {
+        pthread_mutex_lock(&g_load_lock);
+        u->file_base = srcmap_add_file(g_source_map, filename, buffer, (uint32_t)len);
+        pthread_mutex_unlock(&g_load_lock);
+    }
+    return u;
+}
+
+/* Parsed forms come from the file's .gcache when it matches the source;
+ * otherwise parse with parse_next (preserves spans) and refresh it */
+static void load_unit_parse(LoadUnit* u) {
+    uint32_t n_forms = 0;
+    Cell** forms = gcache_read(u->path, u->buffer, u->len, u->file_base, &n_forms);
+    if (!forms) {
+        uint32_t cap = 64;
+        forms = (Cell**)malloc(cap * sizeof(Cell*));
+        int pos = 0;
+        while (forms && u->buffer[pos] != '\0') {
+            /* parse_next handles whitespace/comment skipping internally */
+            Cell* expr = parse_next(u->buffer, &pos, u->file_base);
+            if (!expr) break;  /* End of input or parse error */
+            if (n_forms == cap) {
+                cap *= 2;
+                Cell** grown = (Cell**)realloc(forms, cap * sizeof(Cell*));
+                if (!grown) { cell_release(expr); break; }
+                forms = grown;
+            }
+            forms[n_forms++] = expr;
+        }
+        if (forms) gcache_write(u->path, u->buffer, u->len, u->file_base, forms, n_forms);
+    }
+    u->forms = forms;
+    u->n_forms = forms ? n_forms : 0;
+}
+
+typedef struct {
+    LoadUnit**       units;
+    uint32_t         n;
+    uint16_t         owner;   /* Scheduler id of the loading thread */
+    _Atomic uint32_t next;
+} LoadWave;
+
+static void* load_wave_worker(void* arg) {
+    LoadWave* w = (LoadWave*)arg;
+    /* Cells are born owned by the scheduler that will evaluate and free
+     * them, not by whichever pool thread parsed them */
+    uint16_t self = tls_scheduler_id;
+    tls_scheduler_id = w->owner;
+    uint32_t i;
+    while ((i = atomic_fetch_add(&w->next, 1)) < w->n) {
+        load_unit_parse(w->units[i]);
+    }
+    tls_scheduler_id = self;
+    return NULL;
+}
+
+/* Parse workers live for the whole process. Each wave bumps gen; every
+ * worker runs each wave once and the caller waits for busy to drain. */
+#define LOAD_POOL_MAX 63
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  work;
+    pthread_cond_t  done;
+    LoadWave*       wave;
+    uint64_t        gen;
+    uint32_t        n_threads;
+    uint32_t        busy;
+} g_load_pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                  PTHREAD_COND_INITIALIZER, NULL, 0, 0, 0 };
+
+static void* load_pool_worker(void* arg) {
+    uint64_t seen = (uint64_t)(uintptr_t)arg;
+    pthread_mutex_lock(&g_load_pool.lock);
+    for (;;) {
+        while (g_load_pool.gen == seen) pthread_cond_wait(&g_load_pool.work, &g_load_pool.lock);
+        seen = g_load_pool.gen;
+        LoadWave* w = g_load_pool.wave;
+        pthread_mutex_unlock(&g_load_pool.lock);
+        load_wave_worker(w);
+        pthread_mutex_lock(&g_load_pool.lock);
+        if (--g_load_pool.busy == 0) pthread_cond_signal(&g_load_pool.done);
+    }
+    return NULL;
+}
+
+/* Parse units[0..n) on up to sched_count() threads, the caller included.
+ * The pool runs one wave at a time; a wave that finds it busy is parsed
+ * by its caller alone. */
+static void load_parse_wave(LoadUnit** units, uint32_t n) {
+    LoadWave w = { .units = units, .n = n, .owner = tls_scheduler_id };
+    atomic_init(&w.next, 0);
+    uint32_t want = (uint32_t)sched_count();
+    if (want > n) want = n;
+    want = want > 0 ? want - 1 : 0;
+    if (want > LOAD_POOL_MAX) want = LOAD_POOL_MAX;
+
+    pthread_mutex_lock(&g_load_pool.lock);
+    while (g_load_pool.n_threads < want) {
+        pthread_t t;
+        if (pthread_create(&t, NULL, load_pool_worker,
+                           (void*)(uintptr_t)g_load_pool.gen) != 0) break;
+        pthread_detach(t);
+        g_load_pool.n_threads++;
+    }
+    bool pooled = want > 0 && g_load_pool.n_threads > 0 && !g_load_pool.wave;
+    if (pooled) {
+        g_load_pool.wave = &w;
+        g_load_pool.busy = g_load_pool.n_threads;
+        g_load_pool.gen++;
+        pthread_cond_broadcast(&g_load_pool.work);
+    }
+    pthread_mutex_unlock(&g_load_pool.lock);
+
+    load_wave_worker(&w);
+    if (!pooled) return;
+
+    pthread_mutex_lock(&g_load_pool.lock);
+    while (g_load_pool.busy > 0) pthread_cond_wait(&g_load_pool.done, &g_load_pool.lock);
+    g_load_pool.wave = NULL;
+    pthread_mutex_unlock(&g_load_pool.lock);
+}
+
+/* Paths of literal (load "path") forms anywhere in form */
+static void load_scan_deps(Cell* form, const char*** deps, uint32_t* n, uint32_t* cap) {
+    while (cell_is_pair(form)) {
+        Cell* head = cell_car(form);
+        Cell* rest = cell_cdr(form);
+        if (cell_is_symbol(head) && strcmp(cell_get_symbol(head), "load") == 0 &&
+            cell_is_pair(rest) && cell_is_string(cell_car(rest))) {
+            if (*n == *cap) {
+                *cap = *cap ? *cap * 2 : 16;
+                const char** grown = (const char**)realloc((void*)*deps, *cap * sizeof(char*));
+                if (!grown) return;
+                *deps = grown;
+            }
+            (*deps)[(*n)++] = cell_get_string(cell_car(rest));
+            return;
+        }
+        if (cell_is_pair(head)) load_scan_deps(head, deps, n, cap);
+        form = rest;
+    }
+}
+
+/* Whether path still needs reading: not in the table, not loaded, and
+ * not among the unpublished units[0..n) of this prefetch */
+static bool load_should_prefetch(const char* path, LoadUnit** units, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (strcmp(units[i]->path, path) == 0) return false;
+    }
+    pthread_mutex_lock(&g_load_lock);
+    bool queued = g_load_units_init && strtable_get(&g_load_units, path);
+    pthread_mutex_unlock(&g_load_lock);
+    if (queued) return false;
+    ModuleEntry* e = module_registry_get_entry(path);
+    return !(e && e->load_state != MODULE_UNLOADED);
+}
+
+/* Hand parsed units to the table for the nested loads to take; units[]
+ * must not be touched afterwards. Another thread may have published the
+ * same file meanwhile, in which case its copy wins and ours is freed. */
+static void load_publish(LoadUnit** units, uint32_t n) {
+    pthread_mutex_lock(&g_load_lock);
+    if (!g_load_units_init) {
+        strtable_init(&g_load_units, 32);
+        g_load_units_init = true;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        if (!strtable_get(&g_load_units, units[i]->path)) {
+            strtable_put(&g_load_units, units[i]->path, units[i]);
+            units[i] = NULL;
+        }
+    }
+    pthread_mutex_unlock(&g_load_lock);
+    for (uint32_t i = 0; i < n; i++) {
+        if (units[i]) load_unit_free(units[i]);
+    }
+}
+
+/* Read and parse root and everything it statically loads. Root's unit is
+ * returned to the caller; the others are published once their wave is
+ * parsed and scanned, since a nested load on another thread may take and
+ * free a unit as soon as it is in the table. */
+static LoadUnit* load_prefetch(const char* root) {
+    LoadUnit* first = load_unit_read(root);
+    if (!first) return NULL;
+
+    uint32_t n = 0, cap = 8;
+    LoadUnit** units = (LoadUnit**)malloc(cap * sizeof(LoadUnit*));
+    if (!units) {
+        load_unit_parse(first);
+        return first;
+    }
+    units[n++] = first;
+
+    const char** deps = NULL;
+    uint32_t dep_cap = 0;
+    for (uint32_t wave = 0; wave < n;) {
+        uint32_t end = n;
+        load_parse_wave(units + wave, end - wave);
+        for (uint32_t i = wave; i < end; i++) {
+            uint32_t n_deps = 0;
+            for (uint32_t k = 0; k < units[i]->n_forms; k++) {
+                load_scan_deps(units[i]->forms[k], &deps, &n_deps, &dep_cap);
+            }
+            for (uint32_t d = 0; d < n_deps; d++) {
+                if (strcmp(deps[d], root) == 0 ||
+                    !load_should_prefetch(deps[d], units + wave, n - wave)) continue;
+                LoadUnit* u = load_unit_read(deps[d]);
+                if (!u) continue;
+                if (n == cap) {
+                    cap *= 2;
+                    LoadUnit** grown = (LoadUnit**)realloc(units, cap * sizeof(LoadUnit*));
+                    if (!grown) { load_unit_free(u); continue; }
+                    units = grown;
+                }
+                units[n++] = u;
+            }
+        }
+        /* Dependency paths point into this wave's forms, so it is only
+         * published once scanned; root stays with the caller */
+        uint32_t from = wave == 0 ? 1 : wave;
+        if (end > from) load_publish(units + from, end - from);
+        wave = end;
+    }
+    free((void*)deps);
+    free(units);
+    return first;
+}
+
+/* Forms of filename parsed ahead of time, prefetching them if needed.
+ * Code that runs before a nested load may rewrite the file, so a unit is
+ * only used if the file still holds the text that was parsed. */
+static LoadUnit* load_take_unit(const char* filename) {
+    pthread_mutex_lock(&g_load_lock);
+    LoadUnit* u = g_load_units_init ? (LoadUnit*)strtable_del(&g_load_units, filename) : NULL;
+    pthread_mutex_unlock(&g_load_lock);
+    if (u) {
+        size_t len = 0;
+        char* now = load_read_file(filename, &len);
+        bool same = now && len == u->len && memcmp(now, u->buffer, len) == 0;
+        free(now);
+        if (same) return u;
+        load_unit_free(u);
+    }
+    return load_prefetch(filename);
+}
+
+/* Prefetched units nobody loaded are dropped once the last load in
+ * progress ends, so a later load sees the file as it is then */
+static void load_end(void) {
+    if (atomic_fetch_sub(&g_load_depth, 1) != 1) return;
+    pthread_mutex_lock(&g_load_lock);
+    if (g_load_units_init && atomic_load(&g_load_depth) == 0) {
+        strtable_free(&g_load_units, load_unit_free);
+        g_load_units_init = false;
+    }
+    pthread_mutex_unlock(&g_load_lock);
+}
+
 /* ⋘ - Load and evaluate a file */
 Cell* prim_load(Cell* args) {
     Cell* path = arg1(args);
@@ -8365,31 +8414,13 @@ Cell* prim_load(Cell* args) {
         }
     }
 
-    /* Read file */
-    FILE* file = fopen(filename, "r");
-    if (!file) {
+    atomic_fetch_add(&g_load_depth, 1);
+    LoadUnit* unit = load_take_unit(filename);
+    if (!unit) {
+        load_end();
         return cell_error(":file-not-found", path);
     }
 
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    char* buffer = (char*)malloc(file_size + 1);
-    if (!buffer) {
-        fclose(file);
-        return cell_error(":out-of-memory", path);
-    }
-
-    size_t bytes_read = fread(buffer, 1, file_size, file);
-    buffer[bytes_read] = '\0';
-    fclose(file);
-
-    /* Register file with SourceMap for diagnostic span resolution */
-    if (g_source_map) {
-        srcmap_add_file(g_source_map, filename, buffer, bytes_read);
-    }
-
     /* Register module and set as currently loading */
     module_registry_add(filename);
 
@@ -8412,59 +8443,95 @@ Cell* prim_load(Cell* args) {
     /* Get current context */
     EvalContext* ctx = eval_get_current_context();
 
-    /* Get file_base from SourceMap registration */
-    uint32_t file_base = 0;
-    if (g_source_map) {
-        /* srcmap_add_file was already called above; retrieve the base.
-         * The file was just registered, so its base is next_base - bytes_read. */
-        SourceFile* sf = srcmap_file_for_pos(g_source_map, g_source_map->next_base - 1);
-        if (sf) file_base = sf->base;
-    }
-
-    /* Parse and evaluate all expressions using parse_next (preserves spans) */
-    int pos = 0;
+    /* Evaluate in order */
     Cell* result = cell_nil();
-    int expression_count = 0;
-
-    while (buffer[pos] != '\0') {
-        /* parse_next handles whitespace/comment skipping internally */
-        Cell* expr = parse_next(buffer, &pos, file_base);
-
-        if (!expr) {
-            /* End of input or parse error */
-            break;
-        }
-
-        /* Evaluate expression */
-        if (expression_count > 0) {
-            cell_release(result);
-        }
-        result = eval(ctx, expr);
-        cell_release(expr);
+    for (uint32_t i = 0; i < unit->n_forms; i++) {
+        cell_release(result);
+        result = eval(ctx, unit->forms[i]);
 
         if (cell_is_error(result)) {
+            load_unit_free(unit);
             if (entry) entry->load_state = MODULE_UNLOADED;
             module_set_current_loading(parent_entry ? parent_entry->name : NULL);
-            free(buffer);
+            load_end();
             return result;
         }
+    }
+    load_unit_free(unit);
 
-        expression_count++;
+    /* Cache result and mark as loaded */
+    if (entry) {
+        entry->load_state = MODULE_LOADED;
+        if (entry->cached_result) cell_release(entry->cached_result);
+        entry->cached_result = result;
+        cell_retain(result);
+    }
+
+    /* Restore parent loading module */
+    module_set_current_loading(parent_entry ? parent_entry->name : NULL);
+
+    load_end();
+    return result;
+}
+
+/* gcache-file - where load caches the parsed forms of a source file */
+Cell* prim_gcache_file(Cell* args) {
+    Cell* path = arg1(args);
+    if (!cell_is_string(path)) {
+        return cell_error("gcache-file requires a string path", path);
+    }
+    char* file = gcache_file(cell_get_string(path));
+    if (!file) return cell_nil();
+    Cell* result = cell_string(file);
+    free(file);
+    return result;
+}
+
+/* gcache-hits - loads whose forms came from the parse cache */
+Cell* prim_gcache_hits(Cell* args) {
+    (void)args;
+    return cell_number((double)gcache_hits());
+}
+
+/* Save definitions, macros and registries to an image file.
+ * Returns the number of definitions saved; any left out are named in a
+ * warning on stderr. */
+Cell* prim_save_image(Cell* args) {
+    Cell* path = arg1(args);
+    if (!cell_is_string(path)) {
+        return cell_error("save-image requires a string path", path);
     }
+    EvalContext* ctx = eval_get_current_context();
+    if (!ctx) return cell_error("no-context", cell_nil());
 
-    /* Cache result and mark as loaded */
-    if (entry) {
-        entry->load_state = MODULE_LOADED;
-        if (entry->cached_result) cell_release(entry->cached_result);
-        entry->cached_result = result;
-        cell_retain(result);
+    Cell* skipped = NULL;
+    int saved = image_save(ctx, cell_get_string(path), &skipped);
+    if (saved >= 0 && cell_is_pair(skipped)) {
+        /* The image is still usable; say what it is missing */
+        fprintf(stderr, "Warning: save-image left out definitions that cannot be imaged:");
+        for (Cell* p = skipped; cell_is_pair(p); p = cell_cdr(p)) {
+            fprintf(stderr, " %s", cell_get_symbol(cell_car(p)));
+        }
+        fprintf(stderr, "\n");
     }
+    cell_release(skipped);
+    if (saved < 0) return cell_error("image-write-failed", path);
+    return cell_number(saved);
+}
 
-    /* Restore parent loading module */
-    module_set_current_loading(parent_entry ? parent_entry->name : NULL);
+/* Restore an image written by save-image into the running context */
+Cell* prim_load_image(Cell* args) {
+    Cell* path = arg1(args);
+    if (!cell_is_string(path)) {
+        return cell_error("load-image requires a string path", path);
+    }
+    EvalContext* ctx = eval_get_current_context();
+    if (!ctx) return cell_error("no-context", cell_nil());
 
-    free(buffer);
-    return result;
+    if (!image_load(ctx, cell_get_string(path))) {
+        return cell_error("invalid-image", path);
+    }
+    return cell_bool(true);
 }
 
 /* Forward declaration — completed at end of file */
@@ -10404,10 +10471,17 @@ Cell* prim_weak_is(Cell* args) {
 
 /* ===== HashMap Primitives (Day 109) ===== */
 
-/* ⊞ - create hashmap (variadic) */
-Cell* prim_hashmap_new(Cell* args) {
-    Cell* map = cell_hashmap_new(GROUP_WIDTH);
-    /* If args provided, each should be a pair ⟨key value⟩ */
+/* Hash family keyword → CellHashFamily; false for anything else */
+static bool hash_family_of(Cell* kw, CellHashFamily* out) {
+    if (!cell_is_symbol(kw)) return false;
+    const char* name = cell_get_symbol(kw);
+    if (strcmp(name, ":sip") == 0) { *out = CELL_HASH_SIP; return true; }
+    if (strcmp(name, ":fast") == 0) { *out = CELL_HASH_FAST; return true; }
+    return false;
+}
+
+/* Fill map from a list of ⟨key value⟩ pairs (non-pairs are skipped) */
+static Cell* hashmap_fill(Cell* map, Cell* args) {
     Cell* cur = args;
     while (cur && !cell_is_nil(cur)) {
         if (!cell_is_pair(cur)) break;
@@ -10423,6 +10497,19 @@ Cell* prim_hashmap_new(Cell* args) {
     return map;
 }
 
+/* ⊞ - create hashmap (variadic) */
+Cell* prim_hashmap_new(Cell* args) {
+    return hashmap_fill(cell_hashmap_new(GROUP_WIDTH), args);
+}
+
+/* Create hashmap with an explicit key hash family: :sip (default) or :fast */
+Cell* prim_hashmap_with_hash(Cell* args) {
+    CellHashFamily fam;
+    if (!hash_family_of(arg1(args), &fam))
+        return cell_error("hashmap-with-hash requires :sip or :fast", arg1(args));
+    return hashmap_fill(cell_hashmap_new_with(GROUP_WIDTH, fam), cell_cdr(args));
+}
+
 /* ⊞→ - get value by key */
 Cell* prim_hashmap_get(Cell* args) {
     Cell* map = arg1(args);
@@ -10509,11 +10596,24 @@ Cell* prim_hashmap_merge(Cell* args) {
     return cell_hashmap_merge(m1, m2);
 }
 
+/* ⊞⊇ - pre-size for n entries so later puts never resize */
+Cell* prim_hashmap_reserve(Cell* args) {
+    Cell* map = arg1(args);
+    Cell* n = arg2(args);
+    if (!cell_is_hashmap(map))
+        return cell_error("hashmap-reserve requires hashmap as first arg", map);
+    if (!cell_is_number(n) || cell_get_number(n) < 0)
+        return cell_error("hashmap-reserve requires non-negative count", n);
+    double want = cell_get_number(n);
+    cell_hashmap_reserve(map, want > (double)UINT32_MAX ? UINT32_MAX : (uint32_t)want);
+    cell_retain(map);
+    return map;
+}
+
 /* === HashSet Primitives (Boost-style groups-of-15 + overflow Bloom byte) === */
 
-Cell* prim_set_new(Cell* args) {
-    /* (⊍) → empty set, (⊍ v1 v2 ...) → set from values */
-    Cell* set = cell_hashset_new(1);
+/* Add every value of a list to set */
+static Cell* hashset_fill(Cell* set, Cell* args) {
     Cell* cur = args;
     while (cur && !cell_is_nil(cur) && cell_is_pair(cur)) {
         Cell* val = cell_car(cur);
@@ -10523,6 +10623,28 @@ Cell* prim_set_new(Cell* args) {
     return set;
 }
 
+Cell* prim_set_new(Cell* args) {
+    /* (⊍) → empty set, (⊍ v1 v2 ...) → set from values */
+    return hashset_fill(cell_hashset_new(1), args);
+}
+
+Cell* prim_set_with_hash(Cell* args) {
+    CellHashFamily fam;
+    if (!hash_family_of(arg1(args), &fam))
+        return cell_error("set-with-hash requires :sip or :fast", arg1(args));
+    return hashset_fill(cell_hashset_new_with(1, fam), cell_cdr(args));
+}
+
+/* Hash family a hashmap or set was created with */
+Cell* prim_hash_family(Cell* args) {
+    Cell* c = arg1(args);
+    uint8_t fam;
+    if (cell_is_hashmap(c)) fam = c->data.hashmap.hash_family;
+    else if (cell_is_hashset(c)) fam = c->data.hashset.hash_family;
+    else return cell_error("hash-family requires hashmap or set", c);
+    return cell_symbol(fam == CELL_HASH_FAST ? ":fast" : ":sip");
+}
+
 Cell* prim_set_add(Cell* args) {
     Cell* set = arg1(args);
     Cell* val = arg2(args);
@@ -11115,6 +11237,54 @@ Cell* prim_sorted_map_new(Cell* args) {
     return m;
 }
 
+/* Bulk-load a sorted map from a vector of ⟨k v⟩ pairs in ascending key
+ * order — leaves are packed full bottom-up, no per-key insert */
+Cell* prim_sorted_map_from_sorted(Cell* args) {
+    Cell* vec = arg1(args);
+    if (!cell_is_vector(vec))
+        return cell_error("sorted-map-from-sorted requires vector of ⟨k v⟩ pairs", vec);
+    uint32_t n = cell_vector_size(vec);
+    Cell** keys = (Cell**)malloc((n ? n : 1) * sizeof(Cell*));
+    Cell** vals = (Cell**)malloc((n ? n : 1) * sizeof(Cell*));
+    for (uint32_t i = 0; i < n; i++) {
+        Cell* pair = cell_vector_get(vec, i);
+        if (!cell_is_pair(pair)) {
+            free(keys);
+            free(vals);
+            return cell_error("sorted-map-from-sorted elements must be ⟨k v⟩ pairs", pair);
+        }
+        keys[i] = cell_car(pair);
+        vals[i] = cell_cdr(pair);
+    }
+    Cell* m = cell_sorted_map_from_sorted(keys, vals, n);
+    free(keys);
+    free(vals);
+    if (!m)
+        return cell_error("sorted-map-from-sorted requires keys in ascending order", vec);
+    return m;
+}
+
+/* Lazy range cursor: ⟨k v⟩ for lo ≤ k ≤ hi, ascending */
+Cell* prim_sorted_map_range_iter(Cell* args) {
+    Cell* m = arg1(args);
+    if (!cell_is_sorted_map(m))
+        return cell_error("sorted-map-range-iter requires sorted-map", m);
+    return cell_sorted_map_iter(m, arg2(args), arg3(args), false);
+}
+
+/* Descending cursor over the whole map, or over [lo, hi] when given */
+Cell* prim_sorted_map_reverse_iter(Cell* args) {
+    Cell* m = arg1(args);
+    if (!cell_is_sorted_map(m))
+        return cell_error("sorted-map-reverse-iter requires sorted-map", m);
+    Cell* rest = cell_cdr(args);
+    if (cell_is_nil(rest))
+        return cell_sorted_map_iter(m, NULL, NULL, true);
+    if (!cell_is_pair(cell_cdr(rest)))
+        return cell_error("sorted-map-reverse-iter takes a map, or a map, lo and hi", rest);
+    return cell_sorted_map_iter(m, arg2(args), arg3(args), true);
+}
+
 /* ⋔→ - get value by key */
 Cell* prim_sorted_map_get(Cell* args) {
     Cell* m = arg1(args);
@@ -11251,6 +11421,39 @@ Cell* prim_sorted_map_ceiling(Cell* args) {
     return result ? result : cell_nil();
 }
 
+/* Number of keys below k — O(log n) via subtree counts */
+Cell* prim_sorted_map_rank(Cell* args) {
+    Cell* m = arg1(args);
+    if (!cell_is_sorted_map(m))
+        return cell_error("sorted-map-rank requires sorted-map", m);
+    return cell_number((double)cell_sorted_map_rank(m, arg2(args)));
+}
+
+/* Entry at zero-based position n in key order */
+Cell* prim_sorted_map_nth(Cell* args) {
+    Cell* m = arg1(args);
+    if (!cell_is_sorted_map(m))
+        return cell_error("sorted-map-nth requires sorted-map", m);
+    Cell* idx_cell = arg2(args);
+    if (!cell_is_number(idx_cell))
+        return cell_error("sorted-map-nth index must be number", idx_cell);
+    double n = cell_get_number(idx_cell);
+    uint32_t idx = (uint32_t)n;
+    if (n < 0 || n != idx || idx >= cell_sorted_map_size(m))
+        return cell_error("index-out-of-bounds", idx_cell);
+    return cell_sorted_map_nth(m, idx);
+}
+
+/* Number of keys in [lo, hi] */
+Cell* prim_sorted_map_count_range(Cell* args) {
+    Cell* m = arg1(args);
+    if (!cell_is_sorted_map(m))
+        return cell_error("sorted-map-count-range requires sorted-map", m);
+    Cell* lo = arg2(args);
+    Cell* hi = arg3(args);
+    return cell_number((double)cell_sorted_map_count_range(m, lo, hi));
+}
+
 /* === Trie primitives (Day 117 — ART with SIMD Node16) === */
 
 /* ⊮ - create trie, optionally from ⟨k v⟩ pairs */
@@ -11276,7 +11479,9 @@ Cell* prim_trie_get(Cell* args) {
         return cell_error("trie-get requires trie", t);
     Cell* key = arg2(args);
     Cell* val = cell_trie_get(t, key);
-    return val ? val : cell_nil();
+    if (!val) return cell_nil();
+    cell_retain(val);  /* Borrowed from the trie */
+    return val;
 }
 
 /* ⊮← - put key-value (mutates), returns #t */
@@ -11342,6 +11547,23 @@ Cell* prim_trie_prefix_keys(Cell* args) {
     return cell_trie_prefix_keys(t, prefix);
 }
 
+/* Lazy cursor over ⟨k v⟩ with the given key prefix, in key order */
+Cell* prim_trie_prefix_iter(Cell* args) {
+    Cell* t = arg1(args);
+    if (!cell_is_trie(t))
+        return cell_error("trie-prefix-iter requires trie", t);
+    return cell_trie_iter(t, arg2(args), false);
+}
+
+/* Descending cursor over the whole trie, or over one prefix */
+Cell* prim_trie_reverse_iter(Cell* args) {
+    Cell* t = arg1(args);
+    if (!cell_is_trie(t))
+        return cell_error("trie-reverse-iter requires trie", t);
+    Cell* rest = cell_cdr(args);
+    return cell_trie_iter(t, cell_is_nil(rest) ? NULL : cell_car(rest), true);
+}
+
 /* ⊮⊗ - prefix count */
 Cell* prim_trie_prefix_count(Cell* args) {
     Cell* t = arg1(args);
@@ -11385,6 +11607,457 @@ Cell* prim_trie_vals(Cell* args) {
     return cell_trie_values(t);
 }
 
+/* === Persistent map/set primitives (CHAMP — path copying, transients) === */
+
+/* Persistent updates need a persistent value; ! edits need a live transient */
+static Cell* champ_check(Cell* c, bool is_set, int want, const char* who) {
+    if (is_set ? !cell_is_pset(c) : !cell_is_pmap(c)) {
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%s requires %s", who, is_set ? "pset" : "pmap");
+        return cell_error(msg, c);
+    }
+    if (want == 0) return NULL;
+    bool transient = cell_champ_is_transient(c);
+    if (want > 0 && (!transient || c->data.champ.sealed))
+        return cell_error(transient ? "transient-sealed" : "not-transient", c);
+    if (want < 0 && transient)
+        return cell_error("transient-not-persistent", c);
+    return NULL;
+}
+
+/* Build from the argument list with one transient pass */
+static Cell* champ_from_args(Cell* args, bool is_set) {
+    Cell* base = is_set ? cell_pset_new() : cell_pmap_new();
+    Cell* t = cell_champ_transient(base);
+    cell_release(base);
+    for (Cell* cur = args; cur && cell_is_pair(cur); cur = cell_cdr(cur)) {
+        Cell* item = cell_car(cur);
+        if (is_set) cell_pmap_put_mut(t, item, NULL);
+        else if (cell_is_pair(item)) cell_pmap_put_mut(t, cell_car(item), cell_cdr(item));
+    }
+    Cell* result = cell_champ_persistent(t);
+    cell_release(t);
+    return result;
+}
+
+/* ⊞ᵖ - create persistent map from ⟨k v⟩ pairs */
+Cell* prim_pmap_new(Cell* args) {
+    return champ_from_args(args, false);
+}
+
+/* ⊞ᵖ→ - get value by key */
+Cell* prim_pmap_get(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, 0, "pmap-get");
+    if (err) return err;
+    return cell_pmap_get(m, arg2(args));
+}
+
+/* ⊞ᵖ← - new map with key set */
+Cell* prim_pmap_put(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, -1, "pmap-put");
+    if (err) return err;
+    return cell_pmap_put(m, arg2(args), arg3(args));
+}
+
+/* ⊞ᵖ⊖ - new map without key */
+Cell* prim_pmap_del(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, -1, "pmap-del");
+    if (err) return err;
+    return cell_pmap_del(m, arg2(args));
+}
+
+/* ⊞ᵖ? - type predicate */
+Cell* prim_pmap_is(Cell* args) {
+    return cell_bool(cell_is_pmap(arg1(args)));
+}
+
+/* ⊞ᵖ∋ - has key */
+Cell* prim_pmap_has(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, 0, "pmap-has?");
+    if (err) return err;
+    return cell_bool(cell_pmap_has(m, arg2(args)));
+}
+
+/* ⊞ᵖ# - size */
+Cell* prim_pmap_size(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, 0, "pmap-size");
+    if (err) return err;
+    return cell_number((double)cell_pmap_size(m));
+}
+
+/* ⊞ᵖ⊙ - keys list */
+Cell* prim_pmap_keys(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, 0, "pmap-keys");
+    if (err) return err;
+    return cell_pmap_keys(m);
+}
+
+/* ⊞ᵖ⊗ - values list */
+Cell* prim_pmap_vals(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, 0, "pmap-vals");
+    if (err) return err;
+    return cell_pmap_values(m);
+}
+
+/* ⊞ᵖ* - entries list */
+Cell* prim_pmap_entries(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, 0, "pmap-entries");
+    if (err) return err;
+    return cell_pmap_entries(m);
+}
+
+/* ⊞ᵖ⊕ - merge (m2 wins), sharing the larger map's structure */
+Cell* prim_pmap_merge(Cell* args) {
+    Cell* m1 = arg1(args);
+    Cell* m2 = arg2(args);
+    Cell* err = champ_check(m1, false, -1, "pmap-merge");
+    if (!err) err = champ_check(m2, false, -1, "pmap-merge");
+    if (err) return err;
+    return cell_pmap_merge(m1, m2);
+}
+
+/* ⊞ᵖ⇝ - transient for batch edits */
+Cell* prim_pmap_transient(Cell* args) {
+    Cell* m = arg1(args);
+    Cell* err = champ_check(m, false, -1, "pmap-transient");
+    if (err) return err;
+    return cell_champ_transient(m);
+}
+
+/* ⊞ᵖ←! - set key in place, returns the transient */
+Cell* prim_pmap_put_mut(Cell* args) {
+    Cell* t = arg1(args);
+    Cell* err = champ_check(t, false, 1, "pmap-put!");
+    if (err) return err;
+    cell_pmap_put_mut(t, arg2(args), arg3(args));
+    cell_retain(t);
+    return t;
+}
+
+/* ⊞ᵖ⊖! - remove key in place, returns the transient */
+Cell* prim_pmap_del_mut(Cell* args) {
+    Cell* t = arg1(args);
+    Cell* err = champ_check(t, false, 1, "pmap-del!");
+    if (err) return err;
+    cell_pmap_del_mut(t, arg2(args));
+    cell_retain(t);
+    return t;
+}
+
+/* ⊞ᵖ⇜ - seal transient, returns the persistent map */
+Cell* prim_pmap_persistent(Cell* args) {
+    Cell* t = arg1(args);
+    Cell* err = champ_check(t, false, 1, "pmap-persistent!");
+    if (err) return err;
+    return cell_champ_persistent(t);
+}
+
+/* ⊡ᵖ - create persistent set from values */
+Cell* prim_pset_new(Cell* args) {
+    return champ_from_args(args, true);
+}
+
+/* ⊡ᵖ⊕ - new set with element */
+Cell* prim_pset_add(Cell* args) {
+    Cell* s = arg1(args);
+    Cell* err = champ_check(s, true, -1, "pset-add");
+    if (err) return err;
+    return cell_pmap_put(s, arg2(args), NULL);
+}
+
+/* ⊡ᵖ⊖ - new set without element */
+Cell* prim_pset_remove(Cell* args) {
+    Cell* s = arg1(args);
+    Cell* err = champ_check(s, true, -1, "pset-remove");
+    if (err) return err;
+    return cell_pmap_del(s, arg2(args));
+}
+
+/* ⊡ᵖ? - type predicate */
+Cell* prim_pset_is(Cell* args) {
+    return cell_bool(cell_is_pset(arg1(args)));
+}
+
+/* ⊡ᵖ∋ - membership */
+Cell* prim_pset_has(Cell* args) {
+    Cell* s = arg1(args);
+    Cell* err = champ_check(s, true, 0, "pset-has?");
+    if (err) return err;
+    return cell_bool(cell_pmap_has(s, arg2(args)));
+}
+
+/* ⊡ᵖ# - size */
+Cell* prim_pset_size(Cell* args) {
+    Cell* s = arg1(args);
+    Cell* err = champ_check(s, true, 0, "pset-size");
+    if (err) return err;
+    return cell_number((double)cell_pmap_size(s));
+}
+
+/* ⊡ᵖ⊙ - elements list */
+Cell* prim_pset_elements(Cell* args) {
+    Cell* s = arg1(args);
+    Cell* err = champ_check(s, true, 0, "pset-elements");
+    if (err) return err;
+    return cell_pmap_keys(s);
+}
+
+/* ⊡ᵖ∪ - union, sharing the larger set's structure */
+Cell* prim_pset_union(Cell* args) {
+    Cell* s1 = arg1(args);
+    Cell* s2 = arg2(args);
+    Cell* err = champ_check(s1, true, -1, "pset-union");
+    if (!err) err = champ_check(s2, true, -1, "pset-union");
+    if (err) return err;
+    return cell_pmap_merge(s1, s2);
+}
+
+/* ⊡ᵖ⇝ - transient for batch edits */
+Cell* prim_pset_transient(Cell* args) {
+    Cell* s = arg1(args);
+    Cell* err = champ_check(s, true, -1, "pset-transient");
+    if (err) return err;
+    return cell_champ_transient(s);
+}
+
+/* ⊡ᵖ⊕! - add in place, returns the transient */
+Cell* prim_pset_add_mut(Cell* args) {
+    Cell* t = arg1(args);
+    Cell* err = champ_check(t, true, 1, "pset-add!");
+    if (err) return err;
+    cell_pmap_put_mut(t, arg2(args), NULL);
+    cell_retain(t);
+    return t;
+}
+
+/* ⊡ᵖ⊖! - remove in place, returns the transient */
+Cell* prim_pset_remove_mut(Cell* args) {
+    Cell* t = arg1(args);
+    Cell* err = champ_check(t, true, 1, "pset-remove!");
+    if (err) return err;
+    cell_pmap_del_mut(t, arg2(args));
+    cell_retain(t);
+    return t;
+}
+
+/* ⊡ᵖ⇜ - seal transient, returns the persistent set */
+Cell* prim_pset_persistent(Cell* args) {
+    Cell* t = arg1(args);
+    Cell* err = champ_check(t, true, 1, "pset-persistent!");
+    if (err) return err;
+    return cell_champ_persistent(t);
+}
+
+/* === Record table primitives (⊙▦ — columnar rows of a leaf struct) === */
+
+/* Field list of a registered ⊙≔ leaf type (retained), or NULL */
+static Cell* table_leaf_fields(Cell* type_tag) {
+    EvalContext* ctx = eval_get_current_context();
+    Cell* schema = ctx ? eval_lookup_type(ctx, type_tag) : NULL;
+    if (!schema) return NULL;
+    Cell* fields = NULL;
+    if (cell_is_pair(schema) && cell_is_symbol(cell_car(schema)) &&
+        strcmp(cell_get_symbol(cell_car(schema)), ":leaf") == 0) {
+        fields = cell_cdr(schema);
+        cell_retain(fields);
+    }
+    cell_release(schema);
+    return fields;
+}
+
+/* Append one struct row; error if it is not a row of t's type */
+static Cell* table_push_row(Cell* t, Cell* row, const char* who) {
+    if (!cell_is_struct(row) || cell_struct_kind(row) != STRUCT_LEAF ||
+        !cell_equal(cell_struct_type_tag(row), t->data.table.type_tag)) {
+        char msg[64];
+        snprintf(msg, sizeof(msg), "%s row must be a %s struct", who,
+                 cell_get_symbol(t->data.table.type_tag));
+        return cell_error(msg, row);
+    }
+    if (!cell_table_push(t, row))
+        return cell_error("table-row-missing-field", row);
+    return NULL;
+}
+
+static Cell* table_column_arg(Cell* t, Cell* field, const char* who, int* col) {
+    if (!cell_is_table(t)) {
+        char msg[64];
+        snprintf(msg, sizeof(msg), "%s requires table", who);
+        return cell_error(msg, t);
+    }
+    *col = cell_is_symbol(field) ? cell_table_column(t, field) : -1;
+    if (*col < 0) return cell_error("table-no-such-column", field);
+    return NULL;
+}
+
+static bool table_op_arg(Cell* s, TableOp* op) {
+    static const char* names[] = { ":<", ":<=", ":>", ":>=", ":=", ":!=" };
+    if (!cell_is_symbol(s)) return false;
+    for (int i = 0; i < 6; i++)
+        if (strcmp(cell_get_symbol(s), names[i]) == 0) { *op = (TableOp)i; return true; }
+    return false;
+}
+
+/* ⊙▦ - create table of a leaf struct type, optionally from rows */
+Cell* prim_table_new(Cell* args) {
+    Cell* type_tag = arg1(args);
+    if (!cell_is_symbol(type_tag))
+        return cell_error("table type tag must be a symbol", type_tag);
+    Cell* fields = table_leaf_fields(type_tag);
+    if (!fields) return cell_error("table requires a leaf struct type", type_tag);
+    Cell* t = cell_table_new(type_tag, fields);
+    cell_release(fields);
+    for (Cell* cur = cell_cdr(args); cell_is_pair(cur); cur = cell_cdr(cur)) {
+        Cell* err = table_push_row(t, cell_car(cur), "table");
+        if (err) { cell_release(t); return err; }
+    }
+    return t;
+}
+
+/* ⊙▦? - type predicate */
+Cell* prim_table_is(Cell* args) {
+    return cell_bool(cell_is_table(arg1(args)));
+}
+
+/* ⊙▦# - row count */
+Cell* prim_table_size(Cell* args) {
+    Cell* t = arg1(args);
+    if (!cell_is_table(t)) return cell_error("table-size requires table", t);
+    return cell_number((double)cell_table_size(t));
+}
+
+/* ⊙▦⊙ - column names, in order */
+Cell* prim_table_columns(Cell* args) {
+    Cell* t = arg1(args);
+    if (!cell_is_table(t)) return cell_error("table-columns requires table", t);
+    cell_retain(t->data.table.fields);
+    return t->data.table.fields;
+}
+
+/* ⊙▦: - storage of a column: :int / :float unboxed, :boxed, :empty */
+Cell* prim_table_column_type(Cell* args) {
+    Cell* t = arg1(args);
+    int col;
+    Cell* err = table_column_arg(t, arg2(args), "table-column-type", &col);
+    if (err) return err;
+    return cell_symbol(cell_table_column_kind(t, col));
+}
+
+/* ⊙▦⊕! - append a struct row in place, returns the table */
+Cell* prim_table_push(Cell* args) {
+    Cell* t = arg1(args);
+    if (!cell_is_table(t)) return cell_error("table-push! requires table", t);
+    Cell* err = table_push_row(t, arg2(args), "table-push!");
+    if (err) return err;
+    cell_retain(t);
+    return t;
+}
+
+/* ⊙▦→ - row i as a struct */
+Cell* prim_table_row(Cell* args) {
+    Cell* t = arg1(args);
+    if (!cell_is_table(t)) return cell_error("table-row requires table", t);
+    Cell* idx_cell = arg2(args);
+    if (!cell_is_number(idx_cell))
+        return cell_error("table-row index must be number", idx_cell);
+    double n = cell_get_number(idx_cell);
+    uint32_t idx = (uint32_t)n;
+    if (n < 0 || n != idx || idx >= cell_table_size(t))
+        return cell_error("index-out-of-bounds", idx_cell);
+    return cell_table_row(t, idx);
+}
+
+/* ⊙▦→: - one field of row i, read straight from its column */
+Cell* prim_table_get(Cell* args) {
+    Cell* t = arg1(args);
+    int col;
+    Cell* err = table_column_arg(t, arg3(args), "table-get", &col);
+    if (err) return err;
+    Cell* idx_cell = arg2(args);
+    if (!cell_is_number(idx_cell))
+        return cell_error("table-get index must be number", idx_cell);
+    double n = cell_get_number(idx_cell);
+    uint32_t idx = (uint32_t)n;
+    if (n < 0 || n != idx || idx >= cell_table_size(t))
+        return cell_error("index-out-of-bounds", idx_cell);
+    return cell_table_get(t, idx, col);
+}
+
+/* ⊙▦⟦⟧ - one column as a vector */
+Cell* prim_table_column(Cell* args) {
+    Cell* t = arg1(args);
+    int col;
+    Cell* err = table_column_arg(t, arg2(args), "table-column", &col);
+    if (err) return err;
+    return cell_table_column_values(t, col);
+}
+
+/* ⊙▦⊲ - new table of the rows where (field op value) holds */
+Cell* prim_table_filter(Cell* args) {
+    Cell* t = arg1(args);
+    int col;
+    Cell* err = table_column_arg(t, arg2(args), "table-filter", &col);
+    if (err) return err;
+    TableOp op;
+    if (!table_op_arg(arg3(args), &op))
+        return cell_error("table-filter op must be :< :<= :> :>= := or :!=", arg3(args));
+    return cell_table_filter(t, col, op, arg4(args));
+}
+
+/* ⊙▦⊳ - lazy iterator over the rows where (field op value) holds */
+Cell* prim_table_scan(Cell* args) {
+    Cell* t = arg1(args);
+    int col;
+    Cell* err = table_column_arg(t, arg2(args), "table-scan", &col);
+    if (err) return err;
+    TableOp op;
+    if (!table_op_arg(arg3(args), &op))
+        return cell_error("table-scan op must be :< :<= :> :>= := or :!=", arg3(args));
+    return cell_table_scan(t, col, op, arg4(args));
+}
+
+/* ⊙▦π - new table keeping only the named columns */
+Cell* prim_table_project(Cell* args) {
+    Cell* t = arg1(args);
+    if (!cell_is_table(t)) return cell_error("table-project requires table", t);
+    uint16_t n = 0;
+    for (Cell* cur = cell_cdr(args); cell_is_pair(cur); cur = cell_cdr(cur)) n++;
+    int* cols = (int*)malloc((n ? n : 1) * sizeof(int));
+    uint16_t q = 0;
+    for (Cell* cur = cell_cdr(args); cell_is_pair(cur); cur = cell_cdr(cur)) {
+        Cell* err = table_column_arg(t, cell_car(cur), "table-project", &cols[q++]);
+        if (err) { free(cols); return err; }
+    }
+    Cell* r = cell_table_project(t, cols, n);
+    free(cols);
+    return r;
+}
+
+/* ⊙▦Σ - aggregate one column: :count :sum :min :max :mean */
+Cell* prim_table_agg(Cell* args) {
+    Cell* t = arg1(args);
+    int col;
+    Cell* err = table_column_arg(t, arg2(args), "table-agg", &col);
+    if (err) return err;
+    static const struct { const char* name; TableAgg agg; } aggs[] = {
+        {":count", TABLE_AGG_COUNT}, {":sum", TABLE_AGG_SUM}, {":min", TABLE_AGG_MIN},
+        {":max", TABLE_AGG_MAX}, {":mean", TABLE_AGG_MEAN},
+    };
+    Cell* which = arg3(args);
+    for (size_t i = 0; cell_is_symbol(which) && i < sizeof(aggs) / sizeof(aggs[0]); i++)
+        if (strcmp(cell_get_symbol(which), aggs[i].name) == 0)
+            return cell_table_aggregate(t, col, aggs[i].agg);
+    return cell_error("table-agg must be :count :sum :min :max or :mean", which);
+}
+
 /* =========================================================================
  * Iterator (⊣) — Morsel-Driven Batch Iteration (Day 118)
  * ========================================================================= */
@@ -11481,6 +12154,15 @@ Cell* prim_iter_take(Cell* args) {
     return cell_iterator_take(src, n);
 }
 
+/* Reposition a sorted-map / trie cursor at the lower bound of key */
+Cell* prim_iter_seek(Cell* args) {
+    Cell* it = arg1(args);
+    if (!cell_iterator_seek(it, arg2(args)))
+        return cell_error("iter-seek requires a sorted-map or trie iterator", it);
+    cell_retain(it);
+    return it;
+}
+
 /* ⊣↓ - drop n */
 Cell* prim_iter_drop(Cell* args) {
     Cell* src = arg1(args);
@@ -15167,8 +15849,17 @@ static Primitive primitives[] = {
 
     /* Actor primitives */
     {"actor-spawn", prim_spawn, 1, {"Spawn new actor with behavior function", "(lambda (self) ...) -> actor-spawn[id]"}},
+    {"actor-spawn-arena", prim_spawn_arena, 1, {"Spawn actor with private bulk-freed cell arena", "(lambda (self) ...) -> actor-spawn[id]"}},
+    {"actor-spawn-stack", prim_spawn_stack, 2, {"Spawn actor with an explicit fiber stack size in bytes", "(lambda (self) ...) -> ℕ -> actor-spawn[id]"}},
+    {"actor-memory", prim_actor_memory, 1, {"Resident bytes held by an actor, excluding its stack", "actor-spawn -> ℕ"}},
+    {"actor-arena-info", prim_actor_arena_info, 1, {"Arena statistics for actor (final once it finishes)", "actor-spawn -> [⟨:sym ℕ|Bool⟩] | nil"}},
+    {"freeze", prim_freeze, 1, {"Freeze immutable value for zero-copy sharing across actors", "α -> α | error"}},
+    {"frozen?", prim_frozen_p, 1, {"Check if value belongs to a frozen region", "α -> Bool"}},
+    {"frozen-regions", prim_frozen_regions, 0, {"Number of live frozen regions", "() -> ℕ"}},
     {"actor-send", prim_send, 2, {"Send message to actor (fire-and-forget)", "actor-spawn -> α -> nil"}},
     {"actor-receive", prim_receive, 0, {"Receive message (yields if mailbox empty)", "() -> α"}},
+    {"actor-receive-match", prim_receive_match, 1, {"Selective receive: oldest message matching predicate or tag", "(α -> Bool) | α -> α"}},
+    {"actor-receive-saved", prim_receive_saved, 0, {"Messages held in the selective-receive save queue", "() -> ℕ"}},
     {"actor-run", prim_actor_run, 1, {"Run actor scheduler for N ticks", "ℕ -> ℕ"}},
     {"sched-count", prim_sched_count, -1, {"Get/set scheduler count", "() -> ℕ | ℕ -> nil"}},
     {"sched-id", prim_sched_id, 0, {"Current scheduler ID", "() -> ℕ"}},
@@ -15322,6 +16013,8 @@ static Primitive primitives[] = {
     {"graph-predecessors", prim_graph_predecessors, 2, {"Get direct predecessor nodes", "graph-create -> α -> [α]"}},
     {"graph-path", prim_graph_path, 3, {"Find shortest path between nodes", "graph-create -> α -> α -> [α] | nil"}},
     {"graph-cycles", prim_graph_cycles, 1, {"Detect cycles in graph", "graph-create -> [[α]] | nil"}},
+    {"graph-topo-sort", prim_graph_topo_sort, 1, {"Topological order of graph nodes (error on cycle)", "graph-create -> [α] | error"}},
+    {"graph-shortest-path", prim_graph_shortest_path, 3, {"Least-cost path using numeric edge labels as weights", "graph-create -> α -> α -> (ℝ . [α]) | nil"}},
 
     /* String operations */
     {"string", prim_str, 1, {"Convert value to string", "α -> string"}},
@@ -15382,6 +16075,10 @@ static Primitive primitives[] = {
 
     /* Module System */
     {"load", prim_load, 1, {"Load and evaluate file", "string -> α"}},
+    {"gcache-file", prim_gcache_file, 1, {"Parse cache file used for a source path", "string -> string | nil"}},
+    {"gcache-hits", prim_gcache_hits, 0, {"Loads served from the parse cache", "() -> ℕ"}},
+    {"save-image", prim_save_image, 1, {"Save definitions, macros and registries to an image file; returns the count saved", "string -> ℕ"}},
+    {"load-image", prim_load_image, 1, {"Restore an image written by save-image", "string -> Bool"}},
     {"module-import", prim_module_import, 2, {"Validate symbols exist in module", "string -> [::symbol] -> ::ok | error"}},
     {"module-dependencies", prim_module_dependencies, 1, {"Get module dependencies", "string -> [string]"}},
 
@@ -15419,9 +16116,13 @@ static Primitive primitives[] = {
     {"hashmap-vals", prim_hashmap_vals, 1, {"Get list of values", "hashmap -> [β]"}},
     {"hashmap-entries", prim_hashmap_entries, 1, {"Get list of ⟨k v⟩ pairs", "hashmap -> [⟨α β⟩]"}},
     {"hashmap-merge", prim_hashmap_merge, 2, {"Merge two maps (m2 wins)", "hashmap -> hashmap -> hashmap"}},
+    {"hashmap-reserve", prim_hashmap_reserve, 2, {"Pre-size for n entries (no later resizes)", "hashmap -> ℕ -> hashmap"}},
+    {"hashmap-with-hash", prim_hashmap_with_hash, -1, {"Create hashmap with key hash family :sip or :fast", ":sip|:fast -> ⟨k v⟩... -> hashmap"}},
+    {"hash-family", prim_hash_family, 1, {"Key hash family of a hashmap or set", "hashmap|set -> :sip|:fast"}},
 
     /* HashSet (Boost-style groups-of-15 + overflow Bloom byte) */
     {"set", prim_set_new, -1, {"Create set from values", "α... -> set"}},
+    {"set-with-hash", prim_set_with_hash, -1, {"Create set with element hash family :sip or :fast", ":sip|:fast -> α... -> set"}},
     {"set-add", prim_set_add, 2, {"Add element to set (mutates)", "set -> α -> Bool"}},
     {"set-remove", prim_set_remove, 2, {"Remove element from set", "set -> α -> Bool"}},
     {"set?", prim_set_is, 1, {"Test if value is a set", "α -> Bool"}},
@@ -15495,11 +16196,17 @@ static Primitive primitives[] = {
     {"sorted-map-vals", prim_sorted_map_vals, 1, {"All values in key-sorted order", "sorted-map -> [β]"}},
     {"sorted-map-entries", prim_sorted_map_entries, 1, {"All ⟨k v⟩ pairs in sorted order", "sorted-map -> [⟨α β⟩]"}},
     {"sorted-map-merge", prim_sorted_map_merge, 2, {"Merge two sorted maps (m2 wins)", "sorted-map -> sorted-map -> sorted-map"}},
+    {"sorted-map-from-sorted", prim_sorted_map_from_sorted, 1, {"Bulk-load sorted map from vector of ⟨k v⟩ pairs in ascending key order", "[⟨α β⟩] -> sorted-map"}},
     {"sorted-map-min", prim_sorted_map_min, 1, {"Min entry -> ⟨k v⟩ or nil", "sorted-map -> ⟨α β⟩"}},
     {"sorted-map-max", prim_sorted_map_max, 1, {"Max entry -> ⟨k v⟩ or nil", "sorted-map -> ⟨α β⟩"}},
     {"sorted-map-range", prim_sorted_map_range, 3, {"Range [lo,hi] -> ⟨k v⟩ list", "sorted-map -> α -> α -> [⟨α β⟩]"}},
     {"sorted-map-floor", prim_sorted_map_floor, 2, {"Greatest key <= query -> ⟨k v⟩", "sorted-map -> α -> ⟨α β⟩"}},
     {"sorted-map-ceiling", prim_sorted_map_ceiling, 2, {"Least key >= query -> ⟨k v⟩", "sorted-map -> α -> ⟨α β⟩"}},
+    {"sorted-map-rank", prim_sorted_map_rank, 2, {"Number of keys < k", "sorted-map -> α -> ℕ"}},
+    {"sorted-map-nth", prim_sorted_map_nth, 2, {"Entry at position n in key order -> ⟨k v⟩", "sorted-map -> ℕ -> ⟨α β⟩"}},
+    {"sorted-map-count-range", prim_sorted_map_count_range, 3, {"Number of keys in [lo,hi]", "sorted-map -> α -> α -> ℕ"}},
+    {"sorted-map-range-iter", prim_sorted_map_range_iter, 3, {"Lazy ascending cursor over [lo,hi]", "sorted-map -> α -> α -> iter"}},
+    {"sorted-map-reverse-iter", prim_sorted_map_reverse_iter, -1, {"Lazy descending cursor, optionally over [lo,hi]", "sorted-map -> [α α] -> iter"}},
 
     /* Trie (Day 117 — ART with SIMD Node16 + path compression) */
     {"trie", prim_trie_new, -1, {"Create trie from ⟨k v⟩ pairs", "⟨k v⟩... -> trie"}},
@@ -15512,11 +16219,57 @@ static Primitive primitives[] = {
     {"trie-merge", prim_trie_merge, 2, {"Merge two tries (t2 wins)", "trie -> trie -> trie"}},
     {"trie-prefix-keys", prim_trie_prefix_keys, 2, {"All keys with prefix", "trie -> α -> [α]"}},
     {"trie-prefix-count", prim_trie_prefix_count, 2, {"Count keys with prefix", "trie -> α -> ℕ"}},
+    {"trie-prefix-iter", prim_trie_prefix_iter, 2, {"Lazy cursor over ⟨k v⟩ with prefix, in key order", "trie -> α -> iter"}},
+    {"trie-reverse-iter", prim_trie_reverse_iter, -1, {"Lazy descending cursor, optionally within a prefix", "trie -> [α] -> iter"}},
     {"trie-longest-prefix", prim_trie_longest_prefix, 2, {"Longest stored prefix of query", "trie -> α -> α"}},
     {"trie-entries", prim_trie_entries, 1, {"All ⟨k v⟩ pairs in lex order", "trie -> [⟨α β⟩]"}},
     {"trie-keys", prim_trie_keys, 1, {"All keys in lex order", "trie -> [α]"}},
     {"trie-vals", prim_trie_vals, 1, {"All values in key-sorted order", "trie -> [β]"}},
 
+    /* Persistent map/set (CHAMP — path-copying updates, structural sharing) */
+    {"pmap", prim_pmap_new, -1, {"Create persistent map from ⟨k v⟩ pairs", "⟨k v⟩... -> pmap"}},
+    {"pmap-get", prim_pmap_get, 2, {"Get value by key or nil", "pmap -> α -> β|nil"}},
+    {"pmap-put", prim_pmap_put, 3, {"New map with key set (original unchanged)", "pmap -> α -> β -> pmap"}},
+    {"pmap-del", prim_pmap_del, 2, {"New map without key (original unchanged)", "pmap -> α -> pmap"}},
+    {"pmap?", prim_pmap_is, 1, {"Test if persistent map", "α -> Bool"}},
+    {"pmap-has?", prim_pmap_has, 2, {"Check if key exists", "pmap -> α -> Bool"}},
+    {"pmap-size", prim_pmap_size, 1, {"Get entry count", "pmap -> ℕ"}},
+    {"pmap-keys", prim_pmap_keys, 1, {"Get list of keys", "pmap -> [α]"}},
+    {"pmap-vals", prim_pmap_vals, 1, {"Get list of values", "pmap -> [β]"}},
+    {"pmap-entries", prim_pmap_entries, 1, {"Get list of ⟨k v⟩ pairs", "pmap -> [⟨α β⟩]"}},
+    {"pmap-merge", prim_pmap_merge, 2, {"Merge two maps (m2 wins), sharing structure", "pmap -> pmap -> pmap"}},
+    {"pmap-transient", prim_pmap_transient, 1, {"Transient copy for batch edits", "pmap -> pmap!"}},
+    {"pmap-put!", prim_pmap_put_mut, 3, {"Set key in transient (mutates)", "pmap! -> α -> β -> pmap!"}},
+    {"pmap-del!", prim_pmap_del_mut, 2, {"Remove key from transient (mutates)", "pmap! -> α -> pmap!"}},
+    {"pmap-persistent!", prim_pmap_persistent, 1, {"Seal transient into persistent map", "pmap! -> pmap"}},
+    {"pset", prim_pset_new, -1, {"Create persistent set from values", "α... -> pset"}},
+    {"pset-add", prim_pset_add, 2, {"New set with element (original unchanged)", "pset -> α -> pset"}},
+    {"pset-remove", prim_pset_remove, 2, {"New set without element (original unchanged)", "pset -> α -> pset"}},
+    {"pset?", prim_pset_is, 1, {"Test if persistent set", "α -> Bool"}},
+    {"pset-has?", prim_pset_has, 2, {"Test membership", "pset -> α -> Bool"}},
+    {"pset-size", prim_pset_size, 1, {"Get element count", "pset -> ℕ"}},
+    {"pset-elements", prim_pset_elements, 1, {"Get all elements as list", "pset -> [α]"}},
+    {"pset-union", prim_pset_union, 2, {"Union of two sets, sharing structure", "pset -> pset -> pset"}},
+    {"pset-transient", prim_pset_transient, 1, {"Transient copy for batch edits", "pset -> pset!"}},
+    {"pset-add!", prim_pset_add_mut, 2, {"Add to transient (mutates)", "pset! -> α -> pset!"}},
+    {"pset-remove!", prim_pset_remove_mut, 2, {"Remove from transient (mutates)", "pset! -> α -> pset!"}},
+    {"pset-persistent!", prim_pset_persistent, 1, {"Seal transient into persistent set", "pset! -> pset"}},
+
+    /* Record tables (columnar struct-of-arrays over a leaf struct type) */
+    {"table", prim_table_new, -1, {"Create table of a leaf struct type from rows", ":type -> struct... -> table"}},
+    {"table?", prim_table_is, 1, {"Test if record table", "α -> Bool"}},
+    {"table-size", prim_table_size, 1, {"Get row count", "table -> ℕ"}},
+    {"table-columns", prim_table_columns, 1, {"Get column names in order", "table -> [:symbol]"}},
+    {"table-column-type", prim_table_column_type, 2, {"Column storage: :int :float :boxed or :empty", "table -> :symbol -> :symbol"}},
+    {"table-push!", prim_table_push, 2, {"Append a struct row (mutates)", "table -> struct -> table"}},
+    {"table-row", prim_table_row, 2, {"Row i as a struct", "table -> ℕ -> struct"}},
+    {"table-get", prim_table_get, 3, {"Field of row i, read from its column", "table -> ℕ -> :symbol -> α"}},
+    {"table-column", prim_table_column, 2, {"Column values as a vector", "table -> :symbol -> vector"}},
+    {"table-filter", prim_table_filter, 4, {"New table of rows where field op value holds", "table -> :symbol -> :op -> α -> table"}},
+    {"table-scan", prim_table_scan, 4, {"Iterator over rows where field op value holds", "table -> :symbol -> :op -> α -> iter"}},
+    {"table-project", prim_table_project, -1, {"New table with only the named columns", "table -> :symbol... -> table"}},
+    {"table-agg", prim_table_agg, 3, {"Aggregate a column: :count :sum :min :max :mean", "table -> :symbol -> :symbol -> α"}},
+
     /* Iterator (Day 118 — morsel-driven batch iteration) */
     {"iter", prim_iter, 1, {"Create iterator from collection", "α -> iter"}},
     {"iter-next", prim_iter_next, 1, {"Next element or nil", "iter -> α|nil"}},
@@ -15528,6 +16281,7 @@ static Primitive primitives[] = {
     {"iter-filter", prim_iter_filter, 2, {"Lazy filter (selection vector)", "iter -> (α->Bool) -> iter"}},
     {"iter-take", prim_iter_take, 2, {"Take first n elements", "iter -> ℕ -> iter"}},
     {"iter-drop", prim_iter_drop, 2, {"Drop first n elements", "iter -> ℕ -> iter"}},
+    {"iter-seek", prim_iter_seek, 2, {"Move sorted-map/trie cursor to first key >= k (reverse: <= k)", "iter -> α -> iter"}},
     {"iter-chain", prim_iter_chain, 2, {"Concatenate two iterators", "iter -> iter -> iter"}},
     {"iter-zip", prim_iter_zip, 2, {"Zip two iterators into pairs", "iter -> iter -> iter"}},
     {"iter-reduce", prim_iter_reduce, 3, {"Fold/reduce with init and fn", "iter -> α -> (α->β->α) -> α"}},
@@ -78,8 +78,17 @@ Cell* prim_effect_bind(Cell* args);    /* ≫ - effect bind */
 
 /* Actor primitives */
 Cell* prim_spawn(Cell* args);          /* ⟳ - spawn actor */
+Cell* prim_spawn_arena(Cell* args);    /* ⟳◎ - spawn actor with private arena */
+Cell* prim_actor_arena_info(Cell* args); /* ⟳◎? - arena statistics */
+Cell* prim_spawn_stack(Cell* args);    /* ⟳↕ - spawn actor with explicit stack size */
+Cell* prim_actor_memory(Cell* args);   /* ⟳# - resident bytes held by an actor */
+Cell* prim_freeze(Cell* args);          /* ❄ - freeze for zero-copy sharing */
+Cell* prim_frozen_p(Cell* args);        /* ❄? - frozen region member */
+Cell* prim_frozen_regions(Cell* args);  /* ❄# - live frozen regions */
 Cell* prim_send(Cell* args);           /* →! - send message */
 Cell* prim_receive(Cell* args);        /* ←? - receive message */
+Cell* prim_receive_match(Cell* args);  /* ←?⊙ - selective receive */
+Cell* prim_receive_saved(Cell* args);  /* ←?# - save queue depth */
 Cell* prim_actor_run(Cell* args);      /* ⟳! - run scheduler */
 Cell* prim_actor_alive(Cell* args);    /* ⟳? - check alive */
 Cell* prim_actor_result(Cell* args);   /* ⟳→ - get result */
@@ -133,6 +142,10 @@ Cell* prim_file_empty(Cell* args);          /* ≋∅? - file empty */
 
 /* Module System */
 Cell* prim_load(Cell* args);                /* ⋘ - load and evaluate file */
+Cell* prim_gcache_file(Cell* args);         /* gcache-file - parse cache path for a source */
+Cell* prim_gcache_hits(Cell* args);         /* gcache-hits - loads served from the parse cache */
+Cell* prim_save_image(Cell* args);          /* save-image - write heap image */
+Cell* prim_load_image(Cell* args);          /* load-image - restore heap image */
 Cell* prim_module_import(Cell* args);       /* ⋖ - selective import */
 Cell* prim_module_info(Cell* args);         /* ⌂⊚ - module information */
 Cell* prim_module_dependencies(Cell* args); /* ⌂⊚→ - module dependencies */
@@ -140,6 +153,11 @@ Cell* prim_module_loaded_p(Cell* args);        /* ⋘? - module loaded predicate
 Cell* prim_module_define(Cell* args);          /* ⊞◇ - module define (exports) */
 Cell* prim_module_import_validated(Cell* args); /* ⋘⊳ - validated import */
 
+/* Mutable box primitives */
+Cell* prim_box_create(Cell* args);     /* □ - create mutable box */
+Cell* prim_box_deref(Cell* args);      /* □→ - deref box */
+Cell* prim_box_set(Cell* args);        /* □← - set box, return old value */
+
 /* Weak reference primitives */
 Cell* prim_weak_create(Cell* args);    /* ◇ - create weak reference */
 Cell* prim_weak_deref(Cell* args);     /* ◇→ - deref weak ref */
@@ -158,9 +176,13 @@ Cell* prim_hashmap_keys(Cell* args);      /* ⊞⊙ - keys list */
 Cell* prim_hashmap_vals(Cell* args);      /* ⊞⊗ - values list */
 Cell* prim_hashmap_entries(Cell* args);   /* ⊞* - entries list */
 Cell* prim_hashmap_merge(Cell* args);     /* ⊞⊕ - merge two maps */
+Cell* prim_hashmap_reserve(Cell* args);   /* ⊞⊇ - pre-size for n entries */
+Cell* prim_hashmap_with_hash(Cell* args); /* ⊞ with :sip / :fast key hashing */
+Cell* prim_hash_family(Cell* args);       /* hash family of hashmap / set */
 
 /* HashSet primitives (Boost-style groups-of-15 + overflow Bloom byte) */
 Cell* prim_set_new(Cell* args);           /* ⊍ - create set */
+Cell* prim_set_with_hash(Cell* args);     /* ⊍ with :sip / :fast hashing */
 Cell* prim_set_add(Cell* args);           /* ⊍⊕ - add element */
 Cell* prim_set_remove(Cell* args);        /* ⊍⊖ - remove element */
 Cell* prim_set_is(Cell* args);            /* ⊍? - type predicate */
@@ -234,11 +256,17 @@ Cell* prim_sorted_map_keys(Cell* args);
 Cell* prim_sorted_map_vals(Cell* args);
 Cell* prim_sorted_map_entries(Cell* args);
 Cell* prim_sorted_map_merge(Cell* args);
+Cell* prim_sorted_map_from_sorted(Cell* args);
 Cell* prim_sorted_map_min(Cell* args);
 Cell* prim_sorted_map_max(Cell* args);
 Cell* prim_sorted_map_range(Cell* args);
 Cell* prim_sorted_map_floor(Cell* args);
 Cell* prim_sorted_map_ceiling(Cell* args);
+Cell* prim_sorted_map_rank(Cell* args);
+Cell* prim_sorted_map_nth(Cell* args);
+Cell* prim_sorted_map_count_range(Cell* args);
+Cell* prim_sorted_map_range_iter(Cell* args);
+Cell* prim_sorted_map_reverse_iter(Cell* args);
 
 /* Trie primitives (Day 117 — ART with SIMD Node16 + path compression) */
 Cell* prim_trie_new(Cell* args);
@@ -251,11 +279,57 @@ Cell* prim_trie_size(Cell* args);
 Cell* prim_trie_merge(Cell* args);
 Cell* prim_trie_prefix_keys(Cell* args);
 Cell* prim_trie_prefix_count(Cell* args);
+Cell* prim_trie_prefix_iter(Cell* args);
+Cell* prim_trie_reverse_iter(Cell* args);
 Cell* prim_trie_longest_prefix(Cell* args);
 Cell* prim_trie_entries(Cell* args);
 Cell* prim_trie_keys(Cell* args);
 Cell* prim_trie_vals(Cell* args);
 
+/* Persistent map/set primitives (CHAMP — path copying + transients) */
+Cell* prim_pmap_new(Cell* args);
+Cell* prim_pmap_get(Cell* args);
+Cell* prim_pmap_put(Cell* args);
+Cell* prim_pmap_del(Cell* args);
+Cell* prim_pmap_is(Cell* args);
+Cell* prim_pmap_has(Cell* args);
+Cell* prim_pmap_size(Cell* args);
+Cell* prim_pmap_keys(Cell* args);
+Cell* prim_pmap_vals(Cell* args);
+Cell* prim_pmap_entries(Cell* args);
+Cell* prim_pmap_merge(Cell* args);
+Cell* prim_pmap_transient(Cell* args);
+Cell* prim_pmap_put_mut(Cell* args);
+Cell* prim_pmap_del_mut(Cell* args);
+Cell* prim_pmap_persistent(Cell* args);
+Cell* prim_pset_new(Cell* args);
+Cell* prim_pset_add(Cell* args);
+Cell* prim_pset_remove(Cell* args);
+Cell* prim_pset_is(Cell* args);
+Cell* prim_pset_has(Cell* args);
+Cell* prim_pset_size(Cell* args);
+Cell* prim_pset_elements(Cell* args);
+Cell* prim_pset_union(Cell* args);
+Cell* prim_pset_transient(Cell* args);
+Cell* prim_pset_add_mut(Cell* args);
+Cell* prim_pset_remove_mut(Cell* args);
+Cell* prim_pset_persistent(Cell* args);
+
+/* Record table primitives (columnar struct-of-arrays) */
+Cell* prim_table_new(Cell* args);
+Cell* prim_table_is(Cell* args);
+Cell* prim_table_size(Cell* args);
+Cell* prim_table_columns(Cell* args);
+Cell* prim_table_column_type(Cell* args);
+Cell* prim_table_push(Cell* args);
+Cell* prim_table_row(Cell* args);
+Cell* prim_table_get(Cell* args);
+Cell* prim_table_column(Cell* args);
+Cell* prim_table_filter(Cell* args);
+Cell* prim_table_scan(Cell* args);
+Cell* prim_table_project(Cell* args);
+Cell* prim_table_agg(Cell* args);
+
 /* Char/Case primitives (Day 119) */
 Cell* prim_str_char_code(Cell* args);    /* ≈→# - char code at index */
 Cell* prim_code_to_char(Cell* args);     /* #→≈ - code to single-char string */
@@ -303,6 +377,7 @@ Cell* prim_iter_map(Cell* args);         /* ⊣↦ - lazy map */
 Cell* prim_iter_filter(Cell* args);      /* ⊣⊲ - lazy filter */
 Cell* prim_iter_take(Cell* args);        /* ⊣↑ - take n */
 Cell* prim_iter_drop(Cell* args);        /* ⊣↓ - drop n */
+Cell* prim_iter_seek(Cell* args);        /* seek sorted-map/trie cursor */
 Cell* prim_iter_chain(Cell* args);       /* ⊣⊕⊕ - concatenate */
 Cell* prim_iter_zip(Cell* args);         /* ⊣⊗ - zip */
 Cell* prim_iter_reduce(Cell* args);      /* ⊣Σ - fold/reduce */
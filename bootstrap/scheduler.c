@@ -476,8 +476,8 @@ int global_queue_size(void) {
 char* sched_stack_alloc(Scheduler* s, size_t stack_size) {
     if (!g_page_size) g_page_size = (size_t)sysconf(_SC_PAGESIZE);
 
-    /* Try pool first */
-    if (s && s->stack_pool_count > 0) {
+    /* Try pool first (pool holds default-size stacks only) */
+    if (s && s->stack_pool_count > 0 && stack_size == FIBER_DEFAULT_STACK_SIZE) {
         return s->stack_pool[--s->stack_pool_count];
     }
 
@@ -490,9 +490,12 @@ char* sched_stack_alloc(Scheduler* s, size_t stack_size) {
     /* Guard page: PROT_NONE at lowest address */
     mprotect(base, g_page_size, PROT_NONE);
 
-    /* Pre-fault every page (MAP_POPULATE doesn't exist on macOS) */
+    /* Pre-fault only the top of the stack, where a fiber starts and
+     * mostly stays; the rest is committed on demand. (MAP_POPULATE
+     * doesn't exist on macOS, and would commit the whole reservation.) */
     volatile char* p = (char*)base + g_page_size;
-    for (size_t i = 0; i < stack_size; i += g_page_size) {
+    size_t prefault = stack_size < FIBER_PREFAULT_SIZE ? stack_size : FIBER_PREFAULT_SIZE;
+    for (size_t i = stack_size - prefault; i < stack_size; i += g_page_size) {
         p[i] = 0;
     }
 
@@ -504,7 +507,7 @@ void sched_stack_free(Scheduler* s, char* stack, size_t stack_size) {
     if (!g_page_size) g_page_size = (size_t)sysconf(_SC_PAGESIZE);
 
     /* Check if this is an mmap'd stack (address will be page-aligned - guard_size) */
-    if (s && s->stack_pool_count < STACK_POOL_MAX) {
+    if (s && s->stack_pool_count < STACK_POOL_MAX && stack_size == FIBER_DEFAULT_STACK_SIZE) {
         s->stack_pool[s->stack_pool_count++] = stack;
         return;
     }
@@ -561,12 +564,14 @@ void qsbr_reclaim_amortized(Scheduler* s) {
     RetireRing* r = &s->retire_ring;
     /* Drip-reclaim at most 2 actors per call (PPoPP 2024 amortized pattern).
      * Once safe, the actor pointer is guaranteed not to be dereferenced by
-     * any scheduler's deque/runnext. Actor memory stays in the registry
-     * for result queries — actual free is deferred to actor_reset_all. */
+     * any scheduler's deque/runnext, so its private heap can go. The Actor
+     * itself stays in the registry for result queries — actual free is
+     * deferred to actor_reset_all. */
     int freed = 0;
     while (r->head != r->tail && freed < 2) {
         uint32_t hi = r->head & RETIRE_MASK;
         if (!qsbr_safe(r->epochs[hi])) break;  /* Not yet safe */
+        actor_release_arena(r->actors[hi]);
         r->actors[hi] = NULL;
         r->head++;
         freed++;
@@ -575,12 +580,13 @@ void qsbr_reclaim_amortized(Scheduler* s) {
 
 void qsbr_drain_all(void) {
     /* Called after all workers joined — single-threaded.
-     * Clear retire rings. Actor memory stays in registry for result queries;
-     * actual free is deferred to actor_reset_all. */
+     * Clear retire rings, releasing arenas. Actor memory stays in registry
+     * for result queries; actual free is deferred to actor_reset_all. */
     for (int i = 0; i < g_num_schedulers; i++) {
         RetireRing* r = &g_schedulers[i].retire_ring;
         while (r->head != r->tail) {
             uint32_t hi = r->head & RETIRE_MASK;
+            actor_release_arena(r->actors[hi]);
             r->actors[hi] = NULL;
             r->head++;
         }
@@ -809,6 +815,8 @@ bool sched_actor_runnable(Actor* actor) {
             Actor* awaited = actor_lookup(fiber->suspend_await_actor_id);
             return !awaited || !awaited->alive;
         }
+        case SUSPEND_CALL:
+            return atomic_load_explicit(&actor->call_reply, memory_order_acquire) != NULL;
         case SUSPEND_GENERAL:
             return false; /* Wait for explicit resume */
         case SUSPEND_REDUCTION:
@@ -825,7 +833,8 @@ Cell* sched_prepare_resume(Actor* actor) {
 
     switch (fiber->suspend_reason) {
         case SUSPEND_MAILBOX: {
-            Cell* msg = actor_receive(actor);
+            /* The save queue was already scanned before suspending */
+            Cell* msg = actor_mailbox_take(actor);
             resume_val = msg ? msg : cell_nil();
             break;
         }
@@ -892,6 +901,11 @@ Cell* sched_prepare_resume(Actor* actor) {
             }
             break;
         }
+        case SUSPEND_CALL: {
+            Cell* reply = atomic_exchange_explicit(&actor->call_reply, NULL, memory_order_acq_rel);
+            resume_val = reply ? reply : cell_nil();
+            break;
+        }
         case SUSPEND_GENERAL:
             resume_val = cell_nil();
             break;
@@ -924,6 +938,7 @@ int sched_run_one_quantum(Scheduler* sched, Actor* actor) {
     Fiber* prev_fiber = fiber_current();
     actor_set_current(actor);
     fiber_set_current(fiber);
+    CellArena* prev_arena = cell_arena_enter(actor->arena);
 
     /* Reassign fiber's eval context to this scheduler's context
      * (actor may have been stolen from another scheduler) */
@@ -970,6 +985,7 @@ int sched_run_one_quantum(Scheduler* sched, Actor* actor) {
         fiber_resume(fiber, resume_val);
         if (resume_val) cell_release(resume_val);
     }
+    cell_arena_enter(prev_arena);
 
     /* Save continuation back to fiber for next quantum */
     if (sched->eval_ctx.continuation) {
@@ -1030,6 +1046,7 @@ static void* scheduler_worker_main(void* arg) {
         sched->eval_ctx.reductions_left = CONTEXT_REDS;
         sched->eval_ctx.continuation = NULL;
         sched->eval_ctx.continuation_env = NULL;
+        sched->eval_ctx.stack_limit = NULL;
     }
     eval_set_current_context(&sched->eval_ctx);
 
@@ -1221,6 +1238,7 @@ int sched_run_all(int max_ticks) {
     g_schedulers[0].eval_ctx.reductions_left = CONTEXT_REDS;
     g_schedulers[0].eval_ctx.continuation = NULL;
     g_schedulers[0].eval_ctx.continuation_env = NULL;
+    g_schedulers[0].eval_ctx.stack_limit = NULL;
     eval_set_current_context(&g_schedulers[0].eval_ctx);
 
     /* Distribute actors to schedulers */